@@ -0,0 +1,47 @@
+/*
+ * Async File Benchmarks
+ * Each iteration loads an 8 MiB file from the stdio drive with
+ * FileSystem::load_async() while the timer handler keeps running. The
+ * longest single handler call is printed, since that is the stall the UI
+ * would see.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../misc/file_system.h"
+#include "bench.h"
+#include "../lvgl_cpp.h"
+
+#if LV_USE_FS_STDIO
+
+LVGL_BENCHMARK(File_LoadAsync_8MiB) {
+  std::string path = std::string(1, LV_FS_STDIO_LETTER) + ":bench_async.bin";
+  {
+    std::vector<uint8_t> data(8 * 1024 * 1024, 0x5a);
+    lvgl::File file(path, lvgl::FsMode::Write);
+    file.write(data.data(), static_cast<uint32_t>(data.size()));
+  }
+  double worst_ms = 0.0;
+  for (int i = 0; i < state.iterations; ++i) {
+    bool done = false;
+    lvgl::FileRequest request = lvgl::FileSystem::load_async(
+        path, [&](lvgl::FsRes, std::vector<uint8_t>) { done = true; });
+    while (!done) {
+      auto start = std::chrono::steady_clock::now();
+      lv_tick_inc(1);
+      lv_timer_handler();
+      std::chrono::duration<double, std::milli> took =
+          std::chrono::steady_clock::now() - start;
+      if (took.count() > worst_ms) worst_ms = took.count();
+    }
+  }
+  std::remove("bench_async.bin");
+  // stderr: stdout carries the benchmark's JSON line.
+  std::fprintf(stderr, "  File_LoadAsync_8MiB: worst handler call %.2f ms\n",
+               worst_ms);
+}
+
+#endif  // LV_USE_FS_STDIO
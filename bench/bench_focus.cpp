@@ -0,0 +1,132 @@
+/*
+ * Focus Navigation Benchmarks
+ * A 50x50 grid of buttons in one group. Each iteration walks a square of
+ * 8 cells per side (32 key presses) with linear focus_next/focus_prev, a
+ * naive directional scan that reads every member's coordinates per press,
+ * and Group::focus_direction backed by the cached neighbor graph, with
+ * and without a member moving between presses.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../core/group.h"
+#include "bench.h"
+#include "../lvgl_cpp.h"
+
+namespace {
+
+constexpr int kSide = 50;
+constexpr int kSteps = 8;
+const lvgl::Dir kPath[] = {lvgl::Dir::Right, lvgl::Dir::Bottom,
+                           lvgl::Dir::Left, lvgl::Dir::Top};
+
+struct Grid {
+  std::unique_ptr<lvgl::Object> panel;
+  lvgl::Group group;
+  std::vector<lv_obj_t*> cells;
+
+  Grid() : panel(std::make_unique<lvgl::Object>(lv_scr_act())) {
+    panel->set_size(800, 600);
+    lv_obj_set_style_pad_all(panel->raw(), 0, 0);
+    group.set_wrap(false);
+    cells.reserve(kSide * kSide);
+    for (int i = 0; i < kSide * kSide; ++i) {
+      lv_obj_t* button = lv_button_create(panel->raw());
+      lv_obj_set_pos(button, (i % kSide) * 16, (i / kSide) * 12);
+      lv_obj_set_size(button, 14, 10);
+      group.add_obj(button);
+      cells.push_back(button);
+    }
+    lv_obj_update_layout(panel->raw());
+    group.focus_obj(cells[10 * kSide + 10]);
+  }
+};
+
+// What hand-written directional code typically does: score every member
+// on every press.
+void focus_scan(lv_group_t* group, lvgl::Dir dir) {
+  lv_obj_t* focused = lv_group_get_focused(group);
+  lv_area_t from;
+  lv_obj_get_coords(focused, &from);
+  int32_t fx = (from.x1 + from.x2) / 2;
+  int32_t fy = (from.y1 + from.y2) / 2;
+  lv_obj_t* best = nullptr;
+  int64_t best_score = 0;
+  uint32_t count = lv_group_get_obj_count(group);
+  for (uint32_t i = 0; i < count; ++i) {
+    lv_obj_t* obj = lv_group_get_obj_by_index(group, i);
+    if (obj == focused) continue;
+    lv_area_t to;
+    lv_obj_get_coords(obj, &to);
+    int64_t dx = (to.x1 + to.x2) / 2 - fx;
+    int64_t dy = (to.y1 + to.y2) / 2 - fy;
+    int64_t major = dir == lvgl::Dir::Right    ? dx
+                    : dir == lvgl::Dir::Left   ? -dx
+                    : dir == lvgl::Dir::Bottom ? dy
+                                               : -dy;
+    int64_t minor =
+        dir == lvgl::Dir::Left || dir == lvgl::Dir::Right ? dy : dx;
+    if (major <= 0) continue;
+    int64_t score = 13 * major * major + minor * minor;
+    if (!best || score < best_score) {
+      best = obj;
+      best_score = score;
+    }
+  }
+  if (best) lv_group_focus_obj(best);
+}
+
+}  // namespace
+
+LVGL_BENCHMARK(FocusNav_50x50_Linear) {
+  Grid grid;
+  for (int i = 0; i < state.iterations; ++i) {
+    for (lvgl::Dir dir : kPath) {
+      // Vertical moves cost a full row of presses.
+      int presses = (dir == lvgl::Dir::Left || dir == lvgl::Dir::Right)
+                        ? kSteps
+                        : kSteps * kSide;
+      bool forward = dir == lvgl::Dir::Right || dir == lvgl::Dir::Bottom;
+      for (int p = 0; p < presses; ++p) {
+        if (forward) {
+          grid.group.focus_next();
+        } else {
+          grid.group.focus_prev();
+        }
+      }
+    }
+  }
+}
+
+LVGL_BENCHMARK(FocusNav_50x50_Scan) {
+  Grid grid;
+  for (int i = 0; i < state.iterations; ++i) {
+    for (lvgl::Dir dir : kPath) {
+      for (int p = 0; p < kSteps; ++p) focus_scan(grid.group.raw(), dir);
+    }
+  }
+}
+
+LVGL_BENCHMARK(FocusNav_50x50_Graph) {
+  Grid grid;
+  for (int i = 0; i < state.iterations; ++i) {
+    for (lvgl::Dir dir : kPath) {
+      for (int p = 0; p < kSteps; ++p) grid.group.focus_direction(dir);
+    }
+  }
+}
+
+LVGL_BENCHMARK(FocusNav_50x50_GraphMoving) {
+  Grid grid;
+  for (int i = 0; i < state.iterations; ++i) {
+    // One member away from the path moves per side walked.
+    for (lvgl::Dir dir : kPath) {
+      lv_obj_t* moved = grid.cells[(40 + i % 10) * kSide + (i * 7) % kSide];
+      lv_obj_set_x(moved, lv_obj_get_x(moved) ^ 1);
+      lv_obj_update_layout(grid.panel->raw());
+      for (int p = 0; p < kSteps; ++p) grid.group.focus_direction(dir);
+    }
+  }
+}
@@ -0,0 +1,223 @@
+/*
+ * Font Benchmarks
+ * First-frame cost of Tiny TTF text, cold versus prewarmed glyph cache,
+ * loading a whole binary font versus a subset of it, and CJK label rendering
+ * with and without the glyph index.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../font/owned_font.h"
+#include "../misc/file_system.h"
+#include "../tests/binfont_writer.h"
+#include "../widgets/label.h"
+#include "bench.h"
+#include "../lvgl_cpp.h"
+
+#if LV_USE_TINY_TTF
+
+namespace {
+
+// Set LVGL_BENCH_TTF to benchmark another font.
+std::vector<char> read_bench_ttf() {
+  const char* env = std::getenv("LVGL_BENCH_TTF");
+  const char* path =
+      env ? env : "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in), {});
+}
+
+const char* kParagraph =
+    "The quick brown fox jumps over the lazy dog. 0123456789\n"
+    "Pack my box with five dozen liquor jugs! (42%) [ok] {x: 7}\n"
+    "Sphinx of black quartz, judge my vow; WALTZ, NYMPH, FOR QUICK JIGS.";
+
+const char32_t* kCharset =
+    U" !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    U"[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+// Build a label with the paragraph and render it once.
+void render_paragraph(const lvgl::OwnedFont& font) {
+  auto screen = std::make_unique<lvgl::Object>(lv_scr_act());
+  lvgl::Label label(screen.get());
+  lv_obj_set_style_text_font(label.raw(), font.raw(), 0);
+  label.set_text(kParagraph);
+  lv_refr_now(nullptr);
+}
+
+}  // namespace
+
+// Every iteration loads a fresh font, so each glyph is rasterized inside the
+// render pass.
+LVGL_BENCHMARK(Font_TinyTTF_FirstFrame_Cold) {
+  std::vector<char> ttf = read_bench_ttf();
+  if (ttf.empty()) return;
+  for (int i = 0; i < state.iterations; ++i) {
+    auto font = lvgl::OwnedFont::load_tiny_ttf(ttf.data(), ttf.size(), 24);
+    render_paragraph(font);
+  }
+}
+
+// Same frames with the glyph set rasterized ahead of time; the remaining
+// cost is layout and blending.
+LVGL_BENCHMARK(Font_TinyTTF_FirstFrame_Warm) {
+  std::vector<char> ttf = read_bench_ttf();
+  if (ttf.empty()) return;
+  auto font = lvgl::OwnedFont::load_tiny_ttf(ttf.data(), ttf.size(), 24,
+                                             256 * 1024);
+  font.prewarm(kCharset);
+  for (int i = 0; i < state.iterations; ++i) {
+    render_paragraph(font);
+  }
+}
+
+#endif  // LV_USE_TINY_TTF
+
+#if LV_USE_FS_MEMFS && LV_USE_FS_STDIO && LV_FONT_MONTSERRAT_14
+
+namespace {
+
+// Montserrat 14 serialized to a .bin file on the stdio drive.
+std::string write_bench_bin() {
+  std::string path = std::string(1, LV_FS_STDIO_LETTER) + ":bench_font.bin";
+  std::vector<uint8_t> bin =
+      lvgl_test::BinFontWriter::write(&lv_font_montserrat_14);
+  lvgl::File file(path, lvgl::FsMode::Write);
+  file.write(bin.data(), static_cast<uint32_t>(bin.size()));
+  return path;
+}
+
+const char32_t* kDigits = U"0123456789.,-%";
+
+// LVGL heap bytes in use; 0 unless LVGL uses its builtin allocator.
+size_t heap_used() {
+  lv_mem_monitor_t mon;
+  lv_mem_monitor(&mon);
+  return mon.total_size - mon.free_size;
+}
+
+// Stats go to stderr; stdout carries the benchmark's JSON line.
+void report_font_heap(const char* name, size_t before) {
+  std::fprintf(stderr, "  %s: %zu LVGL heap bytes held by one font\n", name,
+               heap_used() - before);
+}
+
+}  // namespace
+
+// One font stays loaded for the heap report; the loop times load and
+// destroy.
+LVGL_BENCHMARK(Font_Bin_Load_Full) {
+  std::string path = write_bench_bin();
+  size_t before = heap_used();
+  auto kept = lvgl::OwnedFont::load_bin(path);
+  report_font_heap("Full", before);
+  for (int i = 0; i < state.iterations; ++i) {
+    auto font = lvgl::OwnedFont::load_bin(path);
+  }
+}
+
+// A numeric readout only needs a dozen glyphs; the loader then allocates
+// and decodes a fraction of the font.
+LVGL_BENCHMARK(Font_Bin_Load_DigitsSubset) {
+  std::string path = write_bench_bin();
+  lvgl::OwnedFont::SubsetInfo info;
+  size_t before = heap_used();
+  auto kept = lvgl::OwnedFont::load_bin_subset(path, kDigits, &info);
+  report_font_heap("DigitsSubset", before);
+  std::fprintf(stderr, "  DigitsSubset: %u of %u glyphs, %u file bytes saved\n",
+               info.glyphs_kept, info.glyphs_total, info.bytes_saved());
+  for (int i = 0; i < state.iterations; ++i) {
+    auto font = lvgl::OwnedFont::load_bin_subset(path, kDigits);
+  }
+}
+
+#endif  // LV_USE_FS_MEMFS && LV_USE_FS_STDIO && LV_FONT_MONTSERRAT_14
+
+#if LV_USE_FS_STDIO
+
+namespace {
+
+constexpr uint32_t kCjkGlyphs = 2000;
+constexpr uint32_t kCjkPerSubtable = 50;
+
+// A synthetic CJK font laid out like lv_font_conv output for a sparse
+// character set: many SPARSE_TINY subtables, each searched in turn.
+std::string write_cjk_bin(std::string* text) {
+  static const uint8_t kBitmap[72] = {0x5a};  // 12x12 at 4 bpp.
+  static lv_font_fmt_txt_glyph_dsc_t glyphs[kCjkGlyphs + 1];
+  static uint16_t unicodes[kCjkPerSubtable];
+  static lv_font_fmt_txt_cmap_t cmaps[kCjkGlyphs / kCjkPerSubtable];
+
+  for (uint32_t i = 1; i <= kCjkGlyphs; ++i) {
+    glyphs[i] = {0, 14 * 16, 12, 12, 1, -2};
+  }
+  for (uint32_t j = 0; j < kCjkPerSubtable; ++j) unicodes[j] = j * 3;
+  for (uint32_t c = 0; c < kCjkGlyphs / kCjkPerSubtable; ++c) {
+    cmaps[c] = {0x4E00 + c * 0x200, kCjkPerSubtable * 3,
+                static_cast<uint16_t>(1 + c * kCjkPerSubtable), unicodes,
+                nullptr, kCjkPerSubtable, LV_FONT_FMT_TXT_CMAP_SPARSE_TINY};
+  }
+
+  static lv_font_fmt_txt_dsc_t dsc{};
+  dsc.glyph_bitmap = kBitmap;
+  dsc.glyph_dsc = glyphs;
+  dsc.cmaps = cmaps;
+  dsc.cmap_num = kCjkGlyphs / kCjkPerSubtable;
+  dsc.bpp = 4;
+  lv_font_t font{};
+  font.dsc = &dsc;
+  font.line_height = 16;
+  font.base_line = 2;
+
+  text->clear();
+  for (uint32_t c = 0; c < kCjkGlyphs / kCjkPerSubtable; ++c) {
+    for (uint32_t j = 0; j < kCjkPerSubtable; ++j) {
+      uint32_t cp = cmaps[c].range_start + unicodes[j];
+      text->push_back(static_cast<char>(0xE0 | (cp >> 12)));
+      text->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      text->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+  }
+
+  std::string path = std::string(1, LV_FS_STDIO_LETTER) + ":bench_cjk.bin";
+  std::vector<uint8_t> bin = lvgl_test::BinFontWriter::write(&font);
+  lvgl::File file(path, lvgl::FsMode::Write);
+  file.write(bin.data(), static_cast<uint32_t>(bin.size()));
+  return path;
+}
+
+void render_cjk(bool with_glyph_index, int iterations) {
+  std::string text;
+  std::string path = write_cjk_bin(&text);
+  auto font = lvgl::OwnedFont::load_bin(path, with_glyph_index);
+  if (!font.is_valid()) return;
+
+  auto screen = std::make_unique<lvgl::Object>(lv_scr_act());
+  lvgl::Label label(screen.get());
+  lv_obj_set_width(label.raw(), 780);
+  lv_obj_set_style_text_font(label.raw(), font.raw(), 0);
+  for (int i = 0; i < iterations; ++i) {
+    // Re-measures and redraws every glyph.
+    lv_label_set_text(label.raw(), text.c_str());
+    lv_refr_now(nullptr);
+  }
+}
+
+}  // namespace
+
+// 2,000 distinct characters: each lookup walks up to 40 subtables.
+LVGL_BENCHMARK(Font_CJK2000_Label_Cmap) {
+  render_cjk(false, state.iterations);
+}
+
+LVGL_BENCHMARK(Font_CJK2000_Label_GlyphIndex) {
+  render_cjk(true, state.iterations);
+}
+
+#endif  // LV_USE_FS_STDIO
@@ -0,0 +1,109 @@
+/*
+ * Hit Test Benchmarks
+ * A scrollable map holds 1k, 5k or 20k small clickable children on an
+ * 8 px pitch. Each iteration presses and releases 8 visible children
+ * through a pointer input device, once with LVGL's recursive search and
+ * once routed through a HitTestIndex. Building the map and the index is
+ * part of the reported time, so each run also prints the time per press
+ * measured around the input reads alone.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+#include "../core/hit_test_index.h"
+#include "../indev/pointer_input.h"
+#include "bench.h"
+#include "../lvgl_cpp.h"
+
+namespace {
+
+constexpr int32_t kPitch = 8;
+constexpr int32_t kColumns = 100;
+constexpr int32_t kVisibleRows = 70;
+constexpr int kPressesPerIteration = 8;
+
+lv_point_t touch_point = {0, 0};
+bool touch_pressed = false;
+
+void run_presses(lvgl::bench::State& state, const char* name, int children,
+                 bool indexed) {
+  auto map = std::make_unique<lvgl::Object>(lv_scr_act());
+  map->set_size(800, 600);
+  lv_obj_set_style_pad_all(map->raw(), 0, 0);
+  std::unique_ptr<lvgl::HitTestIndex> index;
+  if (indexed) index = std::make_unique<lvgl::HitTestIndex>(*map, 32);
+  for (int i = 0; i < children; ++i) {
+    // Bare objects keep 20k children within the LVGL heap.
+    lv_obj_t* child = lv_obj_create(map->raw());
+    lv_obj_remove_style_all(child);
+    lv_obj_set_pos(child, (i % kColumns) * kPitch, (i / kColumns) * kPitch);
+    lv_obj_set_size(child, kPitch - 2, kPitch - 2);
+  }
+  lv_obj_update_layout(map->raw());
+  if (index) index->rebuild();
+
+  lvgl::PointerInput pointer = lvgl::PointerInput::create();
+  pointer.set_read_cb([](lvgl::IndevData& data) {
+    data.set_point(touch_point)
+        .set_state(touch_pressed ? lvgl::IndevState::Pressed
+                                 : lvgl::IndevState::Released);
+  });
+
+  int32_t rows = std::min(children / kColumns, kVisibleRows);
+  uint32_t seed = 1;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < state.iterations; ++i) {
+    for (int p = 0; p < kPressesPerIteration; ++p) {
+      seed = seed * 1103515245u + 12345u;
+      int32_t col = static_cast<int32_t>((seed >> 8) % kColumns);
+      int32_t row = static_cast<int32_t>((seed >> 20) % rows);
+      touch_point = {col * kPitch + 2, row * kPitch + 2};
+      touch_pressed = true;
+      lv_indev_read(pointer.raw());
+      touch_pressed = false;
+      lv_indev_read(pointer.raw());
+    }
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  int presses = state.iterations * kPressesPerIteration;
+  if (presses > 0) {
+    // stderr: stdout carries the benchmark's JSON line.
+    std::fprintf(
+        stderr, "  %s: %.0f ns per press\n", name,
+        static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count()) /
+            presses);
+  }
+  index.reset();
+}
+
+}  // namespace
+
+LVGL_BENCHMARK(HitTest_Press_1k_Lvgl) {
+  run_presses(state, "HitTest_Press_1k_Lvgl", 1000, false);
+}
+
+LVGL_BENCHMARK(HitTest_Press_1k_Index) {
+  run_presses(state, "HitTest_Press_1k_Index", 1000, true);
+}
+
+LVGL_BENCHMARK(HitTest_Press_5k_Lvgl) {
+  run_presses(state, "HitTest_Press_5k_Lvgl", 5000, false);
+}
+
+LVGL_BENCHMARK(HitTest_Press_5k_Index) {
+  run_presses(state, "HitTest_Press_5k_Index", 5000, true);
+}
+
+LVGL_BENCHMARK(HitTest_Press_20k_Lvgl) {
+  run_presses(state, "HitTest_Press_20k_Lvgl", 20000, false);
+}
+
+LVGL_BENCHMARK(HitTest_Press_20k_Index) {
+  run_presses(state, "HitTest_Press_20k_Index", 20000, true);
+}
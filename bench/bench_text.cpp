@@ -0,0 +1,282 @@
+/*
+ * Text Measurement Benchmarks
+ * A 50x20 numeric table refit to its contents every frame, with and without
+ * the TextMetricsCache, 500 numeric labels updated at 30 Hz, and edits and
+ * scrolling on a 1 MB document in a TextView versus a Textarea, and a
+ * 10k lines/s log in a LogView versus a Textarea.
+ */
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../misc/text_document.h"
+#include "../misc/text_metrics_cache.h"
+#include "../widgets/label.h"
+#include "../widgets/log_view.h"
+#include "../widgets/table.h"
+#include "../widgets/text_view.h"
+#include "../widgets/textarea.h"
+#include "bench.h"
+#include "../lvgl_cpp.h"
+
+namespace {
+
+constexpr uint32_t kRows = 50;
+constexpr uint32_t kCols = 20;
+
+// Rewrite every cell each frame, as a polling dashboard would, then fit
+// every column to its widest cell. Only one cell in 20 actually changes
+// value between frames. Both variants skip unchanged cells, so they differ
+// only in whether fit_column_width() measures through the cache.
+void run_table_frames(lvgl::bench::State& state, bool cached) {
+  lvgl::TextMetricsCache::set_enabled(cached);
+  auto& cache = lvgl::TextMetricsCache::global();
+  cache.reset_stats();
+  auto screen = std::make_unique<lvgl::Object>(lv_scr_act());
+  lvgl::Table table(screen.get());
+  table.set_row_count(kRows).set_column_count(kCols);
+
+  char buf[16];
+  for (int frame = 0; frame < state.iterations; ++frame) {
+    for (uint32_t row = 0; row < kRows; ++row) {
+      for (uint32_t col = 0; col < kCols; ++col) {
+        uint32_t cell = row * kCols + col;
+        bool changes = cell % 20 == static_cast<uint32_t>(frame % 20);
+        uint32_t value = changes ? cell + static_cast<uint32_t>(frame) : cell;
+        std::snprintf(buf, sizeof(buf), "%u", static_cast<unsigned>(value));
+        table.cell(row, col).set_value(buf);
+      }
+    }
+    for (uint32_t col = 0; col < kCols; ++col) table.fit_column_width(col);
+    lv_refr_now(nullptr);
+  }
+  if (cached) {
+    const auto& stats = cache.get_stats();
+    std::fprintf(stderr,
+                 "  TextMetricsCache: %llu hits, %llu misses, %llu evictions, "
+                 "hit rate %.3f\n",
+                 static_cast<unsigned long long>(stats.hits),
+                 static_cast<unsigned long long>(stats.misses),
+                 static_cast<unsigned long long>(stats.evictions),
+                 static_cast<double>(stats.hit_rate()));
+  }
+  lvgl::TextMetricsCache::set_enabled(false);
+}
+
+}  // namespace
+
+LVGL_BENCHMARK(Text_Table_50x20_FitUncached) {
+  run_table_frames(state, false);
+}
+
+// Same frames; cell widths come from the cache. 1000 cells would thrash the
+// default 256 entries, so the capacity is raised for the run.
+LVGL_BENCHMARK(Text_Table_50x20_FitCached) {
+  lvgl::TextMetricsCache::global().set_capacity(kRows * kCols * 2);
+  run_table_frames(state, true);
+  lvgl::TextMetricsCache::global().set_capacity(
+      lvgl::TextMetricsCache::kDefaultCapacity);
+}
+
+namespace {
+
+constexpr int kLabels = 500;
+
+enum class LabelUpdate { LvglFmt, WrapperFmt, Number };
+
+// One iteration is one 30 Hz frame: every label is written, a quarter of
+// them with a new value, then the screen is rendered.
+void run_label_frames(lvgl::bench::State& state, LabelUpdate mode) {
+  auto screen = std::make_unique<lvgl::Object>(lv_scr_act());
+  std::vector<lv_obj_t*> labels;
+  for (int i = 0; i < kLabels; ++i) {
+    lvgl::Label label(screen.get(), lvgl::Object::Ownership::Unmanaged);
+    label.set_pos((i % 20) * 40, (i / 20) * 20);
+    if (mode == LabelUpdate::Number) label.reserve_text(12);
+    labels.push_back(label.raw());
+  }
+
+  for (int frame = 0; frame < state.iterations; ++frame) {
+    for (int i = 0; i < kLabels; ++i) {
+      int32_t value = i * 10 + (frame + i % 4) / 4;
+      lvgl::Label label(labels[i], lvgl::Object::Ownership::Unmanaged);
+      switch (mode) {
+        case LabelUpdate::LvglFmt:
+          lv_label_set_text_fmt(labels[i], "%d.%d",
+                                static_cast<int>(value / 10),
+                                static_cast<int>(value % 10));
+          break;
+        case LabelUpdate::WrapperFmt:
+          label.set_text_fmt("%d.%d", static_cast<int>(value / 10),
+                             static_cast<int>(value % 10));
+          break;
+        case LabelUpdate::Number:
+          label.set_number(value, 1);
+          break;
+      }
+    }
+    lv_refr_now(nullptr);
+  }
+  for (lv_obj_t* obj : labels) lv_obj_delete(obj);
+}
+
+}  // namespace
+
+// Baseline: a fresh LVGL allocation and relayout for every label.
+LVGL_BENCHMARK(Text_Label_500x30Hz_LvglFmt) {
+  run_label_frames(state, LabelUpdate::LvglFmt);
+}
+
+// Stack formatting; unchanged labels are skipped.
+LVGL_BENCHMARK(Text_Label_500x30Hz_Fmt) {
+  run_label_frames(state, LabelUpdate::WrapperFmt);
+}
+
+// to_chars into a reserved buffer; no allocation at all.
+LVGL_BENCHMARK(Text_Label_500x30Hz_Number) {
+  run_label_frames(state, LabelUpdate::Number);
+}
+
+namespace {
+
+// About 1 MB: 16384 lines of 64 bytes.
+std::string make_megabyte_text() {
+  std::string text;
+  text.reserve(16384 * 64);
+  char line[65];
+  for (int i = 0; i < 16384; ++i) {
+    std::snprintf(line, sizeof(line), "%05d %057d\n", i, i);
+    text += line;
+  }
+  return text;
+}
+
+enum class DocEdit { Append, MidInsert, Scroll };
+
+// One iteration is one edit or scroll step followed by a render.
+void run_document_view(lvgl::bench::State& state, DocEdit edit) {
+  auto screen = std::make_unique<lvgl::Object>(lv_scr_act());
+  lvgl::TextDocument doc(make_megabyte_text());
+  lvgl::TextView view(screen.get());
+  view.set_size(400, 300);
+  view.set_document(&doc);
+  lv_refr_now(nullptr);
+
+  for (int i = 0; i < state.iterations; ++i) {
+    switch (edit) {
+      case DocEdit::Append:
+        doc.append("appended line\n");
+        view.scroll_to_line(doc.line_count() - 1);
+        break;
+      case DocEdit::MidInsert:
+        doc.insert(doc.size() / 2, "typed ");
+        break;
+      case DocEdit::Scroll:
+        view.scroll_to_line(static_cast<uint32_t>(i) * 150 % 16384);
+        break;
+    }
+    lv_refr_now(nullptr);
+  }
+}
+
+// Baseline: the same work on a Textarea, whose label lays out all of it.
+void run_textarea(lvgl::bench::State& state, DocEdit edit) {
+  auto screen = std::make_unique<lvgl::Object>(lv_scr_act());
+  std::string text = make_megabyte_text();
+  lvgl::Textarea area(screen.get());
+  area.set_size(400, 300);
+  area.set_text(text.c_str());
+  lv_refr_now(nullptr);
+
+  for (int i = 0; i < state.iterations; ++i) {
+    switch (edit) {
+      case DocEdit::Append:
+        area.set_cursor_pos(LV_TEXTAREA_CURSOR_LAST);
+        area.add_text("appended line\n");
+        break;
+      case DocEdit::MidInsert:
+        area.set_cursor_pos(static_cast<int32_t>(text.size() / 2));
+        area.add_text("typed ");
+        break;
+      case DocEdit::Scroll:
+        lv_obj_scroll_to_y(area.raw(), (i * 150 % 16384) * 16, LV_ANIM_OFF);
+        break;
+    }
+    lv_refr_now(nullptr);
+  }
+}
+
+}  // namespace
+
+LVGL_BENCHMARK(Text_Doc1MB_Append_TextView) {
+  run_document_view(state, DocEdit::Append);
+}
+
+LVGL_BENCHMARK(Text_Doc1MB_Append_Textarea) {
+  run_textarea(state, DocEdit::Append);
+}
+
+LVGL_BENCHMARK(Text_Doc1MB_MidInsert_TextView) {
+  run_document_view(state, DocEdit::MidInsert);
+}
+
+LVGL_BENCHMARK(Text_Doc1MB_MidInsert_Textarea) {
+  run_textarea(state, DocEdit::MidInsert);
+}
+
+LVGL_BENCHMARK(Text_Doc1MB_Scroll_TextView) {
+  run_document_view(state, DocEdit::Scroll);
+}
+
+LVGL_BENCHMARK(Text_Doc1MB_Scroll_Textarea) {
+  run_textarea(state, DocEdit::Scroll);
+}
+
+namespace {
+
+// 10,000 lines per second arrive as 167 lines per 60 Hz frame.
+constexpr int kLogLinesPerFrame = 167;
+
+// One iteration is one frame: a frame's worth of log lines, then a render.
+LVGL_BENCHMARK(Text_Log_10kLps_LogView) {
+  auto screen = std::make_unique<lvgl::Object>(lv_scr_act());
+  lvgl::LogView log(screen.get());
+  log.set_size(400, 300);
+  log.set_capacity(1000);
+  lvgl::LogView::Producer producer = log.get_producer();
+
+  char line[64];
+  int seq = 0;
+  for (int frame = 0; frame < state.iterations; ++frame) {
+    for (int i = 0; i < kLogLinesPerFrame; ++i, ++seq) {
+      std::snprintf(line, sizeof(line), "[%08d] sensor: value=%d", seq,
+                    seq % 977);
+      producer.log(line, seq % 50 == 0 ? lvgl::LogView::Level::Warning
+                                       : lvgl::LogView::Level::Info);
+    }
+    log.drain();
+    lv_refr_now(nullptr);
+  }
+}
+
+// Baseline: the same lines appended to a Textarea, which keeps all of them.
+LVGL_BENCHMARK(Text_Log_10kLps_Textarea) {
+  auto screen = std::make_unique<lvgl::Object>(lv_scr_act());
+  lvgl::Textarea area(screen.get());
+  area.set_size(400, 300);
+
+  char line[64];
+  int seq = 0;
+  for (int frame = 0; frame < state.iterations; ++frame) {
+    for (int i = 0; i < kLogLinesPerFrame; ++i, ++seq) {
+      std::snprintf(line, sizeof(line), "[%08d] sensor: value=%d\n", seq,
+                    seq % 977);
+      area.add_text(line);
+    }
+    lv_refr_now(nullptr);
+  }
+}
+
+}  // namespace
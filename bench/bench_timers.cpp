@@ -0,0 +1,52 @@
+/*
+ * Timer Benchmarks
+ * 10,000 mostly idle periodic timers (1-5 s periods) serviced every 5 ms,
+ * once as plain Timers and once on a TimerWheel. Each iteration is one
+ * lv_timer_handler() pass, so this measures the idle cost of many timers.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "../misc/timer.h"
+#include "../misc/timer_wheel.h"
+#include "bench.h"
+#include "../lvgl_cpp.h"
+
+namespace {
+
+constexpr int kTimers = 10000;
+
+uint32_t period_of(int i) { return 1000 + (i * 37) % 4001; }
+
+void run_handler(lvgl::bench::State& state) {
+  for (int i = 0; i < state.iterations; ++i) {
+    lv_tick_inc(5);
+    lv_timer_handler();
+  }
+}
+
+}  // namespace
+
+LVGL_BENCHMARK(Timer_10kIdle_LvTimer) {
+  uint32_t fired = 0;
+  std::vector<lvgl::Timer> timers;
+  timers.reserve(kTimers);
+  for (int i = 0; i < kTimers; ++i) {
+    timers.emplace_back(period_of(i), [&fired](lvgl::Timer*) { fired++; });
+  }
+  run_handler(state);
+}
+
+LVGL_BENCHMARK(Timer_10kIdle_Wheel) {
+  uint32_t fired = 0;
+  lvgl::TimerWheel wheel;
+  std::vector<lvgl::Timer> timers;
+  timers.reserve(kTimers);
+  for (int i = 0; i < kTimers; ++i) {
+    timers.emplace_back(wheel, period_of(i),
+                        [&fired](lvgl::Timer*) { fired++; });
+  }
+  run_handler(state);
+  timers.clear();
+}
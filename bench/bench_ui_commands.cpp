@@ -0,0 +1,96 @@
+/*
+ * Cross-thread Widget Update Benchmarks
+ * 16 producer threads each update their own label 64 times per iteration
+ * while the LVGL thread keeps rendering. One variant takes a global
+ * recursive API lock around every lv_label_set_text() call, as a port's
+ * lv_lock() would; the other records into a UiCommandBuffer that the LVGL
+ * thread replays once per frame.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../misc/ui_command_buffer.h"
+#include "bench.h"
+#include "../lvgl_cpp.h"
+
+namespace {
+
+constexpr int kProducers = 16;
+constexpr int kUpdatesPerIteration = 64;
+
+struct Labels {
+  // Deleting the container deletes the labels.
+  std::unique_ptr<lvgl::Object> screen =
+      std::make_unique<lvgl::Object>(lv_scr_act());
+  std::vector<std::unique_ptr<lvgl::Label>> labels;
+
+  Labels() {
+    for (int i = 0; i < kProducers; ++i) {
+      labels.push_back(std::make_unique<lvgl::Label>(
+          screen.get(), lvgl::Object::Ownership::Unmanaged));
+      labels.back()->set_pos(10, 10 + i * 20);
+    }
+  }
+};
+
+// Runs `produce(thread_index, update)` on every producer thread while the
+// calling thread renders frames with `render()`.
+template <typename Produce, typename Render>
+void run_producers(lvgl::bench::State& state, Produce produce,
+                   Render render) {
+  std::atomic<int> running{kProducers};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kProducers; ++t) {
+    threads.emplace_back([&, t]() {
+      int updates = state.iterations * kUpdatesPerIteration;
+      for (int i = 0; i < updates; ++i) produce(t, i);
+      --running;
+    });
+  }
+  while (running.load() > 0) render();
+  for (std::thread& thread : threads) thread.join();
+  render();
+}
+
+}  // namespace
+
+LVGL_BENCHMARK(WidgetUpdate_16Threads_LockPerCall) {
+  Labels labels;
+  std::recursive_mutex api_lock;
+  run_producers(
+      state,
+      [&](int t, int i) {
+        char text[16];
+        snprintf(text, sizeof(text), "%d", i);
+        std::lock_guard<std::recursive_mutex> lock(api_lock);
+        lv_label_set_text(labels.labels[t]->raw(), text);
+      },
+      [&]() {
+        std::lock_guard<std::recursive_mutex> lock(api_lock);
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+        lv_timer_handler();
+      });
+}
+
+LVGL_BENCHMARK(WidgetUpdate_16Threads_CommandBuffer) {
+  Labels labels;
+  lvgl::UiCommandBuffer commands;
+  run_producers(
+      state,
+      [&](int t, int i) {
+        char text[16];
+        snprintf(text, sizeof(text), "%d", i);
+        commands.post(*labels.labels[t]).set_text(text);
+      },
+      [&]() {
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+        lv_timer_handler();
+      });
+  commands.flush();
+}
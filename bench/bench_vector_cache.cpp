@@ -0,0 +1,81 @@
+/*
+ * Vector Cache Benchmarks
+ * Each iteration renders one frame of a 400x320 canvas: 500 static 16px
+ * icons on a grid plus one rotating needle. Uncached, every icon is
+ * flattened and rasterized again; cached, the icons share one image and
+ * only the needle is rasterized per frame.
+ */
+
+#include <cstdint>
+
+#include "../draw/draw_buf.h"
+#include "../misc/vector_cache.h"
+#include "bench.h"
+#include "../lvgl_cpp.h"
+
+#if LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
+
+namespace {
+
+constexpr int kCols = 25;
+constexpr int kRows = 20;
+constexpr int kWidth = kCols * 16;
+constexpr int kHeight = kRows * 16;
+
+struct Board {
+  lvgl::draw::DrawBuf buf{kWidth, kHeight};
+  lvgl::Canvas canvas;  // Offscreen.
+  lvgl::VectorPath icon;
+  lvgl::VectorPath needle;
+
+  Board() {
+    canvas.set_draw_buf(buf.raw());
+    // A rounded badge with a check mark.
+    icon.append_rect(1, 1, 12, 12, 3, 3);
+    icon.move_to(4, 7);
+    icon.line_to(6, 10);
+    icon.cubic_to(7, 8, 9, 5, 11, 4);
+    needle.append_rect(-2, -40, 4, 40, 2, 2);
+  }
+
+  void frame(lvgl::VectorCache* cache, int i) {
+    buf.clear();
+    lv_layer_t layer;
+    canvas.init_layer(&layer);
+    {
+      lvgl::VectorDraw draw = cache ? lvgl::VectorDraw(&layer, *cache)
+                                    : lvgl::VectorDraw(&layer);
+      draw.set_fill_color({0xd0, 0x80, 0x20, 0xff});
+      draw.set_stroke_color({0xff, 0xff, 0xff, 0xff});
+      draw.set_stroke_width(1.5f);
+      for (int n = 0; n < kCols * kRows; ++n) {
+        draw.identity();
+        draw.translate((n % kCols) * 16, (n / kCols) * 16);
+        draw.add_path(icon);
+        draw.draw();
+      }
+      draw.identity();
+      draw.translate(kWidth / 2, kHeight / 2);
+      draw.rotate(static_cast<float>(i * 7 % 360));
+      draw.add_path(needle);
+      draw.draw();
+    }
+    canvas.finish_layer(&layer);
+    if (cache) cache->next_frame();
+  }
+};
+
+}  // namespace
+
+LVGL_BENCHMARK(VectorIcons_500_Uncached) {
+  Board board;
+  for (int i = 0; i < state.iterations; ++i) board.frame(nullptr, i);
+}
+
+LVGL_BENCHMARK(VectorIcons_500_Cached) {
+  Board board;
+  lvgl::VectorCache cache(lvgl::VectorCache::kDefaultByteBudget, nullptr);
+  for (int i = 0; i < state.iterations; ++i) board.frame(&cache, i);
+}
+
+#endif  // LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
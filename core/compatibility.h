@@ -113,4 +113,19 @@
 #define LVGL_CPP_HAS_INDEV_GESTURE_ARRAY 0
 #endif
 
+// Background worker threads (async file reads). Define as 0 on targets
+// without std::thread; async reads then run in timer slices only.
+#ifndef LVGL_CPP_HAS_THREADS
+#define LVGL_CPP_HAS_THREADS 1
+#endif
+
+// POSIX pread()/dup() for reading host-backed drivers off the LVGL thread.
+#ifndef LVGL_CPP_HAS_PREAD
+#if defined(__unix__) || defined(__APPLE__)
+#define LVGL_CPP_HAS_PREAD 1
+#else
+#define LVGL_CPP_HAS_PREAD 0
+#endif
+#endif
+
 #endif  // LVGL_CPP_CORE_COMPATIBILITY_H_
@@ -0,0 +1,376 @@
+#include "focus_graph.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace lvgl {
+
+namespace {
+
+constexpr int kLeft = 0;
+constexpr int kRight = 1;
+constexpr int kTop = 2;
+constexpr int kBottom = 3;
+
+constexpr int64_t kMaxDistance = int64_t{1} << 20;
+// Added to candidates outside the current row/column; larger than any
+// in-row score.
+constexpr int64_t kOutOfBeam = int64_t{1} << 50;
+
+int dir_index(Dir dir) {
+  switch (dir) {
+    case Dir::Left:
+      return kLeft;
+    case Dir::Right:
+      return kRight;
+    case Dir::Top:
+      return kTop;
+    case Dir::Bottom:
+      return kBottom;
+    default:
+      return -1;
+  }
+}
+
+bool overlaps(int32_t a1, int32_t a2, int32_t b1, int32_t b2) {
+  return a1 <= b2 && b1 <= a2;
+}
+
+bool same_area(const lv_area_t& a, const lv_area_t& b) {
+  return a.x1 == b.x1 && a.y1 == b.y1 && a.x2 == b.x2 && a.y2 == b.y2;
+}
+
+// Cost of moving from `from` to `to` in `dir`, or -1 if `to` does not lie
+// that way. Edge gaps weigh more than misalignment, as in most spatial
+// navigation schemes.
+int64_t score(const lv_area_t& from, const lv_area_t& to, int dir) {
+  // Doubled centers stay integral.
+  int64_t fx = int64_t{from.x1} + from.x2;
+  int64_t fy = int64_t{from.y1} + from.y2;
+  int64_t tx = int64_t{to.x1} + to.x2;
+  int64_t ty = int64_t{to.y1} + to.y2;
+  int64_t major;
+  int64_t minor;
+  bool beam;
+  switch (dir) {
+    case kLeft:
+      if (tx >= fx) return -1;
+      major = int64_t{from.x1} - to.x2;
+      minor = std::llabs(ty - fy) / 2;
+      beam = overlaps(from.y1, from.y2, to.y1, to.y2);
+      break;
+    case kRight:
+      if (tx <= fx) return -1;
+      major = int64_t{to.x1} - from.x2;
+      minor = std::llabs(ty - fy) / 2;
+      beam = overlaps(from.y1, from.y2, to.y1, to.y2);
+      break;
+    case kTop:
+      if (ty >= fy) return -1;
+      major = int64_t{from.y1} - to.y2;
+      minor = std::llabs(tx - fx) / 2;
+      beam = overlaps(from.x1, from.x2, to.x1, to.x2);
+      break;
+    default:
+      if (ty <= fy) return -1;
+      major = int64_t{to.y1} - from.y2;
+      minor = std::llabs(tx - fx) / 2;
+      beam = overlaps(from.x1, from.x2, to.x1, to.x2);
+      break;
+  }
+  major = std::clamp<int64_t>(major, 0, kMaxDistance);
+  minor = std::min(minor, kMaxDistance);
+  int64_t cost = 13 * major * major + minor * minor;
+  return beam ? cost : cost + kOutOfBeam;
+}
+
+bool usable(lv_obj_t* obj) {
+  return !lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) &&
+         !lv_obj_has_state(obj, LV_STATE_DISABLED);
+}
+
+}  // namespace
+
+FocusGraph::FocusGraph(lv_group_t* group) : group_(group) {}
+
+FocusGraph::~FocusGraph() { clear(); }
+
+size_t FocusGraph::get_edge_count() const {
+  size_t count = 0;
+  for (const Node& node : nodes_) {
+    for (int d = 0; d < kDirs; ++d) count += (node.known >> d) & 1;
+  }
+  return count;
+}
+
+FocusGraph::Node* FocusGraph::find(lv_obj_t* obj) {
+  auto it = index_.find(obj);
+  return it == index_.end() ? nullptr : &nodes_[it->second];
+}
+
+FocusGraph::Node& FocusGraph::track(lv_obj_t* obj) {
+  Node node{};
+  node.obj = obj;
+  node.parent = lv_obj_get_parent(obj);
+  lv_obj_get_coords(obj, &node.area);
+  index_.emplace(obj, nodes_.size());
+  nodes_.push_back(node);
+  watch(node.parent);
+  lv_obj_add_event_cb(obj, member_event_cb, LV_EVENT_DELETE, this);
+  return nodes_.back();
+}
+
+void FocusGraph::watch(lv_obj_t* parent) {
+  // Moves and resizes are reported to the parent, not the object.
+  if (parent && parents_[parent]++ == 0) {
+    lv_obj_add_event_cb(parent, parent_event_cb, LV_EVENT_CHILD_CHANGED,
+                        this);
+  }
+}
+
+void FocusGraph::unwatch(lv_obj_t* parent) {
+  auto it = parents_.find(parent);
+  if (it == parents_.end() || --it->second > 0) return;
+  parents_.erase(it);
+  lv_obj_remove_event_cb_with_user_data(parent, parent_event_cb, this);
+}
+
+void FocusGraph::mark_moved(Node& node) {
+  if (node.moved) return;
+  node.moved = true;
+  moved_.push_back(node.obj);
+}
+
+void FocusGraph::sync() {
+  clear();
+  if (!group_) return;
+  uint32_t count = lv_group_get_obj_count(group_);
+  nodes_.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    lv_obj_t* obj = lv_group_get_obj_by_index(group_, i);
+    if (obj && !find(obj)) track(obj);
+  }
+  synced_ = true;
+}
+
+void FocusGraph::add(lv_obj_t* obj) {
+  if (!obj || !synced_ || find(obj)) return;
+  mark_moved(track(obj));  // Linked on the next lookup.
+}
+
+void FocusGraph::remove(lv_obj_t* obj) { drop(obj, true); }
+
+void FocusGraph::drop(lv_obj_t* obj, bool detach) {
+  auto it = index_.find(obj);
+  if (it == index_.end()) return;
+  size_t i = it->second;
+  index_.erase(it);
+  unlink(obj);
+  unwatch(nodes_[i].parent);
+  if (nodes_[i].moved) {
+    moved_.erase(std::find(moved_.begin(), moved_.end(), obj));
+  }
+  if (detach) {
+    lv_obj_remove_event_cb_with_user_data(obj, member_event_cb, this);
+  }
+  if (i + 1 != nodes_.size()) {
+    nodes_[i] = nodes_.back();
+    index_[nodes_[i].obj] = i;
+  }
+  nodes_.pop_back();
+}
+
+void FocusGraph::clear() {
+  for (const Node& node : nodes_) {
+    lv_obj_remove_event_cb_with_user_data(node.obj, member_event_cb, this);
+  }
+  for (const auto& [parent, count] : parents_) {
+    lv_obj_remove_event_cb_with_user_data(parent, parent_event_cb, this);
+  }
+  nodes_.clear();
+  index_.clear();
+  parents_.clear();
+  moved_.clear();
+  synced_ = false;
+}
+
+void FocusGraph::invalidate() {
+  for (Node& node : nodes_) {
+    lv_obj_get_coords(node.obj, &node.area);
+    node.known = 0;
+    node.moved = false;
+  }
+  moved_.clear();
+}
+
+void FocusGraph::refresh(const Node& ref, std::vector<lv_obj_t*> moved) {
+  // Scrolling moves children without events. Scores only depend on
+  // relative positions, so members that shifted along with `ref` keep
+  // their edges; only the others, and those already in `moved` (flagged
+  // `Node::moved`), are re-linked.
+  lv_area_t now;
+  lv_obj_get_coords(ref.obj, &now);
+  int32_t dx = now.x1 - ref.area.x1;
+  int32_t dy = now.y1 - ref.area.y1;
+  for (Node& node : nodes_) {
+    lv_obj_get_coords(node.obj, &now);
+    if (!node.moved &&
+        (now.x1 - node.area.x1 != dx || now.x2 - node.area.x2 != dx ||
+         now.y1 - node.area.y1 != dy || now.y2 - node.area.y2 != dy)) {
+      moved.push_back(node.obj);
+    }
+    node.area = now;
+    node.moved = false;
+  }
+  relink(moved);
+}
+
+bool FocusGraph::is_current(const Node& node) const {
+  lv_area_t now;
+  lv_obj_get_coords(node.obj, &now);
+  return same_area(now, node.area);
+}
+
+void FocusGraph::apply_moves(const Node& ref) {
+  if (moved_.empty()) return;
+  std::vector<lv_obj_t*> moved;
+  moved.swap(moved_);
+  // After an unreported shift, reading only the moved members would mix
+  // old and new coordinates; re-read everything relative to a member
+  // that was not reported instead.
+  const Node* probe = &ref;
+  for (size_t i = 0; probe->moved; ++i) {
+    if (i == nodes_.size()) {
+      probe = nullptr;
+      break;
+    }
+    probe = &nodes_[i];
+  }
+  if (probe && !is_current(*probe)) {
+    refresh(*probe, std::move(moved));
+    return;
+  }
+  for (lv_obj_t* obj : moved) {
+    Node& node = *find(obj);  // Dropped members leave `moved_`.
+    lv_obj_get_coords(obj, &node.area);
+    node.moved = false;
+  }
+  relink(moved);
+}
+
+void FocusGraph::relink(const std::vector<lv_obj_t*>& moved) {
+  // A relayout moves many members at once; dropping every edge is then
+  // cheaper than an incremental update per member.
+  if (moved.size() > 8 + nodes_.size() / 8) {
+    for (Node& node : nodes_) node.known = 0;
+    return;
+  }
+  for (lv_obj_t* obj : moved) {
+    if (!find(obj)) continue;  // Removed since.
+    unlink(obj);
+    offer(obj);
+  }
+}
+
+void FocusGraph::unlink(lv_obj_t* obj) {
+  for (Node& node : nodes_) {
+    if (node.obj == obj) {
+      node.known = 0;
+      continue;
+    }
+    for (int d = 0; d < kDirs; ++d) {
+      if (node.next[d] == obj) node.known &= ~(1u << d);
+    }
+  }
+}
+
+void FocusGraph::offer(lv_obj_t* obj) {
+  const Node* candidate = find(obj);
+  if (!candidate) return;
+  lv_area_t area = candidate->area;
+  for (Node& node : nodes_) {
+    if (!node.known || node.obj == obj) continue;
+    for (int d = 0; d < kDirs; ++d) {
+      if (!(node.known & (1u << d))) continue;
+      int64_t s = score(node.area, area, d);
+      if (s < 0) continue;
+      if (!node.next[d] || s < node.score[d]) {
+        node.next[d] = obj;
+        node.score[d] = s;
+      }
+    }
+  }
+}
+
+lv_obj_t* FocusGraph::search(const Node& node, int dir, bool usable_only,
+                             int64_t* score_out) const {
+  lv_obj_t* best = nullptr;
+  int64_t best_score = 0;
+  for (const Node& other : nodes_) {
+    if (other.obj == node.obj) continue;
+    int64_t s = score(node.area, other.area, dir);
+    if (s < 0 || (best && s >= best_score)) continue;
+    if (usable_only && !usable(other.obj)) continue;
+    best = other.obj;
+    best_score = s;
+  }
+  if (score_out) *score_out = best_score;
+  return best;
+}
+
+lv_obj_t* FocusGraph::get_neighbor(lv_obj_t* obj, Dir dir) {
+  int d = dir_index(dir);
+  if (d < 0 || !obj || !group_) return nullptr;
+  // Objects added or removed through the C API are not reported.
+  if (!synced_ || lv_group_get_obj_count(group_) != nodes_.size()) sync();
+  Node* node = find(obj);
+  if (!node) return nullptr;
+  apply_moves(*node);
+  if (!is_current(*node)) refresh(*node);
+
+  uint8_t bit = static_cast<uint8_t>(1u << d);
+  auto edge = [&]() {
+    if (!(node->known & bit)) {
+      node->next[d] = search(*node, d, false, &node->score[d]);
+      node->known |= bit;
+    }
+    return node->next[d];
+  };
+  lv_obj_t* next = edge();
+  if (!next) return nullptr;
+  Node* target = find(next);
+  if (target && !is_current(*target)) {
+    // Its container moved without an event.
+    refresh(*node);
+    next = edge();
+    if (!next) return nullptr;
+  }
+  // Visibility and state change without events, so edges ignore them and
+  // a hidden or disabled neighbor falls back to a filtered search.
+  if (!usable(next)) next = search(*node, d, true, nullptr);
+  return next;
+}
+
+void FocusGraph::member_event_cb(lv_event_t* e) {
+  auto* self = static_cast<FocusGraph*>(lv_event_get_user_data(e));
+  auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+  self->drop(obj, false);  // Its callbacks go with it.
+}
+
+void FocusGraph::parent_event_cb(lv_event_t* e) {
+  auto* self = static_cast<FocusGraph*>(lv_event_get_user_data(e));
+  auto* child = static_cast<lv_obj_t*>(lv_event_get_param(e));
+  Node* node = child ? self->find(child) : nullptr;
+  if (!node) return;
+  lv_obj_t* parent = lv_obj_get_parent(child);
+  if (parent != node->parent) {
+    // Moved to another parent.
+    self->watch(parent);
+    self->unwatch(node->parent);
+    node->parent = parent;
+  }
+  self->mark_moved(*node);
+}
+
+}  // namespace lvgl
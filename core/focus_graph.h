@@ -0,0 +1,123 @@
+#ifndef LVGL_CPP_CORE_FOCUS_GRAPH_H_
+#define LVGL_CPP_CORE_FOCUS_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../misc/enums.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file focus_graph.h
+ * @brief User Guide:
+ * `FocusGraph` caches, for every object of an `lv_group_t`, its nearest
+ * neighbor to the left, right, top and bottom. It backs
+ * `Group::focus_direction()`, so keypad and encoder users can move across
+ * a grid in one press per cell instead of walking insertion order.
+ *
+ * Key Features:
+ * - **Lazy edges**: An edge is searched the first time it is needed and
+ *   then cached, so a press costs a hash lookup. Coordinates are cached
+ *   too; a search never calls `lv_obj_get_coords()`.
+ * - **Incremental invalidation**: A member's move or resize (reported by
+ *   `LV_EVENT_CHILD_CHANGED` on its parent) refreshes its coordinates,
+ *   drops the edges that pointed to it and lets it take over any cached
+ *   edge it now beats. Additions and removals are handled the same way.
+ * - **Shift detection**: If the focused object or its cached neighbor
+ *   moved without an event (a scrolled parent), all coordinates are
+ *   re-read; members that shifted along with the focused one keep their
+ *   edges.
+ *
+ * Example:
+ * @code
+ * lvgl::Group group;
+ * for (auto& button : buttons) group.add_obj(button);
+ * group.focus_direction(lvgl::Dir::Bottom);  // One row down.
+ * @endcode
+ *
+ * Candidates lie beyond the current object's center in the direction of
+ * travel. Those overlapping its row (or column) win over the rest; within
+ * each set the squared edge gap weighs 13 times the squared center
+ * misalignment. Call `invalidate()` after changes LVGL does not report,
+ * such as transform styles.
+ */
+namespace lvgl {
+
+class FocusGraph {
+ public:
+  explicit FocusGraph(lv_group_t* group);
+  ~FocusGraph();
+
+  FocusGraph(const FocusGraph&) = delete;
+  FocusGraph& operator=(const FocusGraph&) = delete;
+
+  /**
+   * @brief The neighbor of `obj` in `dir` (Left, Right, Top or Bottom).
+   * @return nullptr if there is none, or `obj` is not in the group.
+   * Hidden and disabled members are skipped.
+   */
+  lv_obj_t* get_neighbor(lv_obj_t* obj, Dir dir);
+
+  /** @brief Track an object added to the group. */
+  void add(lv_obj_t* obj);
+
+  /** @brief Forget an object removed from the group. */
+  void remove(lv_obj_t* obj);
+
+  /** @brief Drop every node; they are re-read on the next lookup. */
+  void clear();
+
+  /** @brief Re-read all coordinates and drop every cached edge. */
+  void invalidate();
+
+  /** @brief Number of tracked objects. */
+  size_t get_node_count() const { return nodes_.size(); }
+
+  /** @brief Number of cached edges. */
+  size_t get_edge_count() const;
+
+ private:
+  static constexpr int kDirs = 4;
+
+  struct Node {
+    lv_obj_t* obj;
+    lv_obj_t* parent;
+    lv_area_t area;
+    lv_obj_t* next[kDirs];  // nullptr: no neighbor that way.
+    int64_t score[kDirs];
+    uint8_t known = 0;  // Bit per direction: `next` is cached.
+    bool moved = false;  // Listed in `moved_`.
+  };
+
+  void sync();
+  Node& track(lv_obj_t* obj);
+  void drop(lv_obj_t* obj, bool detach);
+  void watch(lv_obj_t* parent);
+  void unwatch(lv_obj_t* parent);
+  void mark_moved(Node& node);
+  void refresh(const Node& ref, std::vector<lv_obj_t*> moved = {});
+  void apply_moves(const Node& ref);
+  void relink(const std::vector<lv_obj_t*>& moved);
+  void unlink(lv_obj_t* obj);
+  void offer(lv_obj_t* obj);
+  lv_obj_t* search(const Node& node, int dir, bool usable_only,
+                   int64_t* score) const;
+  bool is_current(const Node& node) const;
+  Node* find(lv_obj_t* obj);
+
+  static void member_event_cb(lv_event_t* e);
+  static void parent_event_cb(lv_event_t* e);
+
+  lv_group_t* group_;
+  std::vector<Node> nodes_;
+  std::unordered_map<lv_obj_t*, size_t> index_;
+  std::unordered_map<lv_obj_t*, uint32_t> parents_;  // Member count.
+  std::vector<lv_obj_t*> moved_;  // Applied on the next lookup; no repeats.
+  bool synced_ = false;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_CORE_FOCUS_GRAPH_H_
@@ -2,6 +2,8 @@
 
 #include <utility>
 
+#include "focus_graph.h"
+
 namespace lvgl {
 
 Group::Group(Ownership ownership)
@@ -11,19 +13,23 @@ Group::Group(lv_group_t* group, Ownership ownership)
     : group_(group), ownership_(ownership) {}
 
 Group::~Group() {
+  focus_graph_.reset();
   if (ownership_ == Ownership::Managed && group_) {
     lv_group_delete(group_);
   }
 }
 
 Group::Group(Group&& other) noexcept
-    : group_(other.group_), ownership_(other.ownership_) {
+    : group_(other.group_),
+      ownership_(other.ownership_),
+      focus_graph_(std::move(other.focus_graph_)) {
   other.group_ = nullptr;
   other.ownership_ = Ownership::Unmanaged;
 }
 
 Group& Group::operator=(Group&& other) noexcept {
   if (this != &other) {
+    focus_graph_ = std::move(other.focus_graph_);
     if (ownership_ == Ownership::Managed && group_) {
       lv_group_delete(group_);
     }
@@ -35,24 +41,26 @@ Group& Group::operator=(Group&& other) noexcept {
   return *this;
 }
 
-void Group::add_obj(Object& obj) {
-  if (group_) lv_group_add_obj(group_, obj.raw());
-}
+void Group::add_obj(Object& obj) { add_obj(obj.raw()); }
 
 void Group::add_obj(lv_obj_t* obj) {
-  if (group_) lv_group_add_obj(group_, obj);
+  if (!group_) return;
+  lv_group_add_obj(group_, obj);
+  if (focus_graph_) focus_graph_->add(obj);
 }
 
-void Group::remove_obj(Object& obj) {
-  if (group_) lv_group_remove_obj(obj.raw());
-}
+void Group::remove_obj(Object& obj) { remove_obj(obj.raw()); }
 
 void Group::remove_obj(lv_obj_t* obj) {
-  if (group_) lv_group_remove_obj(obj);
+  if (!group_) return;
+  if (focus_graph_) focus_graph_->remove(obj);
+  lv_group_remove_obj(obj);
 }
 
 void Group::remove_all_objs() {
-  if (group_) lv_group_remove_all_objs(group_);
+  if (!group_) return;
+  if (focus_graph_) focus_graph_->clear();
+  lv_group_remove_all_objs(group_);
 }
 
 void Group::focus_obj(Object& obj) {
@@ -71,6 +79,50 @@ void Group::focus_prev() {
   if (group_) lv_group_focus_prev(group_);
 }
 
+bool Group::focus_direction(Dir dir) {
+  if (!group_) return false;
+  lv_obj_t* focused = lv_group_get_focused(group_);
+  if (!focused) {
+    lv_group_focus_next(group_);
+    return lv_group_get_focused(group_) != nullptr;
+  }
+  Dir back;
+  switch (dir) {
+    case Dir::Left:
+      back = Dir::Right;
+      break;
+    case Dir::Right:
+      back = Dir::Left;
+      break;
+    case Dir::Top:
+      back = Dir::Bottom;
+      break;
+    case Dir::Bottom:
+      back = Dir::Top;
+      break;
+    default:
+      return false;
+  }
+  FocusGraph& graph = get_focus_graph();
+  lv_obj_t* next = graph.get_neighbor(focused, dir);
+  if (!next && lv_group_get_wrap(group_)) {
+    // Walk to the far end of the row or column.
+    size_t steps = graph.get_node_count();
+    for (lv_obj_t* o = graph.get_neighbor(focused, back); o && steps > 0;
+         o = graph.get_neighbor(o, back), --steps) {
+      next = o;
+    }
+  }
+  if (!next) return false;
+  lv_group_focus_obj(next);
+  return lv_group_get_focused(group_) != focused;
+}
+
+FocusGraph& Group::get_focus_graph() {
+  if (!focus_graph_) focus_graph_ = std::make_unique<FocusGraph>(group_);
+  return *focus_graph_;
+}
+
 void Group::focus_freeze(bool en) {
   if (group_) lv_group_focus_freeze(group_, en);
 }
@@ -100,6 +152,7 @@ void Group::set_default(Group& group) { lv_group_set_default(group.raw()); }
 void Group::swap(Group& other) {
   std::swap(group_, other.group_);
   std::swap(ownership_, other.ownership_);
+  std::swap(focus_graph_, other.focus_graph_);
 }
 
 }  // namespace lvgl
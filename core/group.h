@@ -7,6 +7,8 @@
 
 namespace lvgl {
 
+class FocusGraph;
+
 /**
  * @brief Wrapper for lv_group_t, managing input device focus.
  */
@@ -84,6 +86,23 @@ class Group {
    */
   void focus_prev();
 
+  /**
+   * @brief Focus the nearest object on screen in a direction.
+   *
+   * Neighbors come from a `FocusGraph` built on first use and updated
+   * incrementally as members move, or are added and removed. With wrap
+   * enabled, moving past the edge focuses the far end of the row or
+   * column. Keep one `Group` wrapper per group so the graph is reused.
+   * @param dir Dir::Left, Dir::Right, Dir::Top or Dir::Bottom.
+   * @return true if the focus moved.
+   */
+  bool focus_direction(Dir dir);
+
+  /**
+   * @brief The neighbor graph used by focus_direction().
+   */
+  FocusGraph& get_focus_graph();
+
   /**
    * @brief Freeze the group focus (prevent changing focus).
    * @param en true: freeze, false: unfreeze.
@@ -137,6 +156,7 @@ class Group {
  private:
   lv_group_t* group_ = nullptr;
   Ownership ownership_ = Ownership::Unmanaged;
+  std::unique_ptr<FocusGraph> focus_graph_;
 };
 
 }  // namespace lvgl
@@ -0,0 +1,267 @@
+#include "hit_test_index.h"
+
+#include <algorithm>
+
+#include "object.h"
+
+namespace lvgl {
+
+namespace {
+
+int32_t floor_div(int32_t value, int32_t divisor) {
+  int32_t q = value / divisor;
+  return (value % divisor != 0 && value < 0) ? q - 1 : q;
+}
+
+bool contains(const lv_area_t& area, lv_point_t p) {
+  return p.x >= area.x1 && p.x <= area.x2 && p.y >= area.y1 && p.y <= area.y2;
+}
+
+}  // namespace
+
+HitTestIndex::HitTestIndex(Object& container, int32_t cell_size)
+    : container_(container.raw()),
+      cell_size_(std::max<int32_t>(cell_size, 8)) {
+  if (!container_) return;
+  for (lv_event_code_t code : {LV_EVENT_CHILD_CREATED, LV_EVENT_CHILD_CHANGED,
+                               LV_EVENT_CHILD_DELETED, LV_EVENT_DELETE}) {
+    lv_obj_add_event_cb(container_, container_event_cb, code, this);
+  }
+  create_router();
+  rebuild();
+}
+
+HitTestIndex::~HitTestIndex() {
+  if (restore_pending_) lv_async_call_cancel(restore_cb, this);
+  drop_target();
+  if (!container_) return;
+  lv_obj_remove_event_cb_with_user_data(container_, container_event_cb, this);
+  if (router_) {
+    lv_obj_remove_event_cb_with_user_data(router_, router_event_cb, this);
+    lv_obj_delete(router_);
+  }
+}
+
+void HitTestIndex::create_router() {
+  creating_router_ = true;
+  router_ = lv_obj_create(container_);
+  creating_router_ = false;
+  lv_obj_remove_style_all(router_);
+  lv_obj_set_size(router_, LV_PCT(100), LV_PCT(100));
+  lv_obj_add_flag(router_, LV_OBJ_FLAG_FLOATING);
+  lv_obj_add_flag(router_, LV_OBJ_FLAG_EVENT_BUBBLE);
+  lv_obj_remove_flag(router_, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_remove_flag(router_, LV_OBJ_FLAG_CLICK_FOCUSABLE);
+  lv_obj_remove_flag(router_, LV_OBJ_FLAG_SCROLL_ON_FOCUS);
+  lv_obj_add_event_cb(router_, router_event_cb, LV_EVENT_ALL, this);
+}
+
+void HitTestIndex::schedule_restore() {
+  // Moving the router up is O(children), so do it once per batch of new
+  // children rather than once per child.
+  if (restore_pending_) return;
+  if (lv_async_call(restore_cb, this) == LV_RESULT_OK) restore_pending_ = true;
+}
+
+void HitTestIndex::restore_cb(void* user_data) {
+  auto* self = static_cast<HitTestIndex*>(user_data);
+  self->restore_pending_ = false;
+  if (!self->container_) return;
+  if (!self->router_) {
+    self->create_router();
+  } else {
+    lv_obj_move_foreground(self->router_);
+  }
+}
+
+void HitTestIndex::rebuild() {
+  items_.clear();
+  cells_.clear();
+  stale_ = false;
+  if (!container_) return;
+  uint32_t count = lv_obj_get_child_count(container_);
+  for (uint32_t i = 0; i < count; ++i) {
+    add(lv_obj_get_child(container_, static_cast<int32_t>(i)));
+  }
+  if (router_) lv_obj_move_foreground(router_);
+}
+
+lv_area_t HitTestIndex::to_content(const lv_area_t& area) const {
+  // Relative to the scrolled content, so scrolling keeps entries valid.
+  lv_area_t coords;
+  lv_obj_get_coords(container_, &coords);
+  int32_t dx = lv_obj_get_scroll_x(container_) - coords.x1;
+  int32_t dy = lv_obj_get_scroll_y(container_) - coords.y1;
+  return {area.x1 + dx, area.y1 + dy, area.x2 + dx, area.y2 + dy};
+}
+
+template <typename Fn>
+void HitTestIndex::for_each_cell(const lv_area_t& area, Fn fn) const {
+  int32_t x1 = floor_div(area.x1, cell_size_);
+  int32_t x2 = floor_div(area.x2, cell_size_);
+  int32_t y1 = floor_div(area.y1, cell_size_);
+  int32_t y2 = floor_div(area.y2, cell_size_);
+  for (int32_t cy = y1; cy <= y2; ++cy) {
+    for (int32_t cx = x1; cx <= x2; ++cx) fn(key(cx, cy));
+  }
+}
+
+HitTestIndex::CellKey HitTestIndex::key(int32_t cx, int32_t cy) const {
+  return (static_cast<CellKey>(static_cast<uint32_t>(cx)) << 32) |
+         static_cast<uint32_t>(cy);
+}
+
+void HitTestIndex::add(lv_obj_t* child) {
+  if (child == router_) return;
+  remove(child);
+  lv_area_t area;
+  lv_obj_get_click_area(child, &area);
+  area = to_content(area);
+  items_.emplace(child, area);
+  for_each_cell(area, [&](CellKey k) { cells_[k].push_back(child); });
+}
+
+void HitTestIndex::remove(lv_obj_t* child) {
+  auto it = items_.find(child);
+  if (it == items_.end()) return;
+  for_each_cell(it->second, [&](CellKey k) {
+    auto cell = cells_.find(k);
+    if (cell == cells_.end()) return;
+    std::vector<lv_obj_t*>& list = cell->second;
+    list.erase(std::find(list.begin(), list.end(), child));
+    if (list.empty()) cells_.erase(cell);
+  });
+  items_.erase(it);
+}
+
+lv_obj_t* HitTestIndex::hit_test(lv_point_t point) {
+  if (!container_) return nullptr;
+  if (stale_) rebuild();
+  lv_area_t p = to_content({point.x, point.y, point.x, point.y});
+  auto cell = cells_.find(key(floor_div(p.x1, cell_size_),
+                              floor_div(p.y1, cell_size_)));
+  if (cell == cells_.end()) return nullptr;
+  lv_obj_t* found = nullptr;
+  lv_obj_t* found_child = nullptr;
+  for (lv_obj_t* child : cell->second) {
+    if (!contains(items_.at(child), {p.x1, p.y1})) continue;
+    // LVGL's own search decides within the child: hidden and
+    // non-clickable objects, advanced hit tests and descendants.
+    lv_obj_t* hit = lv_indev_search_obj(child, &point);
+    if (!hit) continue;
+    // Overlaps are rare; only then is the z-order looked up.
+    if (!found ||
+        lv_obj_get_index(child) > lv_obj_get_index(found_child)) {
+      found = hit;
+      found_child = child;
+    }
+  }
+  return found;
+}
+
+void HitTestIndex::press(lv_event_t* e) {
+  drop_target();
+  lv_point_t point;
+  lv_indev_get_point(lv_event_get_indev(e), &point);
+  target_ = hit_test(point);
+  if (!target_) return;
+  lv_obj_add_event_cb(target_, target_deleted_cb, LV_EVENT_DELETE, this);
+  lv_obj_add_state(target_, LV_STATE_PRESSED);
+}
+
+void HitTestIndex::forward(lv_event_t* e) {
+  // Handled on behalf of the target, so the container does not see it
+  // again through the router.
+  lv_event_stop_bubbling(e);
+  lv_obj_send_event(target_, lv_event_get_code(e), lv_event_get_param(e));
+}
+
+void HitTestIndex::drop_target() {
+  if (!target_) return;
+  lv_obj_remove_state(target_, LV_STATE_PRESSED);
+  lv_obj_remove_event_cb_with_user_data(target_, target_deleted_cb, this);
+  target_ = nullptr;
+}
+
+void HitTestIndex::container_event_cb(lv_event_t* e) {
+  auto* self = static_cast<HitTestIndex*>(lv_event_get_user_data(e));
+  auto* child = static_cast<lv_obj_t*>(lv_event_get_param(e));
+  switch (lv_event_get_code(e)) {
+    case LV_EVENT_CHILD_CREATED:
+      if (self->creating_router_ || !child) return;
+      self->add(child);
+      self->schedule_restore();
+      return;
+    case LV_EVENT_CHILD_CHANGED:
+      if (!child || child == self->router_) return;
+      if (lv_obj_get_parent(child) == self->container_) {
+        self->add(child);
+      } else {
+        self->remove(child);  // Moved to another parent.
+      }
+      return;
+    case LV_EVENT_CHILD_DELETED:
+      // The deleted child is not passed, so find it on the next lookup.
+      self->stale_ = true;
+      return;
+    case LV_EVENT_DELETE:
+      self->container_ = nullptr;
+      self->router_ = nullptr;
+      self->items_.clear();
+      self->cells_.clear();
+      return;
+    default:
+      return;
+  }
+}
+
+void HitTestIndex::router_event_cb(lv_event_t* e) {
+  auto* self = static_cast<HitTestIndex*>(lv_event_get_user_data(e));
+  lv_event_code_t code = lv_event_get_code(e);
+  if (code == LV_EVENT_DELETE) {
+    // e.g. lv_obj_clean() on the container, which took the children
+    // with it; put a new router back later.
+    self->router_ = nullptr;
+    self->stale_ = true;
+    if (self->container_) self->schedule_restore();
+    return;
+  }
+  if (code < LV_EVENT_PRESSED || code > LV_EVENT_RELEASED) return;
+  if (code == LV_EVENT_PRESSED) self->press(e);
+  if (!self->target_) return;
+  if (code == LV_EVENT_PRESSING &&
+      !lv_obj_has_flag(self->target_, LV_OBJ_FLAG_PRESS_LOCK)) {
+    // Without press lock LVGL would move on to whatever is under the
+    // pointer now; report the loss instead.
+    lv_point_t point;
+    lv_indev_get_point(lv_event_get_indev(e), &point);
+    lv_area_t area;
+    lv_obj_get_click_area(self->target_, &area);
+    if (!contains(area, point)) {
+      lv_event_stop_bubbling(e);
+      lv_obj_send_event(self->target_, LV_EVENT_PRESS_LOST,
+                        lv_event_get_param(e));
+      self->drop_target();
+      return;
+    }
+  }
+  self->forward(e);
+  if (!self->target_) return;  // Deleted by a handler.
+  if (code == LV_EVENT_PRESS_LOST) {
+    self->drop_target();
+  } else if (code == LV_EVENT_RELEASED) {
+    // CLICKED follows RELEASED, so the target is kept until the next press.
+    lv_obj_remove_state(self->target_, LV_STATE_PRESSED);
+    if (lv_obj_has_flag(self->target_, LV_OBJ_FLAG_CLICK_FOCUSABLE) &&
+        lv_obj_get_group(self->target_)) {
+      lv_group_focus_obj(self->target_);
+    }
+  }
+}
+
+void HitTestIndex::target_deleted_cb(lv_event_t* e) {
+  auto* self = static_cast<HitTestIndex*>(lv_event_get_user_data(e));
+  self->target_ = nullptr;
+}
+
+}  // namespace lvgl
@@ -0,0 +1,115 @@
+#ifndef LVGL_CPP_CORE_HIT_TEST_INDEX_H_
+#define LVGL_CPP_CORE_HIT_TEST_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file hit_test_index.h
+ * @brief User Guide:
+ * `HitTestIndex` speeds up pointer hit testing in a container with
+ * thousands of clickable children (maps, plant floors, large grids). LVGL
+ * normally tests every child on each press and, without press lock, on
+ * each move.
+ *
+ * Key Features:
+ * - **Uniform grid**: Child click areas are bucketed into square cells, so
+ *   a press tests only the children whose area covers its cell.
+ * - **Live updates**: Children are indexed and moved from the container's
+ *   `CHILD_CREATED` and `CHILD_CHANGED` events. Deletions mark the index
+ *   stale; it is rebuilt once, on the next hit test. Scrolling the
+ *   container needs no update.
+ * - **Routing**: A transparent router object is kept on top of the
+ *   children. LVGL's search stops at it, and the router forwards press,
+ *   click and release events to the indexed child (or its deepest
+ *   clickable descendant) and mirrors `LV_STATE_PRESSED` on it.
+ *
+ * Example:
+ * @code
+ * lvgl::Object map(screen);
+ * lvgl::HitTestIndex index(map);
+ * for (const Machine& m : machines) {
+ *   lvgl::Button button(map);
+ *   button.set_pos(m.x, m.y).set_size(24, 24);
+ *   button.add_event_cb(lvgl::EventCode::Clicked, show_details);
+ * }
+ * @endcode
+ *
+ * Limits: events are routed to the hit child, so a scrollable child does
+ * not scroll (the container does), and child transforms are not applied
+ * to the index. Call `rebuild()` after changes made without events, such
+ * as transform styles.
+ */
+namespace lvgl {
+
+class Object;
+
+class HitTestIndex {
+ public:
+  /**
+   * @brief Index the children of `container`.
+   * @param cell_size Grid cell edge in pixels; about the size of a typical
+   * child works well.
+   */
+  explicit HitTestIndex(Object& container, int32_t cell_size = 64);
+  ~HitTestIndex();
+
+  HitTestIndex(const HitTestIndex&) = delete;
+  HitTestIndex& operator=(const HitTestIndex&) = delete;
+
+  /** @brief Re-read every child's click area. */
+  void rebuild();
+
+  /**
+   * @brief The object a press at `point` (screen coordinates) would reach
+   * inside the container, or nullptr if it falls between children.
+   */
+  lv_obj_t* hit_test(lv_point_t point);
+
+  /** @brief Number of indexed children. */
+  size_t get_item_count() const { return items_.size(); }
+
+  /** @brief Number of non-empty grid cells. */
+  size_t get_cell_count() const { return cells_.size(); }
+
+  /** @brief The router object on top of the children. */
+  lv_obj_t* get_router() const { return router_; }
+
+ private:
+  using CellKey = uint64_t;
+
+  void create_router();
+  void schedule_restore();
+  void add(lv_obj_t* child);
+  void remove(lv_obj_t* child);
+  void press(lv_event_t* e);
+  void forward(lv_event_t* e);
+  void drop_target();
+  lv_area_t to_content(const lv_area_t& area) const;
+  template <typename Fn>
+  void for_each_cell(const lv_area_t& area, Fn fn) const;
+  CellKey key(int32_t cx, int32_t cy) const;
+
+  static void restore_cb(void* user_data);
+  static void container_event_cb(lv_event_t* e);
+  static void router_event_cb(lv_event_t* e);
+  static void target_deleted_cb(lv_event_t* e);
+
+  lv_obj_t* container_;
+  lv_obj_t* router_ = nullptr;
+  int32_t cell_size_;
+  std::unordered_map<lv_obj_t*, lv_area_t> items_;  // Content coordinates.
+  std::unordered_map<CellKey, std::vector<lv_obj_t*>> cells_;
+  lv_obj_t* target_ = nullptr;  // Target of the last press.
+  bool stale_ = false;          // A child was deleted.
+  bool restore_pending_ = false;
+  bool creating_router_ = false;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_CORE_HIT_TEST_INDEX_H_
@@ -1,16 +1,492 @@
 #include "owned_font.h"
 
+#include <algorithm>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+
+#include "../core/compatibility.h"
+
+#if LVGL_CPP_HAS_THREADS
+#include <mutex>
+#endif
 
 namespace lvgl {
 
+/**
+ * LRU cache of rasterized glyph bitmaps, keyed by glyph index.
+ *
+ * It is installed by replacing the font's get_glyph_bitmap/release_glyph
+ * callbacks. A miss asks the original backend to rasterize, keeps a copy of
+ * the bitmap and immediately releases the backend's entry. Entries handed
+ * to the renderer are pinned through `lv_font_glyph_dsc_t::entry`, so an
+ * eviction during a draw only frees the bitmap once it is released. Draw
+ * units may run on other threads, hence the lock.
+ */
+struct OwnedFont::GlyphCache {
+  struct Entry {
+    uint32_t key = 0;
+    lv_draw_buf_t* buf = nullptr;
+    size_t bytes = 0;
+    uint32_t pins = 0;    ///< Draws currently using the bitmap.
+    bool cached = true;   ///< False once evicted; freed on last release.
+    Entry* prev = nullptr;
+    Entry* next = nullptr;
+  };
+
+  using GetBitmapCb = const void* (*)(lv_font_glyph_dsc_t*, lv_draw_buf_t*);
+  using ReleaseCb = void (*)(const lv_font_t*, lv_font_glyph_dsc_t*);
+
+  GlyphCache(lv_font_t* font, size_t budget);
+  ~GlyphCache();
+
+  static const void* get_bitmap_proxy(lv_font_glyph_dsc_t* g,
+                                      lv_draw_buf_t* draw_buf);
+  static void release_proxy(const lv_font_t* font, lv_font_glyph_dsc_t* g);
+  static void prewarm_timer_cb(lv_timer_t* timer);
+
+  const void* get_bitmap(lv_font_glyph_dsc_t* g, lv_draw_buf_t* draw_buf);
+  void release(lv_font_glyph_dsc_t* g);
+  bool warm(uint32_t letter);
+  void stop_prewarm();
+
+  // The helpers below expect the lock to be held.
+  Entry* rasterize(lv_font_glyph_dsc_t* g, lv_draw_buf_t* draw_buf);
+  void check_size();
+  void trim();
+  void evict(Entry* e);
+  void clear();
+  void link_front(Entry* e);
+  void unlink(Entry* e);
+  static void free_entry(Entry* e);
+
+#if LVGL_CPP_HAS_THREADS
+  std::unique_lock<std::mutex> lock() const {
+    return std::unique_lock<std::mutex>(mutex);
+  }
+  mutable std::mutex mutex;
+#else
+  struct NoLock {};
+  NoLock lock() const { return {}; }
+#endif
+
+  lv_font_t* font;
+  GetBitmapCb orig_get_bitmap;
+  ReleaseCb orig_release;
+  size_t budget;
+  int32_t line_height;  ///< Changes with lv_tiny_ttf_set_size().
+  GlyphCacheStats stats;
+  std::unordered_map<uint32_t, Entry*> index;
+  Entry* head = nullptr;  ///< Most recently used.
+  Entry* tail = nullptr;  ///< Next to evict.
+
+  std::u32string prewarm_queue;
+  size_t prewarm_pos = 0;
+  uint32_t prewarm_per_tick = 8;
+  lv_timer_t* prewarm_timer = nullptr;
+};
+
+OwnedFont::GlyphCache::GlyphCache(lv_font_t* f, size_t b)
+    : font(f),
+      orig_get_bitmap(f->get_glyph_bitmap),
+      orig_release(f->release_glyph),
+      budget(b),
+      line_height(f->line_height) {
+  font->user_data = this;
+  font->get_glyph_bitmap = get_bitmap_proxy;
+  font->release_glyph = release_proxy;
+}
+
+OwnedFont::GlyphCache::~GlyphCache() {
+  stop_prewarm();
+  font->get_glyph_bitmap = orig_get_bitmap;
+  font->release_glyph = orig_release;
+  font->user_data = nullptr;
+  [[maybe_unused]] auto guard = lock();
+  clear();
+}
+
+const void* OwnedFont::GlyphCache::get_bitmap_proxy(lv_font_glyph_dsc_t* g,
+                                                    lv_draw_buf_t* draw_buf) {
+  auto* self = static_cast<GlyphCache*>(g->resolved_font->user_data);
+  return self->get_bitmap(g, draw_buf);
+}
+
+void OwnedFont::GlyphCache::release_proxy(const lv_font_t* font,
+                                          lv_font_glyph_dsc_t* g) {
+  static_cast<GlyphCache*>(font->user_data)->release(g);
+}
+
+const void* OwnedFont::GlyphCache::get_bitmap(lv_font_glyph_dsc_t* g,
+                                              lv_draw_buf_t* draw_buf) {
+  // Only A8 bitmaps are returned as draw buffers that can be copied.
+  if (g->format != LV_FONT_GLYPH_FORMAT_A8) {
+    return orig_get_bitmap(g, draw_buf);
+  }
+
+  [[maybe_unused]] auto guard = lock();
+  check_size();
+  Entry* e = nullptr;
+  auto it = index.find(g->gid.index);
+  if (it != index.end()) {
+    e = it->second;
+    stats.hits++;
+    unlink(e);
+    link_front(e);
+  } else {
+    stats.misses++;
+    e = rasterize(g, draw_buf);
+    if (!e) return nullptr;
+  }
+
+  e->pins++;
+  g->entry = reinterpret_cast<lv_cache_entry_t*>(e);
+  trim();
+  return e->buf;
+}
+
+void OwnedFont::GlyphCache::release(lv_font_glyph_dsc_t* g) {
+  if (g->format != LV_FONT_GLYPH_FORMAT_A8) {
+    if (orig_release) orig_release(font, g);
+    return;
+  }
+  auto* e = reinterpret_cast<Entry*>(g->entry);
+  if (!e) return;
+  g->entry = nullptr;
+
+  [[maybe_unused]] auto guard = lock();
+  if (--e->pins == 0 && !e->cached) free_entry(e);
+}
+
+bool OwnedFont::GlyphCache::warm(uint32_t letter) {
+  lv_font_glyph_dsc_t g{};
+  if (!lv_font_get_glyph_dsc(font, &g, letter, 0)) return false;
+  if (g.resolved_font != font || g.box_w == 0 || g.box_h == 0) return false;
+  {
+    [[maybe_unused]] auto guard = lock();
+    check_size();
+    if (index.count(g.gid.index)) return false;
+  }
+  if (!lv_font_get_glyph_bitmap(&g, nullptr)) return false;
+  lv_font_glyph_release_draw_data(&g);
+  return true;
+}
+
+void OwnedFont::GlyphCache::prewarm_timer_cb(lv_timer_t* timer) {
+  auto* self = static_cast<GlyphCache*>(lv_timer_get_user_data(timer));
+  uint32_t warmed = 0;
+  while (warmed < self->prewarm_per_tick &&
+         self->prewarm_pos < self->prewarm_queue.size()) {
+    if (self->warm(self->prewarm_queue[self->prewarm_pos++])) warmed++;
+  }
+  if (self->prewarm_pos >= self->prewarm_queue.size()) self->stop_prewarm();
+}
+
+void OwnedFont::GlyphCache::stop_prewarm() {
+  if (prewarm_timer) {
+    lv_timer_delete(prewarm_timer);
+    prewarm_timer = nullptr;
+  }
+  prewarm_queue.clear();
+  prewarm_pos = 0;
+}
+
+OwnedFont::GlyphCache::Entry* OwnedFont::GlyphCache::rasterize(
+    lv_font_glyph_dsc_t* g, lv_draw_buf_t* draw_buf) {
+  auto* src =
+      static_cast<const lv_draw_buf_t*>(orig_get_bitmap(g, draw_buf));
+  if (!src) return nullptr;
+  lv_draw_buf_t* copy = lv_draw_buf_dup(src);
+  // The backend's own entry is not needed once the bitmap is copied.
+  if (orig_release) orig_release(font, g);
+  if (!copy) return nullptr;
+
+  auto* e = new Entry;
+  e->key = g->gid.index;
+  e->buf = copy;
+  e->bytes = copy->data_size;
+  index.emplace(e->key, e);
+  link_front(e);
+  stats.entries++;
+  stats.bytes += e->bytes;
+  return e;
+}
+
+void OwnedFont::GlyphCache::check_size() {
+  // Entries are keyed by glyph id only, so bitmaps of the old size must go
+  // once the font is resized.
+  if (font->line_height == line_height) return;
+  clear();
+  line_height = font->line_height;
+}
+
+void OwnedFont::GlyphCache::trim() {
+  while (stats.bytes > budget && tail) {
+    evict(tail);
+    stats.evictions++;
+  }
+}
+
+void OwnedFont::GlyphCache::evict(Entry* e) {
+  unlink(e);
+  index.erase(e->key);
+  stats.entries--;
+  stats.bytes -= e->bytes;
+  e->cached = false;
+  if (e->pins == 0) free_entry(e);
+}
+
+void OwnedFont::GlyphCache::clear() {
+  while (head) evict(head);
+}
+
+void OwnedFont::GlyphCache::link_front(Entry* e) {
+  e->prev = nullptr;
+  e->next = head;
+  if (head) head->prev = e;
+  head = e;
+  if (!tail) tail = e;
+}
+
+void OwnedFont::GlyphCache::unlink(Entry* e) {
+  if (e->prev) {
+    e->prev->next = e->next;
+  } else {
+    head = e->next;
+  }
+  if (e->next) {
+    e->next->prev = e->prev;
+  } else {
+    tail = e->prev;
+  }
+  e->prev = nullptr;
+  e->next = nullptr;
+}
+
+void OwnedFont::GlyphCache::free_entry(Entry* e) {
+  lv_draw_buf_destroy(e->buf);
+  delete e;
+}
+
+/**
+ * Two-level code point to glyph id table for fmt_txt (binary) fonts.
+ *
+ * `pages` maps the upper bits of a code point to a 256-entry page of glyph
+ * ids; unused pages share page 0, which is all zeros. It replaces the
+ * font's get_glyph_dsc callback, so a lookup is two loads instead of a walk
+ * over the cmap subtables with a binary search in each sparse one. A miss
+ * is just as cheap, which keeps fallback chains fast: LVGL moves on to the
+ * next font after one table read.
+ */
+struct OwnedFont::GlyphIndex {
+  using GetDscCb = bool (*)(const lv_font_t*, lv_font_glyph_dsc_t*, uint32_t,
+                            uint32_t);
+
+  static constexpr uint32_t kPageBits = 8;
+  static constexpr uint32_t kPageSize = 1u << kPageBits;
+  static constexpr uint32_t kMaxLetter = 0x110000;
+
+  explicit GlyphIndex(lv_font_t* f);
+  ~GlyphIndex();
+
+  bool build();
+  void set(uint32_t letter, uint32_t gid);
+  uint32_t find(uint32_t letter) const {
+    if (letter >= kMaxLetter) return 0;
+    return glyphs[(static_cast<uint32_t>(pages[letter >> kPageBits])
+                   << kPageBits) |
+                  (letter & (kPageSize - 1))];
+  }
+  int32_t kerning(uint32_t left, uint32_t right) const;
+
+  static bool get_dsc_proxy(const lv_font_t* font, lv_font_glyph_dsc_t* dsc,
+                            uint32_t letter, uint32_t letter_next);
+
+  lv_font_t* font;
+  const lv_font_fmt_txt_dsc_t* fdsc;
+  GetDscCb orig_get_dsc;
+  lv_font_glyph_dsc_t proto{};  ///< Fields shared by every glyph.
+  std::vector<uint16_t> pages;
+  std::vector<uint16_t> glyphs;
+};
+
+OwnedFont::GlyphIndex::GlyphIndex(lv_font_t* f)
+    : font(f),
+      fdsc(static_cast<const lv_font_fmt_txt_dsc_t*>(f->dsc)),
+      orig_get_dsc(f->get_glyph_dsc),
+      pages(kMaxLetter >> kPageBits, 0),
+      glyphs(kPageSize, 0) {}
+
+OwnedFont::GlyphIndex::~GlyphIndex() {
+  if (font->get_glyph_dsc == get_dsc_proxy) {
+    font->get_glyph_dsc = orig_get_dsc;
+    font->user_data = nullptr;
+  }
+}
+
+void OwnedFont::GlyphIndex::set(uint32_t letter, uint32_t gid) {
+  if (letter >= kMaxLetter || gid == 0 || find(letter) != 0) return;
+  uint16_t& page = pages[letter >> kPageBits];
+  if (page == 0) {
+    page = static_cast<uint16_t>(glyphs.size() >> kPageBits);
+    glyphs.resize(glyphs.size() + kPageSize, 0);
+  }
+  glyphs[(static_cast<uint32_t>(page) << kPageBits) |
+         (letter & (kPageSize - 1))] = static_cast<uint16_t>(gid);
+}
+
+bool OwnedFont::GlyphIndex::build() {
+  // Subtables are visited in order and the first mapping wins, as in
+  // lv_font_fmt_txt's own lookup.
+  uint32_t max_gid = 0;
+  for (uint32_t i = 0; i < fdsc->cmap_num; ++i) {
+    const lv_font_fmt_txt_cmap_t& c = fdsc->cmaps[i];
+    auto add = [&](uint32_t rcp, uint32_t gid) {
+      if (rcp >= c.range_length) return;
+      max_gid = std::max(max_gid, gid);
+      if (gid <= UINT16_MAX) set(c.range_start + rcp, gid);
+    };
+    switch (c.type) {
+      case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+        for (uint32_t r = 0; r < c.range_length; ++r) {
+          add(r, c.glyph_id_start + r);
+        }
+        break;
+      case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+        const auto* ofs = static_cast<const uint8_t*>(c.glyph_id_ofs_list);
+        for (uint32_t r = 0; r < c.range_length; ++r) {
+          add(r, c.glyph_id_start + ofs[r]);
+        }
+        break;
+      }
+      case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+        for (uint32_t j = 0; j < c.list_length; ++j) {
+          add(c.unicode_list[j], c.glyph_id_start + j);
+        }
+        break;
+      case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL: {
+        const auto* ofs = static_cast<const uint16_t*>(c.glyph_id_ofs_list);
+        for (uint32_t j = 0; j < c.list_length; ++j) {
+          add(c.unicode_list[j], c.glyph_id_start + ofs[j]);
+        }
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  // Page numbers and glyph ids are 16 bit.
+  if (max_gid > UINT16_MAX ||
+      glyphs.size() > (size_t{UINT16_MAX} << kPageBits)) {
+    return false;
+  }
+
+  // Take the format, stride, etc. from one real lookup so they always match
+  // what this LVGL version's fmt_txt driver reports.
+  uint32_t sample = 0;
+  for (uint32_t letter = 0; letter < kMaxLetter && sample == 0; ++letter) {
+    if (find(letter) != 0) sample = letter;
+  }
+  if (sample == 0 || !orig_get_dsc(font, &proto, sample, 0)) return false;
+
+  font->user_data = this;
+  font->get_glyph_dsc = get_dsc_proxy;
+  return true;
+}
+
+int32_t OwnedFont::GlyphIndex::kerning(uint32_t left, uint32_t right) const {
+  int32_t value = 0;
+  if (fdsc->kern_classes == 0) {
+    const auto* kdsc =
+        static_cast<const lv_font_fmt_txt_kern_pair_t*>(fdsc->kern_dsc);
+    // Pairs are sorted by (left, right).
+    auto search = [&](const auto* ids) {
+      uint32_t lo = 0;
+      uint32_t hi = kdsc->pair_cnt;
+      while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        uint32_t l = ids[mid * 2];
+        uint32_t r = ids[mid * 2 + 1];
+        if (l == left && r == right) return static_cast<int32_t>(mid);
+        if (l < left || (l == left && r < right)) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      return -1;
+    };
+    int32_t pos = kdsc->glyph_ids_size == 0
+                      ? search(static_cast<const uint8_t*>(kdsc->glyph_ids))
+                      : search(static_cast<const uint16_t*>(kdsc->glyph_ids));
+    if (pos >= 0) value = kdsc->values[pos];
+  } else {
+    const auto* kdsc =
+        static_cast<const lv_font_fmt_txt_kern_classes_t*>(fdsc->kern_dsc);
+    uint8_t left_class = kdsc->left_class_mapping[left];
+    uint8_t right_class = kdsc->right_class_mapping[right];
+    if (left_class > 0 && right_class > 0) {
+      value = kdsc->class_pair_values[(left_class - 1) * kdsc->right_class_cnt +
+                                      (right_class - 1)];
+    }
+  }
+  return value;
+}
+
+// Same result as lv_font_get_glyph_dsc_fmt_txt(), minus the cmap search.
+bool OwnedFont::GlyphIndex::get_dsc_proxy(const lv_font_t* font,
+                                          lv_font_glyph_dsc_t* dsc,
+                                          uint32_t letter,
+                                          uint32_t letter_next) {
+  const auto* self = static_cast<const GlyphIndex*>(font->user_data);
+  bool is_tab = letter == '\t';
+  if (is_tab) letter = ' ';
+
+  uint32_t gid = self->find(letter);
+  if (gid == 0) return false;
+
+  int32_t kv = 0;
+  if (self->fdsc->kern_dsc) {
+    uint32_t gid_next = self->find(letter_next);
+    if (gid_next != 0) {
+      kv = (self->kerning(gid, gid_next) * self->fdsc->kern_scale) >> 4;
+    }
+  }
+
+  const lv_font_fmt_txt_glyph_dsc_t& g = self->fdsc->glyph_dsc[gid];
+  uint32_t adv_w = g.adv_w;
+  if (is_tab) adv_w *= 2;
+  adv_w += kv;
+  adv_w = (adv_w + (1 << 3)) >> 4;
+
+  *dsc = self->proto;
+  dsc->adv_w = adv_w;
+  dsc->box_w = is_tab ? g.box_w * 2 : g.box_w;
+  dsc->box_h = g.box_h;
+  dsc->ofs_x = g.ofs_x;
+  dsc->ofs_y = g.ofs_y;
+  dsc->is_placeholder = false;
+  dsc->gid.index = gid;
+  return true;
+}
+
+float OwnedFont::GlyphCacheStats::hit_rate() const {
+  uint64_t total = hits + misses;
+  if (total == 0) return 0.0f;
+  return static_cast<float>(hits) / static_cast<float>(total);
+}
+
 OwnedFont::OwnedFont() : Font(nullptr) {}
 
 OwnedFont::OwnedFont(lv_font_t* font, FontType type)
     : Font(font), type_(type) {}
 
 OwnedFont::OwnedFont(OwnedFont&& other) noexcept
-    : Font(other.font_), type_(other.type_) {
+    : Font(other.font_),
+      type_(other.type_),
+      glyph_cache_(std::move(other.glyph_cache_)),
+      glyph_index_(std::move(other.glyph_index_)) {
   // Take ownership, clear source
   other.font_ = nullptr;
   other.type_ = FontType::None;
@@ -21,6 +497,8 @@ OwnedFont& OwnedFont::operator=(OwnedFont&& other) noexcept {
     destroy();
     font_ = other.font_;
     type_ = other.type_;
+    glyph_cache_ = std::move(other.glyph_cache_);
+    glyph_index_ = std::move(other.glyph_index_);
     other.font_ = nullptr;
     other.type_ = FontType::None;
   }
@@ -30,6 +508,9 @@ OwnedFont& OwnedFont::operator=(OwnedFont&& other) noexcept {
 OwnedFont::~OwnedFont() { destroy(); }
 
 void OwnedFont::destroy() {
+  // The cache and index restore the font's callbacks, so they go first.
+  glyph_cache_.reset();
+  glyph_index_.reset();
   if (font_) {
     lv_font_t* f = const_cast<lv_font_t*>(font_);
     if (type_ == FontType::TinyTTF) {
@@ -44,18 +525,114 @@ void OwnedFont::destroy() {
   }
 }
 
-OwnedFont OwnedFont::load_bin(const std::string& path) {
+OwnedFont OwnedFont::load_bin(const std::string& path,
+                              bool with_glyph_index) {
   // lv_binfont_create returns a new font object or NULL on failure
   lv_font_t* f = lv_binfont_create(path.c_str());
-  return OwnedFont(f, FontType::Binary);
+  OwnedFont font(f, FontType::Binary);
+  if (with_glyph_index) font.build_glyph_index();
+  return font;
+}
+
+bool OwnedFont::build_glyph_index() {
+  if (glyph_index_) return true;
+  if (!font_ || type_ != FontType::Binary) return false;
+  auto index = std::make_unique<GlyphIndex>(const_cast<lv_font_t*>(font_));
+  if (!index->build()) return false;
+  glyph_index_ = std::move(index);
+  return true;
+}
+
+bool OwnedFont::has_glyph_index() const { return glyph_index_ != nullptr; }
+
+size_t OwnedFont::get_glyph_index_bytes() const {
+  if (!glyph_index_) return 0;
+  return (glyph_index_->pages.size() + glyph_index_->glyphs.size()) *
+         sizeof(uint16_t);
+}
+
+void OwnedFont::set_fallback(const Font* fallback) {
+  if (!font_) return;
+  const_cast<lv_font_t*>(font_)->fallback =
+      fallback ? fallback->raw() : nullptr;
 }
 
 #if LV_USE_TINY_TTF
 OwnedFont OwnedFont::load_tiny_ttf(const void* data, size_t data_size,
-                                   int32_t font_size) {
-  lv_font_t* f = lv_tiny_ttf_create_data(data, data_size, font_size);
-  return OwnedFont(f, FontType::TinyTTF);
+                                   int32_t font_size,
+                                   size_t glyph_cache_bytes,
+                                   size_t backend_cache_size) {
+  if (glyph_cache_bytes == 0) {
+    lv_font_t* f = lv_tiny_ttf_create_data(data, data_size, font_size);
+    return OwnedFont(f, FontType::TinyTTF);
+  }
+
+  // Tiny TTF's own cache also holds glyph metrics used during layout, so it
+  // is kept, but small: bitmaps live in the budgeted cache.
+  lv_font_t* f = lv_tiny_ttf_create_data_ex(data, data_size, font_size,
+                                            LV_FONT_KERNING_NORMAL,
+                                            backend_cache_size);
+  OwnedFont font(f, FontType::TinyTTF);
+  if (f) font.glyph_cache_ = std::make_unique<GlyphCache>(f, glyph_cache_bytes);
+  return font;
 }
 #endif
 
+void OwnedFont::set_glyph_cache_budget(size_t bytes) {
+  if (!glyph_cache_) return;
+  [[maybe_unused]] auto guard = glyph_cache_->lock();
+  glyph_cache_->budget = bytes;
+  glyph_cache_->trim();
+}
+
+size_t OwnedFont::get_glyph_cache_budget() const {
+  return glyph_cache_ ? glyph_cache_->budget : 0;
+}
+
+OwnedFont::GlyphCacheStats OwnedFont::get_glyph_cache_stats() const {
+  if (!glyph_cache_) return {};
+  [[maybe_unused]] auto guard = glyph_cache_->lock();
+  return glyph_cache_->stats;
+}
+
+void OwnedFont::reset_glyph_cache_stats() {
+  if (!glyph_cache_) return;
+  [[maybe_unused]] auto guard = glyph_cache_->lock();
+  GlyphCacheStats& stats = glyph_cache_->stats;
+  stats.hits = 0;
+  stats.misses = 0;
+  stats.evictions = 0;
+}
+
+void OwnedFont::clear_glyph_cache() {
+  if (!glyph_cache_) return;
+  [[maybe_unused]] auto guard = glyph_cache_->lock();
+  glyph_cache_->clear();
+}
+
+uint32_t OwnedFont::prewarm(std::u32string_view charset) {
+  if (!glyph_cache_) return 0;
+  uint32_t warmed = 0;
+  for (char32_t letter : charset) {
+    if (glyph_cache_->warm(letter)) warmed++;
+  }
+  return warmed;
+}
+
+void OwnedFont::prewarm_async(std::u32string_view charset,
+                              uint32_t glyphs_per_tick) {
+  if (!glyph_cache_) return;
+  GlyphCache& cache = *glyph_cache_;
+  cache.stop_prewarm();
+  if (charset.empty()) return;
+  cache.prewarm_queue.assign(charset.begin(), charset.end());
+  cache.prewarm_per_tick = glyphs_per_tick > 0 ? glyphs_per_tick : 1;
+  cache.prewarm_timer =
+      lv_timer_create(GlyphCache::prewarm_timer_cb, 0, &cache);
+}
+
+bool OwnedFont::is_prewarming() const {
+  return glyph_cache_ && glyph_cache_->prewarm_timer != nullptr;
+}
+
 }  // namespace lvgl
@@ -1,7 +1,12 @@
 #ifndef LVGL_CPP_FONT_OWNED_FONT_H_
 #define LVGL_CPP_FONT_OWNED_FONT_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "font.h"
 #include "lvgl.h"
@@ -14,6 +19,43 @@ namespace lvgl {
  */
 class OwnedFont : public Font {
  public:
+  /// Suggested glyph cache budget for load_tiny_ttf().
+  static constexpr size_t kDefaultGlyphCacheBytes = 64 * 1024;
+
+  /**
+   * @brief Counters for the rasterized glyph cache.
+   */
+  struct GlyphCacheStats {
+    uint64_t hits = 0;       ///< Glyph bitmaps served from the cache.
+    uint64_t misses = 0;     ///< Glyph bitmaps that had to be rasterized.
+    uint64_t evictions = 0;  ///< Glyphs dropped to stay within the budget.
+    uint32_t entries = 0;    ///< Glyphs currently cached.
+    size_t bytes = 0;        ///< Bytes of glyph bitmaps currently cached.
+
+    /**
+     * @brief Fraction of bitmap lookups served from the cache.
+     * @return Value in [0, 1]; 0 when nothing has been drawn yet.
+     */
+    float hit_rate() const;
+  };
+
+  /**
+   * @brief Outcome of subsetting a binary font.
+   */
+  struct SubsetInfo {
+    uint32_t glyphs_total = 0;  ///< Glyphs in the source font.
+    uint32_t glyphs_kept = 0;   ///< Glyphs in the subset (including the
+                                ///< reserved glyph 0).
+    uint32_t missing = 0;       ///< Requested code points the font lacks.
+    uint32_t source_bytes = 0;  ///< Size of the source font file.
+    uint32_t subset_bytes = 0;  ///< Size of the generated font.
+
+    /**
+     * @brief Bytes no longer loaded compared to the full font.
+     */
+    uint32_t bytes_saved() const;
+  };
+
   /**
    * @brief Construct an empty/invalid OwnedFont.
    */
@@ -44,19 +86,138 @@ class OwnedFont : public Font {
    * @brief Load a binary font from the filesystem.
    * Wrapper for lv_binfont_create.
    * @param path File path to the .bin font file.
+   * @param with_glyph_index Also build the glyph lookup index
+   * (see build_glyph_index()).
    * @return OwnedFont instance. Check is_valid() for success.
    */
-  static OwnedFont load_bin(const std::string& path);
+  static OwnedFont load_bin(const std::string& path,
+                            bool with_glyph_index = false);
+
+  /**
+   * @brief Load only some characters of a binary font.
+   * The font file is parsed and rewritten with just the glyphs of `charset`
+   * (cmaps and kerning rebuilt), so the LVGL heap only holds what the UI
+   * displays. Requires `LV_USE_FS_MEMFS`; returns an invalid font otherwise.
+   * @param path File path to the .bin font file.
+   * @param charset Code points to keep.
+   * @param info Optional output describing the subset.
+   * @return OwnedFont instance. Check is_valid() for success.
+   */
+  static OwnedFont load_bin_subset(const std::string& path,
+                                   std::u32string_view charset,
+                                   SubsetInfo* info = nullptr);
+
+  /**
+   * @brief Build the subset font used by load_bin_subset() without loading
+   * it, e.g. to store pre-subsetted fonts.
+   * @param path File path to the .bin font file.
+   * @param charset Code points to keep.
+   * @param info Optional output describing the subset.
+   * @return The subset font file, or an empty vector if the source could not
+   * be parsed.
+   */
+  static std::vector<uint8_t> subset_bin(const std::string& path,
+                                         std::u32string_view charset,
+                                         SubsetInfo* info = nullptr);
+
+  /**
+   * @brief Index the font's code point to glyph mapping.
+   * Replaces the cmap subtable search of binary fonts with a two-level
+   * table, which pays off for large sparse fonts such as CJK. Costs
+   * 8.5 KiB plus 512 bytes per 256-code-point page in use.
+   * @return true if the index is active; false for fonts that are not
+   * binary fonts or whose glyph ids exceed 16 bits.
+   */
+  bool build_glyph_index();
+
+  /**
+   * @brief Check whether glyph lookups go through the index.
+   */
+  bool has_glyph_index() const;
+
+  /**
+   * @brief Memory used by the glyph index in bytes (0 without one).
+   */
+  size_t get_glyph_index_bytes() const;
+
+  /**
+   * @brief Set the font used for characters this font lacks.
+   * With a glyph index, a miss costs one table read before LVGL moves on to
+   * the fallback, so indexing every font of a chain keeps lookups fast.
+   * @param fallback The fallback font, or nullptr to clear it. It must
+   * outlive this font.
+   */
+  void set_fallback(const Font* fallback);
 
   /**
    * @brief Create a tiny_ttf font from data.
    * @param data The font data.
    * @param data_size The size of the font data.
    * @param font_size The font size in pixel.
+   * @param glyph_cache_bytes Budget for rasterized glyph bitmaps (e.g.
+   * kDefaultGlyphCacheBytes). Glyphs are evicted least recently used first.
+   * With a budget, Tiny TTF's own cache is cut to `backend_cache_size`
+   * entries; 0 (the default) keeps Tiny TTF's stock caching.
+   * @param backend_cache_size Tiny TTF cache entries kept for glyph metrics
+   * when `glyph_cache_bytes` is non-zero.
    * @return OwnedFont instance. Check is_valid() for success.
    */
   static OwnedFont load_tiny_ttf(const void* data, size_t data_size,
-                                 int32_t font_size);
+                                 int32_t font_size,
+                                 size_t glyph_cache_bytes = 0,
+                                 size_t backend_cache_size = 32);
+
+  /**
+   * @brief Change the glyph cache budget, evicting glyphs if it shrank.
+   * Only fonts created with load_tiny_ttf() and a non-zero budget have a
+   * glyph cache; this is a no-op for other fonts.
+   * @param bytes New budget in bytes.
+   */
+  void set_glyph_cache_budget(size_t bytes);
+
+  /**
+   * @brief Get the glyph cache budget in bytes (0 if there is no cache).
+   */
+  size_t get_glyph_cache_budget() const;
+
+  /**
+   * @brief Get the glyph cache counters.
+   */
+  GlyphCacheStats get_glyph_cache_stats() const;
+
+  /**
+   * @brief Reset hit/miss/eviction counters to zero.
+   */
+  void reset_glyph_cache_stats();
+
+  /**
+   * @brief Drop every cached glyph bitmap.
+   */
+  void clear_glyph_cache();
+
+  /**
+   * @brief Rasterize a set of glyphs into the cache now.
+   * Call while a screen is being built so its first frame does not pay for
+   * rasterization. Characters served by a fallback font are skipped.
+   * @param charset Code points to rasterize.
+   * @return Number of glyphs newly rasterized.
+   */
+  uint32_t prewarm(std::u32string_view charset);
+
+  /**
+   * @brief Rasterize a set of glyphs a few at a time from an LVGL timer.
+   * Spreads the work over idle frames instead of blocking; a new call
+   * replaces any prewarm still in progress.
+   * @param charset Code points to rasterize.
+   * @param glyphs_per_tick Glyphs rasterized per timer run.
+   */
+  void prewarm_async(std::u32string_view charset,
+                     uint32_t glyphs_per_tick = 8);
+
+  /**
+   * @brief Check whether an asynchronous prewarm is still running.
+   */
+  bool is_prewarming() const;
 
  private:
   enum class FontType { None, Binary, TinyTTF };
@@ -71,7 +232,12 @@ class OwnedFont : public Font {
   // Helper to safely delete the managed font
   void destroy();
 
+  struct GlyphCache;
+  struct GlyphIndex;
+
   FontType type_ = FontType::None;
+  std::unique_ptr<GlyphCache> glyph_cache_;
+  std::unique_ptr<GlyphIndex> glyph_index_;
 };
 
 }  // namespace lvgl
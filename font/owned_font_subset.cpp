@@ -0,0 +1,528 @@
+#include "owned_font.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../misc/file_system.h"
+
+// Subsetting of LVGL binary fonts (the lv_font_conv "bin" format read by
+// lv_binfont_create). A file is a sequence of sections, each starting with
+// a 32-bit length (including the 8-byte label) and a 4-character tag:
+//
+//   head  font_header (fixed layout, see BinHeader)
+//   cmap  subtable count, subtable headers, subtable data
+//   loca  glyph count, offsets of each glyph record inside "glyf"
+//   glyf  bit-packed metrics followed by the bitmap, per glyph
+//   kern  optional; sorted glyph pairs (format 0) or class arrays (format 3)
+//
+// The subset keeps glyph records byte for byte, renumbers the kept glyphs
+// and rebuilds loca, cmap and kern around them. All values are little
+// endian, as in the LVGL loader, which reads the structs directly.
+
+namespace lvgl {
+
+namespace {
+
+struct BinHeader {
+  uint32_t version;
+  uint16_t tables_count;
+  uint16_t font_size;
+  uint16_t ascent;
+  int16_t descent;
+  uint16_t typo_ascent;
+  int16_t typo_descent;
+  uint16_t typo_line_gap;
+  int16_t min_y;
+  int16_t max_y;
+  uint16_t default_advance_width;
+  uint16_t kerning_scale;
+  uint8_t index_to_loc_format;
+  uint8_t glyph_id_format;
+  uint8_t advance_width_format;
+  uint8_t bits_per_pixel;
+  uint8_t xy_bits;
+  uint8_t wh_bits;
+  uint8_t advance_width_bits;
+  uint8_t compression_id;
+  uint8_t subpixels_mode;
+  uint8_t padding;
+  int16_t underline_position;
+  uint16_t underline_thickness;
+};
+static_assert(sizeof(BinHeader) == 40, "binfont header layout");
+
+struct BinCmapTable {
+  uint32_t data_offset;
+  uint32_t range_start;
+  uint16_t range_length;
+  uint16_t glyph_id_start;
+  uint16_t data_entries_count;
+  uint8_t format_type;
+  uint8_t padding;
+};
+static_assert(sizeof(BinCmapTable) == 16, "binfont cmap layout");
+
+enum CmapFormat : uint8_t {
+  kFormat0Full = LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL,
+  kSparseFull = LV_FONT_FMT_TXT_CMAP_SPARSE_FULL,
+  kFormat0Tiny = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY,
+  kSparseTiny = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY,
+};
+
+constexpr uint32_t kLabelSize = 8;
+
+struct Cmap {
+  BinCmapTable table;
+  std::vector<uint8_t> ofs8;       // kFormat0Full
+  std::vector<uint16_t> unicodes;  // kSparse*
+  std::vector<uint16_t> ofs16;     // kSparseFull
+};
+
+class Reader {
+ public:
+  explicit Reader(const std::string& path) : file_(path, FsMode::Read) {}
+
+  bool is_open() const { return file_.is_open(); }
+  uint32_t size() { return file_.size(); }
+
+  bool read(void* buf, uint32_t size) {
+    uint32_t br = 0;
+    return file_.read(buf, size, &br) == FsRes::Ok && br == size;
+  }
+
+  template <typename T>
+  bool read(T* value) {
+    return read(value, sizeof(T));
+  }
+
+  template <typename T>
+  bool read(std::vector<T>* values, uint32_t count) {
+    values->resize(count);
+    return count == 0 || read(values->data(), count * sizeof(T));
+  }
+
+  bool seek(uint32_t pos) {
+    return file_.seek(pos, FsWhence::Set) == FsRes::Ok;
+  }
+
+  // Read the section label at `pos`; returns the section length or 0.
+  uint32_t section(uint32_t pos, const char* tag) {
+    uint32_t length = 0;
+    char buf[4];
+    if (!seek(pos) || !read(&length) || !read(buf, 4)) return 0;
+    if (std::memcmp(buf, tag, 4) != 0 || length < kLabelSize) return 0;
+    return length;
+  }
+
+ private:
+  File file_;
+};
+
+class Writer {
+ public:
+  std::vector<uint8_t>& bytes() { return out_; }
+  uint32_t pos() const { return static_cast<uint32_t>(out_.size()); }
+
+  void write(const void* data, size_t size) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    out_.insert(out_.end(), p, p + size);
+  }
+
+  template <typename T>
+  void write(const T& value) {
+    write(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void write(const std::vector<T>& values) {
+    write(values.data(), values.size() * sizeof(T));
+  }
+
+  template <typename T>
+  void patch(uint32_t pos, const T& value) {
+    std::memcpy(out_.data() + pos, &value, sizeof(T));
+  }
+
+  uint32_t begin_section(const char* tag) {
+    uint32_t start = pos();
+    write(uint32_t{0});
+    write(tag, 4);
+    return start;
+  }
+
+  // Fill in the section length, optionally padding to 4 bytes first.
+  uint32_t end_section(uint32_t start, bool align) {
+    if (align) out_.resize((out_.size() + 3) & ~size_t{3}, 0);
+    uint32_t length = pos() - start;
+    patch(start, length);
+    return length;
+  }
+
+ private:
+  std::vector<uint8_t> out_;
+};
+
+// Mirrors the lookup in lv_font_fmt_txt: the first subtable that yields a
+// non-zero glyph id wins.
+uint32_t find_glyph(const std::vector<Cmap>& cmaps, uint32_t cp) {
+  for (const Cmap& cmap : cmaps) {
+    const BinCmapTable& t = cmap.table;
+    if (cp < t.range_start) continue;
+    uint32_t rcp = cp - t.range_start;
+    if (rcp >= t.range_length) continue;
+
+    uint32_t gid = 0;
+    switch (t.format_type) {
+      case kFormat0Tiny:
+        gid = t.glyph_id_start + rcp;
+        break;
+      case kFormat0Full:
+        if (rcp < cmap.ofs8.size()) gid = t.glyph_id_start + cmap.ofs8[rcp];
+        break;
+      case kSparseTiny:
+      case kSparseFull: {
+        auto it = std::lower_bound(cmap.unicodes.begin(), cmap.unicodes.end(),
+                                   rcp);
+        if (it == cmap.unicodes.end() || *it != rcp) break;
+        size_t i = static_cast<size_t>(it - cmap.unicodes.begin());
+        gid = t.format_type == kSparseTiny ? t.glyph_id_start + i
+                                           : t.glyph_id_start + cmap.ofs16[i];
+        break;
+      }
+      default:
+        break;
+    }
+    if (gid != 0) return gid;
+  }
+  return 0;
+}
+
+bool read_cmaps(Reader& in, uint32_t start, std::vector<Cmap>* cmaps) {
+  uint32_t count = 0;
+  if (!in.read(&count)) return false;
+  std::vector<BinCmapTable> tables;
+  if (!in.read(&tables, count)) return false;
+
+  cmaps->resize(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    Cmap& cmap = (*cmaps)[i];
+    cmap.table = tables[i];
+    uint16_t entries = tables[i].data_entries_count;
+    if (!in.seek(start + tables[i].data_offset)) return false;
+    switch (tables[i].format_type) {
+      case kFormat0Full:
+        if (!in.read(&cmap.ofs8, entries)) return false;
+        break;
+      case kFormat0Tiny:
+        break;
+      case kSparseFull:
+        if (!in.read(&cmap.unicodes, entries)) return false;
+        if (!in.read(&cmap.ofs16, entries)) return false;
+        break;
+      case kSparseTiny:
+        if (!in.read(&cmap.unicodes, entries)) return false;
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// Emit cmap subtables for (code point, new glyph id) pairs sorted by code
+// point. A subtable spans at most 65535 code points (16-bit offsets); each
+// one uses the most compact format its contents allow.
+void write_cmaps(Writer& out,
+                 const std::vector<std::pair<uint32_t, uint32_t>>& map) {
+  struct Chunk {
+    size_t begin;
+    size_t end;
+  };
+  std::vector<Chunk> chunks;
+  for (size_t i = 0; i < map.size();) {
+    size_t j = i + 1;
+    while (j < map.size() && map[j].first - map[i].first < 0xFFFF) ++j;
+    chunks.push_back({i, j});
+    i = j;
+  }
+
+  uint32_t start = out.begin_section("cmap");
+  out.write(static_cast<uint32_t>(chunks.size()));
+  uint32_t tables_pos = out.pos();
+  out.bytes().resize(out.bytes().size() + chunks.size() * sizeof(BinCmapTable));
+
+  for (size_t c = 0; c < chunks.size(); ++c) {
+    const Chunk& chunk = chunks[c];
+    uint32_t first_cp = map[chunk.begin].first;
+    uint32_t first_gid = map[chunk.begin].second;
+    uint32_t count = static_cast<uint32_t>(chunk.end - chunk.begin);
+    uint32_t last_cp = map[chunk.end - 1].first;
+
+    bool sequential = true;
+    for (size_t i = chunk.begin; i < chunk.end; ++i) {
+      if (map[i].second != first_gid + (i - chunk.begin)) sequential = false;
+    }
+    bool contiguous = last_cp - first_cp + 1 == count;
+
+    BinCmapTable table{};
+    table.data_offset = out.pos() - start;
+    table.range_start = first_cp;
+    table.range_length = static_cast<uint16_t>(last_cp - first_cp + 1);
+    table.glyph_id_start = static_cast<uint16_t>(first_gid);
+
+    if (sequential && contiguous) {
+      table.format_type = kFormat0Tiny;
+    } else {
+      table.format_type = sequential ? kSparseTiny : kSparseFull;
+      table.data_entries_count = static_cast<uint16_t>(count);
+      for (size_t i = chunk.begin; i < chunk.end; ++i) {
+        out.write(static_cast<uint16_t>(map[i].first - first_cp));
+      }
+      if (!sequential) {
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+          out.write(static_cast<uint16_t>(map[i].second - first_gid));
+        }
+      }
+    }
+    out.patch(tables_pos + static_cast<uint32_t>(c * sizeof(BinCmapTable)),
+              table);
+  }
+  out.end_section(start, true);
+}
+
+bool write_kern(Reader& in, Writer& out, const BinHeader& header,
+                const std::vector<uint32_t>& new_ids, uint32_t new_count) {
+  uint8_t format = 0;
+  uint8_t padding[3];
+  if (!in.read(&format) || !in.read(padding, 3)) return false;
+
+  uint32_t start = out.begin_section("kern");
+  out.write(format);
+  out.write(padding, 3);
+
+  auto remap = [&](uint32_t old_id) -> uint32_t {
+    return old_id < new_ids.size() ? new_ids[old_id] : 0;
+  };
+
+  if (format == 0) {
+    uint32_t entries = 0;
+    if (!in.read(&entries)) return false;
+    std::vector<uint32_t> ids(entries * 2);
+    if (header.glyph_id_format == 0) {
+      std::vector<uint8_t> raw;
+      if (!in.read(&raw, entries * 2)) return false;
+      std::copy(raw.begin(), raw.end(), ids.begin());
+    } else {
+      std::vector<uint16_t> raw;
+      if (!in.read(&raw, entries * 2)) return false;
+      std::copy(raw.begin(), raw.end(), ids.begin());
+    }
+    std::vector<int8_t> values;
+    if (!in.read(&values, entries)) return false;
+
+    struct Pair {
+      uint32_t left;
+      uint32_t right;
+      int8_t value;
+    };
+    std::vector<Pair> pairs;
+    for (uint32_t i = 0; i < entries; ++i) {
+      uint32_t left = remap(ids[i * 2]);
+      uint32_t right = remap(ids[i * 2 + 1]);
+      if (left && right) pairs.push_back({left, right, values[i]});
+    }
+    // The loader binary-searches by (left, right).
+    std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) {
+      return a.left != b.left ? a.left < b.left : a.right < b.right;
+    });
+
+    out.write(static_cast<uint32_t>(pairs.size()));
+    for (const Pair& pair : pairs) {
+      if (header.glyph_id_format == 0) {
+        out.write(static_cast<uint8_t>(pair.left));
+        out.write(static_cast<uint8_t>(pair.right));
+      } else {
+        out.write(static_cast<uint16_t>(pair.left));
+        out.write(static_cast<uint16_t>(pair.right));
+      }
+    }
+    for (const Pair& pair : pairs) out.write(pair.value);
+  } else if (format == 3) {
+    uint16_t mapping_length = 0;
+    uint8_t rows = 0;
+    uint8_t cols = 0;
+    std::vector<uint8_t> left;
+    std::vector<uint8_t> right;
+    std::vector<int8_t> values;
+    if (!in.read(&mapping_length) || !in.read(&rows) || !in.read(&cols) ||
+        !in.read(&left, mapping_length) || !in.read(&right, mapping_length) ||
+        !in.read(&values, static_cast<uint32_t>(rows) * cols)) {
+      return false;
+    }
+
+    // Class arrays are indexed by glyph id; the class table is kept whole.
+    std::vector<uint8_t> new_left(new_count, 0);
+    std::vector<uint8_t> new_right(new_count, 0);
+    for (uint32_t old_id = 0; old_id < mapping_length; ++old_id) {
+      uint32_t id = remap(old_id);
+      if (id == 0) continue;
+      new_left[id] = left[old_id];
+      new_right[id] = right[old_id];
+    }
+    out.write(static_cast<uint16_t>(new_count));
+    out.write(rows);
+    out.write(cols);
+    out.write(new_left);
+    out.write(new_right);
+    out.write(values);
+  } else {
+    return false;
+  }
+
+  out.end_section(start, true);
+  return true;
+}
+
+}  // namespace
+
+uint32_t OwnedFont::SubsetInfo::bytes_saved() const {
+  return source_bytes > subset_bytes ? source_bytes - subset_bytes : 0;
+}
+
+std::vector<uint8_t> OwnedFont::subset_bin(const std::string& path,
+                                           std::u32string_view charset,
+                                           SubsetInfo* info) {
+  Reader in(path);
+  if (!in.is_open()) return {};
+
+  // --- head ---
+  uint32_t head_length = in.section(0, "head");
+  if (head_length < kLabelSize + sizeof(BinHeader)) return {};
+  std::vector<uint8_t> head_raw;
+  if (!in.read(&head_raw, head_length - kLabelSize)) return {};
+  BinHeader header;
+  std::memcpy(&header, head_raw.data(), sizeof(header));
+
+  // --- cmap ---
+  uint32_t cmap_start = head_length;
+  uint32_t cmap_length = in.section(cmap_start, "cmap");
+  std::vector<Cmap> cmaps;
+  if (cmap_length == 0 || !read_cmaps(in, cmap_start, &cmaps)) return {};
+
+  // --- loca ---
+  uint32_t loca_start = cmap_start + cmap_length;
+  uint32_t loca_length = in.section(loca_start, "loca");
+  uint32_t loca_count = 0;
+  if (loca_length == 0 || !in.read(&loca_count) || loca_count == 0) return {};
+  std::vector<uint32_t> offsets(loca_count);
+  if (header.index_to_loc_format == 0) {
+    std::vector<uint16_t> raw;
+    if (!in.read(&raw, loca_count)) return {};
+    std::copy(raw.begin(), raw.end(), offsets.begin());
+  } else if (!in.read(offsets.data(), loca_count * sizeof(uint32_t))) {
+    return {};
+  }
+
+  uint32_t glyf_start = loca_start + loca_length;
+  uint32_t glyf_length = in.section(glyf_start, "glyf");
+  if (glyf_length == 0) return {};
+
+  // --- choose glyphs ---
+  std::vector<uint32_t> cps(charset.begin(), charset.end());
+  std::sort(cps.begin(), cps.end());
+  cps.erase(std::unique(cps.begin(), cps.end()), cps.end());
+
+  // Glyph 0 is reserved and always kept. New ids are handed out in code
+  // point order so that runs of characters stay runs of glyphs.
+  std::vector<uint32_t> new_ids(loca_count, 0);
+  std::vector<uint32_t> kept_old{0};
+  std::vector<std::pair<uint32_t, uint32_t>> map;
+  uint32_t missing = 0;
+  for (uint32_t cp : cps) {
+    uint32_t old_id = find_glyph(cmaps, cp);
+    if (old_id == 0 || old_id >= loca_count) {
+      missing++;
+      continue;
+    }
+    if (new_ids[old_id] == 0) {
+      new_ids[old_id] = static_cast<uint32_t>(kept_old.size());
+      kept_old.push_back(old_id);
+    }
+    map.emplace_back(cp, new_ids[old_id]);
+  }
+  uint32_t new_count = static_cast<uint32_t>(kept_old.size());
+
+  // --- write ---
+  Writer out;
+  header.index_to_loc_format = 1;  // Always 32-bit offsets.
+  std::memcpy(head_raw.data(), &header, sizeof(header));
+  uint32_t head = out.begin_section("head");
+  out.write(head_raw);
+  out.end_section(head, false);
+
+  write_cmaps(out, map);
+
+  uint32_t loca = out.begin_section("loca");
+  out.write(new_count);
+  uint32_t loca_table = out.pos();
+  out.bytes().resize(out.bytes().size() + new_count * sizeof(uint32_t));
+  out.end_section(loca, true);
+
+  // Records are copied verbatim. The loader derives a glyph's bitmap size
+  // from the next offset (or the section end), so "glyf" is not padded.
+  uint32_t glyf = out.begin_section("glyf");
+  std::vector<uint8_t> record;
+  for (uint32_t i = 0; i < new_count; ++i) {
+    uint32_t old_id = kept_old[i];
+    uint32_t begin = offsets[old_id];
+    uint32_t end = old_id + 1 < loca_count ? offsets[old_id + 1] : glyf_length;
+    if (end < begin || end > glyf_length) return {};
+    out.patch(loca_table + i * static_cast<uint32_t>(sizeof(uint32_t)),
+              out.pos() - glyf);
+    if (!in.seek(glyf_start + begin) || !in.read(&record, end - begin)) {
+      return {};
+    }
+    out.write(record);
+  }
+  out.end_section(glyf, false);
+
+  if (header.tables_count >= 4) {
+    uint32_t kern_start = glyf_start + glyf_length;
+    if (in.section(kern_start, "kern") == 0 ||
+        !write_kern(in, out, header, new_ids, new_count)) {
+      return {};
+    }
+  }
+
+  if (info) {
+    info->glyphs_total = loca_count;
+    info->glyphs_kept = new_count;
+    info->missing = missing;
+    info->source_bytes = in.size();
+    info->subset_bytes = out.pos();
+  }
+  return std::move(out.bytes());
+}
+
+OwnedFont OwnedFont::load_bin_subset(const std::string& path,
+                                     std::u32string_view charset,
+                                     SubsetInfo* info) {
+#if LV_USE_FS_MEMFS
+  std::vector<uint8_t> data = subset_bin(path, charset, info);
+  if (data.empty()) return OwnedFont();
+  // The loader copies everything it needs, so the buffer can go afterwards.
+  lv_font_t* f = lv_binfont_create_from_buffer(
+      data.data(), static_cast<uint32_t>(data.size()));
+  return OwnedFont(f, FontType::Binary);
+#else
+  (void)path;
+  (void)charset;
+  (void)info;
+  return OwnedFont();
+#endif
+}
+
+}  // namespace lvgl
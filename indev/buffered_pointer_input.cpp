@@ -0,0 +1,62 @@
+#include "buffered_pointer_input.h"
+
+namespace lvgl {
+
+BufferedPointerInput::BufferedPointerInput(size_t capacity)
+    : queue_(capacity), device_(PointerInput::create()) {
+  device_.set_read_cb([this](IndevData& data) { read(data); });
+}
+
+bool BufferedPointerInput::push(const PointerSample& sample) {
+  if (queue_.try_push(sample)) return true;
+  dropped_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+bool BufferedPointerInput::next(PointerSample& sample) {
+  if (has_lookahead_) {
+    sample = lookahead_;
+    has_lookahead_ = false;
+    return true;
+  }
+  return queue_.try_pop(sample);
+}
+
+void BufferedPointerInput::read(IndevData& data) {
+  PointerSample sample;
+  if (!next(sample)) {
+    // Nothing new: repeat the last state, as a polled driver would.
+    data.set_point(last_.x, last_.y)
+        .set_state(last_.pressed ? IndevState::Pressed : IndevState::Released)
+        .set_continue_reading(false);
+    reads_in_pass_ = 0;
+    return;
+  }
+  // An edge is delivered as is; a run of moves collapses onto its last
+  // sample, stopping before the next edge.
+  if (coalesce_ && sample.pressed == last_.pressed) {
+    PointerSample following;
+    while (next(following)) {
+      if (following.pressed != sample.pressed) {
+        lookahead_ = following;
+        has_lookahead_ = true;
+        break;
+      }
+      sample = following;
+      ++coalesced_;
+    }
+  }
+  last_ = sample;
+  ++delivered_;
+  // Bound one lv_indev_read() so a producer outpacing LVGL cannot hold it
+  // in the loop; the rest waits for the next read.
+  bool more = has_lookahead_ || queue_.size_approx() > 0;
+  if (more && ++reads_in_pass_ >= queue_.capacity()) more = false;
+  if (!more) reads_in_pass_ = 0;
+  data.set_point(sample.x, sample.y)
+      .set_state(sample.pressed ? IndevState::Pressed : IndevState::Released)
+      .set_timestamp(sample.timestamp)
+      .set_continue_reading(more);
+}
+
+}  // namespace lvgl
@@ -0,0 +1,113 @@
+#ifndef LVGL_CPP_INDEV_BUFFERED_POINTER_INPUT_H_
+#define LVGL_CPP_INDEV_BUFFERED_POINTER_INPUT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "../misc/lockfree_queue.h"
+#include "lvgl.h"  // IWYU pragma: export
+#include "pointer_input.h"
+
+/**
+ * @file buffered_pointer_input.h
+ * @brief User Guide:
+ * `BufferedPointerInput` is a pointer device fed by a driver instead of
+ * polled. A touch controller interrupt or driver thread pushes timestamped
+ * samples as they arrive. LVGL then processes every queued sample, in
+ * order, on its next indev read rather than only the latest one.
+ *
+ * Key Features:
+ * - **No lost edges**: Each read delivers one sample and asks LVGL to read
+ *   again (`continue_reading`) until the queue is empty, so a tap shorter
+ *   than the indev period still produces PRESSED and RELEASED.
+ * - **Lock-free producer**: `push()` never locks or allocates and may be
+ *   called from any thread.
+ * - **Move coalescing**: Optionally, runs of samples that only move the
+ *   pointer are reduced to their last sample. Press and release samples
+ *   are never coalesced.
+ *
+ * Example:
+ * @code
+ * static lvgl::BufferedPointerInput touch(512);
+ * touch.set_coalesce_moves(true);
+ * // In the touch controller's interrupt or thread:
+ * touch.push(x, y, pressed);
+ * @endcode
+ *
+ * If the queue fills up (LVGL stalled), further samples are refused and
+ * counted by get_dropped().
+ */
+namespace lvgl {
+
+/**
+ * @brief One pointer reading from the driver.
+ */
+struct PointerSample {
+  int32_t x;
+  int32_t y;
+  uint32_t timestamp;  ///< lv_tick_get() time of the reading.
+  bool pressed;
+};
+
+class BufferedPointerInput {
+ public:
+  /**
+   * @brief Create the LVGL pointer device. LVGL thread only.
+   * @param capacity Samples held before push() refuses more.
+   */
+  explicit BufferedPointerInput(size_t capacity = 256);
+
+  BufferedPointerInput(const BufferedPointerInput&) = delete;
+  BufferedPointerInput& operator=(const BufferedPointerInput&) = delete;
+
+  /**
+   * @brief Queue a sample. Safe from any thread.
+   * @return false if the queue was full and the sample was dropped.
+   */
+  bool push(const PointerSample& sample);
+
+  /**
+   * @brief Queue a sample stamped with the current tick.
+   */
+  bool push(int32_t x, int32_t y, bool pressed) {
+    return push(PointerSample{x, y, lv_tick_get(), pressed});
+  }
+
+  /**
+   * @brief Deliver only the last of consecutive samples that keep the same
+   * pressed state. Off by default.
+   */
+  void set_coalesce_moves(bool coalesce) { coalesce_ = coalesce; }
+
+  PointerInput& device() { return device_; }
+
+  /** @brief Samples refused because the queue was full. */
+  uint64_t get_dropped() const { return dropped_.load(); }
+
+  /** @brief Samples handed to LVGL. */
+  uint64_t get_delivered() const { return delivered_; }
+
+  /** @brief Move samples skipped by coalescing. */
+  uint64_t get_coalesced() const { return coalesced_; }
+
+ private:
+  bool next(PointerSample& sample);
+  void read(IndevData& data);
+
+  LockFreeQueue<PointerSample> queue_;
+  PointerInput device_;
+  std::atomic<uint64_t> dropped_{0};
+  // LVGL thread only.
+  PointerSample last_{0, 0, 0, false};
+  PointerSample lookahead_{0, 0, 0, false};
+  bool has_lookahead_ = false;
+  bool coalesce_ = false;
+  uint32_t reads_in_pass_ = 0;
+  uint64_t delivered_ = 0;
+  uint64_t coalesced_ = 0;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_INDEV_BUFFERED_POINTER_INPUT_H_
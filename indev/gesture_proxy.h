@@ -30,17 +30,12 @@ class GestureProxy {
    */
   struct Config {
     InputDevice* indev;
-    Config& min_velocity(uint16_t v) {
-      // Note: LVGL 9 handles this via indev config if available,
-      // or it might be a global/style setting.
-      // In LVGL 9.1+, it's often part of the indev itself.
-      return *this;
-    }
-    Config& limit(uint16_t dist) {
-      // lv_indev_set_scroll_limit(indev->raw(), dist); // Closest equivalent if
-      // applicable
-      return *this;
-    }
+
+    /** @brief Minimum swipe speed, in pixels per read. */
+    Config& min_velocity(uint16_t v);
+
+    /** @brief Minimum swipe distance, in pixels. */
+    Config& limit(uint16_t dist);
   };
 
   Config config() { return {indev_}; }
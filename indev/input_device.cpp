@@ -1,6 +1,9 @@
 #include "input_device.h"
 
+#include <algorithm>
+
 #include "../core/group.h"
+#include "../misc/latency_probe.h"
 #include "gesture_event.h"
 #include "gesture_proxy.h"
 
@@ -36,9 +39,11 @@ InputDevice::~InputDevice() {
 InputDevice::InputDevice(InputDevice&& other) noexcept
     : indev_(other.indev_),
       owned_(other.owned_),
-      read_cb_(std::move(other.read_cb_)) {
+      read_cb_(std::move(other.read_cb_)),
+      latency_probe_(other.latency_probe_) {
   other.indev_ = nullptr;
   other.owned_ = false;
+  other.latency_probe_ = nullptr;
   // Update user data to point to the new address if we are the owner / handler
   if (indev_) {
     lv_indev_set_user_data(indev_, this);
@@ -53,8 +58,10 @@ InputDevice& InputDevice::operator=(InputDevice&& other) noexcept {
     indev_ = other.indev_;
     owned_ = other.owned_;
     read_cb_ = std::move(other.read_cb_);
+    latency_probe_ = other.latency_probe_;
     other.indev_ = nullptr;
     other.owned_ = false;
+    other.latency_probe_ = nullptr;
     if (indev_) {
       lv_indev_set_user_data(indev_, this);
     }
@@ -93,6 +100,7 @@ void InputDevice::set_read_cb(std::function<void(IndevData&)> cb) {
 }
 
 void InputDevice::process_read(lv_indev_data_t* data) {
+  if (latency_probe_) latency_probe_->on_sample(*this);
   if (read_cb_) {
     IndevData wrapped(data);
     read_cb_(wrapped);
@@ -316,4 +324,20 @@ GestureProxy& GestureProxy::on_gesture(std::function<void(GestureEvent)> cb) {
   return *this;
 }
 
+GestureProxy::Config& GestureProxy::Config::min_velocity(uint16_t v) {
+  if (indev) {
+    indev->set_gesture_min_velocity(
+        static_cast<uint8_t>(std::min<uint16_t>(v, UINT8_MAX)));
+  }
+  return *this;
+}
+
+GestureProxy::Config& GestureProxy::Config::limit(uint16_t dist) {
+  if (indev) {
+    indev->set_gesture_min_distance(
+        static_cast<uint8_t>(std::min<uint16_t>(dist, UINT8_MAX)));
+  }
+  return *this;
+}
+
 }  // namespace lvgl
@@ -27,6 +27,7 @@
 namespace lvgl {
 
 class IndevData;
+class LatencyProbe;
 
 /**
  * @brief Wrapper for LVGL input devices.
@@ -286,6 +287,13 @@ class InputDevice {
   /** @brief Get underlying LVGL handle. */
   lv_indev_t* raw() const { return indev_; }
 
+  /**
+   * @brief Report every sample read to `probe` (nullptr to stop). Use
+   * LatencyProbe::attach() rather than calling this directly.
+   */
+  void set_latency_probe(LatencyProbe* probe) { latency_probe_ = probe; }
+  LatencyProbe* get_latency_probe() const { return latency_probe_; }
+
   // Internal callback dispatcher
   void process_read(lv_indev_data_t* data);
 
@@ -293,6 +301,7 @@ class InputDevice {
   lv_indev_t* indev_ = nullptr;
   bool owned_ = false;
   std::function<void(IndevData&)> read_cb_;
+  LatencyProbe* latency_probe_ = nullptr;
   std::vector<std::unique_ptr<EventCallbackData>> event_callbacks_;
 };
 
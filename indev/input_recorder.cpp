@@ -0,0 +1,302 @@
+#include "input_recorder.h"
+
+#include <chrono>
+#include <cstdio>
+
+#include "../display/display.h"
+#include "../misc/file_system.h"
+
+namespace lvgl {
+
+namespace {
+
+// File layout: magic, version, record count, then per record a flags byte
+// followed by the fields it marks as changed, all as LEB128 varints.
+// Coordinates and encoder steps are zigzag-encoded deltas.
+constexpr uint8_t kMagic[4] = {'L', 'V', 'I', 'R'};
+constexpr uint8_t kVersion = 1;
+
+enum RecordFlags : uint8_t {
+  kPressed = 1 << 0,
+  kHasX = 1 << 1,
+  kHasY = 1 << 2,
+  kHasKey = 1 << 3,
+  kHasEnc = 1 << 4,
+};
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t now_us() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          Clock::now().time_since_epoch())
+          .count());
+}
+
+void put_varint(std::vector<uint8_t>& out, uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t zigzag(int32_t value) {
+  return (static_cast<uint32_t>(value) << 1) ^
+         static_cast<uint32_t>(value >> 31);
+}
+
+int32_t unzigzag(uint32_t value) {
+  return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+class Reader {
+ public:
+  explicit Reader(const std::vector<uint8_t>& bytes) : bytes_(bytes) {}
+
+  bool byte(uint8_t& out) {
+    if (pos_ >= bytes_.size()) return false;
+    out = bytes_[pos_++];
+    return true;
+  }
+
+  bool varint(uint32_t& out) {
+    out = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t b;
+      if (!byte(b)) return false;
+      out |= static_cast<uint32_t>(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+
+  bool at_end() const { return pos_ == bytes_.size(); }
+
+ private:
+  const std::vector<uint8_t>& bytes_;
+  size_t pos_ = 0;
+};
+
+InputRecord from_data(const IndevData& data) {
+  InputRecord record;
+  lv_point_t point = data.get_point();
+  record.x = point.x;
+  record.y = point.y;
+  // lvgl::Key only names control keys; keypads also send characters.
+  record.key = data.raw()->key;
+  record.enc_diff = data.get_enc_diff();
+  record.state = data.get_state();
+  return record;
+}
+
+}  // namespace
+
+std::function<void(IndevData&)> InputRecorder::wrap(
+    std::function<void(IndevData&)> read) {
+  return [this, read = std::move(read)](IndevData& data) {
+    if (read) read(data);
+    if (recording_) record(data);
+  };
+}
+
+void InputRecorder::start() {
+  records_.clear();
+  start_tick_ = lv_tick_get();
+  recording_ = true;
+}
+
+void InputRecorder::record(const IndevData& data) {
+  InputRecord record = from_data(data);
+  record.tick = lv_tick_elaps(start_tick_);
+  if (!records_.empty()) {
+    InputRecord previous = records_.back();
+    previous.tick = record.tick;
+    // Encoder steps are relative, so every non-zero step is an event.
+    if (previous == record && record.enc_diff == 0) return;
+  }
+  records_.push_back(record);
+}
+
+std::vector<uint8_t> InputRecorder::encode(
+    const std::vector<InputRecord>& records) {
+  std::vector<uint8_t> out(std::begin(kMagic), std::end(kMagic));
+  out.push_back(kVersion);
+  put_varint(out, static_cast<uint32_t>(records.size()));
+  InputRecord previous;
+  for (const InputRecord& record : records) {
+    uint8_t flags = record.state == IndevState::Pressed ? kPressed : 0;
+    if (record.x != previous.x) flags |= kHasX;
+    if (record.y != previous.y) flags |= kHasY;
+    if (record.key != previous.key) flags |= kHasKey;
+    if (record.enc_diff != 0) flags |= kHasEnc;
+    out.push_back(flags);
+    put_varint(out, record.tick - previous.tick);
+    if (flags & kHasX) put_varint(out, zigzag(record.x - previous.x));
+    if (flags & kHasY) put_varint(out, zigzag(record.y - previous.y));
+    if (flags & kHasKey) put_varint(out, record.key);
+    if (flags & kHasEnc) put_varint(out, zigzag(record.enc_diff));
+    previous = record;
+  }
+  return out;
+}
+
+FsRes InputRecorder::save(const std::string& path) const {
+  std::vector<uint8_t> bytes = encode();
+  File file;
+  FsRes res = file.open(path, FsMode::Write);
+  if (res != FsRes::Ok) return res;
+  uint32_t written = 0;
+  res = file.write(bytes.data(), static_cast<uint32_t>(bytes.size()),
+                   &written);
+  if (res == FsRes::Ok && written != bytes.size()) res = FsRes::Full;
+  return res;
+}
+
+std::string ReplayReport::to_string() const {
+  char text[256];
+  snprintf(text, sizeof(text),
+           "samples %u, virtual %u ms, wall %llu us (%.1fx), frames %u/%u, "
+           "frame time mean %llu us, p95 %llu us, max %llu us",
+           static_cast<unsigned>(samples), static_cast<unsigned>(virtual_ms),
+           static_cast<unsigned long long>(wall_us),
+           wall_us ? virtual_ms * 1000.0 / wall_us : 0.0,
+           static_cast<unsigned>(frames), static_cast<unsigned>(refreshes),
+           static_cast<unsigned long long>(frame_time.get_mean_us()),
+           static_cast<unsigned long long>(frame_time.get_percentile_us(95)),
+           static_cast<unsigned long long>(frame_time.max_us));
+  return text;
+}
+
+bool InputReplayer::decode(const std::vector<uint8_t>& bytes,
+                           std::vector<InputRecord>& records) {
+  Reader reader(bytes);
+  for (uint8_t expected : kMagic) {
+    uint8_t b;
+    if (!reader.byte(b) || b != expected) return false;
+  }
+  uint8_t version;
+  uint32_t count;
+  if (!reader.byte(version) || version != kVersion) return false;
+  if (!reader.varint(count)) return false;
+  // Every record takes at least two bytes (flags and tick delta), so a
+  // larger count is corrupt; checking first keeps reserve() bounded.
+  if (count > bytes.size() / 2) return false;
+  std::vector<InputRecord> decoded;
+  decoded.reserve(count);
+  InputRecord previous;
+  for (uint32_t i = 0; i < count; ++i) {
+    uint8_t flags;
+    uint32_t value;
+    InputRecord record = previous;
+    record.enc_diff = 0;
+    if (!reader.byte(flags) || !reader.varint(value)) return false;
+    record.tick = previous.tick + value;
+    record.state =
+        (flags & kPressed) ? IndevState::Pressed : IndevState::Released;
+    if (flags & kHasX) {
+      if (!reader.varint(value)) return false;
+      record.x = previous.x + unzigzag(value);
+    }
+    if (flags & kHasY) {
+      if (!reader.varint(value)) return false;
+      record.y = previous.y + unzigzag(value);
+    }
+    if (flags & kHasKey) {
+      if (!reader.varint(record.key)) return false;
+    }
+    if (flags & kHasEnc) {
+      if (!reader.varint(value)) return false;
+      record.enc_diff = static_cast<int16_t>(unzigzag(value));
+    }
+    decoded.push_back(record);
+    previous = record;
+  }
+  if (!reader.at_end()) return false;
+  records = std::move(decoded);
+  return true;
+}
+
+bool InputReplayer::load(const std::string& path) {
+  std::vector<uint8_t> bytes = File::load_to_buffer(path);
+  std::vector<InputRecord> records;
+  if (!decode(bytes, records)) return false;
+  records_ = std::move(records);
+  next_ = 0;
+  return true;
+}
+
+void InputReplayer::attach(InputDevice& device) {
+  device.set_read_cb([this](IndevData& data) { read(data); });
+}
+
+void InputReplayer::read(IndevData& data) {
+  // Outside run() the device holds the last replayed state.
+  uint32_t now = report_ ? lv_tick_elaps(start_tick_) : 0;
+  bool due = report_ && next_ < records_.size() && records_[next_].tick <= now;
+  if (due) {
+    current_ = records_[next_++];
+    if (report_) ++report_->samples;
+  }
+  data.set_point(current_.x, current_.y)
+      .set_state(current_.state)
+      .set_enc_diff(due ? current_.enc_diff : 0)
+      .set_continue_reading(due && next_ < records_.size() &&
+                            records_[next_].tick <= now);
+  data.raw()->key = current_.key;
+}
+
+ReplayReport InputReplayer::run(Display* display, uint32_t frame_period,
+                                uint32_t tail_ms) {
+  ReplayReport report;
+  lv_display_t* disp = display ? display->raw() : lv_display_get_default();
+  if (disp) {
+    for (lv_event_code_t code :
+         {LV_EVENT_REFR_START, LV_EVENT_FLUSH_START, LV_EVENT_REFR_READY}) {
+      lv_display_add_event_cb(disp, display_event_cb, code, this);
+    }
+  }
+  report_ = &report;
+  next_ = 0;
+  current_ = InputRecord();
+  start_tick_ = lv_tick_get();
+  uint32_t end = (records_.empty() ? 0 : records_.back().tick) + tail_ms;
+  uint64_t wall_start = now_us();
+  frame_period = frame_period ? frame_period : 1;
+  while (report.virtual_ms < end) {
+    lv_tick_inc(frame_period);
+    report.virtual_ms += frame_period;
+    lv_timer_handler();
+  }
+  report.wall_us = now_us() - wall_start;
+  report_ = nullptr;
+  if (disp) {
+    lv_display_remove_event_cb_with_user_data(disp, display_event_cb, this);
+  }
+  return report;
+}
+
+void InputReplayer::display_event_cb(lv_event_t* e) {
+  auto* self = static_cast<InputReplayer*>(lv_event_get_user_data(e));
+  if (!self->report_) return;
+  switch (lv_event_get_code(e)) {
+    case LV_EVENT_REFR_START:
+      self->refresh_start_us_ = now_us();
+      self->flushed_ = false;
+      break;
+    case LV_EVENT_FLUSH_START:
+      self->flushed_ = true;
+      break;
+    case LV_EVENT_REFR_READY:
+      ++self->report_->refreshes;
+      if (self->flushed_) {
+        ++self->report_->frames;
+        self->report_->frame_time.add(now_us() - self->refresh_start_us_);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace lvgl
@@ -0,0 +1,169 @@
+#ifndef LVGL_CPP_INDEV_INPUT_RECORDER_H_
+#define LVGL_CPP_INDEV_INPUT_RECORDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../misc/enums.h"
+#include "../misc/latency_probe.h"
+#include "input_device.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file input_recorder.h
+ * @brief User Guide:
+ * `InputRecorder` captures what an input device reads, and `InputReplayer`
+ * feeds it back later, for repeatable interaction benchmarks such as
+ * scrolling a list or dragging a slider.
+ *
+ * Key Features:
+ * - **Compact files**: Only reads that differ from the previous one are
+ *   kept, stored as varint deltas (a few bytes per sample).
+ * - **Virtual time**: `InputReplayer::run()` advances the LVGL tick itself
+ *   and never sleeps, so a 60 second session replays as fast as LVGL can
+ *   render it, with the same result every time.
+ * - **No lost edges**: Samples that fall between two indev reads are all
+ *   delivered, in order, via `continue_reading`.
+ * - **Perf report**: A replay reports frames rendered and a histogram of
+ *   refresh times.
+ *
+ * Example:
+ * @code
+ * lvgl::InputRecorder recorder;
+ * touch.set_read_cb(recorder.wrap(read_touch_controller));
+ * recorder.start();
+ * // ... interact, then:
+ * recorder.save("A:session.lvir");
+ *
+ * lvgl::InputReplayer replayer;
+ * replayer.load("A:session.lvir");
+ * replayer.attach(touch);
+ * lvgl::ReplayReport report = replayer.run();
+ * puts(report.to_string().c_str());
+ * @endcode
+ *
+ * Replay drives time with `lv_tick_inc()`, so no tick callback may be set
+ * with `lv_tick_set_cb()` while it runs.
+ */
+namespace lvgl {
+
+class Display;
+
+/**
+ * @brief One recorded read. `tick` is relative to the start of recording.
+ */
+struct InputRecord {
+  uint32_t tick = 0;
+  int32_t x = 0;
+  int32_t y = 0;
+  uint32_t key = 0;
+  int16_t enc_diff = 0;
+  IndevState state = IndevState::Released;
+
+  bool operator==(const InputRecord& other) const = default;
+};
+
+class InputRecorder {
+ public:
+  /**
+   * @brief Wrap a read callback so that its results are recorded while
+   * recording is on.
+   */
+  std::function<void(IndevData&)> wrap(std::function<void(IndevData&)> read);
+
+  /** @brief Clear previous records and start recording. */
+  void start();
+  void stop() { recording_ = false; }
+  bool is_recording() const { return recording_; }
+
+  const std::vector<InputRecord>& get_records() const { return records_; }
+
+  /** @brief Serialize the records to the binary file format. */
+  std::vector<uint8_t> encode() const { return encode(records_); }
+  static std::vector<uint8_t> encode(const std::vector<InputRecord>& records);
+
+  /** @brief Write encode() to `path` through the LVGL file system. */
+  FsRes save(const std::string& path) const;
+
+ private:
+  void record(const IndevData& data);
+
+  std::vector<InputRecord> records_;
+  uint32_t start_tick_ = 0;
+  bool recording_ = false;
+};
+
+/**
+ * @brief Results of InputReplayer::run(). Times are wall-clock
+ * microseconds.
+ */
+struct ReplayReport {
+  uint32_t samples = 0;       ///< Records delivered to the device.
+  uint32_t virtual_ms = 0;    ///< LVGL ticks replayed.
+  uint64_t wall_us = 0;       ///< Real time the replay took.
+  uint32_t refreshes = 0;     ///< Display refresh cycles.
+  uint32_t frames = 0;        ///< Refreshes that flushed pixels.
+  LatencyStats frame_time;    ///< Refresh time of the flushed frames.
+
+  std::string to_string() const;
+};
+
+class InputReplayer {
+ public:
+  InputReplayer() = default;
+  explicit InputReplayer(std::vector<InputRecord> records)
+      : records_(std::move(records)) {}
+
+  InputReplayer(const InputReplayer&) = delete;
+  InputReplayer& operator=(const InputReplayer&) = delete;
+
+  /**
+   * @brief Parse the binary file format.
+   * @return false if `bytes` is not a valid recording.
+   */
+  static bool decode(const std::vector<uint8_t>& bytes,
+                     std::vector<InputRecord>& records);
+
+  /** @brief Load a recording through the LVGL file system. */
+  bool load(const std::string& path);
+
+  /**
+   * @brief Make `device` read from the recording. Replaces its read
+   * callback, which then refers to this replayer. Outside run() the device
+   * reports the last replayed state.
+   */
+  void attach(InputDevice& device);
+
+  /**
+   * @brief Replay from the first record, rendering every `frame_period` ms
+   * of virtual time until `tail_ms` after the last record.
+   */
+  ReplayReport run(Display* display = nullptr,
+                   uint32_t frame_period = LV_DEF_REFR_PERIOD,
+                   uint32_t tail_ms = 500);
+
+  /** @brief True once every record has been delivered. */
+  bool is_done() const { return next_ >= records_.size(); }
+
+  const std::vector<InputRecord>& get_records() const { return records_; }
+
+ private:
+  void read(IndevData& data);
+  static void display_event_cb(lv_event_t* e);
+
+  std::vector<InputRecord> records_;
+  size_t next_ = 0;
+  InputRecord current_;
+  uint32_t start_tick_ = 0;
+  ReplayReport* report_ = nullptr;  // Set while run() is active.
+  uint64_t refresh_start_us_ = 0;
+  bool flushed_ = false;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_INDEV_INPUT_RECORDER_H_
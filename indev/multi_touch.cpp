@@ -0,0 +1,217 @@
+#include "multi_touch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../core/object.h"
+#include "../display/display.h"
+
+namespace lvgl {
+
+namespace {
+
+constexpr float kRadToDeg = 57.2957795f;
+
+// Keeps an angle difference in (-180, 180] so crossing the atan2 seam is
+// not read as a full turn.
+float wrap_degrees(float degrees) {
+  while (degrees > 180.0f) degrees -= 360.0f;
+  while (degrees <= -180.0f) degrees += 360.0f;
+  return degrees;
+}
+
+}  // namespace
+
+MultiTouchRecognizer::MultiTouchRecognizer(Display* display)
+    : display_(display ? display->raw() : lv_display_get_default()) {}
+
+EventCode MultiTouchRecognizer::get_event_code() {
+  static const uint32_t code = lv_event_register_id();
+  return static_cast<EventCode>(code);
+}
+
+MultiTouchRecognizer& MultiTouchRecognizer::set_config(
+    const MultiTouchConfig& config) {
+  config_ = config;
+  config_.velocity_smoothing =
+      std::clamp(config_.velocity_smoothing, 0.01f, 1.0f);
+  return *this;
+}
+
+MultiTouchRecognizer& MultiTouchRecognizer::set_target(Object* target) {
+  fixed_target_ = target ? target->raw() : nullptr;
+  return *this;
+}
+
+MultiTouchRecognizer& MultiTouchRecognizer::on_gesture(
+    std::function<void(const MultiTouchGesture&)> cb) {
+  callback_ = std::move(cb);
+  return *this;
+}
+
+void MultiTouchRecognizer::update(std::span<const TouchContact> contacts,
+                                  uint32_t timestamp) {
+  contacts = contacts.first(std::min(contacts.size(), kMaxContacts));
+  if (contacts.size() < 2) {
+    gesture_.contacts = static_cast<uint8_t>(contacts.size());
+    if (tracking_) end();
+  } else if (!tracking_) {
+    begin(contacts);
+  } else {
+    track(contacts, timestamp);
+  }
+  std::copy(contacts.begin(), contacts.end(), previous_.begin());
+  previous_count_ = contacts.size();
+  last_timestamp_ = timestamp;
+}
+
+void MultiTouchRecognizer::cancel() {
+  tracking_ = false;
+  recognized_ = false;
+  previous_count_ = 0;
+}
+
+void MultiTouchRecognizer::begin(std::span<const TouchContact> contacts) {
+  float x = 0;
+  float y = 0;
+  for (const TouchContact& c : contacts) {
+    x += c.x;
+    y += c.y;
+  }
+  gesture_ = MultiTouchGesture();
+  gesture_.contacts = static_cast<uint8_t>(contacts.size());
+  gesture_.centroid_x = x / contacts.size();
+  gesture_.centroid_y = y / contacts.size();
+  gesture_.target = fixed_target_;
+  if (!gesture_.target && display_) {
+    lv_point_t point = {static_cast<int32_t>(gesture_.centroid_x),
+                        static_cast<int32_t>(gesture_.centroid_y)};
+    gesture_.target =
+        lv_indev_search_obj(lv_display_get_screen_active(display_), &point);
+  }
+  tracking_ = true;
+  recognized_ = false;
+}
+
+void MultiTouchRecognizer::track(std::span<const TouchContact> contacts,
+                                 uint32_t timestamp) {
+  // Pair contacts with the previous frame by id. Only fingers present in
+  // both frames contribute, so one joining or lifting moves nothing.
+  std::array<const TouchContact*, kMaxContacts> prev{};
+  std::array<const TouchContact*, kMaxContacts> curr{};
+  size_t matched = 0;
+  float prev_x = 0;
+  float prev_y = 0;
+  float curr_x = 0;
+  float curr_y = 0;
+  float all_x = 0;
+  float all_y = 0;
+  for (const TouchContact& c : contacts) {
+    all_x += c.x;
+    all_y += c.y;
+    for (size_t i = 0; i < previous_count_; ++i) {
+      if (previous_[i].id != c.id) continue;
+      prev[matched] = &previous_[i];
+      curr[matched] = &c;
+      prev_x += previous_[i].x;
+      prev_y += previous_[i].y;
+      curr_x += c.x;
+      curr_y += c.y;
+      ++matched;
+      break;
+    }
+  }
+  gesture_.contacts = static_cast<uint8_t>(contacts.size());
+  gesture_.centroid_x = all_x / contacts.size();
+  gesture_.centroid_y = all_y / contacts.size();
+
+  float d_scale = 0;
+  float d_rotation = 0;
+  float d_x = 0;
+  float d_y = 0;
+  if (matched >= 2) {
+    prev_x /= matched;
+    prev_y /= matched;
+    curr_x /= matched;
+    curr_y /= matched;
+    d_x = curr_x - prev_x;
+    d_y = curr_y - prev_y;
+    float prev_spread = 0;
+    float curr_spread = 0;
+    float turn = 0;
+    for (size_t i = 0; i < matched; ++i) {
+      float px = prev[i]->x - prev_x;
+      float py = prev[i]->y - prev_y;
+      float cx = curr[i]->x - curr_x;
+      float cy = curr[i]->y - curr_y;
+      float radius = std::hypot(px, py);
+      prev_spread += radius;
+      curr_spread += std::hypot(cx, cy);
+      // Fingers far from the centroid give the steadier angle.
+      turn += radius *
+              wrap_degrees((std::atan2(cy, cx) - std::atan2(py, px)) *
+                           kRadToDeg);
+    }
+    if (prev_spread > 0) {
+      float scale = gesture_.scale * curr_spread / prev_spread;
+      d_scale = scale - gesture_.scale;
+      gesture_.scale = scale;
+      d_rotation = turn / prev_spread;
+      gesture_.rotation += d_rotation;
+    }
+    gesture_.pan_x += d_x;
+    gesture_.pan_y += d_y;
+  }
+
+  uint32_t dt = timestamp - last_timestamp_;
+  if (dt > 0) {
+    float a = config_.velocity_smoothing;
+    float per_second = 1000.0f / dt;
+    gesture_.scale_velocity +=
+        a * (d_scale * per_second - gesture_.scale_velocity);
+    gesture_.rotation_velocity +=
+        a * (d_rotation * per_second - gesture_.rotation_velocity);
+    gesture_.pan_velocity_x +=
+        a * (d_x * per_second - gesture_.pan_velocity_x);
+    gesture_.pan_velocity_y +=
+        a * (d_y * per_second - gesture_.pan_velocity_y);
+  }
+
+  if (std::fabs(gesture_.scale - 1.0f) >= config_.pinch_threshold) {
+    gesture_.pinch = true;
+  }
+  if (std::fabs(gesture_.rotation) >= config_.rotate_threshold) {
+    gesture_.rotate = true;
+  }
+  if (std::hypot(gesture_.pan_x, gesture_.pan_y) >= config_.pan_threshold) {
+    gesture_.pan = true;
+  }
+  if (recognized_) {
+    emit(MultiTouchPhase::Changed);
+  } else if (gesture_.pinch || gesture_.rotate || gesture_.pan) {
+    recognized_ = true;
+    emit(MultiTouchPhase::Began);
+  }
+}
+
+void MultiTouchRecognizer::end() {
+  bool recognized = recognized_;
+  tracking_ = false;
+  recognized_ = false;
+  if (recognized) emit(MultiTouchPhase::Ended);
+}
+
+void MultiTouchRecognizer::emit(MultiTouchPhase phase) {
+  gesture_.phase = phase;
+  if (gesture_.target && !lv_obj_is_valid(gesture_.target)) {
+    gesture_.target = nullptr;
+  }
+  if (gesture_.target) {
+    lv_obj_send_event(gesture_.target,
+                      static_cast<lv_event_code_t>(get_event_code()),
+                      &gesture_);
+  }
+  if (callback_) callback_(gesture_);
+}
+
+}  // namespace lvgl
@@ -0,0 +1,200 @@
+#ifndef LVGL_CPP_INDEV_MULTI_TOUCH_H_
+#define LVGL_CPP_INDEV_MULTI_TOUCH_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "../core/event.h"
+#include "../misc/enums.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file multi_touch.h
+ * @brief User Guide:
+ * `MultiTouchRecognizer` turns frames of touch contacts into pinch, rotate
+ * and two-finger pan gestures. LVGL input devices carry a single point, so
+ * the recognizer is fed directly from a multi-touch controller's read
+ * callback (or any synthetic source).
+ *
+ * Key Features:
+ * - **Transform tracking**: Scale, rotation and centroid translation since
+ *   the gesture started, accumulated frame to frame so fingers may join or
+ *   lift mid-gesture without a jump.
+ * - **Velocity**: Smoothed scale, rotation and pan velocities, still
+ *   available in the `Ended` event for flings.
+ * - **Typed events**: Gestures are sent as `get_event_code()` to the object
+ *   under the starting centroid (or a fixed target) with a
+ *   `MultiTouchGesture` parameter; read them with `MultiTouchEvent`.
+ * - **Allocation-free**: Contacts are kept in fixed arrays; `update()`
+ *   never allocates.
+ *
+ * Example:
+ * @code
+ * lvgl::MultiTouchRecognizer recognizer;
+ * touch.set_read_cb([&](lvgl::IndevData& data) {
+ *   lvgl::TouchContact contacts[5];
+ *   size_t count = read_controller(contacts);
+ *   recognizer.update({contacts, count}, lv_tick_get());
+ *   // Keep LVGL from scrolling while two fingers are down.
+ *   bool single = count == 1 && !recognizer.is_active();
+ *   data.set_point(contacts[0].x, contacts[0].y)
+ *       .set_state(single ? lvgl::IndevState::Pressed
+ *                         : lvgl::IndevState::Released);
+ * });
+ *
+ * image.add_event_cb(lvgl::MultiTouchRecognizer::get_event_code(),
+ *                    [&image](lvgl::Event& e) {
+ *   const lvgl::MultiTouchGesture& g = lvgl::MultiTouchEvent(e).get_gesture();
+ *   image.set_scale(256 * g.scale).set_rotation(10 * g.rotation);
+ * });
+ * @endcode
+ */
+namespace lvgl {
+
+class Display;
+class Object;
+
+/**
+ * @brief One finger in a touch frame. `id` must stay the same while the
+ * finger is down.
+ */
+struct TouchContact {
+  int32_t id = 0;
+  int32_t x = 0;
+  int32_t y = 0;
+};
+
+enum class MultiTouchPhase : uint8_t {
+  Began,    ///< First frame in which a gesture was recognized.
+  Changed,  ///< Contacts moved.
+  Ended,    ///< Fewer than two contacts remain.
+};
+
+/**
+ * @brief State of a multi-touch gesture. Transforms are relative to the
+ * frame in which two contacts first touched.
+ */
+struct MultiTouchGesture {
+  MultiTouchPhase phase = MultiTouchPhase::Began;
+  uint8_t contacts = 0;  ///< Contacts down (0 or 1 when Ended).
+  bool pinch = false;    ///< Scale passed the pinch threshold.
+  bool rotate = false;   ///< Rotation passed the rotate threshold.
+  bool pan = false;      ///< Translation passed the pan threshold.
+  lv_obj_t* target = nullptr;
+
+  float centroid_x = 0;
+  float centroid_y = 0;
+  float scale = 1;     ///< Finger spread relative to the start.
+  float rotation = 0;  ///< Degrees, clockwise on screen.
+  float pan_x = 0;     ///< Centroid translation in pixels.
+  float pan_y = 0;
+
+  float scale_velocity = 0;     ///< Scale change per second.
+  float rotation_velocity = 0;  ///< Degrees per second.
+  float pan_velocity_x = 0;     ///< Pixels per second.
+  float pan_velocity_y = 0;
+};
+
+/**
+ * @brief Recognition thresholds.
+ */
+struct MultiTouchConfig {
+  float pinch_threshold = 0.08f;   ///< Relative scale change, e.g. 8 %.
+  float rotate_threshold = 10.0f;  ///< Degrees.
+  float pan_threshold = 12.0f;     ///< Pixels.
+  /** Weight of the newest frame in the velocity estimate (0..1]. */
+  float velocity_smoothing = 0.5f;
+};
+
+class MultiTouchRecognizer {
+ public:
+  /** Contacts beyond this many are ignored. */
+  static constexpr size_t kMaxContacts = 10;
+
+  /**
+   * @brief Create on the LVGL thread. Targets are hit-tested on the active
+   * screen of `display` (default: the default display).
+   */
+  explicit MultiTouchRecognizer(Display* display = nullptr);
+
+  MultiTouchRecognizer(const MultiTouchRecognizer&) = delete;
+  MultiTouchRecognizer& operator=(const MultiTouchRecognizer&) = delete;
+
+  /**
+   * @brief The event code gestures are sent with, registered with LVGL on
+   * first use. The event parameter is a `const MultiTouchGesture*`.
+   */
+  static EventCode get_event_code();
+
+  MultiTouchRecognizer& set_config(const MultiTouchConfig& config);
+  const MultiTouchConfig& get_config() const { return config_; }
+
+  /**
+   * @brief Send gestures to `target` instead of hit-testing. Pass nullptr to
+   * hit-test again.
+   */
+  MultiTouchRecognizer& set_target(Object* target);
+
+  /**
+   * @brief Also call `cb` for every gesture event.
+   */
+  MultiTouchRecognizer& on_gesture(
+      std::function<void(const MultiTouchGesture&)> cb);
+
+  /**
+   * @brief Feed the contacts currently down, in any order.
+   * @param contacts Pressed contacts; empty when all fingers lifted.
+   * @param timestamp Time of the frame in ms, e.g. `lv_tick_get()`.
+   */
+  void update(std::span<const TouchContact> contacts, uint32_t timestamp);
+
+  /**
+   * @brief Abandon the current gesture without an Ended event. Contacts
+   * still down start a new one on the next update().
+   */
+  void cancel();
+
+  /** @brief True while a recognized gesture is in progress. */
+  bool is_active() const { return recognized_; }
+
+  /** @brief The latest gesture state. */
+  const MultiTouchGesture& get_gesture() const { return gesture_; }
+
+ private:
+  void track(std::span<const TouchContact> contacts, uint32_t timestamp);
+  void begin(std::span<const TouchContact> contacts);
+  void end();
+  void emit(MultiTouchPhase phase);
+
+  lv_display_t* display_;
+  lv_obj_t* fixed_target_ = nullptr;
+  MultiTouchConfig config_;
+  std::function<void(const MultiTouchGesture&)> callback_;
+
+  std::array<TouchContact, kMaxContacts> previous_{};
+  size_t previous_count_ = 0;
+  uint32_t last_timestamp_ = 0;
+  bool tracking_ = false;    // Two or more contacts are down.
+  bool recognized_ = false;  // A threshold was passed; events are sent.
+  MultiTouchGesture gesture_;
+};
+
+/**
+ * @brief Wrapper for events sent by MultiTouchRecognizer.
+ */
+class MultiTouchEvent : public Event {
+ public:
+  explicit MultiTouchEvent(lv_event_t* event) : Event(event) {}
+  explicit MultiTouchEvent(const Event& event) : Event(event.raw()) {}
+
+  const MultiTouchGesture& get_gesture() const {
+    return *static_cast<const MultiTouchGesture*>(get_param());
+  }
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_INDEV_MULTI_TOUCH_H_
@@ -19,6 +19,20 @@ void AnimationHandle::stop() {
   }
 }
 
+bool AnimationHandle::on_finished(std::function<void()> cb) {
+  if (!var_) return false;
+  lv_anim_t* a = lv_anim_get(var_, exec_cb_);
+  if (!a) return false;
+  if (a->deleted_cb != Animation::deleted_cb_proxy) {
+    if (a->deleted_cb || a->user_data) return false;
+    lv_anim_set_user_data(a, new Animation::CallbackData());
+    lv_anim_set_deleted_cb(a, Animation::deleted_cb_proxy);
+  }
+  auto* data = static_cast<Animation::CallbackData*>(a->user_data);
+  data->finished_cbs.push_back(std::move(cb));
+  return true;
+}
+
 Animation::Animation() {
   ptr_ = &anim_;
   lv_anim_init(ptr_);
@@ -52,6 +66,11 @@ Animation& Animation::set_var(const Object& object) {
 }
 
 Animation& Animation::set_exec_cb(lv_anim_exec_xcb_t exec_cb) {
+  // The last exec callback set wins.
+  if (user_data_) {
+    user_data_->exec_cb = nullptr;
+    user_data_->object_exec_cb = nullptr;
+  }
   lv_anim_set_exec_cb(ptr_, exec_cb);
   return *this;
 }
@@ -106,8 +125,11 @@ Animation& Animation::set_playback_delay(uint32_t delay) {
 
 void Animation::exec_cb_proxy(lv_anim_t* a, int32_t v) {
   CallbackData* data = static_cast<CallbackData*>(a->user_data);
-  if (data && data->exec_cb) {
+  if (!data) return;
+  if (data->exec_cb) {
     data->exec_cb(a->var, v);
+  } else if (data->object_exec_cb && data->target && data->target->raw()) {
+    data->object_exec_cb(*data->target, v);
   }
 }
 
@@ -132,32 +154,38 @@ void Animation::deleted_cb_proxy(lv_anim_t* a) {
     if (data->deleted_cb) {
       data->deleted_cb();
     }
+    for (auto& finished : data->finished_cbs) finished();
+    delete data->target;
     delete data;
   }
 }
 
 Animation& Animation::set_exec_cb(ExecCallback cb) {
+  if (const lv_anim_exec_xcb_t* fn = cb.target<lv_anim_exec_xcb_t>()) {
+    return set_exec_cb(*fn);
+  }
   if (!user_data_) user_data_ = std::make_unique<CallbackData>();
   user_data_->exec_cb = std::move(cb);
+  user_data_->object_exec_cb = nullptr;
+  lv_anim_set_exec_cb(ptr_, nullptr);
   // We don't set user_data on anim_ yet, we do it at start() to allow multiple
   // instances
   return *this;
 }
 
 Animation& Animation::set_exec_cb(ObjectExecCallback cb) {
-  // Trampoline to convert void* -> Object&
-  auto trampoline = [cb](void* var, int32_t v) {
-    if (var) {
-      // Safety Note: This assumes var is an lv_obj_t*.
-      // We check for null, but we can't fully verify type at runtime here.
-      Object obj(static_cast<lv_obj_t*>(var), Object::Ownership::Unmanaged);
-      cb(obj, v);
-    }
-  };
-  return set_exec_cb(static_cast<ExecCallback>(trampoline));
+  if (!user_data_) user_data_ = std::make_unique<CallbackData>();
+  user_data_->object_exec_cb = std::move(cb);
+  user_data_->exec_cb = nullptr;
+  lv_anim_set_exec_cb(ptr_, nullptr);
+  return *this;
 }
 
 Animation& Animation::set_path_cb(const PathCallback& cb) {
+  if (const lv_anim_path_cb_t* fn = cb.target<lv_anim_path_cb_t>()) {
+    if (user_data_) user_data_->path_cb = nullptr;
+    return set_path_cb(*fn);
+  }
   if (!user_data_) user_data_ = std::make_unique<CallbackData>();
   user_data_->path_cb = cb;
   return *this;
@@ -241,24 +269,48 @@ Animation& Animation::set_deleted_cb(std::function<void()> cb) {
   return *this;
 }
 
+void Animation::CallbackData::install(const CallbackData& data,
+                                      lv_anim_t* a) {
+  // Each running animation owns a copy, freed by deleted_cb_proxy.
+  CallbackData* runtime_data = new CallbackData(data);
+  lv_anim_set_user_data(a, runtime_data);
+  lv_anim_set_deleted_cb(a, deleted_cb_proxy);
+
+  if (data.exec_cb || data.object_exec_cb) {
+    lv_anim_set_custom_exec_cb(a, exec_cb_proxy);
+  }
+  if (data.object_exec_cb && a->var) {
+    runtime_data->target = new Object(static_cast<lv_obj_t*>(a->var),
+                                      Object::Ownership::Unmanaged);
+  }
+  if (data.path_cb) {
+    lv_anim_set_path_cb(a, path_cb_proxy);
+  }
+  if (data.completed_cb) {
+    lv_anim_set_completed_cb(a, completed_cb_proxy);
+  }
+}
+
 AnimationHandle Animation::start() {
-  if (user_data_) {
-    // Clone the callback data for this specific animation instance
-    // detailed ownership management requires heap alloc that will be freed by
-    // deleted_cb
-    CallbackData* runtime_data = new CallbackData(*user_data_);
-    lv_anim_set_user_data(ptr_, runtime_data);
-    lv_anim_set_deleted_cb(ptr_, deleted_cb_proxy);
-
-    if (user_data_->exec_cb) {
-      lv_anim_set_custom_exec_cb(ptr_, exec_cb_proxy);
-    }
-    if (user_data_->path_cb) {
-      lv_anim_set_path_cb(ptr_, path_cb_proxy);
-    }
-    if (user_data_->completed_cb) {
-      lv_anim_set_completed_cb(ptr_, completed_cb_proxy);
-    }
+  // Drop proxies left by an earlier start(); their data belongs to the
+  // animation started then.
+  if (ptr_->deleted_cb == deleted_cb_proxy) {
+    lv_anim_set_deleted_cb(ptr_, nullptr);
+    lv_anim_set_user_data(ptr_, nullptr);
+  }
+  if (ptr_->custom_exec_cb == exec_cb_proxy) {
+    lv_anim_set_custom_exec_cb(ptr_, nullptr);
+  }
+  if (ptr_->path_cb == path_cb_proxy) {
+    lv_anim_set_path_cb(ptr_, lv_anim_path_linear);
+  }
+  if (ptr_->completed_cb == completed_cb_proxy) {
+    lv_anim_set_completed_cb(ptr_, nullptr);
+  }
+
+  // Animations with only raw callbacks run without user data.
+  if (user_data_ && !user_data_->empty()) {
+    CallbackData::install(*user_data_, ptr_);
   }
   lv_anim_start(ptr_);
   return AnimationHandle(ptr_->var, ptr_->exec_cb);
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "../core/object.h"  // IWYU pragma: export
 #include "anim_exec_callback.h"
@@ -37,6 +38,14 @@ class AnimationHandle {
    */
   void stop();
 
+  /**
+   * @brief Call `cb` once when the running animation ends, whether it
+   * completes or is deleted.
+   * @return false if the animation is not running, or if it carries raw
+   * LVGL user data that a callback could not be attached next to.
+   */
+  bool on_finished(std::function<void()> cb);
+
  private:
   void* var_ = nullptr;
   lv_anim_exec_xcb_t exec_cb_ = nullptr;
@@ -102,13 +111,14 @@ class ScopedAnimation {
 };
 
 class Animation {
+  friend class AnimationHandle;
   friend class AnimationTimeline;
 
  public:
   using ExecCallback = std::function<void(void*, int32_t)>;
   /**
    * @brief Type-safe execution callback for Objects.
-   * Receives a temporary unmanaged Object wrapper.
+   * Receives an unmanaged Object wrapper borrowed for the call.
    */
   using ObjectExecCallback = std::function<void(Object&, int32_t)>;
 
@@ -175,6 +185,10 @@ class Animation {
   /**
    * @brief Set a C++ execution callback (lambda/std::function).
    *
+   * If `cb` just wraps a plain function pointer, as the `Exec` helpers do,
+   * the pointer is installed on the animation directly and LVGL calls it
+   * without going through `std::function` or allocating callback data.
+   *
    * @example
    * anim.set_exec_cb([](void* var, int32_t val) {
    *     // Custom logic
@@ -182,18 +196,17 @@ class Animation {
    *
    * @param cb The `std::function` callback.
    */
+  Animation& set_exec_cb(ExecCallback cb);
+
   /**
-   * @brief Set a C++ execution callback (lambda/std::function).
+   * @brief Set an execution callback that receives the animated object.
    *
-   * @example
-   * anim.set_exec_cb([](void* var, int32_t val) {
-   *     // Custom logic
-   * });
+   * Each started animation creates one unmanaged wrapper of its object and
+   * passes it to every call, so no `Object` is built per frame. The
+   * wrapper is only valid during the call.
    *
-   * @param cb The `std::function` callback.
+   * @param cb The callback.
    */
-  Animation& set_exec_cb(ExecCallback cb);
-
   Animation& set_exec_cb(ObjectExecCallback cb);
 
   /**
@@ -330,7 +343,8 @@ class Animation {
 
   /**
    * @brief Set a C++ path (easing) callback (lambda/std::function).
-   * Used for custom easing or capturing lambdas.
+   * Used for custom easing or capturing lambdas. A wrapped plain function
+   * pointer, as returned by most `Path` helpers, is installed directly.
    * @param cb The `std::function` path callback.
    */
   Animation& set_path_cb(const PathCallback& cb);
@@ -378,9 +392,23 @@ class Animation {
   // Internal closure data to bridge C callbacks to C++ std::function
   struct CallbackData {
     ExecCallback exec_cb;
+    ObjectExecCallback object_exec_cb;
     PathCallback path_cb;
     CompletedCallback completed_cb;
     std::function<void()> deleted_cb;
+    /// Added to a running animation by AnimationHandle::on_finished().
+    std::vector<std::function<void()>> finished_cbs;
+    /// Wrapper passed to object_exec_cb; owned by a running animation's
+    /// copy and created when it starts.
+    Object* target = nullptr;
+
+    bool empty() const {
+      return !exec_cb && !object_exec_cb && !path_cb && !completed_cb &&
+             !deleted_cb;
+    }
+
+    /// Copy for a starting animation and point `a` at it.
+    static void install(const CallbackData& data, lv_anim_t* a);
   };
 
   std::unique_ptr<CallbackData> user_data_;
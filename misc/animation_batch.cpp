@@ -0,0 +1,258 @@
+#include "animation_batch.h"
+
+#include <algorithm>
+
+namespace lvgl {
+
+namespace {
+
+// Keeps `elapsed * progress_scale` within 32 bits (about 18 hours).
+constexpr uint32_t kMaxDuration = 1u << 26;
+constexpr int kScaleShift = 16;
+
+}  // namespace
+
+lv_anim_exec_xcb_t AnimationBatch::Exec::X() {
+  return (lv_anim_exec_xcb_t)lv_obj_set_x;
+}
+
+lv_anim_exec_xcb_t AnimationBatch::Exec::Y() {
+  return (lv_anim_exec_xcb_t)lv_obj_set_y;
+}
+
+lv_anim_exec_xcb_t AnimationBatch::Exec::Width() {
+  return (lv_anim_exec_xcb_t)lv_obj_set_width;
+}
+
+lv_anim_exec_xcb_t AnimationBatch::Exec::Height() {
+  return (lv_anim_exec_xcb_t)lv_obj_set_height;
+}
+
+AnimationBatch::AnimationBatch() = default;
+
+AnimationBatch::~AnimationBatch() {
+  if (timer_) lv_timer_delete(timer_);
+}
+
+AnimationBatch::Handle AnimationBatch::add(const Tween& tween) {
+  if (index_of_.empty()) {
+    if (!timer_) {
+      timer_ = lv_timer_create(timer_cb, LV_DEF_REFR_PERIOD, this);
+    }
+    lv_timer_resume(timer_);
+    last_tick_ = lv_tick_get();
+  }
+
+  uint32_t duration = std::clamp<uint32_t>(tween.duration, 1, kMaxDuration);
+  uint32_t delay = std::min<uint32_t>(tween.delay, kMaxDuration);
+  Handle handle = next_handle_++;
+  if (next_handle_ == kInvalidHandle) next_handle_ = 1;
+
+  index_of_[handle] = static_cast<uint32_t>(vars_.size());
+  vars_.push_back(tween.var);
+  exec_cbs_.push_back(tween.exec_cb);
+  starts_.push_back(tween.start);
+  ends_.push_back(tween.end);
+  durations_.push_back(static_cast<int32_t>(duration));
+  // Rounded up so that t / duration lands on the exact progress step.
+  uint32_t full = static_cast<uint32_t>(EasingTable::kResolution)
+                  << kScaleShift;
+  progress_scales_.push_back((full + duration - 1) / duration);
+  elapsed_.push_back(-static_cast<int32_t>(delay));
+  curves_.push_back(EasingTable::get(tween.easing));
+  values_.push_back(tween.start);
+  applied_.push_back(tween.start);
+  flags_.push_back(kUnapplied | (tween.repeat ? kRepeat : 0));
+  handles_.push_back(handle);
+  return handle;
+}
+
+AnimationBatch::Handle AnimationBatch::add(const Object& object,
+                                           lv_anim_exec_xcb_t exec_cb,
+                                           int32_t start, int32_t end,
+                                           uint32_t duration, Easing easing) {
+  Tween tween;
+  tween.var = object.raw();
+  tween.exec_cb = exec_cb;
+  tween.start = start;
+  tween.end = end;
+  tween.duration = duration;
+  tween.easing = easing;
+  return add(tween);
+}
+
+void AnimationBatch::remove(Handle handle) {
+  auto it = index_of_.find(handle);
+  if (it == index_of_.end()) return;
+  if (in_tick_) {
+    flags_[it->second] |= kDone;
+    has_done_ = true;
+  } else {
+    remove_at(it->second);
+  }
+}
+
+void AnimationBatch::remove(void* var) {
+  for (uint32_t i = 0; i < vars_.size(); ++i) {
+    if (vars_[i] != var) continue;
+    flags_[i] |= kDone;
+    has_done_ = true;
+  }
+  if (!in_tick_) compact();
+}
+
+void AnimationBatch::clear() {
+  if (in_tick_) {
+    for (uint8_t& flags : flags_) flags |= kDone;
+    has_done_ = true;
+    return;
+  }
+  vars_.clear();
+  exec_cbs_.clear();
+  starts_.clear();
+  ends_.clear();
+  durations_.clear();
+  progress_scales_.clear();
+  elapsed_.clear();
+  curves_.clear();
+  values_.clear();
+  applied_.clear();
+  flags_.clear();
+  handles_.clear();
+  index_of_.clear();
+}
+
+bool AnimationBatch::is_running(Handle handle) const {
+  auto it = index_of_.find(handle);
+  return it != index_of_.end() && !(flags_[it->second] & kDone);
+}
+
+uint32_t AnimationBatch::size() const {
+  return static_cast<uint32_t>(index_of_.size());
+}
+
+void AnimationBatch::set_batch_exec_cb(BatchExecCallback cb,
+                                       void* user_data) {
+  batch_exec_cb_ = cb;
+  batch_user_data_ = user_data;
+}
+
+void AnimationBatch::tick(uint32_t elapsed_ms) {
+  const uint32_t count = static_cast<uint32_t>(vars_.size());
+  if (count == 0) return;
+  const int32_t dt =
+      static_cast<int32_t>(std::min<uint32_t>(elapsed_ms, kMaxDuration));
+
+  // Advance time and ease every tween. No callbacks run here, so the loop
+  // is straight-line code over the arrays.
+  int32_t* elapsed = elapsed_.data();
+  const int32_t* durations = durations_.data();
+  const uint32_t* scales = progress_scales_.data();
+  const int16_t* const* curves = curves_.data();
+  const int32_t* starts = starts_.data();
+  const int32_t* ends = ends_.data();
+  int32_t* values = values_.data();
+  for (uint32_t i = 0; i < count; ++i) {
+    int32_t t = elapsed[i] + dt;
+    elapsed[i] = t;
+    int32_t clamped = std::clamp(t, 0, durations[i] - 1);
+    int32_t progress = std::min<int32_t>(
+        static_cast<int32_t>(
+            (static_cast<uint32_t>(clamped) * scales[i]) >> kScaleShift),
+        EasingTable::kResolution - 1);
+    int32_t eased = EasingTable::sample(curves[i], progress);
+    int64_t delta = static_cast<int64_t>(ends[i]) - starts[i];
+    int64_t scaled = delta * eased + EasingTable::kResolution / 2;
+    int32_t value =
+        starts[i] + static_cast<int32_t>(scaled >> EasingTable::kShift);
+    values[i] = t >= durations[i] ? ends[i] : value;
+  }
+
+  // Apply changed values. Callbacks may add or remove tweens, so index
+  // the vectors from here on.
+  in_tick_ = true;
+  changed_vars_.clear();
+  changed_values_.clear();
+  for (uint32_t i = 0; i < count; ++i) {
+    if (flags_[i] & kDone || elapsed_[i] < 0) continue;
+    if (values_[i] == applied_[i] && !(flags_[i] & kUnapplied)) continue;
+    applied_[i] = values_[i];
+    flags_[i] &= ~kUnapplied;
+    if (exec_cbs_[i]) {
+      exec_cbs_[i](vars_[i], values_[i]);
+    } else {
+      changed_vars_.push_back(vars_[i]);
+      changed_values_.push_back(values_[i]);
+    }
+  }
+  if (batch_exec_cb_ && !changed_vars_.empty()) {
+    batch_exec_cb_(changed_vars_.data(), changed_values_.data(),
+                   static_cast<uint32_t>(changed_vars_.size()),
+                   batch_user_data_);
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    if (elapsed_[i] < durations_[i]) continue;
+    if (flags_[i] & kRepeat) {
+      elapsed_[i] %= durations_[i];
+    } else {
+      flags_[i] |= kDone;
+      has_done_ = true;
+    }
+  }
+  in_tick_ = false;
+  if (has_done_) compact();
+}
+
+void AnimationBatch::timer_cb(lv_timer_t* timer) {
+  auto* self = static_cast<AnimationBatch*>(lv_timer_get_user_data(timer));
+  uint32_t elapsed = lv_tick_elaps(self->last_tick_);
+  self->last_tick_ += elapsed;
+  self->tick(elapsed);
+  if (self->index_of_.empty()) lv_timer_pause(timer);
+}
+
+void AnimationBatch::remove_at(uint32_t index) {
+  uint32_t last = static_cast<uint32_t>(vars_.size()) - 1;
+  index_of_.erase(handles_[index]);
+  if (index != last) {
+    vars_[index] = vars_[last];
+    exec_cbs_[index] = exec_cbs_[last];
+    starts_[index] = starts_[last];
+    ends_[index] = ends_[last];
+    durations_[index] = durations_[last];
+    progress_scales_[index] = progress_scales_[last];
+    elapsed_[index] = elapsed_[last];
+    curves_[index] = curves_[last];
+    values_[index] = values_[last];
+    applied_[index] = applied_[last];
+    flags_[index] = flags_[last];
+    handles_[index] = handles_[last];
+    index_of_[handles_[index]] = index;
+  }
+  vars_.pop_back();
+  exec_cbs_.pop_back();
+  starts_.pop_back();
+  ends_.pop_back();
+  durations_.pop_back();
+  progress_scales_.pop_back();
+  elapsed_.pop_back();
+  curves_.pop_back();
+  values_.pop_back();
+  applied_.pop_back();
+  flags_.pop_back();
+  handles_.pop_back();
+}
+
+void AnimationBatch::compact() {
+  for (uint32_t i = 0; i < vars_.size();) {
+    if (flags_[i] & kDone) {
+      remove_at(i);
+    } else {
+      ++i;
+    }
+  }
+  has_done_ = false;
+}
+
+}  // namespace lvgl
@@ -0,0 +1,156 @@
+#ifndef LVGL_CPP_MISC_ANIMATION_BATCH_H_
+#define LVGL_CPP_MISC_ANIMATION_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/object.h"
+#include "easing.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file animation_batch.h
+ * @brief User Guide:
+ * `AnimationBatch` runs many simple tweens from one LVGL timer. Every
+ * `Animation` is its own `lv_anim_t`, and LVGL walks them one by one each
+ * frame; a batch keeps its tweens in flat arrays instead and advances them
+ * all in a single loop, with easing read from precomputed tables.
+ *
+ * Tweens have a start, end, duration, delay and `Easing`, and may repeat
+ * forever. Values are only written when they change, either through a
+ * per-tween exec callback or through one batch callback that receives all
+ * changed values of a frame at once.
+ *
+ * Unlike an `lv_anim_t`, a tween is not removed when its object is
+ * deleted: call `remove(var)` first.
+ *
+ * Example:
+ * @code
+ * lvgl::AnimationBatch batch;
+ * for (auto& bar : bars) {
+ *   batch.add(bar, lvgl::AnimationBatch::Exec::Y(), 0, 100, 500,
+ *             lvgl::Easing::EaseInOut);
+ * }
+ * @endcode
+ */
+namespace lvgl {
+
+class AnimationBatch {
+ public:
+  using Handle = uint32_t;
+  static constexpr Handle kInvalidHandle = 0;
+
+  /**
+   * @brief Receives every value that changed in a frame, for tweens added
+   * without an exec callback.
+   */
+  using BatchExecCallback = void (*)(void* const* vars, const int32_t* values,
+                                     uint32_t count, void* user_data);
+
+  struct Tween {
+    void* var = nullptr;
+    /** Called with each new value. nullptr sends it to the batch callback. */
+    lv_anim_exec_xcb_t exec_cb = nullptr;
+    int32_t start = 0;
+    int32_t end = 0;
+    uint32_t duration = 0;
+    uint32_t delay = 0;
+    Easing easing = Easing::Linear;
+    bool repeat = false;  ///< Restart from `start` forever.
+  };
+
+  /** Object setters usable as exec callbacks. */
+  struct Exec {
+    static lv_anim_exec_xcb_t X();
+    static lv_anim_exec_xcb_t Y();
+    static lv_anim_exec_xcb_t Width();
+    static lv_anim_exec_xcb_t Height();
+  };
+
+  AnimationBatch();
+  ~AnimationBatch();
+
+  AnimationBatch(const AnimationBatch&) = delete;
+  AnimationBatch& operator=(const AnimationBatch&) = delete;
+  AnimationBatch(AnimationBatch&&) = delete;
+  AnimationBatch& operator=(AnimationBatch&&) = delete;
+
+  /**
+   * @brief Start a tween. Takes effect on the next tick.
+   * @return Handle for remove() and is_running().
+   */
+  Handle add(const Tween& tween);
+  Handle add(const Object& object, lv_anim_exec_xcb_t exec_cb, int32_t start,
+             int32_t end, uint32_t duration, Easing easing = Easing::Linear);
+
+  /**
+   * @brief Stop a tween where it is.
+   */
+  void remove(Handle handle);
+
+  /**
+   * @brief Stop every tween on `var`, e.g. before deleting the object.
+   */
+  void remove(void* var);
+  void remove(const Object& object) { remove(object.raw()); }
+
+  void clear();
+
+  bool is_running(Handle handle) const;
+
+  /**
+   * @brief Number of running tweens.
+   */
+  uint32_t size() const;
+
+  /**
+   * @brief Callback for tweens added without an exec callback.
+   */
+  void set_batch_exec_cb(BatchExecCallback cb, void* user_data = nullptr);
+
+  /**
+   * @brief Advance every tween by `elapsed_ms` and apply the new values.
+   * Called by the batch's LVGL timer; call it directly to step manually.
+   */
+  void tick(uint32_t elapsed_ms);
+
+ private:
+  enum Flags : uint8_t { kRepeat = 1, kDone = 2, kUnapplied = 4 };
+
+  static void timer_cb(lv_timer_t* timer);
+  void remove_at(uint32_t index);
+  void compact();
+
+  // One entry per tween, in parallel.
+  std::vector<void*> vars_;
+  std::vector<lv_anim_exec_xcb_t> exec_cbs_;
+  std::vector<int32_t> starts_;
+  std::vector<int32_t> ends_;
+  std::vector<int32_t> durations_;
+  std::vector<uint32_t> progress_scales_;  // (kResolution << 16) / duration
+  std::vector<int32_t> elapsed_;           // Negative while delayed.
+  std::vector<const int16_t*> curves_;
+  std::vector<int32_t> values_;
+  std::vector<int32_t> applied_;
+  std::vector<uint8_t> flags_;
+  std::vector<Handle> handles_;
+
+  std::unordered_map<Handle, uint32_t> index_of_;
+  Handle next_handle_ = 1;
+
+  BatchExecCallback batch_exec_cb_ = nullptr;
+  void* batch_user_data_ = nullptr;
+  std::vector<void*> changed_vars_;
+  std::vector<int32_t> changed_values_;
+
+  lv_timer_t* timer_ = nullptr;
+  uint32_t last_tick_ = 0;
+  bool in_tick_ = false;
+  bool has_done_ = false;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_ANIMATION_BATCH_H_
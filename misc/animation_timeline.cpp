@@ -1,7 +1,18 @@
 #include "animation_timeline.h"
 
+#include <utility>
+
 namespace lvgl {
 
+namespace {
+
+// The clip's lv_anim_t runs 0..duration linearly, so the value is the time.
+void keyframe_exec_cb(lv_anim_t* a, int32_t value) {
+  static_cast<KeyframeClip*>(a->var)->seek(static_cast<uint32_t>(value));
+}
+
+}  // namespace
+
 AnimationTimeline::AnimationTimeline() {
   timeline_ = lv_anim_timeline_create();
 }
@@ -14,7 +25,7 @@ AnimationTimeline::~AnimationTimeline() {
 }
 
 AnimationTimeline::AnimationTimeline(AnimationTimeline&& other) noexcept
-    : timeline_(other.timeline_) {
+    : timeline_(other.timeline_), clips_(std::move(other.clips_)) {
   other.timeline_ = nullptr;
 }
 
@@ -25,6 +36,7 @@ AnimationTimeline& AnimationTimeline::operator=(
       lv_anim_timeline_delete(timeline_);
     }
     timeline_ = other.timeline_;
+    clips_ = std::move(other.clips_);
     other.timeline_ = nullptr;
   }
   return *this;
@@ -33,30 +45,29 @@ AnimationTimeline& AnimationTimeline::operator=(
 void AnimationTimeline::add(Animation& anim, uint32_t start_time) {
   lv_anim_t temp_anim = anim.anim_;
 
-  if (anim.user_data_) {
-    // Clone callback data (Animation is a friend)
-    // We allocate a new CallbackData on the heap.
-    // It will be deleted by Animation::deleted_cb_proxy when this timeline/anim
-    // is deleted.
-    auto* runtime_data = new Animation::CallbackData(*anim.user_data_);
-
-    lv_anim_set_user_data(&temp_anim, runtime_data);
-    lv_anim_set_deleted_cb(&temp_anim, Animation::deleted_cb_proxy);
-
-    if (anim.user_data_->exec_cb) {
-      lv_anim_set_custom_exec_cb(&temp_anim, Animation::exec_cb_proxy);
-    }
-    if (anim.user_data_->path_cb) {
-      lv_anim_set_path_cb(&temp_anim, Animation::path_cb_proxy);
-    }
-    if (anim.user_data_->completed_cb) {
-      lv_anim_set_completed_cb(&temp_anim, Animation::completed_cb_proxy);
-    }
+  if (anim.user_data_ && !anim.user_data_->empty()) {
+    // Clone callback data (Animation is a friend). The copy is deleted by
+    // Animation::deleted_cb_proxy when this timeline/anim is deleted.
+    Animation::CallbackData::install(*anim.user_data_, &temp_anim);
   }
 
   lv_anim_timeline_add(timeline_, start_time, &temp_anim);
 }
 
+void AnimationTimeline::add(KeyframeClip clip, uint32_t start_time) {
+  auto owned = std::make_shared<KeyframeClip>(std::move(clip));
+  int32_t duration = static_cast<int32_t>(owned->get_duration());
+
+  lv_anim_t anim;
+  lv_anim_init(&anim);
+  lv_anim_set_var(&anim, owned.get());
+  lv_anim_set_values(&anim, 0, duration);
+  lv_anim_set_duration(&anim, static_cast<uint32_t>(duration));
+  lv_anim_set_custom_exec_cb(&anim, keyframe_exec_cb);
+  lv_anim_timeline_add(timeline_, start_time, &anim);
+  clips_.push_back(std::move(owned));
+}
+
 uint32_t AnimationTimeline::start() {
   if (timeline_) return lv_anim_timeline_start(timeline_);
   return 0;
@@ -124,6 +135,8 @@ void AnimationTimeline::merge(const AnimationTimeline& other,
     // Checking coverage.json, it lists lv_anim_timeline_merge as wrapped?
     // Wait, the header has it.
     lv_anim_timeline_merge(timeline_, other.timeline_, extra_delay);
+    // Merged keyframe entries point at the other timeline's clips.
+    clips_.insert(clips_.end(), other.clips_.begin(), other.clips_.end());
   }
 }
 
@@ -1,7 +1,11 @@
 #ifndef LVGL_CPP_MISC_ANIMATION_TIMELINE_H_
 #define LVGL_CPP_MISC_ANIMATION_TIMELINE_H_
 
+#include <memory>
+#include <vector>
+
 #include "animation.h"
+#include "keyframe_track.h"
 #include "lvgl.h"
 
 namespace lvgl {
@@ -25,6 +29,14 @@ class AnimationTimeline {
    */
   void add(Animation& anim, uint32_t start_time);
 
+  /**
+   * @brief Add compiled keyframes. The whole clip plays as one entry, and
+   * seeking evaluates each of its tracks once.
+   * @param clip The clip, kept alive by this timeline.
+   * @param start_time The start time on the timeline in milliseconds.
+   */
+  void add(KeyframeClip clip, uint32_t start_time);
+
   /**
    * @brief Start the animation timeline.
    * @return Total time spent in animation timeline.
@@ -125,7 +137,8 @@ class AnimationTimeline {
 
   /**
    * @brief Detach the timeline from this object.
-   * caller must manage memory of the timeline.
+   * caller must manage memory of the timeline. Keyframe clips stay owned
+   * by this object and must outlive the detached timeline.
    * @return The raw lv_anim_timeline_t pointer.
    */
   lv_anim_timeline_t* detach();
@@ -137,6 +150,7 @@ class AnimationTimeline {
 
  private:
   lv_anim_timeline_t* timeline_ = nullptr;
+  std::vector<std::shared_ptr<KeyframeClip>> clips_;
 };
 
 }  // namespace lvgl
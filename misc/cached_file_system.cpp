@@ -0,0 +1,377 @@
+#include "cached_file_system.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace lvgl {
+
+struct CachedFileSystem::OpenFile {
+  lv_fs_file_t backing;
+  uint32_t id = 0;
+  uint32_t pos = 0;
+  uint32_t backing_pos = 0;  ///< Position of the backing handle.
+  uint32_t next_seq = 0;     ///< Where a sequential read would start.
+  bool sequential = false;
+};
+
+namespace {
+
+uint64_t block_key(uint32_t id, uint32_t block) {
+  return (static_cast<uint64_t>(id) << 32) | block;
+}
+
+}  // namespace
+
+float CachedFileSystem::Stats::hit_rate() const {
+  uint64_t total = hits + misses;
+  if (total == 0) return 0.0f;
+  return static_cast<float>(hits) / static_cast<float>(total);
+}
+
+CachedFileSystem::CachedFileSystem(char letter, char backing_letter)
+    : CachedFileSystem(letter, backing_letter, Config{}) {}
+
+CachedFileSystem::CachedFileSystem(char letter, char backing_letter,
+                                   const Config& config)
+    : FileSystemDriver(letter),
+      backing_letter_(backing_letter),
+      config_(config) {
+  if (config_.block_size == 0) config_.block_size = 4096;
+  if (config_.max_blocks == 0) config_.max_blocks = 1;
+  // A single miss never loads more blocks than the cache can hold, so the
+  // block that was asked for is never evicted by its own read-ahead.
+  config_.read_ahead_blocks =
+      std::min(config_.read_ahead_blocks, config_.max_blocks - 1);
+
+  pool_.resize(static_cast<size_t>(config_.block_size) * config_.max_blocks);
+  slots_.resize(config_.max_blocks);
+  free_.reserve(config_.max_blocks);
+  for (uint32_t i = config_.max_blocks; i > 0; --i) free_.push_back(i - 1);
+  index_.reserve(config_.max_blocks);
+  scratch_.resize(static_cast<size_t>(config_.block_size) *
+                  (config_.read_ahead_blocks + 1));
+}
+
+CachedFileSystem::~CachedFileSystem() = default;
+
+char CachedFileSystem::get_backing_letter() const { return backing_letter_; }
+
+const CachedFileSystem::Config& CachedFileSystem::get_config() const {
+  return config_;
+}
+
+const CachedFileSystem::Stats& CachedFileSystem::get_stats() const {
+  return stats_;
+}
+
+void CachedFileSystem::reset_stats() { stats_ = Stats{}; }
+
+void CachedFileSystem::invalidate() {
+  for (uint32_t i = 0; i < slots_.size(); ++i) {
+    if (slots_[i].used) drop(i);
+  }
+}
+
+void CachedFileSystem::invalidate(const std::string& path) {
+  auto it = file_ids_.find(path);
+  if (it == file_ids_.end()) return;
+  // Forgets the path unless a file is still open on it.
+  invalidate_range(it->second.id, 0, UINT32_MAX);
+}
+
+size_t CachedFileSystem::get_path_count() const { return file_ids_.size(); }
+
+bool CachedFileSystem::ready() { return lv_fs_is_ready(backing_letter_); }
+
+void* CachedFileSystem::open(const char* path, FsMode mode) {
+  auto* f = new OpenFile;
+  std::string real = backing_path(path);
+  if (lv_fs_open(&f->backing, real.c_str(),
+                 static_cast<lv_fs_mode_t>(mode)) != LV_FS_RES_OK) {
+    delete f;
+    return nullptr;
+  }
+  f->id = acquire_id(path);
+  // Opening for writing may truncate, so nothing cached for it is trusted.
+  if (static_cast<uint8_t>(mode) & LV_FS_MODE_WR) {
+    invalidate_range(f->id, 0, UINT32_MAX);
+  }
+  return f;
+}
+
+FsRes CachedFileSystem::close(void* file) {
+  auto* f = static_cast<OpenFile*>(file);
+  lv_fs_res_t res = lv_fs_close(&f->backing);
+  release_id(f->id);
+  delete f;
+  return static_cast<FsRes>(res);
+}
+
+FsRes CachedFileSystem::read(void* file, void* buf, uint32_t btr,
+                             uint32_t* br) {
+  auto* f = static_cast<OpenFile*>(file);
+  if (br) *br = 0;
+
+  f->sequential = (f->pos == f->next_seq);
+
+  auto* out = static_cast<uint8_t*>(buf);
+  const uint32_t bs = config_.block_size;
+  uint32_t done = 0;
+  while (done < btr) {
+    uint32_t block = f->pos / bs;
+    uint32_t offset = f->pos % bs;
+    uint32_t slot = find(block_key(f->id, block));
+    if (slot == kNone) {
+      FsRes res = load_blocks(f, block, &slot);
+      if (res != FsRes::Ok) {
+        if (done == 0) return res;
+        break;
+      }
+      if (slot == kNone) break;  // End of file.
+    } else {
+      stats_.hits++;
+      touch(slot);
+    }
+
+    const Slot& s = slots_[slot];
+    if (offset >= s.length) break;  // End of file inside a short block.
+    uint32_t n = std::min(btr - done, s.length - offset);
+    std::memcpy(out + done, slot_data(slot) + offset, n);
+    done += n;
+    f->pos += n;
+  }
+
+  f->next_seq = f->pos;
+  if (br) *br = done;
+  return FsRes::Ok;
+}
+
+FsRes CachedFileSystem::write(void* file, const void* buf, uint32_t btw,
+                              uint32_t* bw) {
+  auto* f = static_cast<OpenFile*>(file);
+  if (bw) *bw = 0;
+  if (btw == 0) return FsRes::Ok;
+
+  if (f->backing_pos != f->pos) {
+    lv_fs_res_t res = lv_fs_seek(&f->backing, f->pos, LV_FS_SEEK_SET);
+    if (res != LV_FS_RES_OK) return static_cast<FsRes>(res);
+    f->backing_pos = f->pos;
+  }
+
+  uint32_t written = 0;
+  lv_fs_res_t res = lv_fs_write(&f->backing, buf, btw, &written);
+  const uint32_t bs = config_.block_size;
+  if (written > 0) {
+    invalidate_range(f->id, f->pos / bs, (f->pos + written - 1) / bs);
+  }
+  f->pos += written;
+  f->backing_pos = f->pos;
+  if (bw) *bw = written;
+  return static_cast<FsRes>(res);
+}
+
+FsRes CachedFileSystem::seek(void* file, uint32_t pos, FsWhence whence) {
+  auto* f = static_cast<OpenFile*>(file);
+  switch (whence) {
+    case FsWhence::Set:
+      f->pos = pos;
+      break;
+    case FsWhence::Cur:
+      f->pos += pos;
+      break;
+    case FsWhence::End: {
+      uint32_t size = 0;
+      FsRes res = file_size(f, &size);
+      if (res != FsRes::Ok) return res;
+      f->pos = size + pos;
+      break;
+    }
+  }
+  return FsRes::Ok;
+}
+
+FsRes CachedFileSystem::tell(void* file, uint32_t* pos) {
+  *pos = static_cast<OpenFile*>(file)->pos;
+  return FsRes::Ok;
+}
+
+void* CachedFileSystem::dir_open(const char* path) {
+  auto* dir = new lv_fs_dir_t;
+  std::string real = backing_path(path);
+  if (lv_fs_dir_open(dir, real.c_str()) != LV_FS_RES_OK) {
+    delete dir;
+    return nullptr;
+  }
+  return dir;
+}
+
+FsRes CachedFileSystem::dir_read(void* dir, char* fn, uint32_t fn_len) {
+  return static_cast<FsRes>(
+      lv_fs_dir_read(static_cast<lv_fs_dir_t*>(dir), fn, fn_len));
+}
+
+FsRes CachedFileSystem::dir_close(void* dir) {
+  auto* d = static_cast<lv_fs_dir_t*>(dir);
+  lv_fs_res_t res = lv_fs_dir_close(d);
+  delete d;
+  return static_cast<FsRes>(res);
+}
+
+std::string CachedFileSystem::backing_path(const char* path) const {
+  std::string real(1, backing_letter_);
+  real += ':';
+  real += path;
+  return real;
+}
+
+uint32_t CachedFileSystem::acquire_id(const char* path) {
+  auto [it, inserted] = file_ids_.try_emplace(path);
+  if (inserted) {
+    // Ids are reused only after their path was forgotten.
+    while (next_id_ == 0 || paths_.count(next_id_)) ++next_id_;
+    it->second.id = next_id_++;
+    paths_.emplace(it->second.id, &*it);
+  }
+  it->second.refs++;
+  return it->second.id;
+}
+
+void CachedFileSystem::release_id(uint32_t id) {
+  auto it = paths_.find(id);
+  if (it == paths_.end()) return;
+  FileIds::value_type* entry = it->second;
+  if (--entry->second.refs > 0) return;
+  paths_.erase(it);
+  file_ids_.erase(file_ids_.find(entry->first));
+}
+
+FsRes CachedFileSystem::file_size(OpenFile* f, uint32_t* size) {
+  lv_fs_res_t res = lv_fs_seek(&f->backing, 0, LV_FS_SEEK_END);
+  if (res != LV_FS_RES_OK) return static_cast<FsRes>(res);
+  res = lv_fs_tell(&f->backing, size);
+  if (res != LV_FS_RES_OK) return static_cast<FsRes>(res);
+  f->backing_pos = *size;
+  return FsRes::Ok;
+}
+
+FsRes CachedFileSystem::load_blocks(OpenFile* f, uint32_t block,
+                                    uint32_t* slot) {
+  *slot = kNone;
+  const uint32_t bs = config_.block_size;
+
+  uint32_t count = 1;
+  if (f->sequential) {
+    // Extend the read over following blocks until one is already cached.
+    while (count <= config_.read_ahead_blocks &&
+           find(block_key(f->id, block + count)) == kNone) {
+      count++;
+    }
+  }
+
+  uint32_t start = block * bs;
+  if (f->backing_pos != start) {
+    lv_fs_res_t res = lv_fs_seek(&f->backing, start, LV_FS_SEEK_SET);
+    if (res != LV_FS_RES_OK) return static_cast<FsRes>(res);
+    f->backing_pos = start;
+  }
+
+  uint32_t got = 0;
+  lv_fs_res_t res = lv_fs_read(&f->backing, scratch_.data(), count * bs, &got);
+  stats_.backing_reads++;
+  stats_.backing_bytes += got;
+  f->backing_pos = start + got;
+  if (res != LV_FS_RES_OK) return static_cast<FsRes>(res);
+  stats_.misses++;
+
+  // Insert the speculative blocks first so the requested one ends up as the
+  // most recently used entry.
+  for (uint32_t i = count; i > 0; --i) {
+    uint32_t offset = (i - 1) * bs;
+    if (offset >= got) continue;
+    uint32_t s = acquire_slot();
+    Slot& entry = slots_[s];
+    entry.key = block_key(f->id, block + i - 1);
+    entry.length = std::min(bs, got - offset);
+    entry.used = true;
+    paths_[f->id]->second.refs++;
+    std::memcpy(slot_data(s), scratch_.data() + offset, entry.length);
+    index_[entry.key] = s;
+    touch(s);
+    if (i == 1) {
+      *slot = s;
+    } else {
+      stats_.read_ahead_blocks++;
+    }
+  }
+  return FsRes::Ok;
+}
+
+uint32_t CachedFileSystem::find(uint64_t key) {
+  auto it = index_.find(key);
+  return it == index_.end() ? kNone : it->second;
+}
+
+uint32_t CachedFileSystem::acquire_slot() {
+  if (!free_.empty()) {
+    uint32_t s = free_.back();
+    free_.pop_back();
+    return s;
+  }
+  uint32_t victim = lru_tail_;
+  drop(victim);
+  stats_.evictions++;
+  free_.pop_back();  // drop() returned the victim to the free list.
+  return victim;
+}
+
+void CachedFileSystem::touch(uint32_t slot) {
+  unlink(slot);
+  Slot& s = slots_[slot];
+  s.prev = kNone;
+  s.next = lru_head_;
+  if (lru_head_ != kNone) slots_[lru_head_].prev = slot;
+  lru_head_ = slot;
+  if (lru_tail_ == kNone) lru_tail_ = slot;
+}
+
+void CachedFileSystem::unlink(uint32_t slot) {
+  Slot& s = slots_[slot];
+  if (s.prev != kNone) {
+    slots_[s.prev].next = s.next;
+  } else if (lru_head_ == slot) {
+    lru_head_ = s.next;
+  }
+  if (s.next != kNone) {
+    slots_[s.next].prev = s.prev;
+  } else if (lru_tail_ == slot) {
+    lru_tail_ = s.prev;
+  }
+  s.prev = kNone;
+  s.next = kNone;
+}
+
+void CachedFileSystem::drop(uint32_t slot) {
+  Slot& s = slots_[slot];
+  index_.erase(s.key);
+  unlink(slot);
+  s.used = false;
+  s.length = 0;
+  free_.push_back(slot);
+  release_id(static_cast<uint32_t>(s.key >> 32));
+}
+
+void CachedFileSystem::invalidate_range(uint32_t id, uint32_t first_block,
+                                        uint32_t last_block) {
+  for (uint32_t i = 0; i < slots_.size(); ++i) {
+    const Slot& s = slots_[i];
+    if (!s.used || (s.key >> 32) != id) continue;
+    uint32_t block = static_cast<uint32_t>(s.key);
+    if (block >= first_block && block <= last_block) drop(i);
+  }
+}
+
+uint8_t* CachedFileSystem::slot_data(uint32_t slot) {
+  return pool_.data() + static_cast<size_t>(slot) * config_.block_size;
+}
+
+}  // namespace lvgl
@@ -0,0 +1,169 @@
+#ifndef LVGL_CPP_MISC_CACHED_FILE_SYSTEM_H_
+#define LVGL_CPP_MISC_CACHED_FILE_SYSTEM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file_system.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+namespace lvgl {
+
+/**
+ * @brief Block-caching driver layered over another `lv_fs` driver.
+ *
+ * Registered under its own drive letter, it forwards every path to the
+ * backing letter and serves reads from an LRU cache of fixed-size blocks.
+ * Sequential access is detected per open file; once a file is being read
+ * front to back, misses fetch the missing block plus the next
+ * `read_ahead_blocks` in a single backing read. Writes go straight through to
+ * the backing driver and invalidate the blocks they touch.
+ *
+ * Blocks are shared between handles opened on the same path, so a font or
+ * image that is reopened is served from memory.
+ *
+ * @code
+ * lvgl::CachedFileSystem cache('C', 'S');  // 'C:' reads through to 'S:'
+ * auto font = lvgl::OwnedFont::load_bin("C:/fonts/ui.bin");
+ * LV_LOG_USER("hit rate %.2f", cache.get_stats().hit_rate());
+ * @endcode
+ */
+class CachedFileSystem : public FileSystemDriver {
+ public:
+  struct Config {
+    uint32_t block_size = 4096;      ///< Bytes per cached block.
+    uint32_t max_blocks = 32;        ///< LRU capacity in blocks.
+    uint32_t read_ahead_blocks = 4;  ///< Extra blocks fetched when reading
+                                     ///< sequentially (0 = off).
+  };
+
+  struct Stats {
+    uint64_t hits = 0;               ///< Block lookups served from memory.
+    uint64_t misses = 0;             ///< Block lookups that hit the backing
+                                     ///< driver.
+    uint64_t read_ahead_blocks = 0;  ///< Blocks loaded speculatively.
+    uint64_t evictions = 0;          ///< Blocks dropped to make room.
+    uint64_t backing_reads = 0;      ///< Read calls into the backing driver.
+    uint64_t backing_bytes = 0;      ///< Bytes read from the backing driver.
+
+    /**
+     * @brief Fraction of block lookups served from the cache.
+     * @return Value in [0, 1]; 0 when nothing has been read yet.
+     */
+    float hit_rate() const;
+  };
+
+  /**
+   * @brief Register a caching driver.
+   * @param letter Drive letter to register the cache under.
+   * @param backing_letter Drive letter of the driver being cached.
+   */
+  CachedFileSystem(char letter, char backing_letter);
+  CachedFileSystem(char letter, char backing_letter, const Config& config);
+  ~CachedFileSystem() override;
+
+  /**
+   * @brief Get the letter of the wrapped driver.
+   */
+  char get_backing_letter() const;
+
+  /**
+   * @brief Get the active configuration.
+   */
+  const Config& get_config() const;
+
+  /**
+   * @brief Get the accumulated cache statistics.
+   */
+  const Stats& get_stats() const;
+
+  /**
+   * @brief Reset all statistics counters to zero.
+   */
+  void reset_stats();
+
+  /**
+   * @brief Drop every cached block, e.g. after the backing media changed.
+   */
+  void invalidate();
+
+  /**
+   * @brief Drop the cached blocks of a single file.
+   * @param path Path relative to the drive (without the letter).
+   */
+  void invalidate(const std::string& path);
+
+  /**
+   * @brief Number of paths with an open file or cached blocks. A path is
+   * forgotten once it has neither.
+   */
+  size_t get_path_count() const;
+
+ protected:
+  bool ready() override;
+  void* open(const char* path, FsMode mode) override;
+  FsRes close(void* file) override;
+  FsRes read(void* file, void* buf, uint32_t btr, uint32_t* br) override;
+  FsRes write(void* file, const void* buf, uint32_t btw,
+              uint32_t* bw) override;
+  FsRes seek(void* file, uint32_t pos, FsWhence whence) override;
+  FsRes tell(void* file, uint32_t* pos) override;
+  void* dir_open(const char* path) override;
+  FsRes dir_read(void* dir, char* fn, uint32_t fn_len) override;
+  FsRes dir_close(void* dir) override;
+
+ private:
+  struct OpenFile;
+
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  struct Slot {
+    uint64_t key = 0;
+    uint32_t length = 0;  ///< Valid bytes (short at end of file).
+    uint32_t prev = kNone;
+    uint32_t next = kNone;
+    bool used = false;
+  };
+
+  std::string backing_path(const char* path) const;
+  uint32_t acquire_id(const char* path);
+  void release_id(uint32_t id);
+  FsRes file_size(OpenFile* f, uint32_t* size);
+  FsRes load_blocks(OpenFile* f, uint32_t block, uint32_t* slot);
+  uint32_t find(uint64_t key);
+  uint32_t acquire_slot();
+  void touch(uint32_t slot);
+  void unlink(uint32_t slot);
+  void drop(uint32_t slot);
+  void invalidate_range(uint32_t id, uint32_t first_block,
+                        uint32_t last_block);
+  uint8_t* slot_data(uint32_t slot);
+
+  char backing_letter_;
+  Config config_;
+  Stats stats_;
+
+  std::vector<uint8_t> pool_;
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_;
+  std::unordered_map<uint64_t, uint32_t> index_;
+  uint32_t lru_head_ = kNone;  ///< Most recently used.
+  uint32_t lru_tail_ = kNone;  ///< Next to evict.
+  std::vector<uint8_t> scratch_;
+
+  struct FileRef {
+    uint32_t id = 0;
+    uint32_t refs = 0;  ///< Open files plus cached blocks.
+  };
+  using FileIds = std::unordered_map<std::string, FileRef>;
+  FileIds file_ids_;
+  std::unordered_map<uint32_t, FileIds::value_type*> paths_;  ///< By id.
+  uint32_t next_id_ = 1;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_CACHED_FILE_SYSTEM_H_
@@ -0,0 +1,388 @@
+#include "coroutine.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "../core/observer.h"
+
+namespace lvgl {
+
+namespace detail {
+
+namespace {
+
+// Frames are pooled in 64-byte size classes up to 1 KiB; larger frames go
+// straight to the heap.
+constexpr size_t kFrameGranule = 64;
+constexpr size_t kFrameClasses = 16;
+
+// Per thread, so frames created and freed off the LVGL thread (for example
+// by Executor jobs) need no lock. A frame freed on another thread than the
+// one that made it joins that thread's lists.
+struct FreeFrames {
+  void* heads[kFrameClasses] = {};
+
+  ~FreeFrames() {
+    for (void* head : heads) {
+      while (head) {
+        void* next = *static_cast<void**>(head);
+        ::operator delete(head);
+        head = next;
+      }
+    }
+  }
+};
+
+thread_local FreeFrames free_frames;
+
+// True if tick `a` is earlier than tick `b`, across wrap-around.
+bool before(uint32_t a, uint32_t b) {
+  return static_cast<int32_t>(a - b) < 0;
+}
+
+struct Slot {
+  std::coroutine_handle<> handle;
+  uint32_t generation = 0;
+  bool ready = false;
+};
+
+struct Sleeper {
+  uint32_t due;
+  uint64_t seq;
+  uint64_t token;
+};
+
+// Heap order: earliest due first, then first added.
+bool later(const Sleeper& a, const Sleeper& b) {
+  if (a.due != b.due) return before(b.due, a.due);
+  return a.seq > b.seq;
+}
+
+struct Watch {
+  uint64_t token;
+  bool (*done)(void*);
+  void* user_data;
+};
+
+struct State {
+  std::vector<Slot> slots = std::vector<Slot>(1);  // Index 0 is no token.
+  std::vector<uint32_t> free_slots;
+  std::vector<uint64_t> ready;
+  std::vector<uint64_t> batch;
+  std::vector<uint64_t> after_frame;
+  std::vector<Sleeper> sleepers;
+  std::vector<Watch> watches;
+  std::vector<std::coroutine_handle<>> doomed;
+  uint64_t seq = 0;
+  lv_timer_t* timer = nullptr;
+  lv_display_t* display = nullptr;
+  bool running = false;
+};
+
+// Never destroyed: its timer may outlive static destruction order.
+State& state() {
+  static State* instance = new State();
+  return *instance;
+}
+
+Slot* find(uint64_t token) {
+  State& s = state();
+  uint32_t index = static_cast<uint32_t>(token);
+  if (index == 0 || index >= s.slots.size()) return nullptr;
+  Slot& slot = s.slots[index];
+  if (slot.generation != static_cast<uint32_t>(token >> 32)) return nullptr;
+  return &slot;
+}
+
+// Mark a parked token ready; returns false if it is stale or already ready.
+bool mark_ready(uint64_t token) {
+  Slot* slot = find(token);
+  if (!slot || slot->ready) return false;
+  slot->ready = true;
+  return true;
+}
+
+void rearm();
+
+void run(lv_timer_t*) {
+  State& s = state();
+  s.running = true;
+
+  // Cancellations first, so their pending wake-ups become stale.
+  std::vector<std::coroutine_handle<>> doomed;
+  doomed.swap(s.doomed);
+  for (std::coroutine_handle<> handle : doomed) handle.destroy();
+
+  s.batch.clear();
+  s.batch.swap(s.ready);
+  uint32_t now = lv_tick_get();
+  while (!s.sleepers.empty() && !before(now, s.sleepers.front().due)) {
+    std::pop_heap(s.sleepers.begin(), s.sleepers.end(), later);
+    uint64_t token = s.sleepers.back().token;
+    s.sleepers.pop_back();
+    if (mark_ready(token)) s.batch.push_back(token);
+  }
+  for (size_t i = 0; i < s.watches.size();) {
+    Watch& watch = s.watches[i];
+    Slot* slot = find(watch.token);
+    if (slot && !watch.done(watch.user_data)) {
+      ++i;
+      continue;
+    }
+    if (mark_ready(watch.token)) s.batch.push_back(watch.token);
+    watch = s.watches.back();
+    s.watches.pop_back();
+  }
+
+  // Resumed coroutines may park again; those wait for the next pass.
+  for (size_t i = 0; i < s.batch.size(); ++i) {
+    Slot* slot = find(s.batch[i]);
+    if (!slot || !slot->ready) continue;
+    std::coroutine_handle<> handle = slot->handle;
+    Scheduler::unpark(s.batch[i]);
+    handle.resume();
+  }
+  s.running = false;
+  rearm();
+}
+
+void rearm() {
+  State& s = state();
+  if (s.running) return;  // run() rearms when it is done.
+  if (!s.timer) s.timer = lv_timer_create(run, 0, nullptr);
+  uint32_t period = UINT32_MAX;
+  if (!s.ready.empty() || !s.doomed.empty()) {
+    period = 0;
+  } else {
+    if (!s.sleepers.empty()) {
+      uint32_t now = lv_tick_get();
+      uint32_t due = s.sleepers.front().due;
+      period = before(now, due) ? due - now : 0;
+    }
+    if (!s.watches.empty()) {
+      period = std::min<uint32_t>(period, LV_DEF_REFR_PERIOD);
+    }
+  }
+  if (period == UINT32_MAX) {
+    lv_timer_pause(s.timer);
+    return;
+  }
+  lv_timer_set_period(s.timer, period);
+  lv_timer_reset(s.timer);
+  lv_timer_resume(s.timer);
+}
+
+void display_event_cb(lv_event_t* e) {
+  State& s = state();
+  if (lv_event_get_code(e) == LV_EVENT_DELETE) s.display = nullptr;
+  std::vector<uint64_t> waiting;
+  waiting.swap(s.after_frame);
+  for (uint64_t token : waiting) Scheduler::wake(token);
+}
+
+}  // namespace
+
+void* FramePool::allocate(size_t size) {
+  size_t size_class = (size + kFrameGranule - 1) / kFrameGranule;
+  if (size_class == 0 || size_class > kFrameClasses) {
+    return ::operator new(size);
+  }
+  void*& head = free_frames.heads[size_class - 1];
+  if (head) {
+    void* frame = head;
+    head = *static_cast<void**>(frame);
+    return frame;
+  }
+  return ::operator new(size_class * kFrameGranule);
+}
+
+void FramePool::deallocate(void* ptr, size_t size) {
+  size_t size_class = (size + kFrameGranule - 1) / kFrameGranule;
+  if (size_class == 0 || size_class > kFrameClasses) {
+    ::operator delete(ptr);
+    return;
+  }
+  void*& head = free_frames.heads[size_class - 1];
+  *static_cast<void**>(ptr) = head;
+  head = ptr;
+}
+
+uint64_t Scheduler::park(std::coroutine_handle<> handle) {
+  State& s = state();
+  uint32_t index;
+  if (!s.free_slots.empty()) {
+    index = s.free_slots.back();
+    s.free_slots.pop_back();
+  } else {
+    index = static_cast<uint32_t>(s.slots.size());
+    s.slots.emplace_back();
+  }
+  Slot& slot = s.slots[index];
+  slot.handle = handle;
+  slot.ready = false;
+  return (static_cast<uint64_t>(slot.generation) << 32) | index;
+}
+
+void Scheduler::unpark(uint64_t token) {
+  Slot* slot = find(token);
+  if (!slot) return;
+  slot->handle = nullptr;
+  slot->ready = false;
+  ++slot->generation;
+  state().free_slots.push_back(static_cast<uint32_t>(token));
+}
+
+void Scheduler::wake(uint64_t token) {
+  if (!mark_ready(token)) return;
+  state().ready.push_back(token);
+  rearm();
+}
+
+void Scheduler::wake_at(uint64_t token, uint32_t tick) {
+  State& s = state();
+  s.sleepers.push_back({tick, s.seq++, token});
+  std::push_heap(s.sleepers.begin(), s.sleepers.end(), later);
+  rearm();
+}
+
+void Scheduler::wake_after_frame(uint64_t token) {
+  State& s = state();
+  lv_display_t* display = lv_display_get_default();
+  if (!display) {
+    wake(token);
+    return;
+  }
+  if (s.display != display) {
+    if (s.display) {
+      lv_display_remove_event_cb_with_user_data(s.display, display_event_cb,
+                                                nullptr);
+    }
+    s.display = display;
+    lv_display_add_event_cb(display, display_event_cb, LV_EVENT_REFR_READY,
+                            nullptr);
+    lv_display_add_event_cb(display, display_event_cb, LV_EVENT_DELETE,
+                            nullptr);
+  }
+  s.after_frame.push_back(token);
+}
+
+void Scheduler::wake_when(uint64_t token, bool (*done)(void*),
+                          void* user_data) {
+  state().watches.push_back({token, done, user_data});
+  rearm();
+}
+
+void Scheduler::cancel(std::coroutine_handle<> root) {
+  state().doomed.push_back(root);
+  rearm();
+}
+
+void Scheduler::forget(std::coroutine_handle<> root) {
+  std::vector<std::coroutine_handle<>>& doomed = state().doomed;
+  doomed.erase(std::remove(doomed.begin(), doomed.end(), root), doomed.end());
+}
+
+PromiseBase::~PromiseBase() {
+  if (owner) {
+    lv_obj_remove_event_cb_with_user_data(owner, owner_deleted_cb, this);
+  }
+  if (cancel_pending) Scheduler::forget(handle);
+}
+
+std::coroutine_handle<> PromiseBase::finish(
+    std::coroutine_handle<> self) noexcept {
+  if (continuation) return continuation;
+  if (detached) self.destroy();
+  return std::noop_coroutine();
+}
+
+void PromiseBase::bind(lv_obj_t* obj, std::coroutine_handle<> self) {
+  owner = obj;
+  handle = self;
+  lv_obj_add_event_cb(obj, owner_deleted_cb, LV_EVENT_DELETE, this);
+}
+
+void PromiseBase::owner_deleted_cb(lv_event_t* e) {
+  auto* promise = static_cast<PromiseBase*>(lv_event_get_user_data(e));
+  promise->owner = nullptr;
+  if (promise->cancel_pending) return;
+  promise->cancel_pending = true;
+  Scheduler::cancel(promise->handle);
+}
+
+}  // namespace detail
+
+void DelayAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  token_ = detail::Scheduler::park(handle);
+  detail::Scheduler::wake_at(token_, lv_tick_get() + ms_);
+}
+
+void FrameAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  token_ = detail::Scheduler::park(handle);
+  detail::Scheduler::wake_after_frame(token_);
+}
+
+void AnimationAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  token_ = detail::Scheduler::park(handle);
+  uint64_t token = token_;
+  if (!handle_.on_finished([token]() { detail::Scheduler::wake(token); })) {
+    // Raw LVGL user data on the animation: check for its end every frame.
+    detail::Scheduler::wake_when(token_, is_stopped, &handle_);
+  }
+}
+
+bool AnimationAwaiter::is_stopped(void* user_data) {
+  return !static_cast<AnimationHandle*>(user_data)->is_running();
+}
+
+EventAwaiter::EventAwaiter(Object& obj, EventCode code)
+    : obj_(obj.raw()), code_(static_cast<lv_event_code_t>(code)) {}
+
+EventAwaiter::~EventAwaiter() {
+  if (registered_ && obj_) {
+    lv_obj_remove_event_cb_with_user_data(obj_, event_cb, this);
+  }
+}
+
+void EventAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  token_ = detail::Scheduler::park(handle);
+  lv_obj_add_event_cb(obj_, event_cb, code_, this);
+  if (code_ != LV_EVENT_DELETE) {
+    lv_obj_add_event_cb(obj_, event_cb, LV_EVENT_DELETE, this);
+  }
+  registered_ = true;
+}
+
+void EventAwaiter::event_cb(lv_event_t* e) {
+  auto* self = static_cast<EventAwaiter*>(lv_event_get_user_data(e));
+  lv_event_code_t code = lv_event_get_code(e);
+  if (code == self->code_) self->fired_ = true;
+  if (code == LV_EVENT_DELETE) {
+    // The object frees its callbacks itself.
+    self->obj_ = nullptr;
+    self->registered_ = false;
+  }
+  detail::Scheduler::wake(self->token_);
+}
+
+#if LV_USE_OBSERVER
+SubjectAwaiter::~SubjectAwaiter() {
+  if (observer_) lv_observer_remove(observer_);
+}
+
+void SubjectAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  token_ = detail::Scheduler::park(handle);
+  // Adding an observer notifies it once right away; that call is skipped.
+  adding_ = true;
+  observer_ = lv_subject_add_observer(subject_->raw(), observer_cb, this);
+  adding_ = false;
+}
+
+void SubjectAwaiter::observer_cb(lv_observer_t* observer, lv_subject_t*) {
+  auto* self =
+      static_cast<SubjectAwaiter*>(lv_observer_get_user_data(observer));
+  if (!self->adding_) detail::Scheduler::wake(self->token_);
+}
+#endif
+
+}  // namespace lvgl
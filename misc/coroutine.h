@@ -0,0 +1,387 @@
+#ifndef LVGL_CPP_MISC_COROUTINE_H_
+#define LVGL_CPP_MISC_COROUTINE_H_
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "../core/object.h"  // IWYU pragma: export
+#include "animation.h"
+#include "enums.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file coroutine.h
+ * @brief User Guide:
+ * `Task<T>` lets a multi-step UI flow be written as one C++20 coroutine
+ * instead of nested `Timer::oneshot` and `set_completed_cb` lambdas.
+ *
+ * Key Features:
+ * - **Awaitables**: `next_frame()`, `delay(ms)`, `co_await anim.start()`,
+ *   `event(obj, code)` and `subject_changed(subject)`.
+ * - **One timer**: Every suspended coroutine is resumed from a single
+ *   scheduler timer on the LVGL thread, never from inside an event or
+ *   animation callback.
+ * - **Pooled frames**: Coroutine frames come from size-class free lists, so
+ *   a flow that runs repeatedly stops allocating.
+ * - **Cancellation**: A task detached with an owner `Object` is destroyed
+ *   when the object is deleted, running the destructors of its locals.
+ *
+ * Example:
+ * @code
+ * lvgl::Task<> show_result(lvgl::Object& panel, lvgl::Button& retry) {
+ *   co_await fade_out(panel).start();
+ *   co_await lvgl::delay(200);
+ *   panel.remove_flag(lvgl::ObjFlag::Hidden);
+ *   if (co_await lvgl::event(retry, lvgl::EventCode::Clicked)) {
+ *     // ...
+ *   }
+ * }
+ *
+ * show_result(panel, retry).detach(panel);
+ * @endcode
+ *
+ * Tasks are lazy: nothing runs until the task is awaited, started or
+ * detached. Coroutines must only be used on the LVGL thread.
+ */
+namespace lvgl {
+
+#if LV_USE_OBSERVER
+class Subject;
+#endif
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief Free-list allocator for coroutine frames. The lists are per
+ * thread; frames may be created and destroyed on any thread.
+ */
+class FramePool {
+ public:
+  static void* allocate(size_t size);
+  static void deallocate(void* ptr, size_t size);
+};
+
+/**
+ * @brief Resumes parked coroutines from one LVGL timer.
+ *
+ * A suspended coroutine is parked under a token. Wake-ups only mark the
+ * token ready; the coroutine runs on the next scheduler pass, unless its
+ * awaiter was destroyed first.
+ */
+class Scheduler {
+ public:
+  static uint64_t park(std::coroutine_handle<> handle);
+  static void unpark(uint64_t token);
+  static void wake(uint64_t token);
+  static void wake_at(uint64_t token, uint32_t tick);
+  static void wake_after_frame(uint64_t token);
+  /** Wake `token` on the first pass at which `done(user_data)` is true. */
+  static void wake_when(uint64_t token, bool (*done)(void*), void* user_data);
+  /** Destroy a detached coroutine at the start of the next pass. */
+  static void cancel(std::coroutine_handle<> root);
+  static void forget(std::coroutine_handle<> root);
+};
+
+struct PromiseBase {
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename P>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<P> handle) noexcept {
+      return handle.promise().finish(handle);
+    }
+    void await_resume() const noexcept {}
+  };
+
+  static void* operator new(size_t size) { return FramePool::allocate(size); }
+  static void operator delete(void* ptr, size_t size) {
+    FramePool::deallocate(ptr, size);
+  }
+
+  ~PromiseBase();
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() const noexcept { std::terminate(); }
+
+  std::coroutine_handle<> finish(std::coroutine_handle<> self) noexcept;
+  void bind(lv_obj_t* obj, std::coroutine_handle<> self);
+
+  std::coroutine_handle<> continuation;
+  std::coroutine_handle<> handle;  // Set by bind().
+  lv_obj_t* owner = nullptr;
+  bool started = false;
+  bool detached = false;
+  bool cancel_pending = false;
+
+ private:
+  static void owner_deleted_cb(lv_event_t* e);
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+  Task<T> get_return_object() noexcept;
+  template <typename U>
+  void return_value(U&& value) {
+    result.emplace(std::forward<U>(value));
+  }
+  T take() { return std::move(*result); }
+
+  std::optional<T> result;
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+  Task<void> get_return_object() noexcept;
+  void return_void() const noexcept {}
+  void take() const noexcept {}
+};
+
+/**
+ * @brief Base of the awaitables: holds the parked token and unparks it
+ * when the awaiting coroutine is destroyed.
+ */
+class Waiter {
+ public:
+  Waiter(const Waiter&) = delete;
+  Waiter& operator=(const Waiter&) = delete;
+
+ protected:
+  Waiter() = default;
+  ~Waiter() {
+    if (token_) Scheduler::unpark(token_);
+  }
+
+  uint64_t token_ = 0;
+};
+
+}  // namespace detail
+
+/**
+ * @brief A lazily started coroutine returning `T`.
+ *
+ * Owning a task keeps its frame alive; destroying an unfinished task
+ * cancels it. `co_await task` runs it to completion and returns its value.
+ */
+template <typename T>
+class Task {
+ public:
+  using promise_type = detail::Promise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Task() = default;
+  explicit Task(Handle handle) : handle_(handle) {}
+  ~Task() {
+    if (handle_) handle_.destroy();
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) handle_.destroy();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  /**
+   * @brief True once the coroutine has returned (or for an empty task).
+   */
+  bool is_done() const { return !handle_ || handle_.done(); }
+
+  /**
+   * @brief Run the coroutine up to its first suspension. It keeps running
+   * from the scheduler while this task is alive.
+   */
+  Task& start() {
+    if (handle_ && !handle_.promise().started) {
+      handle_.promise().started = true;
+      handle_.resume();
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Start the coroutine and let it free itself when it returns.
+   */
+  void detach() {
+    if (!handle_) return;
+    Handle handle = std::exchange(handle_, {});
+    promise_type& promise = handle.promise();
+    if (handle.done()) {
+      handle.destroy();
+      return;
+    }
+    promise.detached = true;
+    if (!promise.started) {
+      promise.started = true;
+      handle.resume();  // May finish and free the frame.
+    }
+  }
+
+  /**
+   * @brief Like detach(), but the coroutine is also destroyed when `owner`
+   * is deleted. Cancellation takes effect at its next suspension.
+   */
+  void detach(Object& owner) {
+    if (handle_ && owner.raw()) handle_.promise().bind(owner.raw(), handle_);
+    detach();
+  }
+
+  auto operator co_await() && noexcept {
+    struct Awaiter {
+      Handle handle;
+      bool await_ready() const noexcept { return !handle || handle.done(); }
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<> awaiting) noexcept {
+        promise_type& promise = handle.promise();
+        promise.continuation = awaiting;
+        if (promise.started) return std::noop_coroutine();
+        promise.started = true;
+        return handle;
+      }
+      T await_resume() { return handle.promise().take(); }
+    };
+    return Awaiter{handle_};
+  }
+
+ private:
+  Handle handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+  return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+  return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Awaitable resuming after `ms` milliseconds. `delay(0)` yields to
+ * the next scheduler pass.
+ */
+class DelayAwaiter : private detail::Waiter {
+ public:
+  explicit DelayAwaiter(uint32_t ms) : ms_(ms) {}
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  void await_resume() const noexcept {}
+
+ private:
+  uint32_t ms_;
+};
+
+/**
+ * @brief Awaitable resuming after the default display's next refresh, or on
+ * the next pass when there is no display.
+ */
+class FrameAwaiter : private detail::Waiter {
+ public:
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Awaitable resuming when an animation ends. Animations that are not
+ * running do not suspend.
+ */
+class AnimationAwaiter : private detail::Waiter {
+ public:
+  explicit AnimationAwaiter(AnimationHandle handle) : handle_(handle) {}
+  bool await_ready() const { return !handle_.is_running(); }
+  void await_suspend(std::coroutine_handle<> handle);
+  void await_resume() const noexcept {}
+
+ private:
+  static bool is_stopped(void* user_data);
+  AnimationHandle handle_;
+};
+
+/**
+ * @brief Awaitable resuming when an object receives an event.
+ *
+ * `co_await` yields true when the event arrived and false when the object
+ * was deleted first.
+ */
+class EventAwaiter : private detail::Waiter {
+ public:
+  EventAwaiter(Object& obj, EventCode code);
+  ~EventAwaiter();
+  bool await_ready() const noexcept { return obj_ == nullptr; }
+  void await_suspend(std::coroutine_handle<> handle);
+  bool await_resume() const noexcept { return fired_; }
+
+ private:
+  static void event_cb(lv_event_t* e);
+  lv_obj_t* obj_;
+  lv_event_code_t code_;
+  bool registered_ = false;
+  bool fired_ = false;
+};
+
+#if LV_USE_OBSERVER
+/**
+ * @brief Awaitable resuming after a subject's next notification. The subject
+ * must outlive the wait.
+ */
+class SubjectAwaiter : private detail::Waiter {
+ public:
+  explicit SubjectAwaiter(Subject& subject) : subject_(&subject) {}
+  ~SubjectAwaiter();
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  void await_resume() const noexcept {}
+
+ private:
+  static void observer_cb(lv_observer_t* observer, lv_subject_t* subject);
+  Subject* subject_;
+  lv_observer_t* observer_ = nullptr;
+  bool adding_ = false;
+};
+#endif
+
+inline DelayAwaiter delay(uint32_t ms) { return DelayAwaiter(ms); }
+
+inline DelayAwaiter delay(std::chrono::milliseconds ms) {
+  return DelayAwaiter(static_cast<uint32_t>(ms.count()));
+}
+
+inline FrameAwaiter next_frame() { return FrameAwaiter(); }
+
+inline EventAwaiter event(Object& obj, EventCode code) {
+  return EventAwaiter(obj, code);
+}
+
+#if LV_USE_OBSERVER
+inline SubjectAwaiter subject_changed(Subject& subject) {
+  return SubjectAwaiter(subject);
+}
+#endif
+
+/**
+ * @brief Makes `co_await animation.start()` wait for the animation to end.
+ */
+inline AnimationAwaiter operator co_await(AnimationHandle handle) {
+  return AnimationAwaiter(handle);
+}
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_COROUTINE_H_
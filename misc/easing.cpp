@@ -0,0 +1,69 @@
+#include "easing.h"
+
+#include <cstring>
+
+namespace lvgl {
+
+namespace {
+
+constexpr int kEasingCount = static_cast<int>(Easing::Step) + 1;
+
+struct Tables {
+  int16_t samples[kEasingCount][EasingTable::kSteps + 1];
+
+  Tables() {
+    lv_anim_t anim;
+    std::memset(&anim, 0, sizeof(anim));
+    anim.start_value = 0;
+    anim.end_value = EasingTable::kResolution;
+    anim.duration = EasingTable::kResolution;
+    for (int e = 0; e < kEasingCount; ++e) {
+      lv_anim_path_cb_t path = EasingTable::path_cb(static_cast<Easing>(e));
+      for (int32_t i = 0; i <= EasingTable::kSteps; ++i) {
+        anim.act_time = i << EasingTable::kStepShift;
+        samples[e][i] = static_cast<int16_t>(path(&anim));
+      }
+    }
+    // Step only jumps at the very end; keep the last interval flat.
+    samples[static_cast<int>(Easing::Step)][EasingTable::kSteps] = 0;
+  }
+};
+
+const Tables& tables() {
+  static const Tables instance;
+  return instance;
+}
+
+}  // namespace
+
+const int16_t* EasingTable::get(Easing easing) {
+  return tables().samples[static_cast<int>(easing)];
+}
+
+int32_t EasingTable::eval(Easing easing, int32_t progress) {
+  if (progress >= kResolution) return kResolution;
+  if (progress <= 0) return 0;
+  return sample(get(easing), progress);
+}
+
+lv_anim_path_cb_t EasingTable::path_cb(Easing easing) {
+  switch (easing) {
+    case Easing::EaseIn:
+      return lv_anim_path_ease_in;
+    case Easing::EaseOut:
+      return lv_anim_path_ease_out;
+    case Easing::EaseInOut:
+      return lv_anim_path_ease_in_out;
+    case Easing::Overshoot:
+      return lv_anim_path_overshoot;
+    case Easing::Bounce:
+      return lv_anim_path_bounce;
+    case Easing::Step:
+      return lv_anim_path_step;
+    case Easing::Linear:
+    default:
+      return lv_anim_path_linear;
+  }
+}
+
+}  // namespace lvgl
@@ -0,0 +1,73 @@
+#ifndef LVGL_CPP_MISC_EASING_H_
+#define LVGL_CPP_MISC_EASING_H_
+
+#include <cstdint>
+
+#include "lvgl.h"  // IWYU pragma: export
+
+namespace lvgl {
+
+/**
+ * @brief The built-in LVGL animation paths, as plain ids.
+ */
+enum class Easing : uint8_t {
+  Linear,
+  EaseIn,
+  EaseOut,
+  EaseInOut,
+  Overshoot,
+  Bounce,
+  Step,
+};
+
+/**
+ * @brief Precomputed easing curves.
+ *
+ * Each curve is sampled once from the matching `lv_anim_path_*` function
+ * and evaluated by linear interpolation between samples, which is cheap
+ * enough to run over thousands of values per frame. Results stay within
+ * a few units of 1024 of LVGL's own paths.
+ */
+class EasingTable {
+ public:
+  /** Progress and eased values are on a 0..kResolution scale. */
+  static constexpr int32_t kShift = LV_BEZIER_VAL_SHIFT;
+  static constexpr int32_t kResolution = 1 << kShift;
+
+  /** Samples per curve, not counting the final one at kResolution. */
+  static constexpr int32_t kSteps = 256;
+
+  static constexpr int32_t kStepShift = 2;  // kResolution / kSteps == 4
+
+  /**
+   * @brief The `kSteps + 1` samples of a curve. Built on first use. The
+   * last sample is the value just before the end, so it is 0 for Step.
+   */
+  static const int16_t* get(Easing easing);
+
+  /**
+   * @brief Eased value of `progress` (0..kResolution). Every curve ends at
+   * exactly kResolution.
+   */
+  static int32_t eval(Easing easing, int32_t progress);
+
+  /**
+   * @brief Interpolate samples from get() at `progress`, which must be in
+   * 0..kResolution - 1. Inline for use in per-frame loops.
+   */
+  static int32_t sample(const int16_t* samples, int32_t progress) {
+    int32_t index = progress >> kStepShift;
+    int32_t frac = progress & ((1 << kStepShift) - 1);
+    int32_t a = samples[index];
+    return a + (((samples[index + 1] - a) * frac) >> kStepShift);
+  }
+
+  /**
+   * @brief The LVGL path function an easing was sampled from.
+   */
+  static lv_anim_path_cb_t path_cb(Easing easing);
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_EASING_H_
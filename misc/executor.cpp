@@ -0,0 +1,212 @@
+#include "executor.h"
+
+#include <algorithm>
+#include <deque>
+
+namespace lvgl {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// The pool and worker index of the current thread, if it is a worker.
+thread_local const Executor* current_pool = nullptr;
+thread_local uint32_t current_worker = 0;
+
+uint64_t to_us(Clock::duration duration) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void store_max(std::atomic<uint64_t>& target, uint64_t value) {
+  uint64_t current = target.load(std::memory_order_relaxed);
+  while (value > current &&
+         !target.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+namespace detail {
+
+void JobMetrics::record(Clock::time_point queued, Clock::time_point started,
+                        Clock::time_point finished) {
+  uint64_t wait = to_us(started - queued);
+  uint64_t run = to_us(finished - started);
+  completed_.fetch_add(1, std::memory_order_relaxed);
+  total_wait_us_.fetch_add(wait, std::memory_order_relaxed);
+  total_run_us_.fetch_add(run, std::memory_order_relaxed);
+  store_max(max_wait_us_, wait);
+  store_max(max_run_us_, run);
+}
+
+ExecutorMetrics JobMetrics::get() const {
+  ExecutorMetrics metrics;
+  metrics.completed = completed_.load(std::memory_order_relaxed);
+  metrics.rejected = rejected.load(std::memory_order_relaxed);
+  metrics.stolen = stolen.load(std::memory_order_relaxed);
+  metrics.total_wait_us = total_wait_us_.load(std::memory_order_relaxed);
+  metrics.max_wait_us = max_wait_us_.load(std::memory_order_relaxed);
+  metrics.total_run_us = total_run_us_.load(std::memory_order_relaxed);
+  metrics.max_run_us = max_run_us_.load(std::memory_order_relaxed);
+  return metrics;
+}
+
+}  // namespace detail
+
+UiExecutor::UiExecutor(uint32_t drain_period)
+    : ui_thread_(std::this_thread::get_id()) {
+  timer_ = lv_timer_create(timer_cb, drain_period, this);
+}
+
+UiExecutor::~UiExecutor() {
+  if (timer_) lv_timer_delete(timer_);
+}
+
+void UiExecutor::post(std::function<void()> fn) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back({std::move(fn), Clock::now()});
+  }
+  pending_.store(true, std::memory_order_release);
+}
+
+uint32_t UiExecutor::drain() {
+  if (!pending_.exchange(false, std::memory_order_acquire)) return 0;
+  // Taken out of the member so that a job may call drain() itself.
+  std::vector<detail::Job> jobs = std::move(running_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs.swap(queue_);
+  }
+  for (detail::Job& job : jobs) {
+    Clock::time_point started = Clock::now();
+    job.fn();
+    metrics_.record(job.queued, started, Clock::now());
+  }
+  uint32_t count = static_cast<uint32_t>(jobs.size());
+  jobs.clear();
+  running_ = std::move(jobs);
+  return count;
+}
+
+void UiExecutor::timer_cb(lv_timer_t* timer) {
+  static_cast<UiExecutor*>(lv_timer_get_user_data(timer))->drain();
+}
+
+struct Executor::Worker {
+  std::mutex mutex;
+  std::deque<detail::Job> jobs;
+  std::thread thread;
+};
+
+Executor::Executor(UiExecutor& ui, uint32_t threads, size_t capacity)
+    : ui_(ui), capacity_(std::max<size_t>(capacity, 1)) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (uint32_t i = 0; i < threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (uint32_t i = 0; i < threads; ++i) {
+    workers_[i]->thread = std::thread(&Executor::run_worker, this, i);
+  }
+}
+
+Executor::~Executor() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  work_cv_.notify_all();
+  space_cv_.notify_all();
+  for (auto& worker : workers_) worker->thread.join();
+}
+
+void Executor::post(std::function<void()> fn) {
+  if (current_pool == this) {
+    // A blocked worker could wait for itself, so workers never block.
+    pending_.fetch_add(1);
+  } else {
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    space_cv_.wait(lock, [this]() { return pending_.load() < capacity_; });
+    pending_.fetch_add(1);
+  }
+  push({std::move(fn), Clock::now()});
+}
+
+bool Executor::try_post(std::function<void()> fn) {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    if (pending_.load() >= capacity_) {
+      metrics_.rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    pending_.fetch_add(1);
+  }
+  push({std::move(fn), Clock::now()});
+  return true;
+}
+
+void Executor::push(detail::Job job) {
+  uint32_t index = current_pool == this
+                       ? current_worker
+                       : next_.fetch_add(1) % workers_.size();
+  {
+    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+    workers_[index]->jobs.push_back(std::move(job));
+  }
+  queued_.fetch_add(1);
+  {
+    // Pairs with the check in run_worker() so the wake-up is not lost.
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  work_cv_.notify_one();
+}
+
+bool Executor::pop(uint32_t index, detail::Job& job) {
+  size_t count = workers_.size();
+  for (size_t i = 0; i < count; ++i) {
+    Worker& worker = *workers_[(index + i) % count];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.jobs.empty()) continue;
+    // Own jobs are taken oldest first; stolen ones newest first, which
+    // keeps the two ends of a queue apart.
+    if (i == 0) {
+      job = std::move(worker.jobs.front());
+      worker.jobs.pop_front();
+    } else {
+      job = std::move(worker.jobs.back());
+      worker.jobs.pop_back();
+      metrics_.stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+    queued_.fetch_sub(1);
+    if (pending_.fetch_sub(1) >= capacity_) {
+      std::lock_guard<std::mutex> sleep_lock(sleep_mutex_);
+      space_cv_.notify_one();
+    }
+    return true;
+  }
+  return false;
+}
+
+void Executor::run_worker(uint32_t index) {
+  current_pool = this;
+  current_worker = index;
+  for (;;) {
+    detail::Job job;
+    if (pop(index, job)) {
+      Clock::time_point started = Clock::now();
+      job.fn();
+      metrics_.record(job.queued, started, Clock::now());
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    if (queued_.load() > 0) continue;
+    if (stopping_) return;
+    work_cv_.wait(lock);
+  }
+}
+
+}  // namespace lvgl
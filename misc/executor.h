@@ -0,0 +1,265 @@
+#ifndef LVGL_CPP_MISC_EXECUTOR_H_
+#define LVGL_CPP_MISC_EXECUTOR_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file executor.h
+ * @brief User Guide:
+ * `Executor` runs CPU-heavy work (parsing, image processing, chart
+ * decimation) on a fixed pool of threads, and `UiExecutor` brings results
+ * back to the LVGL thread. Neither touches LVGL from a worker.
+ *
+ * Key Features:
+ * - **Work stealing**: Each worker has its own queue; idle workers take
+ *   jobs from busy ones.
+ * - **Back-pressure**: `post()` blocks while `capacity` jobs are queued,
+ *   and `try_post()` refuses instead, so a fast producer cannot queue
+ *   unbounded work.
+ * - **Ordering**: UI jobs run in the order they were posted. Jobs posted
+ *   by one thread therefore reach the UI in that thread's order. Pool
+ *   jobs have no ordering.
+ * - **Metrics**: Both executors count jobs and record queue wait and run
+ *   time.
+ * - **Coroutines**: `co_await pool.schedule()` continues a `Task` on a
+ *   worker and `co_await ui.schedule()` brings it back.
+ *
+ * Example:
+ * @code
+ * lvgl::UiExecutor ui;
+ * lvgl::Executor pool(ui);
+ * pool.then_on_ui([path]() { return parse_csv(path); },
+ *                 [&chart](Series series) { chart.set_series(series); });
+ * @endcode
+ *
+ * A `Task` that switches to the pool must be back on the LVGL thread before
+ * it returns, and must not be detached with an owner object, which could
+ * cancel it while a worker runs it. Destroy the `Executor` before the
+ * `UiExecutor` it posts to.
+ */
+namespace lvgl {
+
+/**
+ * @brief Counters kept by an executor. Times are in microseconds.
+ */
+struct ExecutorMetrics {
+  uint64_t completed = 0;
+  uint64_t rejected = 0;  ///< try_post() calls refused for back-pressure.
+  uint64_t stolen = 0;    ///< Pool jobs run by a worker that did not own them.
+  uint64_t total_wait_us = 0;
+  uint64_t max_wait_us = 0;
+  uint64_t total_run_us = 0;
+  uint64_t max_run_us = 0;
+};
+
+namespace detail {
+
+struct Job {
+  std::function<void()> fn;
+  std::chrono::steady_clock::time_point queued;
+};
+
+class JobMetrics {
+ public:
+  void record(std::chrono::steady_clock::time_point queued,
+              std::chrono::steady_clock::time_point started,
+              std::chrono::steady_clock::time_point finished);
+  ExecutorMetrics get() const;
+
+  std::atomic<uint64_t> rejected{0};
+  std::atomic<uint64_t> stolen{0};
+
+ private:
+  std::atomic<uint64_t> completed_{0};
+  std::atomic<uint64_t> total_wait_us_{0};
+  std::atomic<uint64_t> max_wait_us_{0};
+  std::atomic<uint64_t> total_run_us_{0};
+  std::atomic<uint64_t> max_run_us_{0};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Runs jobs on the LVGL thread. Jobs may be posted from any thread
+ * and are run by an LVGL timer, or by drain().
+ */
+class UiExecutor {
+ public:
+  /** Default interval between drains of the job queue. */
+  static constexpr uint32_t kDefaultDrainPeriod = 5;
+
+  /**
+   * @brief Create on the LVGL thread.
+   */
+  explicit UiExecutor(uint32_t drain_period = kDefaultDrainPeriod);
+  ~UiExecutor();
+
+  UiExecutor(const UiExecutor&) = delete;
+  UiExecutor& operator=(const UiExecutor&) = delete;
+
+  /**
+   * @brief Queue `fn` to run on the LVGL thread. Never blocks.
+   */
+  void post(std::function<void()> fn);
+
+  /**
+   * @brief Run the queued jobs now. LVGL thread only.
+   * @return Number of jobs run.
+   */
+  uint32_t drain();
+
+  /**
+   * @brief True on the thread that created this executor.
+   */
+  bool is_ui_thread() const {
+    return std::this_thread::get_id() == ui_thread_;
+  }
+
+  ExecutorMetrics get_metrics() const { return metrics_.get(); }
+
+  /**
+   * @brief Awaitable that continues a coroutine on the LVGL thread. It does
+   * not suspend when already there.
+   */
+  auto schedule() {
+    struct Awaiter {
+      UiExecutor* ui;
+      bool await_ready() const { return ui->is_ui_thread(); }
+      void await_suspend(std::coroutine_handle<> handle) {
+        ui->post([handle]() { handle.resume(); });
+      }
+      void await_resume() const noexcept {}
+    };
+    return Awaiter{this};
+  }
+
+ private:
+  static void timer_cb(lv_timer_t* timer);
+
+  std::thread::id ui_thread_;
+  lv_timer_t* timer_ = nullptr;
+  std::mutex mutex_;
+  std::vector<detail::Job> queue_;
+  std::vector<detail::Job> running_;
+  std::atomic<bool> pending_{false};
+  detail::JobMetrics metrics_;
+};
+
+/**
+ * @brief Fixed-size work-stealing thread pool.
+ */
+class Executor {
+ public:
+  /** Jobs that may be queued before post() blocks. */
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  /**
+   * @param ui Executor receiving then_on_ui() continuations.
+   * @param threads Worker count; 0 uses the hardware concurrency.
+   * @param capacity Queued jobs allowed before post() blocks.
+   */
+  explicit Executor(UiExecutor& ui, uint32_t threads = 0,
+                    size_t capacity = kDefaultCapacity);
+
+  /**
+   * @brief Runs every queued job, then joins the workers.
+   */
+  ~Executor();
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  /**
+   * @brief Queue `fn` on the pool, blocking while it is at capacity. Jobs
+   * posted from a worker never block, so a job can always fan out.
+   */
+  void post(std::function<void()> fn);
+
+  /**
+   * @brief Queue `fn` unless the pool is at capacity.
+   * @return false if the job was refused.
+   */
+  bool try_post(std::function<void()> fn);
+
+  /**
+   * @brief Run `work` on the pool and pass its result to `done` on the
+   * LVGL thread.
+   */
+  template <typename Work, typename Done>
+  void then_on_ui(Work work, Done done) {
+    UiExecutor* ui = &ui_;
+    post([ui, work = std::move(work), done = std::move(done)]() mutable {
+      if constexpr (std::is_void_v<std::invoke_result_t<Work&>>) {
+        work();
+        ui->post(std::move(done));
+      } else {
+        ui->post([done = std::move(done), result = work()]() mutable {
+          done(std::move(result));
+        });
+      }
+    });
+  }
+
+  uint32_t get_thread_count() const {
+    return static_cast<uint32_t>(workers_.size());
+  }
+
+  /**
+   * @brief Jobs queued and not yet started.
+   */
+  size_t get_pending() const { return pending_.load(); }
+
+  ExecutorMetrics get_metrics() const { return metrics_.get(); }
+
+  /**
+   * @brief Awaitable that continues a coroutine on a worker thread.
+   */
+  auto schedule() {
+    struct Awaiter {
+      Executor* pool;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> handle) {
+        pool->post([handle]() { handle.resume(); });
+      }
+      void await_resume() const noexcept {}
+    };
+    return Awaiter{this};
+  }
+
+ private:
+  struct Worker;
+
+  void push(detail::Job job);
+  bool pop(uint32_t index, detail::Job& job);
+  void run_worker(uint32_t index);
+
+  UiExecutor& ui_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  size_t capacity_;
+  std::atomic<size_t> pending_{0};  // Queued or reserved by a poster.
+  std::atomic<size_t> queued_{0};   // In a worker's queue.
+  std::atomic<uint32_t> next_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable space_cv_;
+  bool stopping_ = false;
+  detail::JobMetrics metrics_;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_EXECUTOR_H_
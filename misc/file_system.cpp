@@ -1,5 +1,7 @@
 #include "file_system.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>  // for memset
 
 #include "../core/compatibility.h"
@@ -71,6 +73,7 @@ File::File(File&& other) noexcept
     : file_(other.file_), is_opened_(other.is_opened_) {
   other.is_opened_ = false;
   std::memset(&other.file_, 0, sizeof(other.file_));
+  adopt_requests(other);
 }
 
 File& File::operator=(File&& other) noexcept {
@@ -80,6 +83,7 @@ File& File::operator=(File&& other) noexcept {
     is_opened_ = other.is_opened_;
     other.is_opened_ = false;
     std::memset(&other.file_, 0, sizeof(other.file_));
+    adopt_requests(other);
   }
   return *this;
 }
@@ -95,6 +99,7 @@ FsRes File::open(const std::string& path, FsMode mode) {
 }
 
 FsRes File::close() {
+  cancel_requests();
   if (is_opened_) {
     lv_fs_res_t res = lv_fs_close(&file_);
     is_opened_ = false;
@@ -277,4 +282,372 @@ std::vector<uint8_t> File::load_to_buffer(const std::string& path) {
   return buf;
 }
 
+// --- FileSystemDriver ---
+
+namespace {
+
+// Descriptors of destroyed drivers. LVGL keeps pointers to them in its driver
+// list, so they are parked here and handed to the next driver created for the
+// same letter.
+std::vector<lv_fs_drv_t*>& detached_drivers() {
+  static std::vector<lv_fs_drv_t*> drivers;
+  return drivers;
+}
+
+}  // namespace
+
+FileSystemDriver::FileSystemDriver(char letter) : drv_(nullptr) {
+  auto& detached = detached_drivers();
+  auto it = std::find_if(
+      detached.begin(), detached.end(),
+      [letter](lv_fs_drv_t* d) { return d->letter == letter; });
+  if (it != detached.end()) {
+    drv_ = *it;
+    detached.erase(it);
+  } else {
+    drv_ = new lv_fs_drv_t;
+    lv_fs_drv_init(drv_);
+    drv_->letter = letter;
+    drv_->cache_size = 0;
+    drv_->ready_cb = ready_proxy;
+    drv_->open_cb = open_proxy;
+    drv_->close_cb = close_proxy;
+    drv_->read_cb = read_proxy;
+    drv_->write_cb = write_proxy;
+    drv_->seek_cb = seek_proxy;
+    drv_->tell_cb = tell_proxy;
+    drv_->dir_open_cb = dir_open_proxy;
+    drv_->dir_read_cb = dir_read_proxy;
+    drv_->dir_close_cb = dir_close_proxy;
+    lv_fs_drv_register(drv_);
+  }
+  drv_->user_data = this;
+}
+
+FileSystemDriver::~FileSystemDriver() {
+  drv_->user_data = nullptr;
+  detached_drivers().push_back(drv_);
+}
+
+char FileSystemDriver::get_letter() const { return drv_->letter; }
+
+lv_fs_drv_t* FileSystemDriver::raw() { return drv_; }
+
+bool FileSystemDriver::ready() { return true; }
+
+FsRes FileSystemDriver::write(void* file, const void* buf, uint32_t btw,
+                              uint32_t* bw) {
+  (void)file;
+  (void)buf;
+  (void)btw;
+  if (bw) *bw = 0;
+  return FsRes::NotImp;
+}
+
+void* FileSystemDriver::dir_open(const char* path) {
+  (void)path;
+  return nullptr;
+}
+
+FsRes FileSystemDriver::dir_read(void* dir, char* fn, uint32_t fn_len) {
+  (void)dir;
+  (void)fn;
+  (void)fn_len;
+  return FsRes::NotImp;
+}
+
+FsRes FileSystemDriver::dir_close(void* dir) {
+  (void)dir;
+  return FsRes::NotImp;
+}
+
+FileSystemDriver* FileSystemDriver::from(lv_fs_drv_t* drv) {
+  return drv ? static_cast<FileSystemDriver*>(drv->user_data) : nullptr;
+}
+
+bool FileSystemDriver::ready_proxy(lv_fs_drv_t* drv) {
+  FileSystemDriver* self = from(drv);
+  return self && self->ready();
+}
+
+void* FileSystemDriver::open_proxy(lv_fs_drv_t* drv, const char* path,
+                                   lv_fs_mode_t mode) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return nullptr;
+  return self->open(path, static_cast<FsMode>(mode));
+}
+
+lv_fs_res_t FileSystemDriver::close_proxy(lv_fs_drv_t* drv, void* file_p) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return LV_FS_RES_NOT_EX;
+  return static_cast<lv_fs_res_t>(self->close(file_p));
+}
+
+lv_fs_res_t FileSystemDriver::read_proxy(lv_fs_drv_t* drv, void* file_p,
+                                         void* buf, uint32_t btr,
+                                         uint32_t* br) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return LV_FS_RES_NOT_EX;
+  return static_cast<lv_fs_res_t>(self->read(file_p, buf, btr, br));
+}
+
+lv_fs_res_t FileSystemDriver::write_proxy(lv_fs_drv_t* drv, void* file_p,
+                                          const void* buf, uint32_t btw,
+                                          uint32_t* bw) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return LV_FS_RES_NOT_EX;
+  return static_cast<lv_fs_res_t>(self->write(file_p, buf, btw, bw));
+}
+
+lv_fs_res_t FileSystemDriver::seek_proxy(lv_fs_drv_t* drv, void* file_p,
+                                         uint32_t pos, lv_fs_whence_t whence) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return LV_FS_RES_NOT_EX;
+  return static_cast<lv_fs_res_t>(
+      self->seek(file_p, pos, static_cast<FsWhence>(whence)));
+}
+
+lv_fs_res_t FileSystemDriver::tell_proxy(lv_fs_drv_t* drv, void* file_p,
+                                         uint32_t* pos_p) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return LV_FS_RES_NOT_EX;
+  return static_cast<lv_fs_res_t>(self->tell(file_p, pos_p));
+}
+
+void* FileSystemDriver::dir_open_proxy(lv_fs_drv_t* drv, const char* path) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return nullptr;
+  return self->dir_open(path);
+}
+
+lv_fs_res_t FileSystemDriver::dir_read_proxy(lv_fs_drv_t* drv, void* rddir_p,
+                                             char* fn, uint32_t fn_len) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return LV_FS_RES_NOT_EX;
+  return static_cast<lv_fs_res_t>(self->dir_read(rddir_p, fn, fn_len));
+}
+
+lv_fs_res_t FileSystemDriver::dir_close_proxy(lv_fs_drv_t* drv,
+                                              void* rddir_p) {
+  FileSystemDriver* self = from(drv);
+  if (!self) return LV_FS_RES_NOT_EX;
+  return static_cast<lv_fs_res_t>(self->dir_close(rddir_p));
+}
+
+// --- RamFileSystem ---
+
+struct RamFileSystem::Entry {
+  std::vector<uint8_t> bytes;
+  const uint8_t* external = nullptr;  ///< Set for add_file_static() files.
+  size_t external_size = 0;
+
+  const uint8_t* data() const { return external ? external : bytes.data(); }
+  size_t size() const { return external ? external_size : bytes.size(); }
+
+  std::vector<uint8_t>& writable() {
+    if (external) {
+      bytes.assign(external, external + external_size);
+      external = nullptr;
+      external_size = 0;
+    }
+    return bytes;
+  }
+};
+
+struct RamFileSystem::OpenFile {
+  std::shared_ptr<Entry> entry;
+  uint32_t pos = 0;
+  uint8_t mode = 0;
+};
+
+struct RamFileSystem::OpenDir {
+  std::vector<std::string> names;
+  size_t next = 0;
+};
+
+RamFileSystem::RamFileSystem(char letter) : FileSystemDriver(letter) {}
+
+RamFileSystem::~RamFileSystem() = default;
+
+void RamFileSystem::add_file(const std::string& path, const void* data,
+                             size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  add_file(path, std::vector<uint8_t>(bytes, bytes + size));
+}
+
+void RamFileSystem::add_file(const std::string& path,
+                             std::vector<uint8_t> data) {
+  auto entry = std::make_shared<Entry>();
+  entry->bytes = std::move(data);
+  files_[normalize(path)] = std::move(entry);
+}
+
+void RamFileSystem::add_file_static(const std::string& path, const void* data,
+                                    size_t size) {
+  auto entry = std::make_shared<Entry>();
+  entry->external = static_cast<const uint8_t*>(data);
+  entry->external_size = size;
+  files_[normalize(path)] = std::move(entry);
+}
+
+bool RamFileSystem::remove_file(const std::string& path) {
+  return files_.erase(normalize(path)) > 0;
+}
+
+void RamFileSystem::clear() { files_.clear(); }
+
+bool RamFileSystem::contains(const std::string& path) const {
+  return files_.count(normalize(path)) > 0;
+}
+
+std::span<const uint8_t> RamFileSystem::view(const std::string& path) const {
+  auto it = files_.find(normalize(path));
+  if (it == files_.end()) return {};
+  return {it->second->data(), it->second->size()};
+}
+
+size_t RamFileSystem::get_file_count() const { return files_.size(); }
+
+size_t RamFileSystem::get_total_size() const {
+  size_t total = 0;
+  for (const auto& [path, entry] : files_) total += entry->size();
+  return total;
+}
+
+void* RamFileSystem::open(const char* path, FsMode mode) {
+  std::string key = normalize(path);
+  auto it = files_.find(key);
+  if (mode == FsMode::Write) {
+    // Write-only opens create or truncate, like fopen(path, "wb").
+    if (it == files_.end()) {
+      it = files_.emplace(key, std::make_shared<Entry>()).first;
+    } else {
+      it->second->external = nullptr;
+      it->second->external_size = 0;
+      it->second->bytes.clear();
+    }
+  } else if (it == files_.end()) {
+    return nullptr;
+  }
+
+  auto* f = new OpenFile;
+  f->entry = it->second;
+  f->mode = static_cast<uint8_t>(mode);
+  return f;
+}
+
+FsRes RamFileSystem::close(void* file) {
+  delete static_cast<OpenFile*>(file);
+  return FsRes::Ok;
+}
+
+FsRes RamFileSystem::read(void* file, void* buf, uint32_t btr, uint32_t* br) {
+  auto* f = static_cast<OpenFile*>(file);
+  if (br) *br = 0;
+  if (!(f->mode & LV_FS_MODE_RD)) return FsRes::Denied;
+
+  size_t size = f->entry->size();
+  uint32_t n = 0;
+  if (f->pos < size) {
+    n = static_cast<uint32_t>(std::min<size_t>(btr, size - f->pos));
+    std::memcpy(buf, f->entry->data() + f->pos, n);
+  }
+  f->pos += n;
+  if (br) *br = n;
+  return FsRes::Ok;
+}
+
+FsRes RamFileSystem::write(void* file, const void* buf, uint32_t btw,
+                           uint32_t* bw) {
+  auto* f = static_cast<OpenFile*>(file);
+  if (bw) *bw = 0;
+  if (!(f->mode & LV_FS_MODE_WR)) return FsRes::Denied;
+
+  std::vector<uint8_t>& bytes = f->entry->writable();
+  size_t end = static_cast<size_t>(f->pos) + btw;
+  if (bytes.size() < end) bytes.resize(end);
+  std::memcpy(bytes.data() + f->pos, buf, btw);
+  f->pos += btw;
+  if (bw) *bw = btw;
+  return FsRes::Ok;
+}
+
+FsRes RamFileSystem::seek(void* file, uint32_t pos, FsWhence whence) {
+  auto* f = static_cast<OpenFile*>(file);
+  switch (whence) {
+    case FsWhence::Set:
+      f->pos = pos;
+      break;
+    case FsWhence::Cur:
+      f->pos += pos;
+      break;
+    case FsWhence::End:
+      f->pos = static_cast<uint32_t>(f->entry->size()) + pos;
+      break;
+  }
+  return FsRes::Ok;
+}
+
+FsRes RamFileSystem::tell(void* file, uint32_t* pos) {
+  *pos = static_cast<OpenFile*>(file)->pos;
+  return FsRes::Ok;
+}
+
+void* RamFileSystem::dir_open(const char* path) {
+  std::string prefix = normalize(path);
+  if (!prefix.empty()) prefix += '/';
+
+  auto* dir = new OpenDir;
+  // Keys sharing a prefix are contiguous in the map, and so are the files of
+  // each sub-directory, which is reported once.
+  for (auto it = files_.lower_bound(prefix);
+       it != files_.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+       ++it) {
+    std::string rest = it->first.substr(prefix.size());
+    size_t slash = rest.find('/');
+    if (slash == std::string::npos) {
+      dir->names.push_back(std::move(rest));
+      continue;
+    }
+    std::string sub = "/" + rest.substr(0, slash);
+    if (dir->names.empty() || dir->names.back() != sub) {
+      dir->names.push_back(std::move(sub));
+    }
+  }
+
+  if (dir->names.empty() && !prefix.empty()) {
+    delete dir;
+    return nullptr;
+  }
+  return dir;
+}
+
+FsRes RamFileSystem::dir_read(void* dir, char* fn, uint32_t fn_len) {
+  auto* d = static_cast<OpenDir*>(dir);
+  if (fn_len == 0) return FsRes::InvParam;
+  if (d->next >= d->names.size()) {
+    fn[0] = '\0';
+    return FsRes::Ok;
+  }
+  std::snprintf(fn, fn_len, "%s", d->names[d->next++].c_str());
+  return FsRes::Ok;
+}
+
+FsRes RamFileSystem::dir_close(void* dir) {
+  delete static_cast<OpenDir*>(dir);
+  return FsRes::Ok;
+}
+
+std::string RamFileSystem::normalize(const std::string& path) const {
+  size_t start = 0;
+  if (path.size() >= 2 && path[1] == ':') start = 2;
+  while (start < path.size() && (path[start] == '/' || path[start] == '\\')) {
+    start++;
+  }
+  std::string key = path.substr(start);
+  while (!key.empty() && key.back() == '/') key.pop_back();
+  if (key == ".") key.clear();
+  return key;
+}
+
 }  // namespace lvgl
@@ -2,6 +2,10 @@
 #define LVGL_CPP_MISC_FILE_SYSTEM_H_
 
 #include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -10,6 +14,59 @@
 
 namespace lvgl {
 
+/**
+ * @brief Completion callback of an asynchronous read.
+ *
+ * Runs on the LVGL thread. `data` holds the bytes read (possibly fewer than
+ * requested at end of file) and is empty on error.
+ */
+using FileLoadCallback =
+    std::function<void(FsRes res, std::vector<uint8_t> data)>;
+
+/**
+ * @brief Handle for an asynchronous file read.
+ *
+ * Destroying the handle cancels the request unless release() was called.
+ * A cancelled request never invokes its callback. Move-only.
+ */
+class FileRequest {
+ public:
+  FileRequest();
+  ~FileRequest();
+
+  FileRequest(const FileRequest&) = delete;
+  FileRequest& operator=(const FileRequest&) = delete;
+  FileRequest(FileRequest&& other) noexcept;
+  FileRequest& operator=(FileRequest&& other) noexcept;
+
+  /**
+   * @brief Cancel the request.
+   * @return true if cancelled, false if already completed or invalid.
+   */
+  bool cancel();
+
+  /**
+   * @brief Check if the request is still pending.
+   */
+  bool valid() const;
+
+  /**
+   * @brief Let the request complete even after the handle is destroyed.
+   */
+  void release();
+
+ private:
+  struct State;
+
+  explicit FileRequest(std::shared_ptr<State> state);
+
+  std::shared_ptr<State> state_;
+
+  friend class AsyncFileIo;
+  friend class File;
+  friend class FileSystem;
+};
+
 /**
  * @brief Wrapper for file operations (lv_fs_file_t)
  */
@@ -55,6 +112,23 @@ class File {
    */
   static std::vector<uint8_t> load_to_buffer(const std::string& path);
 
+  /**
+   * @brief Read `btr` bytes at `offset` without blocking the LVGL thread.
+   *
+   * Files on the stdio/posix drivers are read with `pread()` on a worker
+   * thread; other drivers are read in small slices from an LVGL timer. The
+   * file position is left unchanged. Must be called from the LVGL thread.
+   * Moving the File carries its pending reads along; closing or
+   * destroying it cancels them.
+   * @param offset Byte offset to read from.
+   * @param btr Bytes to read.
+   * @param callback Invoked on the LVGL thread with the result.
+   * @return Handle for cancellation. Destroying it cancels the read; call
+   * release() to let it finish unattended.
+   */
+  [[nodiscard]] FileRequest read_async(uint32_t offset, uint32_t btr,
+                                       FileLoadCallback callback);
+
   /**
    * @brief Write to the file.
    * @param buf Buffer to write from.
@@ -93,8 +167,13 @@ class File {
   bool is_open() const;
 
  private:
+  void cancel_requests();
+  void adopt_requests(File& other);
+
   lv_fs_file_t file_;
   bool is_opened_ = false;
+  // Pending read_async() requests that read through `file_`.
+  std::vector<std::weak_ptr<FileRequest::State>> requests_;
 };
 
 /**
@@ -199,6 +278,216 @@ class FileSystem {
    * @return true if ready.
    */
   static bool is_ready(char letter);
+
+  /**
+   * @brief Load a whole file without blocking the LVGL thread.
+   *
+   * See File::read_async() for how the read is performed. Must be called
+   * from the LVGL thread.
+   * @param path The path to the file.
+   * @param callback Invoked on the LVGL thread with the contents.
+   * @return Handle for cancellation. Destroying it cancels the load; call
+   * release() to let it finish unattended.
+   *
+   * @example
+   * auto req = lvgl::FileSystem::load_async(
+   *     "S:/fonts/cjk.bin", [](lvgl::FsRes res, std::vector<uint8_t> data) {
+   *       if (res == lvgl::FsRes::Ok) use_font(std::move(data));
+   *     });
+   */
+  [[nodiscard]] static FileRequest load_async(const std::string& path,
+                                              FileLoadCallback callback);
+
+  /**
+   * @brief Limit how many asynchronous reads run at once (default 4).
+   *
+   * Further requests queue until a running one completes.
+   * @param count Maximum number of in-flight requests (at least 1).
+   */
+  static void set_max_in_flight(uint32_t count);
+
+  /**
+   * @brief Number of asynchronous reads currently running.
+   */
+  static uint32_t get_in_flight();
+
+  /**
+   * @brief Number of asynchronous reads waiting for an in-flight slot.
+   */
+  static uint32_t get_pending();
+};
+
+/**
+ * @brief Base class for `lv_fs` drivers implemented in C++.
+ *
+ * The constructor registers an `lv_fs_drv_t` under `letter` whose callbacks
+ * dispatch to the virtual hooks below. LVGL has no way to unregister a
+ * driver, so the destructor detaches it instead: the letter stays registered
+ * but reports not-ready and every call fails with `FsRes::NotEx`. A later
+ * driver created for the same letter reuses the detached descriptor.
+ *
+ * Paths passed to the hooks have the drive letter and ':' stripped.
+ */
+class FileSystemDriver {
+ public:
+  explicit FileSystemDriver(char letter);
+  virtual ~FileSystemDriver();
+
+  FileSystemDriver(const FileSystemDriver&) = delete;
+  FileSystemDriver& operator=(const FileSystemDriver&) = delete;
+  FileSystemDriver(FileSystemDriver&&) = delete;
+  FileSystemDriver& operator=(FileSystemDriver&&) = delete;
+
+  /**
+   * @brief Get the drive letter this driver is registered under.
+   */
+  char get_letter() const;
+
+  /**
+   * @brief Get the registered LVGL driver descriptor.
+   */
+  lv_fs_drv_t* raw();
+
+ protected:
+  virtual bool ready();
+  virtual void* open(const char* path, FsMode mode) = 0;
+  virtual FsRes close(void* file) = 0;
+  virtual FsRes read(void* file, void* buf, uint32_t btr, uint32_t* br) = 0;
+  virtual FsRes write(void* file, const void* buf, uint32_t btw,
+                      uint32_t* bw);
+  virtual FsRes seek(void* file, uint32_t pos, FsWhence whence) = 0;
+  virtual FsRes tell(void* file, uint32_t* pos) = 0;
+  virtual void* dir_open(const char* path);
+  virtual FsRes dir_read(void* dir, char* fn, uint32_t fn_len);
+  virtual FsRes dir_close(void* dir);
+
+ private:
+  static FileSystemDriver* from(lv_fs_drv_t* drv);
+  static bool ready_proxy(lv_fs_drv_t* drv);
+  static void* open_proxy(lv_fs_drv_t* drv, const char* path,
+                          lv_fs_mode_t mode);
+  static lv_fs_res_t close_proxy(lv_fs_drv_t* drv, void* file_p);
+  static lv_fs_res_t read_proxy(lv_fs_drv_t* drv, void* file_p, void* buf,
+                                uint32_t btr, uint32_t* br);
+  static lv_fs_res_t write_proxy(lv_fs_drv_t* drv, void* file_p,
+                                 const void* buf, uint32_t btw, uint32_t* bw);
+  static lv_fs_res_t seek_proxy(lv_fs_drv_t* drv, void* file_p, uint32_t pos,
+                                lv_fs_whence_t whence);
+  static lv_fs_res_t tell_proxy(lv_fs_drv_t* drv, void* file_p,
+                                uint32_t* pos_p);
+  static void* dir_open_proxy(lv_fs_drv_t* drv, const char* path);
+  static lv_fs_res_t dir_read_proxy(lv_fs_drv_t* drv, void* rddir_p, char* fn,
+                                    uint32_t fn_len);
+  static lv_fs_res_t dir_close_proxy(lv_fs_drv_t* drv, void* rddir_p);
+
+  lv_fs_drv_t* drv_;
+};
+
+/**
+ * @brief RAM disk: an `lv_fs` driver backed by in-process buffers.
+ *
+ * Files live in a map keyed by path, so assets decompressed at boot or
+ * generated by tests can be handed to any API that takes an `lv_fs` path
+ * without touching real storage. Paths are relative to the drive; a leading
+ * drive prefix and leading slashes are ignored, so `"R:/img/a.bin"`,
+ * `"/img/a.bin"` and `"img/a.bin"` name the same file.
+ *
+ * Directories are implicit: listing `"R:img"` yields every file directly
+ * below `img/`, with sub-directories reported as `"/name"` like the stdio
+ * driver does.
+ *
+ * @code
+ * lvgl::RamFileSystem ram('R');
+ * ram.add_file("fonts/ui.bin", std::move(decompressed));
+ * auto font = lvgl::OwnedFont::load_bin("R:fonts/ui.bin");
+ * @endcode
+ */
+class RamFileSystem : public FileSystemDriver {
+ public:
+  explicit RamFileSystem(char letter);
+  ~RamFileSystem() override;
+
+  /**
+   * @brief Add or replace a file with a copy of `data`.
+   * @param path Path of the file on this drive.
+   * @param data Contents to copy.
+   * @param size Size of `data` in bytes.
+   */
+  void add_file(const std::string& path, const void* data, size_t size);
+
+  /**
+   * @brief Add or replace a file, taking ownership of the buffer.
+   * @param path Path of the file on this drive.
+   * @param data Contents; moved in without copying.
+   */
+  void add_file(const std::string& path, std::vector<uint8_t> data);
+
+  /**
+   * @brief Add or replace a read-mostly file that references external data.
+   *
+   * Nothing is copied; `data` must outlive the file (typically an asset
+   * linked into flash). The first write through `lv_fs` copies it.
+   * @param path Path of the file on this drive.
+   * @param data Contents to reference.
+   * @param size Size of `data` in bytes.
+   */
+  void add_file_static(const std::string& path, const void* data,
+                       size_t size);
+
+  /**
+   * @brief Remove a file. Handles already open on it stay valid.
+   * @return true if the file existed.
+   */
+  bool remove_file(const std::string& path);
+
+  /**
+   * @brief Remove every file.
+   */
+  void clear();
+
+  /**
+   * @brief Check whether a file exists.
+   */
+  bool contains(const std::string& path) const;
+
+  /**
+   * @brief Zero-copy view of a file's contents.
+   *
+   * The view is invalidated when the file is written, replaced or removed.
+   * @return The contents, or an empty span if the file does not exist.
+   */
+  std::span<const uint8_t> view(const std::string& path) const;
+
+  /**
+   * @brief Number of files on the drive.
+   */
+  size_t get_file_count() const;
+
+  /**
+   * @brief Total size of all files in bytes.
+   */
+  size_t get_total_size() const;
+
+ protected:
+  void* open(const char* path, FsMode mode) override;
+  FsRes close(void* file) override;
+  FsRes read(void* file, void* buf, uint32_t btr, uint32_t* br) override;
+  FsRes write(void* file, const void* buf, uint32_t btw,
+              uint32_t* bw) override;
+  FsRes seek(void* file, uint32_t pos, FsWhence whence) override;
+  FsRes tell(void* file, uint32_t* pos) override;
+  void* dir_open(const char* path) override;
+  FsRes dir_read(void* dir, char* fn, uint32_t fn_len) override;
+  FsRes dir_close(void* dir) override;
+
+ private:
+  struct Entry;
+  struct OpenFile;
+  struct OpenDir;
+
+  std::string normalize(const std::string& path) const;
+
+  std::map<std::string, std::shared_ptr<Entry>> files_;
 };
 
 }  // namespace lvgl
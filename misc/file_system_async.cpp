@@ -0,0 +1,504 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../core/compatibility.h"
+#include "file_system.h"
+
+// Asynchronous reads for File::read_async() and FileSystem::load_async().
+// Host-backed drivers (stdio/posix) are read with pread() on one worker
+// thread; every other driver is read in small slices from an lv_timer so
+// that no single frame stalls on a large file.
+
+#if LVGL_CPP_HAS_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#if LVGL_CPP_HAS_PREAD
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace lvgl {
+
+struct FileRequest::State {
+  static constexpr uint32_t kWholeFile = UINT32_MAX;
+
+  enum class Source : uint8_t {
+    NativePath,  ///< Opened and read with pread() on the worker thread.
+    NativeFd,    ///< Duplicated descriptor read with pread() on the worker.
+    FsPath,      ///< Opened through lv_fs and read in slices.
+    FsFile,      ///< Caller's open lv_fs file, read in slices.
+  };
+
+  Source source = Source::FsPath;
+  std::string path;
+  int fd = -1;
+  lv_fs_file_t* file = nullptr;
+  lv_fs_file_t own_file{};
+  bool own_file_open = false;
+  uint32_t offset = 0;
+  uint32_t length = kWholeFile;
+  uint32_t filled = 0;
+
+  FileLoadCallback callback;
+  std::atomic<bool> cancelled{false};
+  bool done = false;  ///< Completed or cancelled; only touched on LVGL thread.
+  FsRes res = FsRes::Ok;
+  std::vector<uint8_t> data;
+};
+
+/**
+ * Schedules asynchronous reads. Everything except the worker loop runs on
+ * the LVGL thread; the worker only touches the request it is reading and
+ * the guarded queues.
+ */
+class AsyncFileIo {
+ public:
+  using StatePtr = std::shared_ptr<FileRequest::State>;
+  using Source = FileRequest::State::Source;
+
+  static AsyncFileIo& get() {
+    static AsyncFileIo instance;
+    return instance;
+  }
+
+  ~AsyncFileIo() {
+#if LVGL_CPP_HAS_THREADS
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+#endif
+  }
+
+  FileRequest submit(StatePtr state) {
+    pending_.push_back(state);
+    start_pending();
+    if (!timer_) timer_ = lv_timer_create(timer_cb, 1, this);
+    return FileRequest(std::move(state));
+  }
+
+  void set_max_in_flight(uint32_t count) {
+    max_in_flight_ = std::max<uint32_t>(count, 1);
+    start_pending();
+  }
+
+  uint32_t in_flight() const { return active_; }
+  uint32_t pending() const { return static_cast<uint32_t>(pending_.size()); }
+
+  // Map a stdio/posix path to the host path, or return false.
+  static bool native_path(const std::string& path, std::string* real);
+  // Duplicate the host descriptor behind a stdio/posix file, or return -1.
+  static int native_fd(lv_fs_file_t* file);
+
+ private:
+  // Bytes read per request per timer tick on the lv_fs fallback path.
+  static constexpr uint32_t kSliceBytes = 16 * 1024;
+  // Bytes per pread() call, so cancellation is noticed promptly.
+  static constexpr size_t kNativeChunk = 256 * 1024;
+
+  static void timer_cb(lv_timer_t* timer) {
+    static_cast<AsyncFileIo*>(lv_timer_get_user_data(timer))->poll();
+  }
+
+  void poll();
+  void start_pending();
+  void start(const StatePtr& s);
+  bool step(FileRequest::State& s);
+  void finish(const StatePtr& s);
+  static void read_native(FileRequest::State& s);
+
+#if LVGL_CPP_HAS_THREADS
+  void worker_main();
+
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<StatePtr> work_;       // Guarded by mutex_.
+  std::deque<StatePtr> completed_;  // Guarded by mutex_.
+  bool stop_ = false;               // Guarded by mutex_.
+#endif
+
+  std::deque<StatePtr> pending_;
+  std::vector<StatePtr> sliced_;
+  uint32_t active_ = 0;
+  uint32_t max_in_flight_ = 4;
+  lv_timer_t* timer_ = nullptr;
+};
+
+void AsyncFileIo::poll() {
+  std::vector<StatePtr> finished;
+
+#if LVGL_CPP_HAS_THREADS
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!completed_.empty()) {
+      finished.push_back(std::move(completed_.front()));
+      completed_.pop_front();
+    }
+  }
+#endif
+
+  for (size_t i = 0; i < sliced_.size();) {
+    if (step(*sliced_[i])) {
+      finished.push_back(std::move(sliced_[i]));
+      sliced_.erase(sliced_.begin() + static_cast<std::ptrdiff_t>(i));
+    } else {
+      ++i;
+    }
+  }
+
+  active_ -= static_cast<uint32_t>(finished.size());
+  start_pending();
+
+  // Callbacks may submit new requests, so they run after the bookkeeping.
+  for (const StatePtr& s : finished) finish(s);
+
+  if (active_ == 0 && pending_.empty() && timer_) {
+    lv_timer_delete(timer_);
+    timer_ = nullptr;
+  }
+}
+
+void AsyncFileIo::start_pending() {
+  while (active_ < max_in_flight_ && !pending_.empty()) {
+    StatePtr s = std::move(pending_.front());
+    pending_.pop_front();
+    if (s->cancelled.load()) {
+      if (s->fd >= 0) {
+#if LVGL_CPP_HAS_PREAD
+        ::close(s->fd);
+#endif
+        s->fd = -1;
+      }
+      s->done = true;
+      s->callback = nullptr;
+      continue;
+    }
+    start(s);
+  }
+}
+
+void AsyncFileIo::start(const StatePtr& s) {
+  active_++;
+
+#if LVGL_CPP_HAS_THREADS
+  if (s->source == Source::NativePath || s->source == Source::NativeFd) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      work_.push_back(s);
+    }
+    if (!worker_.joinable()) {
+      worker_ = std::thread(&AsyncFileIo::worker_main, this);
+    }
+    cv_.notify_one();
+    return;
+  }
+#endif
+
+  if (s->source == Source::FsPath) {
+    lv_fs_res_t res = lv_fs_open(&s->own_file, s->path.c_str(), LV_FS_MODE_RD);
+    if (res == LV_FS_RES_OK) {
+      s->own_file_open = true;
+      s->file = &s->own_file;
+      if (s->length == FileRequest::State::kWholeFile) {
+        uint32_t size = 0;
+        res = lv_fs_seek(s->file, 0, LV_FS_SEEK_END);
+        if (res == LV_FS_RES_OK) res = lv_fs_tell(s->file, &size);
+        s->length = size > s->offset ? size - s->offset : 0;
+      }
+      if (res == LV_FS_RES_OK) {
+        res = lv_fs_seek(s->file, s->offset, LV_FS_SEEK_SET);
+      }
+    }
+    if (res != LV_FS_RES_OK) {
+      s->res = static_cast<FsRes>(res);
+      s->length = 0;
+    }
+  } else if (!s->file) {
+    s->length = 0;  // read_async() on a closed File; res is preset.
+  }
+
+  s->data.resize(s->length);
+  sliced_.push_back(s);
+}
+
+bool AsyncFileIo::step(FileRequest::State& s) {
+  if (s.cancelled.load()) return true;
+
+  uint32_t want = std::min(kSliceBytes, s.length - s.filled);
+  if (want == 0) return true;
+
+  // A caller-owned file may be used between slices, so seek every time and
+  // restore its position afterwards.
+  uint32_t saved = 0;
+  lv_fs_res_t res = LV_FS_RES_OK;
+  if (s.source == Source::FsFile) {
+    res = lv_fs_tell(s.file, &saved);
+    if (res == LV_FS_RES_OK) {
+      res = lv_fs_seek(s.file, s.offset + s.filled, LV_FS_SEEK_SET);
+    }
+  }
+
+  uint32_t br = 0;
+  if (res == LV_FS_RES_OK) {
+    res = lv_fs_read(s.file, s.data.data() + s.filled, want, &br);
+  }
+  if (s.source == Source::FsFile) lv_fs_seek(s.file, saved, LV_FS_SEEK_SET);
+
+  s.filled += br;
+  if (res != LV_FS_RES_OK) {
+    s.res = static_cast<FsRes>(res);
+    return true;
+  }
+  return br < want || s.filled == s.length;
+}
+
+void AsyncFileIo::finish(const StatePtr& s) {
+  if (s->own_file_open) {
+    lv_fs_close(&s->own_file);
+    s->own_file_open = false;
+  }
+  s->file = nullptr;
+
+  if (s->source == Source::FsPath || s->source == Source::FsFile) {
+    s->data.resize(s->filled);
+  }
+  if (s->res != FsRes::Ok) s->data.clear();
+
+  s->done = true;
+  FileLoadCallback callback = std::move(s->callback);
+  s->callback = nullptr;
+  if (!s->cancelled.load() && callback) callback(s->res, std::move(s->data));
+}
+
+void AsyncFileIo::read_native(FileRequest::State& s) {
+#if LVGL_CPP_HAS_PREAD
+  int fd = s.fd;
+  if (s.source == Source::NativePath) {
+    fd = ::open(s.path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      s.res = FsRes::NotEx;
+      return;
+    }
+  }
+  s.fd = -1;
+
+  uint32_t length = s.length;
+  if (length == FileRequest::State::kWholeFile) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      s.res = FsRes::FsErr;
+      ::close(fd);
+      return;
+    }
+    uint64_t size = static_cast<uint64_t>(st.st_size);
+    length = size > s.offset ? static_cast<uint32_t>(size - s.offset) : 0;
+  }
+
+  s.data.resize(length);
+  uint32_t filled = 0;
+  while (filled < length && !s.cancelled.load()) {
+    size_t want = std::min<size_t>(kNativeChunk, length - filled);
+    ssize_t n = ::pread(fd, s.data.data() + filled, want,
+                        static_cast<off_t>(s.offset) + filled);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      s.res = FsRes::FsErr;
+      break;
+    }
+    if (n == 0) break;
+    filled += static_cast<uint32_t>(n);
+  }
+  s.data.resize(filled);
+  ::close(fd);
+#else
+  s.res = FsRes::NotImp;
+#endif
+}
+
+#if LVGL_CPP_HAS_THREADS
+void AsyncFileIo::worker_main() {
+  for (;;) {
+    StatePtr s;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !work_.empty(); });
+      if (stop_) return;
+      s = std::move(work_.front());
+      work_.pop_front();
+    }
+    read_native(*s);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completed_.push_back(std::move(s));
+    }
+  }
+}
+#endif
+
+bool AsyncFileIo::native_path(const std::string& path, std::string* real) {
+#if LVGL_CPP_HAS_THREADS && LVGL_CPP_HAS_PREAD
+  if (path.size() < 2 || path[1] != ':') return false;
+  // Drivers implemented in C++ (FileSystemDriver) set user_data and must be
+  // called through lv_fs.
+  lv_fs_drv_t* drv = lv_fs_get_drv(path[0]);
+  if (!drv || drv->user_data) return false;
+
+  const char* prefix = nullptr;
+#if LV_USE_FS_STDIO
+  if (path[0] == LV_FS_STDIO_LETTER) prefix = LV_FS_STDIO_PATH;
+#endif
+#if LV_USE_FS_POSIX
+  if (path[0] == LV_FS_POSIX_LETTER) prefix = LV_FS_POSIX_PATH;
+#endif
+  if (!prefix) return false;
+  *real = std::string(prefix) + path.substr(2);
+  return true;
+#else
+  (void)path;
+  (void)real;
+  return false;
+#endif
+}
+
+int AsyncFileIo::native_fd(lv_fs_file_t* file) {
+#if LVGL_CPP_HAS_THREADS && LVGL_CPP_HAS_PREAD
+  if (!file->drv || file->drv->user_data || !file->file_d) return -1;
+
+  int fd = -1;
+#if LV_USE_FS_STDIO
+  if (file->drv->letter == LV_FS_STDIO_LETTER) {
+    std::FILE* fp = static_cast<std::FILE*>(file->file_d);
+    std::fflush(fp);  // Make buffered writes visible to pread().
+    fd = ::fileno(fp);
+  }
+#endif
+#if LV_USE_FS_POSIX
+  if (file->drv->letter == LV_FS_POSIX_LETTER) {
+    fd = static_cast<int>(reinterpret_cast<intptr_t>(file->file_d));
+  }
+#endif
+  // The worker owns a duplicate so closing the File cannot pull the
+  // descriptor out from under an in-flight read.
+  return fd >= 0 ? ::dup(fd) : -1;
+#else
+  (void)file;
+  return -1;
+#endif
+}
+
+// --- FileRequest ---
+
+FileRequest::FileRequest() = default;
+
+FileRequest::FileRequest(std::shared_ptr<State> state)
+    : state_(std::move(state)) {}
+
+FileRequest::~FileRequest() { cancel(); }
+
+FileRequest::FileRequest(FileRequest&& other) noexcept
+    : state_(std::move(other.state_)) {}
+
+FileRequest& FileRequest::operator=(FileRequest&& other) noexcept {
+  if (this != &other) {
+    cancel();
+    state_ = std::move(other.state_);
+  }
+  return *this;
+}
+
+bool FileRequest::cancel() {
+  if (!state_ || state_->done || state_->cancelled.load()) return false;
+  state_->cancelled.store(true);
+  return true;
+}
+
+bool FileRequest::valid() const {
+  return state_ && !state_->done && !state_->cancelled.load();
+}
+
+void FileRequest::release() { state_.reset(); }
+
+// --- File ---
+
+void File::cancel_requests() {
+  for (const auto& weak : requests_) {
+    if (auto state = weak.lock()) {
+      // Slices run on this thread, so none is reading `file_` right now.
+      state->cancelled.store(true);
+      state->file = nullptr;
+    }
+  }
+  requests_.clear();
+}
+
+void File::adopt_requests(File& other) {
+  requests_ = std::move(other.requests_);
+  other.requests_.clear();
+  for (const auto& weak : requests_) {
+    if (auto state = weak.lock()) state->file = &file_;
+  }
+}
+
+// --- Entry points ---
+
+FileRequest File::read_async(uint32_t offset, uint32_t btr,
+                             FileLoadCallback callback) {
+  auto state = std::make_shared<FileRequest::State>();
+  state->callback = std::move(callback);
+  state->offset = offset;
+  state->length = btr;
+
+  if (!is_opened_) {
+    state->source = FileRequest::State::Source::FsFile;
+    state->res = FsRes::NotEx;
+  } else if ((state->fd = AsyncFileIo::native_fd(&file_)) >= 0) {
+    state->source = FileRequest::State::Source::NativeFd;
+  } else {
+    state->source = FileRequest::State::Source::FsFile;
+    state->file = &file_;
+    // Drop handles of finished requests before tracking this one.
+    requests_.erase(
+        std::remove_if(requests_.begin(), requests_.end(),
+                       [](const auto& weak) { return weak.expired(); }),
+        requests_.end());
+    requests_.push_back(state);
+  }
+  return AsyncFileIo::get().submit(std::move(state));
+}
+
+FileRequest FileSystem::load_async(const std::string& path,
+                                   FileLoadCallback callback) {
+  auto state = std::make_shared<FileRequest::State>();
+  state->callback = std::move(callback);
+  if (AsyncFileIo::native_path(path, &state->path)) {
+    state->source = FileRequest::State::Source::NativePath;
+  } else {
+    state->source = FileRequest::State::Source::FsPath;
+    state->path = path;
+  }
+  return AsyncFileIo::get().submit(std::move(state));
+}
+
+void FileSystem::set_max_in_flight(uint32_t count) {
+  AsyncFileIo::get().set_max_in_flight(count);
+}
+
+uint32_t FileSystem::get_in_flight() { return AsyncFileIo::get().in_flight(); }
+
+uint32_t FileSystem::get_pending() { return AsyncFileIo::get().pending(); }
+
+}  // namespace lvgl
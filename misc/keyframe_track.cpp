@@ -0,0 +1,133 @@
+#include "keyframe_track.h"
+
+#include <algorithm>
+
+namespace lvgl {
+
+namespace {
+
+constexpr int kScaleShift = 16;
+
+}  // namespace
+
+KeyframeTrack::KeyframeTrack(void* var, lv_anim_exec_xcb_t exec_cb)
+    : var_(var), exec_cb_(exec_cb) {}
+
+KeyframeTrack::KeyframeTrack(const Object& object, lv_anim_exec_xcb_t exec_cb)
+    : KeyframeTrack(object.raw(), exec_cb) {}
+
+KeyframeTrack& KeyframeTrack::key(uint32_t time, int32_t value,
+                                  Easing easing) {
+  keys_.push_back({time, value, easing});
+  return *this;
+}
+
+uint32_t KeyframeTrack::get_duration() const {
+  uint32_t duration = 0;
+  for (const Key& key : keys_) duration = std::max(duration, key.time);
+  return duration;
+}
+
+KeyframeClip::KeyframeClip(const std::vector<KeyframeTrack>& tracks) {
+  tracks_.reserve(tracks.size());
+  for (const KeyframeTrack& source : tracks) {
+    if (source.keys_.empty()) continue;
+    std::vector<KeyframeTrack::Key> keys = source.keys_;
+    std::stable_sort(keys.begin(), keys.end(),
+                     [](const KeyframeTrack::Key& a,
+                        const KeyframeTrack::Key& b) {
+                       return a.time < b.time;
+                     });
+
+    Track track;
+    track.var = source.var_;
+    track.exec_cb = source.exec_cb_;
+    track.first_segment = static_cast<uint32_t>(segments_.size());
+    track.first_value = keys.front().value;
+    track.last_value = keys.back().value;
+    track.first_time = keys.front().time;
+    track.last_time = keys.back().time;
+    for (size_t i = 1; i < keys.size(); ++i) {
+      // Keys at the same time are a jump; nothing to interpolate.
+      if (keys[i].time == keys[i - 1].time) continue;
+      uint32_t length = keys[i].time - keys[i - 1].time;
+      uint32_t full = static_cast<uint32_t>(EasingTable::kResolution)
+                      << kScaleShift;
+      Segment segment;
+      segment.start = keys[i - 1].time;
+      segment.end = keys[i].time;
+      segment.progress_scale = std::max<uint32_t>(
+          full / length + (full % length != 0), 1);
+      segment.from = keys[i - 1].value;
+      segment.to = keys[i].value;
+      segment.curve = EasingTable::get(keys[i].easing);
+      segments_.push_back(segment);
+    }
+    track.segment_count =
+        static_cast<uint32_t>(segments_.size()) - track.first_segment;
+    duration_ = std::max(duration_, track.last_time);
+    tracks_.push_back(track);
+  }
+  cursors_.assign(tracks_.size(), 0);
+  applied_.assign(tracks_.size(), 0);
+  has_applied_.assign(tracks_.size(), 0);
+}
+
+void KeyframeClip::seek(uint32_t time) {
+  for (uint32_t i = 0; i < tracks_.size(); ++i) {
+    const Track& track = tracks_[i];
+    int32_t value;
+    if (time < track.first_time) {
+      value = track.first_value;
+    } else if (time >= track.last_time || track.segment_count == 0) {
+      value = track.last_value;
+    } else {
+      cursors_[i] = find_segment(track, time, cursors_[i]);
+      value = eval(segments_[track.first_segment + cursors_[i]], time);
+    }
+    if (has_applied_[i] && applied_[i] == value) continue;
+    applied_[i] = value;
+    has_applied_[i] = 1;
+    if (track.exec_cb) track.exec_cb(track.var, value);
+  }
+}
+
+int32_t KeyframeClip::get_value(uint32_t track_index, uint32_t time) const {
+  if (track_index >= tracks_.size()) return 0;
+  const Track& track = tracks_[track_index];
+  if (time < track.first_time) return track.first_value;
+  if (time >= track.last_time || track.segment_count == 0) {
+    return track.last_value;
+  }
+  uint32_t index = find_segment(track, time, cursors_[track_index]);
+  return eval(segments_[track.first_segment + index], time);
+}
+
+uint32_t KeyframeClip::find_segment(const Track& track, uint32_t time,
+                                    uint32_t hint) const {
+  // Playback and scrubbing mostly stay in the same or the next segment.
+  const Segment* first = &segments_[track.first_segment];
+  for (uint32_t i = hint; i < hint + 2 && i < track.segment_count; ++i) {
+    if (time >= first[i].start && time < first[i].end) return i;
+  }
+  const Segment* last = first + track.segment_count;
+  const Segment* found =
+      std::upper_bound(first, last, time,
+                       [](uint32_t t, const Segment& segment) {
+                         return t < segment.start;
+                       });
+  return static_cast<uint32_t>(found - first) - 1;
+}
+
+int32_t KeyframeClip::eval(const Segment& segment, uint32_t time) {
+  uint32_t offset = time - segment.start;
+  int32_t progress = static_cast<int32_t>(std::min<uint64_t>(
+      (static_cast<uint64_t>(offset) * segment.progress_scale) >> kScaleShift,
+      EasingTable::kResolution - 1));
+  int32_t eased = EasingTable::sample(segment.curve, progress);
+  int64_t delta = static_cast<int64_t>(segment.to) - segment.from;
+  int64_t scaled = delta * eased + EasingTable::kResolution / 2;
+  return segment.from + static_cast<int32_t>(scaled >> EasingTable::kShift);
+}
+
+}  // namespace lvgl
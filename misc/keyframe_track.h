@@ -0,0 +1,139 @@
+#ifndef LVGL_CPP_MISC_KEYFRAME_TRACK_H_
+#define LVGL_CPP_MISC_KEYFRAME_TRACK_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "../core/object.h"
+#include "easing.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file keyframe_track.h
+ * @brief User Guide:
+ * Keyframes describe a sequence declaratively: each `KeyframeTrack` holds
+ * the keys of one property, and a `KeyframeClip` compiles a set of tracks
+ * into one flat table. Adding a clip to an `AnimationTimeline` costs a
+ * single `lv_anim_t`, and seeking it writes every property in one pass
+ * without allocating.
+ *
+ * Example:
+ * @code
+ * std::vector<lvgl::KeyframeTrack> tracks;
+ * tracks.emplace_back(logo, (lv_anim_exec_xcb_t)lv_obj_set_y)
+ *     .key(0, -100)
+ *     .key(400, 20, lvgl::Easing::EaseOut)
+ *     .key(600, 0, lvgl::Easing::EaseInOut);
+ * tracks.emplace_back(title, (lv_anim_exec_xcb_t)lv_obj_set_x)
+ *     .key(300, -200)
+ *     .key(700, 0, lvgl::Easing::EaseOut);
+ *
+ * lvgl::AnimationTimeline timeline;
+ * timeline.add(lvgl::KeyframeClip(tracks), 0);
+ * timeline.start();
+ * @endcode
+ */
+namespace lvgl {
+
+/**
+ * @brief The keys of one property.
+ */
+class KeyframeTrack {
+ public:
+  KeyframeTrack(void* var, lv_anim_exec_xcb_t exec_cb);
+  KeyframeTrack(const Object& object, lv_anim_exec_xcb_t exec_cb);
+
+  /**
+   * @brief Add a key. Keys may be added in any order.
+   * @param time Time in milliseconds from the start of the clip.
+   * @param easing Shape of the segment that ends at this key.
+   */
+  KeyframeTrack& key(uint32_t time, int32_t value,
+                     Easing easing = Easing::Linear);
+
+  /**
+   * @brief Time of the last key.
+   */
+  uint32_t get_duration() const;
+
+ private:
+  friend class KeyframeClip;
+
+  struct Key {
+    uint32_t time;
+    int32_t value;
+    Easing easing;
+  };
+
+  void* var_;
+  lv_anim_exec_xcb_t exec_cb_;
+  std::vector<Key> keys_;
+};
+
+/**
+ * @brief Tracks compiled into a table for seeking.
+ *
+ * Before its first key a track holds the first value, and after its last
+ * key the last value. Values are only written when they change between
+ * seeks.
+ */
+class KeyframeClip {
+ public:
+  KeyframeClip() = default;
+  explicit KeyframeClip(const std::vector<KeyframeTrack>& tracks);
+
+  /**
+   * @brief Time of the last key over all tracks.
+   */
+  uint32_t get_duration() const { return duration_; }
+
+  uint32_t get_track_count() const {
+    return static_cast<uint32_t>(tracks_.size());
+  }
+
+  /**
+   * @brief Apply every track at `time` milliseconds.
+   */
+  void seek(uint32_t time);
+
+  /**
+   * @brief Value of a track at `time`, without applying it.
+   */
+  int32_t get_value(uint32_t track, uint32_t time) const;
+
+ private:
+  struct Segment {
+    uint32_t start;
+    uint32_t end;
+    uint32_t progress_scale;  // (kResolution << 16) / (end - start)
+    int32_t from;
+    int32_t to;
+    const int16_t* curve;
+  };
+
+  struct Track {
+    void* var;
+    lv_anim_exec_xcb_t exec_cb;
+    uint32_t first_segment;
+    uint32_t segment_count;
+    int32_t first_value;
+    int32_t last_value;
+    uint32_t first_time;
+    uint32_t last_time;
+  };
+
+  uint32_t find_segment(const Track& track, uint32_t time,
+                        uint32_t hint) const;
+  static int32_t eval(const Segment& segment, uint32_t time);
+
+  std::vector<Track> tracks_;
+  std::vector<Segment> segments_;
+  std::vector<uint32_t> cursors_;  // Last segment used, per track.
+  std::vector<int32_t> applied_;
+  std::vector<uint8_t> has_applied_;
+  uint32_t duration_ = 0;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_KEYFRAME_TRACK_H_
@@ -0,0 +1,188 @@
+#include "latency_probe.h"
+
+#include <algorithm>
+
+#include "../core/object.h"
+#include "../display/display.h"
+#include "../indev/input_device.h"
+
+namespace lvgl {
+
+namespace {
+
+constexpr uint64_t kFirstBucketUs = 500;
+
+bool overlaps(const lv_area_t& a, const lv_area_t& b) {
+  return a.x1 <= b.x2 && b.x1 <= a.x2 && a.y1 <= b.y2 && b.y1 <= a.y2;
+}
+
+}  // namespace
+
+void LatencyStats::add(uint64_t us) {
+  min_us = count ? std::min(min_us, us) : us;
+  max_us = std::max(max_us, us);
+  ++count;
+  total_us += us;
+  size_t index = 0;
+  while (index + 1 < kBuckets && us >= get_bucket_limit_us(index)) ++index;
+  ++buckets[index];
+}
+
+uint64_t LatencyStats::get_bucket_limit_us(size_t index) {
+  if (index + 1 >= kBuckets) return UINT64_MAX;
+  return kFirstBucketUs << index;
+}
+
+uint64_t LatencyStats::get_percentile_us(double percent) const {
+  if (count == 0) return 0;
+  double wanted = count * std::clamp(percent, 0.0, 100.0) / 100.0;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += buckets[i];
+    if (seen >= wanted && seen > 0) {
+      return std::min(get_bucket_limit_us(i), max_us);
+    }
+  }
+  return max_us;
+}
+
+LatencyProbe::LatencyProbe(Display* display)
+    : display_(display ? display->raw() : lv_display_get_default()) {
+  if (!display_) return;
+  for (lv_event_code_t code :
+       {LV_EVENT_INVALIDATE_AREA, LV_EVENT_REFR_START, LV_EVENT_FLUSH_FINISH,
+        LV_EVENT_REFR_READY, LV_EVENT_DELETE}) {
+    lv_display_add_event_cb(display_, display_event_cb, code, this);
+  }
+}
+
+LatencyProbe::~LatencyProbe() {
+  if (display_) {
+    lv_display_remove_event_cb_with_user_data(display_, display_event_cb,
+                                              this);
+  }
+  for (auto& entry : per_widget_) {
+    lv_obj_remove_event_cb_with_user_data(entry.first, widget_deleted_cb,
+                                          this);
+  }
+}
+
+void LatencyProbe::attach(InputDevice& indev) {
+  indev.set_latency_probe(this);
+}
+
+void LatencyProbe::detach(InputDevice& indev) {
+  if (indev.get_latency_probe() == this) indev.set_latency_probe(nullptr);
+}
+
+const LatencyStats* LatencyProbe::get_stats(const Object& widget) const {
+  auto it = per_widget_.find(widget.raw());
+  if (it == per_widget_.end() || it->second.count == 0) return nullptr;
+  return &it->second;
+}
+
+size_t LatencyProbe::get_pending() const {
+  size_t unmeasured = (collecting_ && !tags_.back().has_area) ? 1 : 0;
+  return tags_.size() - unmeasured;
+}
+
+void LatencyProbe::reset() {
+  total_ = LatencyStats();
+  // Entries stay so their delete callbacks remain paired.
+  for (auto& entry : per_widget_) entry.second = LatencyStats();
+}
+
+void LatencyProbe::on_sample(InputDevice& indev) {
+  drop_unmeasured();
+  tags_.push_back({Clock::now(), indev.raw(), nullptr, {}, false, false});
+  collecting_ = true;
+}
+
+void LatencyProbe::drop_unmeasured() {
+  if (collecting_ && !tags_.back().has_area) tags_.pop_back();
+  collecting_ = false;
+}
+
+void LatencyProbe::complete(size_t index, Clock::time_point now) {
+  const Tag& tag = tags_[index];
+  auto us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(now - tag.start)
+          .count());
+  total_.add(us);
+  if (tag.widget) per_widget_[tag.widget].add(us);
+  tags_.erase(tags_.begin() + index);
+}
+
+void LatencyProbe::display_event_cb(lv_event_t* e) {
+  auto* self = static_cast<LatencyProbe*>(lv_event_get_user_data(e));
+  switch (lv_event_get_code(e)) {
+    case LV_EVENT_INVALIDATE_AREA: {
+      if (!self->collecting_) return;
+      Tag& tag = self->tags_.back();
+      // Only changes made while LVGL processes this tag's sample.
+      if (lv_indev_active() != tag.indev) return;
+      auto* area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+      if (!area) return;
+      if (!tag.has_area) {
+        tag.area = *area;
+        tag.has_area = true;
+      } else {
+        tag.area.x1 = std::min(tag.area.x1, area->x1);
+        tag.area.y1 = std::min(tag.area.y1, area->y1);
+        tag.area.x2 = std::max(tag.area.x2, area->x2);
+        tag.area.y2 = std::max(tag.area.y2, area->y2);
+      }
+      lv_obj_t* widget = lv_indev_get_active_obj();
+      if (!tag.widget && widget) {
+        tag.widget = widget;
+        if (self->per_widget_.find(widget) == self->per_widget_.end()) {
+          self->per_widget_.emplace(widget, LatencyStats());
+          lv_obj_add_event_cb(widget, widget_deleted_cb, LV_EVENT_DELETE,
+                              self);
+        }
+      }
+      return;
+    }
+    case LV_EVENT_REFR_START:
+      self->drop_unmeasured();
+      for (Tag& tag : self->tags_) tag.rendering = true;
+      return;
+    case LV_EVENT_FLUSH_FINISH: {
+      auto* area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+      if (!area) return;
+      Clock::time_point now = Clock::now();
+      for (size_t i = self->tags_.size(); i-- > 0;) {
+        const Tag& tag = self->tags_[i];
+        if (tag.rendering && overlaps(tag.area, *area)) self->complete(i, now);
+      }
+      return;
+    }
+    case LV_EVENT_REFR_READY: {
+      // Everything invalidated before the refresh has been drawn by now,
+      // even if no flush area matched (e.g. a rotated display).
+      Clock::time_point now = Clock::now();
+      for (size_t i = self->tags_.size(); i-- > 0;) {
+        if (self->tags_[i].rendering) self->complete(i, now);
+      }
+      return;
+    }
+    case LV_EVENT_DELETE:
+      self->display_ = nullptr;
+      self->tags_.clear();
+      self->collecting_ = false;
+      return;
+    default:
+      return;
+  }
+}
+
+void LatencyProbe::widget_deleted_cb(lv_event_t* e) {
+  auto* self = static_cast<LatencyProbe*>(lv_event_get_user_data(e));
+  auto* widget = static_cast<lv_obj_t*>(lv_event_get_target(e));
+  self->per_widget_.erase(widget);
+  for (Tag& tag : self->tags_) {
+    if (tag.widget == widget) tag.widget = nullptr;
+  }
+}
+
+}  // namespace lvgl
@@ -0,0 +1,148 @@
+#ifndef LVGL_CPP_MISC_LATENCY_PROBE_H_
+#define LVGL_CPP_MISC_LATENCY_PROBE_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file latency_probe.h
+ * @brief User Guide:
+ * `LatencyProbe` measures input-to-photon latency: the time from an input
+ * sample entering `InputDevice::process_read()` to the flush of the pixels
+ * it changed.
+ *
+ * Key Features:
+ * - **Tagging**: Every sample read from an attached device opens a tag.
+ *   Areas invalidated while LVGL processes that sample (event handlers,
+ *   state changes, style transitions) are added to the tag, along with the
+ *   object the device was acting on. A sample that invalidates nothing is
+ *   not measured.
+ * - **Completion**: A tag completes when the first flush overlapping its
+ *   areas finishes, or at the end of the refresh that rendered them.
+ * - **Reporting**: A latency histogram for all inputs and a breakdown per
+ *   widget.
+ *
+ * Example:
+ * @code
+ * lvgl::LatencyProbe probe;
+ * probe.attach(touch);
+ * // ... later
+ * const lvgl::LatencyStats& stats = probe.get_stats();
+ * printf("p95 %llu us\n", (unsigned long long)stats.get_percentile_us(95));
+ * @endcode
+ *
+ * Times come from `std::chrono::steady_clock`. A flush ends when the flush
+ * callback returns. With an asynchronous driver, this excludes the transfer
+ * still running after the callback. Detach or destroy every attached device
+ * before the probe.
+ */
+namespace lvgl {
+
+class Display;
+class InputDevice;
+class Object;
+
+/**
+ * @brief Latency samples and their histogram.
+ */
+struct LatencyStats {
+  /** Bucket `i` holds latencies below `get_bucket_limit_us(i)`. */
+  static constexpr size_t kBuckets = 12;
+
+  uint64_t count = 0;
+  uint64_t total_us = 0;
+  uint64_t min_us = 0;
+  uint64_t max_us = 0;
+  std::array<uint64_t, kBuckets> buckets{};
+
+  void add(uint64_t us);
+
+  /**
+   * @brief Upper bound of bucket `index`: 0.5 ms doubling per bucket, the
+   * last being unbounded.
+   */
+  static uint64_t get_bucket_limit_us(size_t index);
+
+  uint64_t get_mean_us() const { return count ? total_us / count : 0; }
+
+  /**
+   * @brief Upper bound of the bucket holding the `percent` percentile,
+   * capped at max_us.
+   */
+  uint64_t get_percentile_us(double percent) const;
+};
+
+class LatencyProbe {
+ public:
+  /**
+   * @brief Create on the LVGL thread, watching `display` (default: the
+   * default display).
+   */
+  explicit LatencyProbe(Display* display = nullptr);
+  ~LatencyProbe();
+
+  LatencyProbe(const LatencyProbe&) = delete;
+  LatencyProbe& operator=(const LatencyProbe&) = delete;
+
+  /**
+   * @brief Tag every sample `indev` reads from now on.
+   */
+  void attach(InputDevice& indev);
+  void detach(InputDevice& indev);
+
+  /** @brief Latency of every measured input. */
+  const LatencyStats& get_stats() const { return total_; }
+
+  /**
+   * @brief Latency of inputs acting on `widget`, or nullptr if there were
+   * none. Entries are removed when their widget is deleted.
+   */
+  const LatencyStats* get_stats(const Object& widget) const;
+
+  const std::unordered_map<lv_obj_t*, LatencyStats>& get_widget_stats()
+      const {
+    return per_widget_;
+  }
+
+  /** @brief Inputs that changed the screen and are not yet flushed. */
+  size_t get_pending() const;
+
+  /** @brief Clear all statistics. */
+  void reset();
+
+  /** @brief Called by InputDevice::process_read() for each sample. */
+  void on_sample(InputDevice& indev);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Tag {
+    Clock::time_point start;
+    lv_indev_t* indev;
+    lv_obj_t* widget;
+    lv_area_t area;
+    bool has_area;
+    bool rendering;  // Its frame is being refreshed.
+  };
+
+  void complete(size_t index, Clock::time_point now);
+  void drop_unmeasured();
+  static void display_event_cb(lv_event_t* e);
+  static void widget_deleted_cb(lv_event_t* e);
+
+  lv_display_t* display_ = nullptr;
+  std::vector<Tag> tags_;
+  bool collecting_ = false;  // The last tag still takes invalidations.
+  LatencyStats total_;
+  std::unordered_map<lv_obj_t*, LatencyStats> per_widget_;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_LATENCY_PROBE_H_
@@ -0,0 +1,123 @@
+#ifndef LVGL_CPP_MISC_LOCKFREE_QUEUE_H_
+#define LVGL_CPP_MISC_LOCKFREE_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace lvgl {
+
+/**
+ * @brief Bounded multi-producer, multi-consumer queue that never locks or
+ * allocates after construction.
+ *
+ * Each slot carries a sequence number telling producers and consumers
+ * whose turn it is (Vyukov's bounded MPMC queue), so a push or pop is a
+ * single compare-and-swap on the shared index plus a copy. When the queue
+ * is full, try_push() fails instead of waiting, which suits producers that
+ * must not stall, such as logging from an interrupt-driven thread.
+ *
+ * @tparam T Trivially copyable element type.
+ */
+template <typename T>
+class LockFreeQueue {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "LockFreeQueue elements must be trivially copyable");
+
+ public:
+  /**
+   * @param capacity Minimum number of elements; rounded up to a power of
+   * two (at least 2).
+   */
+  explicit LockFreeQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size *= 2;
+    mask_ = size - 1;
+    slots_ = std::make_unique<Slot[]>(size);
+    for (size_t i = 0; i < size; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  LockFreeQueue(const LockFreeQueue&) = delete;
+  LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+  size_t capacity() const { return mask_ + 1; }
+
+  /**
+   * @brief Append a copy of `value`.
+   * @return false if the queue is full.
+   */
+  bool try_push(const T& value) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos & mask_];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Remove the oldest element into `out`.
+   * @return false if the queue is empty.
+   */
+  bool try_pop(T& out) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos & mask_];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          out = slot.value;
+          slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Approximate number of queued elements; exact when no other
+   * thread is pushing or popping.
+   */
+  size_t size_approx() const {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t head = head_.load(std::memory_order_relaxed);
+    return tail >= head ? tail - head : 0;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_ = 0;
+  // Producers and consumers each hammer one index; keep them apart.
+  alignas(64) std::atomic<size_t> tail_{0};
+  alignas(64) std::atomic<size_t> head_{0};
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_LOCKFREE_QUEUE_H_
@@ -0,0 +1,186 @@
+#include "spring_animator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace lvgl {
+
+namespace {
+
+constexpr float kStepSeconds = SpringAnimator::kStepMs / 1000.0f;
+
+}  // namespace
+
+SpringAnimator::SpringAnimator() = default;
+
+SpringAnimator::~SpringAnimator() {
+  if (timer_) lv_timer_delete(timer_);
+}
+
+SpringAnimator& SpringAnimator::set_var(void* var) {
+  var_ = var;
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_var(const Object& object) {
+  return set_var(object.raw());
+}
+
+SpringAnimator& SpringAnimator::set_exec_cb(lv_anim_exec_xcb_t exec_cb) {
+  exec_raw_ = exec_cb;
+  exec_cb_ = nullptr;
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_exec_cb(Animation::ExecCallback cb) {
+  if (const lv_anim_exec_xcb_t* fn = cb.target<lv_anim_exec_xcb_t>()) {
+    return set_exec_cb(*fn);
+  }
+  exec_raw_ = nullptr;
+  exec_cb_ = std::move(cb);
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_stiffness(float stiffness) {
+  stiffness_ = std::max(stiffness, 0.0f);
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_damping(float damping) {
+  damping_ = std::max(damping, 0.0f);
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_mass(float mass) {
+  mass_ = std::max(mass, 0.001f);
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_friction(float friction) {
+  friction_ = std::max(friction, 0.0f);
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_rest_threshold(float distance,
+                                                   float speed) {
+  rest_distance_ = distance;
+  rest_speed_ = speed;
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_value(int32_t value) {
+  stop();
+  position_ = static_cast<float>(value);
+  target_ = value;
+  apply(true);
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_velocity(float velocity) {
+  velocity_ = velocity;
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::set_target(int32_t target) {
+  target_ = target;
+  start(Mode::Spring);
+  return *this;
+}
+
+SpringAnimator& SpringAnimator::fling(float velocity) {
+  velocity_ = velocity;
+  start(Mode::Inertia);
+  return *this;
+}
+
+void SpringAnimator::stop() {
+  running_ = false;
+  velocity_ = 0.0f;
+  if (timer_) {
+    lv_timer_delete(timer_);
+    timer_ = nullptr;
+  }
+}
+
+SpringAnimator& SpringAnimator::set_completed_cb(CompletedCallback cb) {
+  completed_cb_ = std::move(cb);
+  return *this;
+}
+
+int32_t SpringAnimator::get_value() const {
+  return static_cast<int32_t>(std::lround(position_));
+}
+
+void SpringAnimator::step(uint32_t elapsed_ms) {
+  if (!running_) return;
+  pending_ms_ += std::min(elapsed_ms, kMaxCatchUpMs);
+  while (pending_ms_ >= kStepMs) {
+    pending_ms_ -= kStepMs;
+    integrate();
+    if (at_rest()) {
+      settle();
+      return;
+    }
+  }
+  apply();
+}
+
+void SpringAnimator::timer_cb(lv_timer_t* timer) {
+  auto* self = static_cast<SpringAnimator*>(lv_timer_get_user_data(timer));
+  uint32_t elapsed = lv_tick_elaps(self->last_tick_);
+  self->last_tick_ += elapsed;
+  self->step(elapsed);
+}
+
+void SpringAnimator::start(Mode mode) {
+  mode_ = mode;
+  if (running_) return;
+  running_ = true;
+  pending_ms_ = 0;
+  last_tick_ = lv_tick_get();
+  if (!timer_) timer_ = lv_timer_create(timer_cb, LV_DEF_REFR_PERIOD, this);
+}
+
+void SpringAnimator::integrate() {
+  if (mode_ == Mode::Spring) {
+    // Semi-implicit Euler: stable for stiff springs at this step size.
+    float displacement = position_ - static_cast<float>(target_);
+    float accel = (-stiffness_ * displacement - damping_ * velocity_) / mass_;
+    velocity_ += accel * kStepSeconds;
+  } else {
+    velocity_ -= velocity_ * std::min(friction_ * kStepSeconds, 1.0f);
+  }
+  position_ += velocity_ * kStepSeconds;
+}
+
+bool SpringAnimator::at_rest() const {
+  if (std::fabs(velocity_) >= rest_speed_) return false;
+  if (mode_ == Mode::Inertia) return true;
+  return std::fabs(position_ - static_cast<float>(target_)) < rest_distance_;
+}
+
+void SpringAnimator::apply(bool force) {
+  int32_t value = get_value();
+  if (value == applied_ && !force) return;
+  applied_ = value;
+  if (exec_raw_) {
+    exec_raw_(var_, value);
+  } else if (exec_cb_) {
+    exec_cb_(var_, value);
+  }
+}
+
+void SpringAnimator::settle() {
+  if (mode_ == Mode::Spring) {
+    position_ = static_cast<float>(target_);
+  } else {
+    target_ = get_value();
+    position_ = static_cast<float>(target_);
+  }
+  stop();
+  apply();
+  if (completed_cb_) completed_cb_();
+}
+
+}  // namespace lvgl
@@ -0,0 +1,168 @@
+#ifndef LVGL_CPP_MISC_SPRING_ANIMATOR_H_
+#define LVGL_CPP_MISC_SPRING_ANIMATOR_H_
+
+#include <cstdint>
+#include <functional>
+
+#include "../core/object.h"
+#include "animation.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file spring_animator.h
+ * @brief User Guide:
+ * `SpringAnimator` moves a value with physics instead of a fixed duration.
+ * Position and velocity are integrated in fixed steps, so the target can
+ * change at any moment (a drag released, a snap point crossed) and the
+ * motion continues smoothly from the current velocity, with nothing
+ * reallocated.
+ *
+ * Two modes:
+ * - **Spring**: `set_target()` pulls the value towards a target through a
+ *   damped spring.
+ * - **Inertia**: `fling()` lets the value coast with a velocity that
+ *   decays by friction, as after a flick.
+ *
+ * The animator runs its own LVGL timer while moving and deletes it once
+ * the value comes to rest. Values reach the property through the same exec
+ * callbacks as `Animation`.
+ *
+ * Example:
+ * @code
+ * lvgl::SpringAnimator spring;
+ * spring.set_var(card).set_exec_cb(lvgl::Animation::Exec::X());
+ * spring.set_value(card.get_x());
+ * // On release:
+ * spring.set_velocity(release_velocity).set_target(0);
+ * @endcode
+ */
+namespace lvgl {
+
+class SpringAnimator {
+ public:
+  /** Integration step. Results depend only on total elapsed time. */
+  static constexpr uint32_t kStepMs = 4;
+
+  /** Longer gaps between ticks are cut to this to avoid long catch-ups. */
+  static constexpr uint32_t kMaxCatchUpMs = 250;
+
+  using CompletedCallback = std::function<void()>;
+
+  SpringAnimator();
+  ~SpringAnimator();
+
+  SpringAnimator(const SpringAnimator&) = delete;
+  SpringAnimator& operator=(const SpringAnimator&) = delete;
+  SpringAnimator(SpringAnimator&&) = delete;
+  SpringAnimator& operator=(SpringAnimator&&) = delete;
+
+  SpringAnimator& set_var(void* var);
+  SpringAnimator& set_var(const Object& object);
+
+  /**
+   * @brief Set the property setter. Plain function pointers, including
+   * the `Animation::Exec` helpers, are called directly.
+   */
+  SpringAnimator& set_exec_cb(lv_anim_exec_xcb_t exec_cb);
+  SpringAnimator& set_exec_cb(Animation::ExecCallback cb);
+
+  /**
+   * @brief Spring constants. Defaults are stiffness 170, damping 26,
+   * mass 1: a quick move with almost no overshoot.
+   */
+  SpringAnimator& set_stiffness(float stiffness);
+  SpringAnimator& set_damping(float damping);
+  SpringAnimator& set_mass(float mass);
+
+  /**
+   * @brief Velocity decay rate for fling(), per second. Higher stops
+   * sooner. Default 4.
+   */
+  SpringAnimator& set_friction(float friction);
+
+  /**
+   * @brief The value is at rest once it is within `distance` of the
+   * target and slower than `speed` units per second.
+   */
+  SpringAnimator& set_rest_threshold(float distance, float speed);
+
+  /**
+   * @brief Jump to `value` and stop.
+   */
+  SpringAnimator& set_value(int32_t value);
+
+  /**
+   * @brief Set the velocity in units per second, e.g. from a gesture.
+   */
+  SpringAnimator& set_velocity(float velocity);
+
+  /**
+   * @brief Spring towards `target`, keeping the current velocity.
+   * Starts the animator if it is at rest.
+   */
+  SpringAnimator& set_target(int32_t target);
+
+  /**
+   * @brief Coast at `velocity` units per second until friction stops it.
+   */
+  SpringAnimator& fling(float velocity);
+
+  /**
+   * @brief Stop where the value is now. The completed callback is not
+   * called.
+   */
+  void stop();
+
+  /**
+   * @brief Called when the value comes to rest.
+   */
+  SpringAnimator& set_completed_cb(CompletedCallback cb);
+
+  int32_t get_value() const;
+  float get_velocity() const { return velocity_; }
+  int32_t get_target() const { return target_; }
+  bool is_running() const { return running_; }
+
+  /**
+   * @brief Advance by `elapsed_ms`. Called by the animator's timer; call
+   * it directly to step manually.
+   */
+  void step(uint32_t elapsed_ms);
+
+ private:
+  enum class Mode : uint8_t { Spring, Inertia };
+
+  static void timer_cb(lv_timer_t* timer);
+  void start(Mode mode);
+  void integrate();
+  bool at_rest() const;
+  void apply(bool force = false);
+  void settle();
+
+  void* var_ = nullptr;
+  lv_anim_exec_xcb_t exec_raw_ = nullptr;
+  Animation::ExecCallback exec_cb_;
+  CompletedCallback completed_cb_;
+
+  float stiffness_ = 170.0f;
+  float damping_ = 26.0f;
+  float mass_ = 1.0f;
+  float friction_ = 4.0f;
+  float rest_distance_ = 0.5f;
+  float rest_speed_ = 5.0f;
+
+  float position_ = 0.0f;
+  float velocity_ = 0.0f;
+  int32_t target_ = 0;
+  int32_t applied_ = 0;
+  uint32_t pending_ms_ = 0;
+  Mode mode_ = Mode::Spring;
+  bool running_ = false;
+
+  lv_timer_t* timer_ = nullptr;
+  uint32_t last_tick_ = 0;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_SPRING_ANIMATOR_H_
@@ -0,0 +1,350 @@
+#include "text_document.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace lvgl {
+
+namespace {
+
+void index_breaks(std::string_view text, uint32_t base,
+                  std::vector<uint32_t>* out) {
+  for (size_t i = text.find('\n'); i != std::string_view::npos;
+       i = text.find('\n', i + 1)) {
+    out->push_back(base + static_cast<uint32_t>(i));
+  }
+}
+
+}  // namespace
+
+TextDocument::TextDocument() = default;
+
+TextDocument::TextDocument(std::string text) { set_text(std::move(text)); }
+
+TextDocument::~TextDocument() = default;
+
+TextDocument::TextDocument(TextDocument&&) noexcept = default;
+
+TextDocument& TextDocument::operator=(TextDocument&&) noexcept = default;
+
+const std::string& TextDocument::buffer(Source source) const {
+  return source == kOriginal ? original_ : added_;
+}
+
+const std::vector<uint32_t>& TextDocument::breaks(Source source) const {
+  return source == kOriginal ? original_breaks_ : added_breaks_;
+}
+
+uint32_t TextDocument::count_breaks(Source source, uint32_t begin,
+                                    uint32_t end) const {
+  const std::vector<uint32_t>& b = breaks(source);
+  return static_cast<uint32_t>(std::lower_bound(b.begin(), b.end(), end) -
+                               std::lower_bound(b.begin(), b.end(), begin));
+}
+
+int32_t TextDocument::new_node(Source source, uint32_t start,
+                               uint32_t length) {
+  // xorshift32; priorities only need to be well spread.
+  seed_ ^= seed_ << 13;
+  seed_ ^= seed_ >> 17;
+  seed_ ^= seed_ << 5;
+
+  Node node{start,  length, count_breaks(source, start, start + length),
+            seed_,  -1,     -1,
+            length, 0,      source};
+  node.total_newlines = node.newlines;
+  if (!free_nodes_.empty()) {
+    int32_t id = free_nodes_.back();
+    free_nodes_.pop_back();
+    nodes_[id] = node;
+    return id;
+  }
+  nodes_.push_back(node);
+  return static_cast<int32_t>(nodes_.size() - 1);
+}
+
+void TextDocument::free_tree(int32_t t) {
+  if (t < 0) return;
+  free_tree(nodes_[t].left);
+  free_tree(nodes_[t].right);
+  free_nodes_.push_back(t);
+}
+
+void TextDocument::update(int32_t t) {
+  Node& n = nodes_[t];
+  n.total_length = n.length;
+  n.total_newlines = n.newlines;
+  if (n.left >= 0) {
+    n.total_length += nodes_[n.left].total_length;
+    n.total_newlines += nodes_[n.left].total_newlines;
+  }
+  if (n.right >= 0) {
+    n.total_length += nodes_[n.right].total_length;
+    n.total_newlines += nodes_[n.right].total_newlines;
+  }
+}
+
+// Split into the first `pos` bytes and the rest, cutting a piece in two if
+// `pos` falls inside it.
+void TextDocument::split(int32_t t, size_t pos, int32_t* left,
+                         int32_t* right) {
+  if (t < 0) {
+    *left = *right = -1;
+    return;
+  }
+  // Children are passed through locals: cutting a piece below may grow
+  // nodes_ and move it.
+  size_t left_len = nodes_[t].left >= 0 ? nodes_[nodes_[t].left].total_length
+                                        : 0;
+  if (pos <= left_len) {
+    int32_t rest = -1;
+    split(nodes_[t].left, pos, left, &rest);
+    nodes_[t].left = rest;
+    update(t);
+    *right = t;
+    return;
+  }
+  pos -= left_len;
+  if (pos >= nodes_[t].length) {
+    int32_t rest = -1;
+    split(nodes_[t].right, pos - nodes_[t].length, &rest, right);
+    nodes_[t].right = rest;
+    update(t);
+    *left = t;
+    return;
+  }
+
+  // Cut this piece: it keeps the head, a new node takes the tail.
+  uint32_t head = static_cast<uint32_t>(pos);
+  int32_t tail = new_node(nodes_[t].source, nodes_[t].start + head,
+                          nodes_[t].length - head);
+  Node& n = nodes_[t];
+  n.length = head;
+  n.newlines -= nodes_[tail].newlines;
+  int32_t rest = n.right;
+  n.right = -1;
+  update(t);
+  *left = t;
+  *right = merge(tail, rest);
+}
+
+int32_t TextDocument::merge(int32_t left, int32_t right) {
+  if (left < 0) return right;
+  if (right < 0) return left;
+  if (nodes_[left].priority > nodes_[right].priority) {
+    nodes_[left].right = merge(nodes_[left].right, right);
+    update(left);
+    return left;
+  }
+  nodes_[right].left = merge(left, nodes_[right].left);
+  update(right);
+  return right;
+}
+
+// Grow the last piece of `t` if it ends where the new text starts in the
+// added buffer, i.e. the insertion continues the previous one.
+bool TextDocument::extend_last(int32_t t, uint32_t start, uint32_t length,
+                               uint32_t newlines) {
+  if (t < 0) return false;
+  Node& n = nodes_[t];
+  bool extended = false;
+  if (n.right >= 0) {
+    extended = extend_last(n.right, start, length, newlines);
+  } else if (n.source == kAdded && n.start + n.length == start) {
+    n.length += length;
+    n.newlines += newlines;
+    extended = true;
+  }
+  if (extended) update(t);
+  return extended;
+}
+
+void TextDocument::notify(uint32_t first_line, uint32_t removed,
+                          uint32_t added) {
+  if (on_change_) on_change_(Change{first_line, removed, added});
+}
+
+size_t TextDocument::size() const {
+  return root_ >= 0 ? nodes_[root_].total_length : 0;
+}
+
+uint32_t TextDocument::line_count() const {
+  return (root_ >= 0 ? nodes_[root_].total_newlines : 0) + 1;
+}
+
+void TextDocument::insert(size_t pos, std::string_view text) {
+  if (text.empty()) return;
+  pos = std::min(pos, size());
+  uint32_t first_line = line_of(pos);
+
+  uint32_t start = static_cast<uint32_t>(added_.size());
+  added_.append(text);
+  index_breaks(text, start, &added_breaks_);
+  uint32_t length = static_cast<uint32_t>(text.size());
+  uint32_t newlines = count_breaks(kAdded, start, start + length);
+
+  int32_t left = -1;
+  int32_t right = -1;
+  split(root_, pos, &left, &right);
+  if (!extend_last(left, start, length, newlines)) {
+    left = merge(left, new_node(kAdded, start, length));
+  }
+  root_ = merge(left, right);
+  notify(first_line, 1, newlines + 1);
+}
+
+void TextDocument::append(std::string_view text) { insert(size(), text); }
+
+void TextDocument::erase(size_t pos, size_t len) {
+  pos = std::min(pos, size());
+  len = std::min(len, size() - pos);
+  if (len == 0) return;
+  uint32_t first_line = line_of(pos);
+
+  int32_t left = -1;
+  int32_t middle = -1;
+  int32_t right = -1;
+  split(root_, pos, &left, &right);
+  split(right, len, &middle, &right);
+  uint32_t removed = nodes_[middle].total_newlines;
+  free_tree(middle);
+  root_ = merge(left, right);
+  notify(first_line, removed + 1, 1);
+}
+
+void TextDocument::set_text(std::string text) {
+  uint32_t old_lines = line_count();
+  nodes_.clear();
+  free_nodes_.clear();
+  added_.clear();
+  added_breaks_.clear();
+  original_ = std::move(text);
+  original_breaks_.clear();
+  index_breaks(original_, 0, &original_breaks_);
+  root_ = original_.empty()
+              ? -1
+              : new_node(kOriginal, 0, static_cast<uint32_t>(original_.size()));
+  notify(0, old_lines, line_count());
+}
+
+void TextDocument::collect(int32_t t, size_t offset, size_t pos, size_t end,
+                           std::string* out) const {
+  while (t >= 0 && offset < end) {
+    const Node& n = nodes_[t];
+    size_t left_len = n.left >= 0 ? nodes_[n.left].total_length : 0;
+    size_t piece = offset + left_len;
+    if (pos < piece) collect(n.left, offset, pos, end, out);
+    size_t from = std::max(pos, piece);
+    size_t to = std::min(end, piece + n.length);
+    if (from < to) {
+      out->append(buffer(n.source), n.start + (from - piece), to - from);
+    }
+    // Continue right without recursing.
+    offset = piece + n.length;
+    if (end <= offset) return;
+    t = n.right;
+  }
+}
+
+std::string TextDocument::get_text() const { return get_text(0, size()); }
+
+std::string TextDocument::get_text(size_t pos, size_t len) const {
+  std::string out;
+  copy_text(pos, len, &out);
+  return out;
+}
+
+void TextDocument::copy_text(size_t pos, size_t len, std::string* out) const {
+  pos = std::min(pos, size());
+  len = std::min(len, size() - pos);
+  out->reserve(out->size() + len);
+  collect(root_, 0, pos, pos + len, out);
+}
+
+size_t TextDocument::line_start(uint32_t line) const {
+  if (line == 0) return 0;
+  if (line >= line_count()) return size();
+
+  // Find the line-th break; the line starts right after it.
+  uint32_t remaining = line;
+  size_t offset = 0;
+  int32_t t = root_;
+  while (t >= 0) {
+    const Node& n = nodes_[t];
+    uint32_t left_breaks = n.left >= 0 ? nodes_[n.left].total_newlines : 0;
+    if (remaining <= left_breaks) {
+      t = n.left;
+      continue;
+    }
+    remaining -= left_breaks;
+    size_t left_len = n.left >= 0 ? nodes_[n.left].total_length : 0;
+    if (remaining <= n.newlines) {
+      const std::vector<uint32_t>& b = breaks(n.source);
+      auto first = std::lower_bound(b.begin(), b.end(), n.start);
+      uint32_t at = *(first + (remaining - 1));
+      return offset + left_len + (at - n.start) + 1;
+    }
+    remaining -= n.newlines;
+    offset += left_len + n.length;
+    t = n.right;
+  }
+  return size();
+}
+
+size_t TextDocument::line_length(uint32_t line) const {
+  if (line >= line_count()) return 0;
+  size_t begin = line_start(line);
+  size_t end = line + 1 < line_count() ? line_start(line + 1) - 1 : size();
+  return end - begin;
+}
+
+std::string TextDocument::get_line(uint32_t line) const {
+  std::string out;
+  get_line(line, &out);
+  return out;
+}
+
+void TextDocument::get_line(uint32_t line, std::string* out) const {
+  out->clear();
+  if (line >= line_count()) return;
+  size_t begin = line_start(line);
+  size_t end = line + 1 < line_count() ? line_start(line + 1) - 1 : size();
+  copy_text(begin, end - begin, out);
+}
+
+uint32_t TextDocument::line_of(size_t pos) const {
+  // Count the breaks before `pos`.
+  uint32_t line = 0;
+  int32_t t = root_;
+  while (t >= 0) {
+    const Node& n = nodes_[t];
+    size_t left_len = n.left >= 0 ? nodes_[n.left].total_length : 0;
+    if (pos < left_len) {
+      t = n.left;
+      continue;
+    }
+    line += n.left >= 0 ? nodes_[n.left].total_newlines : 0;
+    pos -= left_len;
+    if (pos < n.length) {
+      return line + count_breaks(n.source, n.start,
+                                 n.start + static_cast<uint32_t>(pos));
+    }
+    line += n.newlines;
+    pos -= n.length;
+    t = n.right;
+  }
+  return line;
+}
+
+uint32_t TextDocument::count_pieces(int32_t t) const {
+  if (t < 0) return 0;
+  return 1 + count_pieces(nodes_[t].left) + count_pieces(nodes_[t].right);
+}
+
+uint32_t TextDocument::get_piece_count() const { return count_pieces(root_); }
+
+void TextDocument::set_change_callback(ChangeCallback callback) {
+  on_change_ = std::move(callback);
+}
+
+}  // namespace lvgl
@@ -0,0 +1,189 @@
+#ifndef LVGL_CPP_MISC_TEXT_DOCUMENT_H_
+#define LVGL_CPP_MISC_TEXT_DOCUMENT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lvgl {
+
+/**
+ * @brief Editable text stored as a piece table, for documents too large to
+ * live in one LVGL label buffer.
+ *
+ * The text is the concatenation of pieces, each a range of either the
+ * original text or an append-only buffer holding everything inserted since.
+ * Pieces sit in a balanced tree (a treap) that also sums their bytes and
+ * line breaks, so inserting, erasing and mapping between byte offsets and
+ * lines are O(log n) in the number of pieces; no edit moves existing text.
+ * Typing at the end of the latest insertion extends its piece instead of
+ * adding one.
+ *
+ * Lines are separated by '\n'; a document always has at least one line.
+ *
+ * @code
+ * lvgl::TextDocument doc(load_log());
+ * doc.append("new line\n");
+ * doc.insert(doc.line_start(10), "// ");
+ * std::string line = doc.get_line(10);
+ * @endcode
+ *
+ * Not thread-safe.
+ */
+class TextDocument {
+ public:
+  /**
+   * @brief Describes an edit in lines: lines
+   * `[first_line, first_line + removed_lines)` of the old text became
+   * `[first_line, first_line + added_lines)` of the new one.
+   */
+  struct Change {
+    uint32_t first_line;
+    uint32_t removed_lines;
+    uint32_t added_lines;
+  };
+
+  using ChangeCallback = std::function<void(const Change&)>;
+
+  TextDocument();
+  explicit TextDocument(std::string text);
+  ~TextDocument();
+
+  TextDocument(TextDocument&&) noexcept;
+  TextDocument& operator=(TextDocument&&) noexcept;
+  TextDocument(const TextDocument&) = delete;
+  TextDocument& operator=(const TextDocument&) = delete;
+
+  /**
+   * @brief Length in bytes.
+   */
+  size_t size() const;
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Number of lines (line breaks + 1).
+   */
+  uint32_t line_count() const;
+
+  /**
+   * @brief Insert text.
+   * @param pos Byte offset; clamped to size().
+   * @param text UTF-8 text to insert.
+   */
+  void insert(size_t pos, std::string_view text);
+
+  /**
+   * @brief Insert text at the end.
+   */
+  void append(std::string_view text);
+
+  /**
+   * @brief Erase a range of bytes; the range is clamped to the document.
+   */
+  void erase(size_t pos, size_t len);
+
+  /**
+   * @brief Replace the whole text, dropping all edit history.
+   */
+  void set_text(std::string text);
+
+  /**
+   * @brief Copy the whole text.
+   */
+  std::string get_text() const;
+
+  /**
+   * @brief Copy a range of bytes (clamped to the document).
+   */
+  std::string get_text(size_t pos, size_t len) const;
+
+  /**
+   * @brief Append a range of bytes to `out`, reusing its capacity.
+   */
+  void copy_text(size_t pos, size_t len, std::string* out) const;
+
+  /**
+   * @brief Byte offset where a line starts.
+   * @param line Line index; values past the end give size().
+   */
+  size_t line_start(uint32_t line) const;
+
+  /**
+   * @brief Length of a line in bytes, without its line break.
+   */
+  size_t line_length(uint32_t line) const;
+
+  /**
+   * @brief Copy a line without its line break.
+   */
+  std::string get_line(uint32_t line) const;
+
+  /**
+   * @brief Replace `out` with a line, reusing its capacity.
+   */
+  void get_line(uint32_t line, std::string* out) const;
+
+  /**
+   * @brief Index of the line containing a byte offset.
+   */
+  uint32_t line_of(size_t pos) const;
+
+  /**
+   * @brief Number of pieces the text is currently split into.
+   */
+  uint32_t get_piece_count() const;
+
+  /**
+   * @brief Be told about every edit, e.g. to invalidate per-line caches.
+   * A document has one callback; setting another replaces it.
+   */
+  void set_change_callback(ChangeCallback callback);
+
+ private:
+  enum Source : uint8_t { kOriginal, kAdded };
+
+  struct Node {
+    uint32_t start;
+    uint32_t length;
+    uint32_t newlines;
+    uint32_t priority;
+    int32_t left;
+    int32_t right;
+    size_t total_length;     ///< Bytes in this subtree.
+    uint32_t total_newlines; ///< Line breaks in this subtree.
+    Source source;
+  };
+
+  const std::string& buffer(Source source) const;
+  const std::vector<uint32_t>& breaks(Source source) const;
+  uint32_t count_breaks(Source source, uint32_t begin, uint32_t end) const;
+
+  int32_t new_node(Source source, uint32_t start, uint32_t length);
+  void free_tree(int32_t t);
+  void update(int32_t t);
+  void split(int32_t t, size_t pos, int32_t* left, int32_t* right);
+  int32_t merge(int32_t left, int32_t right);
+  bool extend_last(int32_t t, uint32_t start, uint32_t length,
+                   uint32_t newlines);
+  void collect(int32_t t, size_t offset, size_t pos, size_t end,
+               std::string* out) const;
+  uint32_t count_pieces(int32_t t) const;
+  void notify(uint32_t first_line, uint32_t removed, uint32_t added);
+
+  std::string original_;
+  std::string added_;
+  std::vector<uint32_t> original_breaks_;  ///< Offsets of '\n'.
+  std::vector<uint32_t> added_breaks_;
+  std::vector<Node> nodes_;
+  std::vector<int32_t> free_nodes_;
+  int32_t root_ = -1;
+  uint32_t seed_ = 2463534242u;
+  ChangeCallback on_change_;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_TEXT_DOCUMENT_H_
@@ -0,0 +1,138 @@
+#include "text_metrics_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace lvgl {
+
+namespace {
+
+bool g_enabled = false;
+
+uint64_t hash_text(const char* text, size_t len) {
+  // FNV-1a: cheap for the short strings labels and cells usually hold.
+  uint64_t h = 1469598103934665603ull;
+  for (size_t i = 0; i < len; ++i) {
+    h ^= static_cast<uint8_t>(text[i]);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+}  // namespace
+
+float TextMetricsCache::Stats::hit_rate() const {
+  uint64_t total = hits + misses;
+  if (total == 0) return 0.0f;
+  return static_cast<float>(hits) / static_cast<float>(total);
+}
+
+size_t TextMetricsCache::KeyHash::operator()(const Key& key) const {
+  uint64_t h = key.hash;
+  h ^= reinterpret_cast<uintptr_t>(key.font) + 0x9e3779b97f4a7c15ull +
+       (h << 6) + (h >> 2);
+  h ^= (static_cast<uint64_t>(static_cast<uint32_t>(key.max_width)) << 32) |
+       key.flags;
+  h ^= (static_cast<uint64_t>(static_cast<uint32_t>(key.letter_space))
+        << 16) ^
+       static_cast<uint32_t>(key.line_space);
+  return static_cast<size_t>(h);
+}
+
+TextMetricsCache::TextMetricsCache(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)) {
+  index_.reserve(capacity_);
+}
+
+TextMetricsCache& TextMetricsCache::global() {
+  static TextMetricsCache instance;
+  return instance;
+}
+
+void TextMetricsCache::set_enabled(bool enabled) {
+  g_enabled = enabled;
+  if (!enabled) global().clear();
+}
+
+bool TextMetricsCache::is_enabled() { return g_enabled; }
+
+Point TextMetricsCache::text_size(const char* text, const lv_font_t* font,
+                                  int32_t letter_space, int32_t line_space,
+                                  int32_t max_width, lv_text_flag_t flags) {
+  if (g_enabled) {
+    return global().measure(text, font, letter_space, line_space, max_width,
+                            flags);
+  }
+  lv_point_t size;
+  lv_text_get_size(&size, text ? text : "", font, letter_space, line_space,
+                   max_width, flags);
+  return size;
+}
+
+Point TextMetricsCache::measure(const char* text, const lv_font_t* font,
+                                int32_t letter_space, int32_t line_space,
+                                int32_t max_width, lv_text_flag_t flags) {
+  if (!text) text = "";
+  size_t len = std::strlen(text);
+  Key key{font,         hash_text(text, len), letter_space,
+          line_space,   max_width,            static_cast<uint32_t>(flags)};
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    Entry& entry = *it->second;
+    if (entry.text.size() == len &&
+        std::memcmp(entry.text.data(), text, len) == 0) {
+      stats_.hits++;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return entry.size;
+    }
+    // Hash collision: replace the older text.
+    lru_.erase(it->second);
+    index_.erase(it);
+    stats_.entries--;
+  }
+
+  stats_.misses++;
+  lv_point_t size;
+  lv_text_get_size(&size, text, font, letter_space, line_space, max_width,
+                   flags);
+  lru_.push_front(Entry{key, std::string(text, len), size});
+  index_.emplace(key, lru_.begin());
+  stats_.entries++;
+  trim();
+  return size;
+}
+
+void TextMetricsCache::set_capacity(size_t capacity) {
+  capacity_ = std::max<size_t>(capacity, 1);
+  trim();
+}
+
+size_t TextMetricsCache::get_capacity() const { return capacity_; }
+
+const TextMetricsCache::Stats& TextMetricsCache::get_stats() const {
+  return stats_;
+}
+
+void TextMetricsCache::reset_stats() {
+  stats_.hits = 0;
+  stats_.misses = 0;
+  stats_.evictions = 0;
+}
+
+void TextMetricsCache::clear() {
+  lru_.clear();
+  index_.clear();
+  stats_.entries = 0;
+}
+
+void TextMetricsCache::trim() {
+  while (lru_.size() > capacity_) {
+    index_.erase(lru_.back().key);
+    lru_.pop_back();
+    stats_.entries--;
+    stats_.evictions++;
+  }
+}
+
+}  // namespace lvgl
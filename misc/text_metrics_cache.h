@@ -0,0 +1,147 @@
+#ifndef LVGL_CPP_MISC_TEXT_METRICS_CACHE_H_
+#define LVGL_CPP_MISC_TEXT_METRICS_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "geometry.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+namespace lvgl {
+
+/**
+ * @brief LRU cache of `lv_text_get_size()` results.
+ *
+ * Entries are keyed by (font, text hash, letter space, line space, max
+ * width, flags). The text itself is stored too, so a hash collision is a
+ * miss, never a wrong size.
+ *
+ * A process-wide instance backs the measuring helpers of `Label`, `Table`
+ * and `Span` (`get_text_size()`, `fit_column_width()`). It is disabled by
+ * default. LVGL's own measuring during layout and refresh does not go
+ * through it.
+ *
+ * @code
+ * lvgl::TextMetricsCache::set_enabled(true);
+ * table.fit_column_width(0);  // Measures every cell through the cache.
+ * auto stats = lvgl::TextMetricsCache::global().get_stats();
+ * @endcode
+ *
+ * Not thread-safe; use it from the LVGL thread like the widgets it serves.
+ */
+class TextMetricsCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 256;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint32_t entries = 0;
+
+    /**
+     * @brief Fraction of lookups served from the cache.
+     * @return Value in [0, 1]; 0 when nothing has been measured yet.
+     */
+    float hit_rate() const;
+  };
+
+  /**
+   * @brief Create a cache.
+   * @param capacity Maximum number of entries (at least 1).
+   */
+  explicit TextMetricsCache(size_t capacity = kDefaultCapacity);
+
+  TextMetricsCache(const TextMetricsCache&) = delete;
+  TextMetricsCache& operator=(const TextMetricsCache&) = delete;
+
+  /**
+   * @brief Get the process-wide cache used by the widget wrappers.
+   */
+  static TextMetricsCache& global();
+
+  /**
+   * @brief Enable or disable the wrappers' use of the global cache.
+   * Disabling also clears it.
+   */
+  static void set_enabled(bool enabled);
+
+  /**
+   * @brief Check whether the wrappers use the global cache.
+   */
+  static bool is_enabled();
+
+  /**
+   * @brief Measure text through the global cache when it is enabled, or
+   * directly with `lv_text_get_size()` otherwise.
+   */
+  static Point text_size(const char* text, const lv_font_t* font,
+                         int32_t letter_space, int32_t line_space,
+                         int32_t max_width = LV_COORD_MAX,
+                         lv_text_flag_t flags = LV_TEXT_FLAG_NONE);
+
+  /**
+   * @brief Measure text, computing and storing the size on a miss.
+   * @param text Null-terminated UTF-8 text (nullptr is treated as "").
+   * @param font Font used to render the text.
+   * @param letter_space Extra space between letters.
+   * @param line_space Extra space between lines.
+   * @param max_width Wrap width, or `LV_COORD_MAX` for no wrapping.
+   * @param flags Text flags (e.g. `LV_TEXT_FLAG_EXPAND`).
+   * @return Width and height of the text block.
+   */
+  Point measure(const char* text, const lv_font_t* font,
+                int32_t letter_space, int32_t line_space,
+                int32_t max_width = LV_COORD_MAX,
+                lv_text_flag_t flags = LV_TEXT_FLAG_NONE);
+
+  /**
+   * @brief Change the capacity, evicting entries if it shrank.
+   */
+  void set_capacity(size_t capacity);
+  size_t get_capacity() const;
+
+  const Stats& get_stats() const;
+  void reset_stats();
+
+  /**
+   * @brief Drop every entry, e.g. after a font was destroyed.
+   */
+  void clear();
+
+ private:
+  struct Key {
+    const lv_font_t* font;
+    uint64_t hash;
+    int32_t letter_space;
+    int32_t line_space;
+    int32_t max_width;
+    uint32_t flags;
+
+    bool operator==(const Key& other) const = default;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::string text;
+    lv_point_t size;
+  };
+
+  void trim();
+
+  size_t capacity_;
+  Stats stats_;
+  std::list<Entry> lru_;  ///< Front is most recently used.
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_TEXT_METRICS_CACHE_H_
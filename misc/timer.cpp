@@ -1,10 +1,14 @@
 #include "timer.h"
 
+#include "timer_wheel.h"
+
 namespace lvgl {
 
 struct Timer::Data {
   TimerCallback cb;
   Timer* owner = nullptr;
+  TimerWheel* wheel = nullptr;  // Set for timers driven by a wheel.
+  uint32_t wheel_id = 0;
 };
 
 void Timer::timer_proxy(lv_timer_t* t) {
@@ -19,6 +23,11 @@ void Timer::timer_proxy(lv_timer_t* t) {
   }
 }
 
+void Timer::wheel_proxy(void* user_data) {
+  auto* data = static_cast<Data*>(user_data);
+  if (data->cb) data->cb(data->owner);
+}
+
 Timer::Timer() : timer_(nullptr) {}
 
 Timer::Timer(uint32_t period, TimerCallback cb) {
@@ -26,10 +35,19 @@ Timer::Timer(uint32_t period, TimerCallback cb) {
   timer_ = lv_timer_create(timer_proxy, period, data_);
 }
 
+Timer::Timer(TimerWheel& wheel, uint32_t period, TimerCallback cb)
+    : timer_(nullptr) {
+  data_ = new Data{std::move(cb), this, &wheel};
+  data_->wheel_id = wheel.add(period, wheel_proxy, data_);
+}
+
 Timer::~Timer() {
   if (timer_) {
     lv_timer_delete(timer_);
     timer_ = nullptr;
+  }
+  if (data_) {
+    if (data_->wheel) data_->wheel->remove(data_->wheel_id);
     delete data_;
     data_ = nullptr;
   }
@@ -47,8 +65,9 @@ Timer::Timer(Timer&& other) noexcept
 
 Timer& Timer::operator=(Timer&& other) noexcept {
   if (this != &other) {
-    if (timer_) {
-      lv_timer_delete(timer_);
+    if (timer_) lv_timer_delete(timer_);
+    if (data_) {
+      if (data_->wheel) data_->wheel->remove(data_->wheel_id);
       delete data_;
     }
     timer_ = other.timer_;
@@ -112,7 +131,11 @@ Timer Timer::periodic(uint32_t period, TimerCallback cb) {
 uint32_t Timer::handler() { return lv_timer_handler(); }
 
 Timer& Timer::set_period(uint32_t period) {
-  if (timer_) lv_timer_set_period(timer_, period);
+  if (timer_) {
+    lv_timer_set_period(timer_, period);
+  } else if (data_ && data_->wheel) {
+    data_->wheel->set_period(data_->wheel_id, period);
+  }
   return *this;
 }
 
@@ -129,27 +152,47 @@ Timer& Timer::set_cb(TimerCallback cb) {
 }
 
 Timer& Timer::pause() {
-  if (timer_) lv_timer_pause(timer_);
+  if (timer_) {
+    lv_timer_pause(timer_);
+  } else if (data_ && data_->wheel) {
+    data_->wheel->pause(data_->wheel_id);
+  }
   return *this;
 }
 
 Timer& Timer::resume() {
-  if (timer_) lv_timer_resume(timer_);
+  if (timer_) {
+    lv_timer_resume(timer_);
+  } else if (data_ && data_->wheel) {
+    data_->wheel->resume(data_->wheel_id);
+  }
   return *this;
 }
 
 Timer& Timer::ready() {
-  if (timer_) lv_timer_ready(timer_);
+  if (timer_) {
+    lv_timer_ready(timer_);
+  } else if (data_ && data_->wheel) {
+    data_->wheel->ready(data_->wheel_id);
+  }
   return *this;
 }
 
 Timer& Timer::reset() {
-  if (timer_) lv_timer_reset(timer_);
+  if (timer_) {
+    lv_timer_reset(timer_);
+  } else if (data_ && data_->wheel) {
+    data_->wheel->reset(data_->wheel_id);
+  }
   return *this;
 }
 
 Timer& Timer::set_repeat_count(int32_t repeat_count) {
-  if (timer_) lv_timer_set_repeat_count(timer_, repeat_count);
+  if (timer_) {
+    lv_timer_set_repeat_count(timer_, repeat_count);
+  } else if (data_ && data_->wheel) {
+    data_->wheel->set_repeat_count(data_->wheel_id, repeat_count);
+  }
   return *this;
 }
 
@@ -9,12 +9,23 @@
 
 namespace lvgl {
 
+class TimerWheel;
+
 class Timer {
  public:
   using TimerCallback = std::function<void(Timer*)>;
 
   Timer();
   Timer(uint32_t period, TimerCallback cb);
+
+  /**
+   * @brief Create a periodic timer driven by a `TimerWheel` instead of its
+   * own LVGL timer. `raw()` returns nullptr for such timers.
+   * @param wheel The wheel; must outlive the timer.
+   * @param period Period in milliseconds.
+   * @param cb Callback function.
+   */
+  Timer(TimerWheel& wheel, uint32_t period, TimerCallback cb);
   ~Timer();
 
   // Move-only type
@@ -109,7 +120,8 @@ class Timer {
    * @brief Detach the timer from this object.
    * The timer will continue running and the callback will be invoked with
    * nullptr. caller must manage memory of the timer and data.
-   * @return The raw lv_timer_t pointer.
+   * Timers on a `TimerWheel` cannot be detached.
+   * @return The raw lv_timer_t pointer, or nullptr.
    */
   lv_timer_t* detach();
 
@@ -126,6 +138,7 @@ class Timer {
   Data* data_ = nullptr;
 
   static void timer_proxy(lv_timer_t* t);
+  static void wheel_proxy(void* user_data);
   static std::function<void()> resume_handler_;
   static void resume_handler_proxy(void* data);
 };
@@ -0,0 +1,334 @@
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace lvgl {
+
+namespace {
+
+constexpr uint32_t kMaxPeriod = 0x7FFFFFFF;
+
+// True if tick `a` is earlier than tick `b`, across wrap-around.
+bool before(uint32_t a, uint32_t b) {
+  return static_cast<int32_t>(a - b) < 0;
+}
+
+// Slot layout: the root level has 256 one-millisecond slots; each further
+// level has 64 slots, each covering a whole turn of the level below.
+constexpr int level_shift(int level) { return 8 + (level - 1) * 6; }
+
+constexpr uint32_t level_base(int level) { return 256 + (level - 1) * 64; }
+
+}  // namespace
+
+TimerWheel::TimerWheel() {
+  std::fill(std::begin(heads_), std::end(heads_), kNone);
+  next_ = lv_tick_get();
+  driver_ = lv_timer_create(timer_cb, 1000, this);
+  lv_timer_pause(driver_);
+}
+
+TimerWheel::~TimerWheel() {
+  if (driver_) lv_timer_delete(driver_);
+}
+
+uint32_t TimerWheel::get_next_deadline() const {
+  if (linked_ == 0) return LV_NO_TIMER_READY;
+  uint32_t due = next_expiry();
+  uint32_t now = lv_tick_get();
+  return before(due, now) ? 0 : due - now;
+}
+
+void TimerWheel::process() {
+  uint32_t now = lv_tick_get();
+  if (heads_[kDueSlot] != kNone) {
+    running_ = true;
+    floor_ = next_;
+    run_slot(kDueSlot, now);
+    running_ = false;
+  }
+  while (linked_ > 0 && !before(now, next_)) {
+    uint32_t index = next_ & (kRootSlots - 1);
+    if (heads_[index] == kNone) {
+      // Jump to the next occupied slot of this turn, or to its end.
+      uint32_t occupied = kRootSlots;
+      for (uint32_t word = (index + 1) / 64; word < kRootSlots / 64; ++word) {
+        uint64_t bits = root_bits_[word];
+        if (word == (index + 1) / 64) bits &= ~0ull << ((index + 1) % 64);
+        if (bits) {
+          occupied = word * 64 + std::countr_zero(bits);
+          break;
+        }
+      }
+      advance(std::min(occupied - index, now - next_ + 1));
+      continue;
+    }
+    running_ = true;
+    floor_ = next_ + 1;
+    run_slot(index, now);
+    running_ = false;
+    advance(1);
+  }
+  if (linked_ == 0) next_ = now + 1;
+  rearm_driver();
+}
+
+uint32_t TimerWheel::add(uint32_t period, Callback cb, void* user_data) {
+  uint32_t id;
+  if (free_ != kNone) {
+    id = free_;
+    free_ = entries_[id].next;
+  } else {
+    id = static_cast<uint32_t>(entries_.size());
+    entries_.emplace_back();
+  }
+  Entry& entry = entries_[id];
+  entry = Entry();
+  entry.cb = cb;
+  entry.user_data = user_data;
+  entry.period = std::clamp<uint32_t>(period, 1, kMaxPeriod);
+  entry.last_run = lv_tick_get();
+  ++count_;
+  schedule(id, entry.last_run + entry.period);
+  return id;
+}
+
+void TimerWheel::remove(uint32_t id) {
+  if (id >= entries_.size() || !entries_[id].cb) return;
+  if (entries_[id].linked) unlink(id);
+  if (firing_ == id) firing_ = kNone;
+  entries_[id] = Entry();
+  entries_[id].next = free_;
+  free_ = id;
+  --count_;
+}
+
+void TimerWheel::set_period(uint32_t id, uint32_t period) {
+  Entry& entry = entries_[id];
+  entry.period = std::clamp<uint32_t>(period, 1, kMaxPeriod);
+  if (entry.linked) schedule(id, entry.last_run + entry.period);
+}
+
+void TimerWheel::set_repeat_count(uint32_t id, int32_t repeat_count) {
+  entries_[id].repeat_count = repeat_count;
+}
+
+void TimerWheel::pause(uint32_t id) {
+  Entry& entry = entries_[id];
+  entry.paused = true;
+  if (entry.linked) unlink(id);
+}
+
+void TimerWheel::resume(uint32_t id) {
+  Entry& entry = entries_[id];
+  if (!entry.paused) return;
+  entry.paused = false;
+  schedule(id, entry.last_run + entry.period);
+}
+
+void TimerWheel::reset(uint32_t id) {
+  Entry& entry = entries_[id];
+  entry.last_run = lv_tick_get();
+  if (!entry.paused) schedule(id, entry.last_run + entry.period);
+}
+
+void TimerWheel::ready(uint32_t id) {
+  if (!entries_[id].paused) schedule(id, lv_tick_get());
+}
+
+void TimerWheel::timer_cb(lv_timer_t* timer) {
+  static_cast<TimerWheel*>(lv_timer_get_user_data(timer))->process();
+}
+
+void TimerWheel::schedule(uint32_t id, uint32_t expires) {
+  Entry& entry = entries_[id];
+  if (entry.linked) unlink(id);
+  // An empty wheel may have stopped counting long ago; restart it at now
+  // so the new entry does not have to be walked up to.
+  if (linked_ == 0 && !running_) next_ = lv_tick_get();
+  entry.expires = expires;
+  link(id);
+  if (!running_ && (!driver_armed_ || before(expires, driver_due_))) {
+    rearm_driver();
+  }
+}
+
+void TimerWheel::link(uint32_t id) {
+  Entry& entry = entries_[id];
+  // While a slot runs, due entries go to the first millisecond that has
+  // not been processed yet instead of the running slot.
+  if (running_ && before(entry.expires, floor_)) entry.expires = floor_;
+
+  uint32_t delta = entry.expires - next_;
+  uint32_t slot;
+  if (before(entry.expires, next_)) {
+    slot = kDueSlot;
+  } else if (delta < kRootSlots) {
+    slot = entry.expires & (kRootSlots - 1);
+  } else {
+    int level = 1;
+    while (level < kLevels - 1 &&
+           delta >= 1u << (level_shift(level) + kLevelBits)) {
+      ++level;
+    }
+    slot = level_base(level) +
+           ((entry.expires >> level_shift(level)) & (kLevelSlots - 1));
+  }
+
+  entry.slot = static_cast<uint16_t>(slot);
+  entry.prev = kNone;
+  entry.next = heads_[slot];
+  if (entry.next != kNone) entries_[entry.next].prev = id;
+  heads_[slot] = id;
+  entry.linked = true;
+  set_occupied(slot, true);
+  ++linked_;
+}
+
+void TimerWheel::unlink(uint32_t id) {
+  Entry& entry = entries_[id];
+  if (entry.prev != kNone) {
+    entries_[entry.prev].next = entry.next;
+  } else {
+    heads_[entry.slot] = entry.next;
+    if (entry.next == kNone) set_occupied(entry.slot, false);
+  }
+  if (entry.next != kNone) entries_[entry.next].prev = entry.prev;
+  entry.prev = kNone;
+  entry.next = kNone;
+  entry.linked = false;
+  --linked_;
+}
+
+void TimerWheel::advance(uint32_t ms) {
+  // Never crosses a turn of the root level, so at most one cascade. The
+  // upper levels are cascaded as soon as a turn starts, which keeps
+  // next_expiry() exact between passes.
+  next_ += ms;
+  if ((next_ & (kRootSlots - 1)) == 0) cascade(1);
+}
+
+void TimerWheel::cascade(int level) {
+  uint32_t index = (next_ >> level_shift(level)) & (kLevelSlots - 1);
+  uint32_t slot = level_base(level) + index;
+  uint32_t id = heads_[slot];
+  heads_[slot] = kNone;
+  set_occupied(slot, false);
+  while (id != kNone) {
+    uint32_t next = entries_[id].next;
+    entries_[id].linked = false;
+    --linked_;
+    link(id);
+    id = next;
+  }
+  if (index == 0 && level < kLevels - 1) cascade(level + 1);
+}
+
+void TimerWheel::run_slot(uint32_t slot, uint32_t now) {
+  // Entries scheduled from callbacks never land in this slot, so popping
+  // the head until it is empty terminates.
+  uint32_t id;
+  while ((id = heads_[slot]) != kNone) {
+    unlink(id);
+    Entry& entry = entries_[id];
+    if (entry.repeat_count > 0) --entry.repeat_count;
+    entry.last_run = now;
+    firing_ = id;
+    entry.cb(entry.user_data);
+    // The callback may have added timers and moved `entries_`.
+    if (firing_ != id) continue;  // Removed by its callback.
+    Entry& after = entries_[id];
+    if (!after.linked && !after.paused) {
+      if (after.repeat_count == 0) {
+        after.paused = true;
+      } else {
+        after.expires = now + after.period;
+        link(id);
+      }
+    }
+    firing_ = kNone;
+  }
+}
+
+uint32_t TimerWheel::next_expiry() const {
+  if (heads_[kDueSlot] != kNone) return slot_min_expiry(kDueSlot);
+  uint32_t index = next_ & (kRootSlots - 1);
+  uint32_t first = kRootSlots;
+  for (uint32_t word = 0; word < kRootSlots / 64; ++word) {
+    if (root_bits_[word]) {
+      first = word * 64 + std::countr_zero(root_bits_[word]);
+      break;
+    }
+  }
+  // Root slots at or after the current one are due within this turn and
+  // beat everything on the upper levels.
+  for (uint32_t word = index / 64; word < kRootSlots / 64; ++word) {
+    uint64_t bits = root_bits_[word];
+    if (word == index / 64) bits &= ~0ull << (index % 64);
+    if (bits) return next_ + (word * 64 + std::countr_zero(bits) - index);
+  }
+
+  bool found = first < index;
+  uint32_t best = found ? next_ + (kRootSlots - index) + first : 0;
+  for (int level = 1; level < kLevels; ++level) {
+    uint64_t bits = level_bits_[level];
+    if (!bits) continue;
+    uint32_t current = (next_ >> level_shift(level)) & (kLevelSlots - 1);
+    // First occupied slot after the current one, wrapping around to it.
+    uint32_t start = (current + 1) & (kLevelSlots - 1);
+    uint32_t offset = std::countr_zero(std::rotr(bits, start));
+    uint32_t slot = level_base(level) + ((start + offset) & (kLevelSlots - 1));
+    uint32_t expires = slot_min_expiry(slot);
+    if (!found || before(expires, best)) {
+      best = expires;
+      found = true;
+    }
+  }
+  return best;
+}
+
+uint32_t TimerWheel::slot_min_expiry(uint32_t slot) const {
+  uint32_t id = heads_[slot];
+  uint32_t best = entries_[id].expires;
+  for (id = entries_[id].next; id != kNone; id = entries_[id].next) {
+    if (before(entries_[id].expires, best)) best = entries_[id].expires;
+  }
+  return best;
+}
+
+void TimerWheel::rearm_driver() {
+  if (linked_ == 0) {
+    lv_timer_pause(driver_);
+    driver_armed_ = false;
+    return;
+  }
+  uint32_t due = next_expiry();
+  uint32_t now = lv_tick_get();
+  lv_timer_set_period(driver_, before(due, now) ? 0 : due - now);
+  lv_timer_reset(driver_);
+  lv_timer_resume(driver_);
+  driver_due_ = due;
+  driver_armed_ = true;
+}
+
+void TimerWheel::set_occupied(uint32_t slot, bool occupied) {
+  uint64_t* word;
+  uint32_t bit;
+  if (slot == kDueSlot) {
+    return;
+  } else if (slot < kRootSlots) {
+    word = &root_bits_[slot / 64];
+    bit = slot % 64;
+  } else {
+    word = &level_bits_[1 + (slot - kRootSlots) / kLevelSlots];
+    bit = (slot - kRootSlots) % kLevelSlots;
+  }
+  if (occupied) {
+    *word |= 1ull << bit;
+  } else {
+    *word &= ~(1ull << bit);
+  }
+}
+
+}  // namespace lvgl
@@ -0,0 +1,138 @@
+#ifndef LVGL_CPP_MISC_TIMER_WHEEL_H_
+#define LVGL_CPP_MISC_TIMER_WHEEL_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file timer_wheel.h
+ * @brief User Guide:
+ * A `TimerWheel` runs many `Timer`s from a single LVGL timer. Each
+ * `lv_timer_t` is checked on every `lv_timer_handler()` pass, so thousands
+ * of them cost CPU even when none is due. Timers on a wheel are kept in
+ * hierarchical time slots instead: starting, stopping and rescheduling are
+ * O(1), and a pass only touches the timers that are due.
+ *
+ * The wheel keeps its LVGL timer set to the next deadline, so the value
+ * returned by `lv_timer_handler()` stays accurate for the port's sleep.
+ *
+ * Example:
+ * @code
+ * lvgl::TimerWheel wheel;
+ * std::vector<lvgl::Timer> refreshers;
+ * for (auto& tile : tiles) {
+ *   refreshers.emplace_back(wheel, 1000, [&tile](lvgl::Timer*) {
+ *     tile.refresh();
+ *   });
+ * }
+ * @endcode
+ *
+ * Timers keep their period, repeat count, pause and resume behaviour, except
+ * that a timer whose repeat count runs out is paused rather than deleted.
+ * All timers of a wheel must be destroyed before the wheel.
+ */
+namespace lvgl {
+
+class Timer;
+
+class TimerWheel {
+ public:
+  TimerWheel();
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+  TimerWheel(TimerWheel&&) = delete;
+  TimerWheel& operator=(TimerWheel&&) = delete;
+
+  /**
+   * @brief Number of timers on the wheel, including paused ones.
+   */
+  uint32_t size() const { return count_; }
+
+  /**
+   * @brief Milliseconds until the next timer is due, 0 if one is overdue,
+   * or LV_NO_TIMER_READY if none is scheduled.
+   */
+  uint32_t get_next_deadline() const;
+
+  /**
+   * @brief Run every timer due by now. Called by the wheel's LVGL timer.
+   */
+  void process();
+
+ private:
+  friend class Timer;
+
+  using Callback = void (*)(void* user_data);
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  static constexpr int kLevels = 5;
+  static constexpr int kRootBits = 8;
+  static constexpr int kLevelBits = 6;
+  static constexpr uint32_t kRootSlots = 1u << kRootBits;
+  static constexpr uint32_t kLevelSlots = 1u << kLevelBits;
+  static constexpr uint32_t kSlots = kRootSlots + (kLevels - 1) * kLevelSlots;
+  // Entries that fell due before `next_`; run first on the next pass.
+  static constexpr uint32_t kDueSlot = kSlots;
+
+  struct Entry {
+    Callback cb = nullptr;
+    void* user_data = nullptr;
+    uint32_t period = 0;
+    uint32_t expires = 0;
+    uint32_t last_run = 0;
+    int32_t repeat_count = -1;
+    uint32_t prev = kNone;
+    uint32_t next = kNone;  // Also links the free list.
+    uint16_t slot = 0;
+    bool linked = false;
+    bool paused = false;
+  };
+
+  // Used by Timer. Ids index `entries_` and stay valid until remove().
+  uint32_t add(uint32_t period, Callback cb, void* user_data);
+  void remove(uint32_t id);
+  void set_period(uint32_t id, uint32_t period);
+  void set_repeat_count(uint32_t id, int32_t repeat_count);
+  void pause(uint32_t id);
+  void resume(uint32_t id);
+  void reset(uint32_t id);
+  void ready(uint32_t id);
+
+  static void timer_cb(lv_timer_t* timer);
+  void schedule(uint32_t id, uint32_t expires);
+  void link(uint32_t id);
+  void unlink(uint32_t id);
+  void advance(uint32_t ms);
+  void cascade(int level);
+  void run_slot(uint32_t slot, uint32_t now);
+  uint32_t next_expiry() const;
+  uint32_t slot_min_expiry(uint32_t slot) const;
+  void rearm_driver();
+  void set_occupied(uint32_t slot, bool occupied);
+
+  std::vector<Entry> entries_;
+  uint32_t free_ = kNone;
+  uint32_t count_ = 0;
+
+  uint32_t heads_[kSlots + 1];
+  uint64_t root_bits_[kRootSlots / 64] = {};
+  uint64_t level_bits_[kLevels] = {};  // Index 0 unused.
+
+  uint32_t next_ = 0;  // Next millisecond to process.
+  uint32_t linked_ = 0;
+  uint32_t firing_ = kNone;
+  uint32_t floor_ = 0;    // Earliest expiry while a slot runs.
+  bool running_ = false;  // A slot's callbacks are running.
+
+  lv_timer_t* driver_ = nullptr;
+  uint32_t driver_due_ = 0;
+  bool driver_armed_ = false;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_TIMER_WHEEL_H_
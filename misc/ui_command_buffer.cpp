@@ -0,0 +1,227 @@
+#include "ui_command_buffer.h"
+
+#include <functional>
+
+#include "../core/object.h"
+#include "../display/display.h"
+#include "../widgets/arc.h"
+#include "../widgets/bar.h"
+#include "../widgets/label.h"
+#include "../widgets/slider.h"
+#include "../widgets/textarea.h"
+
+namespace lvgl {
+
+namespace {
+
+constexpr UiCommandBuffer::Property kProperties[] = {
+    UiCommandBuffer::Property::Text, UiCommandBuffer::Property::Value,
+    UiCommandBuffer::Property::Position, UiCommandBuffer::Property::Size,
+    UiCommandBuffer::Property::Hidden};
+
+void apply_label_text(lv_obj_t* obj, const UiCommandBuffer::Command& cmd) {
+  lv_label_set_text(obj, cmd.text.c_str());
+}
+
+void apply_textarea_text(lv_obj_t* obj, const UiCommandBuffer::Command& cmd) {
+  lv_textarea_set_text(obj, cmd.text.c_str());
+}
+
+void apply_bar_value(lv_obj_t* obj, const UiCommandBuffer::Command& cmd) {
+  lv_bar_set_value(obj, cmd.a, static_cast<lv_anim_enable_t>(cmd.b));
+}
+
+void apply_slider_value(lv_obj_t* obj, const UiCommandBuffer::Command& cmd) {
+  lv_slider_set_value(obj, cmd.a, static_cast<lv_anim_enable_t>(cmd.b));
+}
+
+void apply_arc_value(lv_obj_t* obj, const UiCommandBuffer::Command& cmd) {
+  lv_arc_set_value(obj, cmd.a);
+}
+
+}  // namespace
+
+size_t UiCommandBuffer::KeyHash::operator()(const Key& key) const {
+  return std::hash<lv_obj_t*>()(key.obj) * 31 +
+         static_cast<size_t>(key.property);
+}
+
+UiCommandBuffer::UiCommandBuffer(Display* display)
+    : display_(display ? display->raw() : lv_display_get_default()) {
+  if (display_) {
+    lv_display_add_event_cb(display_, display_event_cb, LV_EVENT_REFR_START,
+                            this);
+    lv_display_add_event_cb(display_, display_event_cb, LV_EVENT_DELETE,
+                            this);
+  }
+}
+
+UiCommandBuffer::~UiCommandBuffer() {
+  if (display_) {
+    lv_display_remove_event_cb_with_user_data(display_, display_event_cb,
+                                              this);
+  }
+  for (lv_obj_t* obj : tracked_) {
+    lv_obj_remove_event_cb_with_user_data(obj, deleted_cb, this);
+  }
+}
+
+UiCommandBuffer::ObjectCommands UiCommandBuffer::post(Object& obj) {
+  return ObjectCommands(*this, obj.raw());
+}
+
+UiCommandBuffer::TextCommands UiCommandBuffer::post(Label& label) {
+  return TextCommands(*this, label.raw(), apply_label_text, &lv_label_class);
+}
+
+UiCommandBuffer::TextCommands UiCommandBuffer::post(Textarea& textarea) {
+  return TextCommands(*this, textarea.raw(), apply_textarea_text,
+                      &lv_textarea_class);
+}
+
+UiCommandBuffer::ValueCommands UiCommandBuffer::post(Bar& bar) {
+  return ValueCommands(*this, bar.raw(), apply_bar_value, &lv_bar_class);
+}
+
+UiCommandBuffer::ValueCommands UiCommandBuffer::post(Slider& slider) {
+  return ValueCommands(*this, slider.raw(), apply_slider_value,
+                       &lv_slider_class);
+}
+
+UiCommandBuffer::ValueCommands UiCommandBuffer::post(Arc& arc) {
+  return ValueCommands(*this, arc.raw(), apply_arc_value, &lv_arc_class);
+}
+
+UiCommandBuffer::Stripe& UiCommandBuffer::stripe_for(lv_obj_t* obj) {
+  // Objects come from an allocator; drop the alignment bits.
+  size_t hash = reinterpret_cast<uintptr_t>(obj) >> 4;
+  return stripes_[(hash ^ (hash >> 7)) % kStripes];
+}
+
+void UiCommandBuffer::record(lv_obj_t* obj, Property property, ApplyFn apply,
+                             const lv_obj_class_t* cls, int32_t a, int32_t b,
+                             std::string_view text) {
+  if (!obj) return;
+  Stripe& stripe = stripe_for(obj);
+  std::lock_guard<std::mutex> lock(stripe.mutex);
+  ++stripe.recorded;
+  auto [it, inserted] = stripe.index.try_emplace(
+      Key{obj, property}, static_cast<uint32_t>(stripe.pending.size()));
+  if (inserted) {
+    stripe.pending.push_back(
+        {obj, property, apply, cls, a, b, std::string(text)});
+    return;
+  }
+  ++stripe.coalesced;
+  Command& command = stripe.pending[it->second];
+  command.apply = apply;
+  command.cls = cls;
+  command.a = a;
+  command.b = b;
+  command.text.assign(text);
+}
+
+uint32_t UiCommandBuffer::flush() {
+  uint32_t applied = 0;
+  flushing_ = true;
+  for (Stripe& stripe : stripes_) {
+    {
+      std::lock_guard<std::mutex> lock(stripe.mutex);
+      if (stripe.pending.empty()) continue;
+      stripe.pending.swap(stripe.replaying);
+      stripe.index.clear();
+    }
+    // A command may delete an object; deleted_cb() then clears the
+    // object's remaining commands in `replaying`.
+    for (size_t i = 0; i < stripe.replaying.size(); ++i) {
+      Command& command = stripe.replaying[i];
+      if (!command.obj || !watch(command.obj)) continue;
+      if (command.cls && !lv_obj_check_type(command.obj, command.cls)) {
+        continue;
+      }
+      command.apply(command.obj, command);
+      ++applied;
+    }
+    stripe.replaying.clear();
+  }
+  flushing_ = false;
+  return applied;
+}
+
+void UiCommandBuffer::track(Object& obj) { watch(obj.raw()); }
+
+bool UiCommandBuffer::watch(lv_obj_t* obj) {
+  if (tracked_.count(obj)) return true;
+  if (!lv_obj_is_valid(obj)) return false;
+  tracked_.insert(obj);
+  lv_obj_add_event_cb(obj, deleted_cb, LV_EVENT_DELETE, this);
+  return true;
+}
+
+void UiCommandBuffer::drop(lv_obj_t* obj) {
+  Stripe& stripe = stripe_for(obj);
+  std::lock_guard<std::mutex> lock(stripe.mutex);
+  for (Property property : kProperties) {
+    auto it = stripe.index.find(Key{obj, property});
+    if (it == stripe.index.end()) continue;
+    stripe.pending[it->second].obj = nullptr;
+    stripe.index.erase(it);
+  }
+  if (flushing_) {
+    for (Command& command : stripe.replaying) {
+      if (command.obj == obj) command.obj = nullptr;
+    }
+  }
+}
+
+uint64_t UiCommandBuffer::get_recorded() const {
+  uint64_t total = 0;
+  for (const Stripe& stripe : stripes_) {
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    total += stripe.recorded;
+  }
+  return total;
+}
+
+uint64_t UiCommandBuffer::get_coalesced() const {
+  uint64_t total = 0;
+  for (const Stripe& stripe : stripes_) {
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    total += stripe.coalesced;
+  }
+  return total;
+}
+
+void UiCommandBuffer::apply_pos(lv_obj_t* obj, const Command& command) {
+  lv_obj_set_pos(obj, command.a, command.b);
+}
+
+void UiCommandBuffer::apply_size(lv_obj_t* obj, const Command& command) {
+  lv_obj_set_size(obj, command.a, command.b);
+}
+
+void UiCommandBuffer::apply_hidden(lv_obj_t* obj, const Command& command) {
+  if (command.a) {
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+  } else {
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_HIDDEN);
+  }
+}
+
+void UiCommandBuffer::display_event_cb(lv_event_t* e) {
+  auto* self = static_cast<UiCommandBuffer*>(lv_event_get_user_data(e));
+  if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+    self->display_ = nullptr;
+    return;
+  }
+  self->flush();
+}
+
+void UiCommandBuffer::deleted_cb(lv_event_t* e) {
+  auto* self = static_cast<UiCommandBuffer*>(lv_event_get_user_data(e));
+  auto* obj = static_cast<lv_obj_t*>(lv_event_get_target(e));
+  self->tracked_.erase(obj);
+  self->drop(obj);
+}
+
+}  // namespace lvgl
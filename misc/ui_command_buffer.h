@@ -0,0 +1,238 @@
+#ifndef LVGL_CPP_MISC_UI_COMMAND_BUFFER_H_
+#define LVGL_CPP_MISC_UI_COMMAND_BUFFER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../misc/enums.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file ui_command_buffer.h
+ * @brief User Guide:
+ * `UiCommandBuffer` lets worker threads update widgets without taking the
+ * LVGL lock. Threads record commands against a widget; the buffer replays
+ * them on the LVGL thread at the start of each display refresh.
+ *
+ * Key Features:
+ * - **Coalescing**: Commands are keyed by (object, property). Recording the
+ *   same property again replaces the pending value, so only the last one is
+ *   applied. A producer updating a label 1,000 times per frame costs one
+ *   `lv_label_set_text()`.
+ * - **Short critical sections**: Recording only copies the value into one
+ *   of several independently locked stripes, chosen by object, so
+ *   producers rarely contend with each other and never with rendering.
+ * - **Ordering**: Commands for one object are applied in the order their
+ *   properties were first recorded in the frame.
+ * - **Deleted objects**: Pending commands for a deleted object are dropped.
+ *
+ * Example:
+ * @code
+ * lvgl::UiCommandBuffer commands;  // Created on the LVGL thread.
+ * // On any thread:
+ * commands.post(status_label).set_text("Connected");
+ * commands.post(progress).set_value(percent, lvgl::AnimEnable::On);
+ * @endcode
+ *
+ * Commands only carry the raw object pointer and the widget class the
+ * setter needs. An object first seen by the buffer is checked with
+ * `lv_obj_is_valid()` before use, and a widget command is skipped unless
+ * `lv_obj_check_type()` matches, so a reused address never reaches the
+ * wrong setter. Call `track()` on the LVGL thread for objects that may be
+ * deleted while commands are pending, so their address cannot be mistaken
+ * for a new object's.
+ *
+ * `post()` reads the wrapper's raw pointer on the calling thread: the
+ * wrapper must stay alive, and not be moved from, until `post()` returns.
+ * The returned recorder keeps only the raw pointer.
+ */
+namespace lvgl {
+
+class Arc;
+class Bar;
+class Display;
+class Label;
+class Object;
+class Slider;
+class Textarea;
+
+class UiCommandBuffer {
+ public:
+  /** Properties that commands coalesce on. */
+  enum class Property : uint8_t { Text, Value, Position, Size, Hidden };
+
+  struct Command;
+  using ApplyFn = void (*)(lv_obj_t* obj, const Command& command);
+
+  struct Command {
+    lv_obj_t* obj;
+    Property property;
+    ApplyFn apply;
+    const lv_obj_class_t* cls;  ///< Required class, or nullptr for any.
+    int32_t a;
+    int32_t b;
+    std::string text;
+  };
+
+  /**
+   * @brief Records commands for one object. Returned by post().
+   */
+  template <typename Derived>
+  class Recorder {
+   public:
+    Derived& set_pos(int32_t x, int32_t y) {
+      buffer_.record(obj_, Property::Position, apply_pos, nullptr, x, y);
+      return self();
+    }
+    Derived& set_size(int32_t width, int32_t height) {
+      buffer_.record(obj_, Property::Size, apply_size, nullptr, width,
+                     height);
+      return self();
+    }
+    Derived& set_hidden(bool hidden) {
+      buffer_.record(obj_, Property::Hidden, apply_hidden, nullptr, hidden,
+                     0);
+      return self();
+    }
+
+   protected:
+    Recorder(UiCommandBuffer& buffer, lv_obj_t* obj)
+        : buffer_(buffer), obj_(obj) {}
+    Derived& self() { return static_cast<Derived&>(*this); }
+
+    UiCommandBuffer& buffer_;
+    lv_obj_t* obj_;
+  };
+
+  class ObjectCommands : public Recorder<ObjectCommands> {
+   public:
+    ObjectCommands(UiCommandBuffer& buffer, lv_obj_t* obj)
+        : Recorder(buffer, obj) {}
+  };
+
+  class TextCommands : public Recorder<TextCommands> {
+   public:
+    TextCommands(UiCommandBuffer& buffer, lv_obj_t* obj, ApplyFn apply,
+                 const lv_obj_class_t* cls)
+        : Recorder(buffer, obj), apply_(apply), cls_(cls) {}
+    TextCommands& set_text(std::string_view text) {
+      buffer_.record(obj_, Property::Text, apply_, cls_, 0, 0, text);
+      return *this;
+    }
+
+   private:
+    ApplyFn apply_;
+    const lv_obj_class_t* cls_;
+  };
+
+  class ValueCommands : public Recorder<ValueCommands> {
+   public:
+    ValueCommands(UiCommandBuffer& buffer, lv_obj_t* obj, ApplyFn apply,
+                  const lv_obj_class_t* cls)
+        : Recorder(buffer, obj), apply_(apply), cls_(cls) {}
+    ValueCommands& set_value(int32_t value, AnimEnable anim = AnimEnable::Off) {
+      buffer_.record(obj_, Property::Value, apply_, cls_, value,
+                     static_cast<int32_t>(anim));
+      return *this;
+    }
+
+   private:
+    ApplyFn apply_;
+    const lv_obj_class_t* cls_;
+  };
+
+  /**
+   * @brief Create on the LVGL thread. Commands are replayed when `display`
+   * (default: the default display) starts a refresh.
+   */
+  explicit UiCommandBuffer(Display* display = nullptr);
+  ~UiCommandBuffer();
+
+  UiCommandBuffer(const UiCommandBuffer&) = delete;
+  UiCommandBuffer& operator=(const UiCommandBuffer&) = delete;
+
+  /** @name Recording (any thread) */
+  ///@{
+  ObjectCommands post(Object& obj);
+  TextCommands post(Label& label);
+  TextCommands post(Textarea& textarea);
+  ValueCommands post(Bar& bar);
+  ValueCommands post(Slider& slider);
+  ValueCommands post(Arc& arc);
+  ///@}
+
+  /**
+   * @brief Apply all pending commands now. LVGL thread only.
+   * @return Number of commands applied.
+   */
+  uint32_t flush();
+
+  /**
+   * @brief Watch `obj` for deletion so pending commands are dropped with
+   * it. LVGL thread only.
+   */
+  void track(Object& obj);
+
+  /**
+   * @brief Commands recorded so far, including coalesced ones.
+   */
+  uint64_t get_recorded() const;
+
+  /**
+   * @brief Commands replaced by a later value before being applied.
+   */
+  uint64_t get_coalesced() const;
+
+ private:
+  static constexpr size_t kStripes = 16;
+
+  struct Key {
+    lv_obj_t* obj;
+    Property property;
+    bool operator==(const Key& other) const {
+      return obj == other.obj && property == other.property;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct alignas(64) Stripe {
+    mutable std::mutex mutex;
+    std::vector<Command> pending;
+    std::unordered_map<Key, uint32_t, KeyHash> index;
+    std::vector<Command> replaying;  // LVGL thread only.
+    uint64_t recorded = 0;
+    uint64_t coalesced = 0;
+  };
+
+  void record(lv_obj_t* obj, Property property, ApplyFn apply,
+              const lv_obj_class_t* cls, int32_t a, int32_t b,
+              std::string_view text = {});
+  Stripe& stripe_for(lv_obj_t* obj);
+  bool watch(lv_obj_t* obj);
+  void drop(lv_obj_t* obj);
+
+  static void apply_pos(lv_obj_t* obj, const Command& command);
+  static void apply_size(lv_obj_t* obj, const Command& command);
+  static void apply_hidden(lv_obj_t* obj, const Command& command);
+  static void display_event_cb(lv_event_t* e);
+  static void deleted_cb(lv_event_t* e);
+
+  std::array<Stripe, kStripes> stripes_;
+  lv_display_t* display_ = nullptr;
+  std::unordered_set<lv_obj_t*> tracked_;
+  bool flushing_ = false;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_MISC_UI_COMMAND_BUFFER_H_
@@ -2,11 +2,80 @@
 
 #if LV_USE_VECTOR_GRAPHIC
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "vector_cache.h"
+
 namespace lvgl {
 
+namespace {
+
+// FNV-1a over the arguments of each call.
+constexpr uint64_t kHashSeed = 14695981039346656037ull;
+
+uint64_t hash_bytes(uint64_t h, const void* data, size_t size) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    h ^= p[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+template <typename T>
+uint64_t hash_value(uint64_t h, const T& value) {
+  return hash_bytes(h, &value, sizeof(value));
+}
+
+enum PathOp : uint8_t {
+  kMoveTo = 1,
+  kLineTo,
+  kQuadTo,
+  kCubicTo,
+  kArcTo,
+  kClose,
+  kRect,
+  kCircle,
+  kArc,
+  kAppendPath,
+  kTransform,
+};
+
+// Setter ids recorded by a cached VectorDraw; 0 marks a path.
+enum Setting : uint32_t {
+  kPath = 0,
+  kBlendMode,
+  kFillColor,
+  kFillOpa,
+  kFillRule,
+  kFillImage,
+  kFillLinearGradient,
+  kFillRadialGradient,
+  kFillGradientStops,
+  kFillGradientSpread,
+  kFillTransform,
+  kStrokeColor,
+  kStrokeOpa,
+  kStrokeWidth,
+  kStrokeDash,
+  kStrokeCap,
+  kStrokeJoin,
+  kStrokeMiterLimit,
+  kStrokeLinearGradient,
+  kStrokeRadialGradient,
+  kStrokeGradientStops,
+  kStrokeGradientSpread,
+  kStrokeTransform,
+};
+
+}  // namespace
+
 // --- VectorPath ---
 
-VectorPath::VectorPath(lv_vector_path_quality_t quality) {
+VectorPath::VectorPath(lv_vector_path_quality_t quality)
+    : quality_(quality), hash_(hash_value(kHashSeed, quality)) {
   path_ = lv_vector_path_create(quality);
 }
 
@@ -14,7 +83,8 @@ VectorPath::~VectorPath() {
   if (path_) lv_vector_path_delete(path_);
 }
 
-VectorPath::VectorPath(VectorPath&& other) noexcept : path_(other.path_) {
+VectorPath::VectorPath(VectorPath&& other) noexcept
+    : path_(other.path_), quality_(other.quality_), hash_(other.hash_) {
   other.path_ = nullptr;
 }
 
@@ -22,117 +92,153 @@ VectorPath& VectorPath::operator=(VectorPath&& other) noexcept {
   if (this != &other) {
     if (path_) lv_vector_path_delete(path_);
     path_ = other.path_;
+    quality_ = other.quality_;
+    hash_ = other.hash_;
     other.path_ = nullptr;
   }
   return *this;
 }
 
+void VectorPath::mix(uint8_t op, const void* args, size_t size) {
+  hash_ = hash_bytes(hash_value(hash_, op), args, size);
+}
+
 void VectorPath::copy_from(const VectorPath& other) {
   if (path_ && other.path_) {
     lv_vector_path_copy(path_, other.path_);
+    quality_ = other.quality_;
+    hash_ = other.hash_;
   }
 }
 
 void VectorPath::clear() {
-  if (path_) lv_vector_path_clear(path_);
+  if (!path_) return;
+  lv_vector_path_clear(path_);
+  hash_ = hash_value(kHashSeed, quality_);
 }
 
 void VectorPath::move_to(float x, float y) {
   lv_fpoint_t p = {x, y};
-  if (path_) lv_vector_path_move_to(path_, &p);
+  if (!path_) return;
+  lv_vector_path_move_to(path_, &p);
+  mix(kMoveTo, &p, sizeof(p));
 }
 
 void VectorPath::line_to(float x, float y) {
   lv_fpoint_t p = {x, y};
-  if (path_) lv_vector_path_line_to(path_, &p);
+  if (!path_) return;
+  lv_vector_path_line_to(path_, &p);
+  mix(kLineTo, &p, sizeof(p));
 }
 
 void VectorPath::quad_to(float cx, float cy, float x, float y) {
-  lv_fpoint_t p1 = {cx, cy};
-  lv_fpoint_t p2 = {x, y};
-  if (path_) lv_vector_path_quad_to(path_, &p1, &p2);
+  lv_fpoint_t p[] = {{cx, cy}, {x, y}};
+  if (!path_) return;
+  lv_vector_path_quad_to(path_, &p[0], &p[1]);
+  mix(kQuadTo, p, sizeof(p));
 }
 
 void VectorPath::cubic_to(float cx1, float cy1, float cx2, float cy2, float x,
                           float y) {
-  lv_fpoint_t p1 = {cx1, cy1};
-  lv_fpoint_t p2 = {cx2, cy2};
-  lv_fpoint_t p3 = {x, y};
-  if (path_) lv_vector_path_cubic_to(path_, &p1, &p2, &p3);
+  lv_fpoint_t p[] = {{cx1, cy1}, {cx2, cy2}, {x, y}};
+  if (!path_) return;
+  lv_vector_path_cubic_to(path_, &p[0], &p[1], &p[2]);
+  mix(kCubicTo, p, sizeof(p));
 }
 
 void VectorPath::arc_to(float rx, float ry, float angle, bool large_arc,
                         bool sweep, float x, float y) {
   lv_fpoint_t p = {x, y};
-  if (path_) lv_vector_path_arc_to(path_, rx, ry, angle, large_arc, sweep, &p);
+  if (!path_) return;
+  lv_vector_path_arc_to(path_, rx, ry, angle, large_arc, sweep, &p);
+  float args[] = {rx, ry, angle, x, y, large_arc ? 1.0f : 0.0f,
+                  sweep ? 1.0f : 0.0f};
+  mix(kArcTo, args, sizeof(args));
 }
 
 void VectorPath::close() {
-  if (path_) lv_vector_path_close(path_);
+  if (!path_) return;
+  lv_vector_path_close(path_);
+  mix(kClose, nullptr, 0);
 }
 
 void VectorPath::append_rect(float x, float y, float w, float h, float rx,
                              float ry) {
-  if (path_) lv_vector_path_append_rectangle(path_, x, y, w, h, rx, ry);
+  if (!path_) return;
+  lv_vector_path_append_rectangle(path_, x, y, w, h, rx, ry);
+  float args[] = {x, y, w, h, rx, ry};
+  mix(kRect, args, sizeof(args));
 }
 
 void VectorPath::append_rect(const Area& area, float rx, float ry) {
-  if (path_)
-    lv_vector_path_append_rectangle(
-        path_, (float)area.raw()->x1, (float)area.raw()->y1,
-        (float)lv_area_get_width(area.raw()),
-        (float)lv_area_get_height(area.raw()), rx, ry);
+  append_rect((float)area.raw()->x1, (float)area.raw()->y1,
+              (float)lv_area_get_width(area.raw()),
+              (float)lv_area_get_height(area.raw()), rx, ry);
 }
 
 // ... existing code ...
 
 void VectorDraw::set_fill_image(const DrawImageDescriptor& dsc) {
-  if (dsc_)
-    lv_draw_vector_dsc_set_fill_image(
-        dsc_, reinterpret_cast<const lv_draw_image_dsc_t*>(dsc.raw()));
+  set_fill_image(*dsc.raw());
 }
 
 // ... existing code ...
 
 void VectorDraw::set_fill_gradient_stops(
     const std::vector<GradientStop>& stops) {
-  if (dsc_ && !stops.empty()) {
-    // Cast is safe because GradientStop has same layout as lv_grad_stop_t
-    lv_draw_vector_dsc_set_fill_gradient_color_stops(
-        dsc_, reinterpret_cast<const lv_grad_stop_t*>(stops.data()),
-        stops.size());
-  }
+  if (stops.empty()) return;
+  update(kFillGradientStops, stops.data(),
+         stops.size() * sizeof(GradientStop),
+         [stops](lv_draw_vector_dsc_t* dsc) {
+           // Cast is safe because GradientStop has same layout as
+           // lv_grad_stop_t
+           lv_draw_vector_dsc_set_fill_gradient_color_stops(
+               dsc, reinterpret_cast<const lv_grad_stop_t*>(stops.data()),
+               stops.size());
+         });
 }
 
 // ... existing code ...
 
 void VectorDraw::set_stroke_gradient_stops(
     const std::vector<GradientStop>& stops) {
-  if (dsc_ && !stops.empty()) {
-    lv_draw_vector_dsc_set_stroke_gradient_color_stops(
-        dsc_, reinterpret_cast<const lv_grad_stop_t*>(stops.data()),
-        stops.size());
-  }
+  if (stops.empty()) return;
+  update(kStrokeGradientStops, stops.data(),
+         stops.size() * sizeof(GradientStop),
+         [stops](lv_draw_vector_dsc_t* dsc) {
+           lv_draw_vector_dsc_set_stroke_gradient_color_stops(
+               dsc, reinterpret_cast<const lv_grad_stop_t*>(stops.data()),
+               stops.size());
+         });
 }
 
 void VectorPath::append_circle(float cx, float cy, float rx, float ry) {
   lv_fpoint_t c = {cx, cy};
-  if (path_) lv_vector_path_append_circle(path_, &c, rx, ry);
+  if (!path_) return;
+  lv_vector_path_append_circle(path_, &c, rx, ry);
+  float args[] = {cx, cy, rx, ry};
+  mix(kCircle, args, sizeof(args));
 }
 
 void VectorPath::append_arc(float cx, float cy, float radius, float start_angle,
                             float sweep, bool pie) {
   lv_fpoint_t c = {cx, cy};
-  if (path_)
-    lv_vector_path_append_arc(path_, &c, radius, start_angle, sweep, pie);
+  if (!path_) return;
+  lv_vector_path_append_arc(path_, &c, radius, start_angle, sweep, pie);
+  float args[] = {cx, cy, radius, start_angle, sweep, pie ? 1.0f : 0.0f};
+  mix(kArc, args, sizeof(args));
 }
 
 void VectorPath::append_path(const VectorPath& other) {
-  if (path_ && other.path_) lv_vector_path_append_path(path_, other.path_);
+  if (!path_ || !other.path_) return;
+  lv_vector_path_append_path(path_, other.path_);
+  mix(kAppendPath, &other.hash_, sizeof(other.hash_));
 }
 
 void VectorPath::transform(const lv_matrix_t& matrix) {
-  if (path_) lv_matrix_transform_path(&matrix, path_);
+  if (!path_) return;
+  lv_matrix_transform_path(&matrix, path_);
+  mix(kTransform, &matrix, sizeof(matrix));
 }
 
 void VectorPath::get_bounding_box(lv_area_t& area) const {
@@ -141,15 +247,31 @@ void VectorPath::get_bounding_box(lv_area_t& area) const {
 
 // --- VectorDraw ---
 
-VectorDraw::VectorDraw(lv_layer_t* layer) {
+VectorDraw::VectorDraw(lv_layer_t* layer) : layer_(layer) {
   dsc_ = lv_draw_vector_dsc_create(layer);
+  lv_matrix_identity(&matrix_);
+}
+
+VectorDraw::VectorDraw(lv_layer_t* layer, VectorCache& cache)
+    : VectorDraw(layer) {
+  cache_ = &cache;
 }
 
 VectorDraw::~VectorDraw() {
   if (dsc_) lv_draw_vector_dsc_delete(dsc_);
 }
 
-VectorDraw::VectorDraw(VectorDraw&& other) noexcept : dsc_(other.dsc_) {
+VectorDraw::VectorDraw(VectorDraw&& other) noexcept
+    : dsc_(other.dsc_),
+      layer_(other.layer_),
+      cache_(other.cache_),
+      matrix_(other.matrix_),
+      stroke_width_(other.stroke_width_),
+      blend_(other.blend_),
+      fill_image_(other.fill_image_),
+      origin_(other.origin_),
+      state_(std::move(other.state_)),
+      ops_(std::move(other.ops_)) {
   other.dsc_ = nullptr;
 }
 
@@ -157,156 +279,387 @@ VectorDraw& VectorDraw::operator=(VectorDraw&& other) noexcept {
   if (this != &other) {
     if (dsc_) lv_draw_vector_dsc_delete(dsc_);
     dsc_ = other.dsc_;
+    layer_ = other.layer_;
+    cache_ = other.cache_;
+    matrix_ = other.matrix_;
+    stroke_width_ = other.stroke_width_;
+    blend_ = other.blend_;
+    fill_image_ = other.fill_image_;
+    origin_ = other.origin_;
+    state_ = std::move(other.state_);
+    ops_ = std::move(other.ops_);
     other.dsc_ = nullptr;
   }
   return *this;
 }
 
+template <typename Fn>
+void VectorDraw::update(uint32_t setting, const void* value, size_t size,
+                        Fn fn) {
+  if (!dsc_) return;
+  fn(dsc_);
+  if (!cache_) return;
+  uint64_t hash = hash_bytes(hash_value(kHashSeed, setting), value, size);
+  ops_.push_back({setting, hash, std::move(fn), nullptr, {}, 0.0f});
+}
+
 void VectorDraw::set_transform(const lv_matrix_t& matrix) {
-  if (dsc_) lv_draw_vector_dsc_set_transform(dsc_, &matrix);
+  if (!dsc_) return;
+  lv_draw_vector_dsc_set_transform(dsc_, &matrix);
+  matrix_ = matrix;
 }
 
 void VectorDraw::set_blend_mode(lv_vector_blend_t blend) {
-  if (dsc_) lv_draw_vector_dsc_set_blend_mode(dsc_, blend);
+  update(kBlendMode, &blend, sizeof(blend), [blend](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_blend_mode(d, blend);
+  });
+  blend_ = blend;
 }
 
 void VectorDraw::set_fill_color(lv_color32_t color) {
-  if (dsc_) lv_draw_vector_dsc_set_fill_color32(dsc_, color);
+  update(kFillColor, &color, sizeof(color), [color](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_fill_color32(d, color);
+  });
+  fill_image_ = false;
 }
 
 void VectorDraw::set_fill_opa(lv_opa_t opa) {
-  if (dsc_) lv_draw_vector_dsc_set_fill_opa(dsc_, opa);
+  update(kFillOpa, &opa, sizeof(opa), [opa](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_fill_opa(d, opa);
+  });
 }
 
 void VectorDraw::set_fill_rule(lv_vector_fill_t rule) {
-  if (dsc_) lv_draw_vector_dsc_set_fill_rule(dsc_, rule);
+  update(kFillRule, &rule, sizeof(rule), [rule](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_fill_rule(d, rule);
+  });
 }
 
 void VectorDraw::set_fill_image(const lv_draw_image_dsc_t& img_dsc) {
-  if (dsc_) lv_draw_vector_dsc_set_fill_image(dsc_, &img_dsc);
+  // Only the fields that change the pattern; `base` holds the caller's
+  // object, layer and user data.
+  uint64_t key = hash_value(kHashSeed, img_dsc.src);
+  key = hash_value(key, img_dsc.rotation);
+  key = hash_value(key, img_dsc.scale_x);
+  key = hash_value(key, img_dsc.scale_y);
+  key = hash_value(key, img_dsc.skew_x);
+  key = hash_value(key, img_dsc.skew_y);
+  key = hash_value(key, img_dsc.pivot);
+  key = hash_value(key, img_dsc.recolor);
+  key = hash_value(key, img_dsc.recolor_opa);
+  key = hash_value(key, img_dsc.opa);
+  key = hash_value(key, static_cast<uint8_t>(img_dsc.blend_mode));
+  key = hash_value(key, static_cast<uint8_t>(img_dsc.antialias));
+  key = hash_value(key, static_cast<uint8_t>(img_dsc.tile));
+  update(kFillImage, &key, sizeof(key), [img_dsc](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_fill_image(d, &img_dsc);
+  });
+  fill_image_ = true;
 }
 
 void VectorDraw::set_fill_linear_gradient(float x1, float y1, float x2,
                                           float y2) {
-  if (dsc_) lv_draw_vector_dsc_set_fill_linear_gradient(dsc_, x1, y1, x2, y2);
+  float args[] = {x1, y1, x2, y2};
+  update(kFillLinearGradient, args, sizeof(args),
+         [=](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_fill_linear_gradient(d, x1, y1, x2, y2);
+         });
+  fill_image_ = false;
 }
 
 void VectorDraw::set_fill_radial_gradient(float cx, float cy, float radius) {
-  if (dsc_) lv_draw_vector_dsc_set_fill_radial_gradient(dsc_, cx, cy, radius);
+  float args[] = {cx, cy, radius};
+  update(kFillRadialGradient, args, sizeof(args),
+         [=](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_fill_radial_gradient(d, cx, cy, radius);
+         });
+  fill_image_ = false;
 }
 
 void VectorDraw::set_fill_gradient_stops(
     const std::vector<lv_grad_stop_t>& stops) {
-  if (dsc_ && !stops.empty()) {
-    lv_draw_vector_dsc_set_fill_gradient_color_stops(dsc_, stops.data(),
-                                                     stops.size());
-  }
+  if (stops.empty()) return;
+  update(kFillGradientStops, stops.data(),
+         stops.size() * sizeof(lv_grad_stop_t),
+         [stops](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_fill_gradient_color_stops(d, stops.data(),
+                                                            stops.size());
+         });
 }
 
 void VectorDraw::set_fill_gradient_spread(lv_vector_gradient_spread_t spread) {
-  if (dsc_) lv_draw_vector_dsc_set_fill_gradient_spread(dsc_, spread);
+  update(kFillGradientSpread, &spread, sizeof(spread),
+         [spread](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_fill_gradient_spread(d, spread);
+         });
 }
 
 void VectorDraw::set_fill_transform(const lv_matrix_t& matrix) {
-  if (dsc_) lv_draw_vector_dsc_set_fill_transform(dsc_, &matrix);
+  update(kFillTransform, &matrix, sizeof(matrix),
+         [matrix](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_fill_transform(d, &matrix);
+         });
 }
 
 void VectorDraw::set_stroke_color(lv_color32_t color) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_color32(dsc_, color);
+  update(kStrokeColor, &color, sizeof(color),
+         [color](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_stroke_color32(d, color);
+         });
 }
 
 void VectorDraw::set_stroke_opa(lv_opa_t opa) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_opa(dsc_, opa);
+  update(kStrokeOpa, &opa, sizeof(opa), [opa](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_stroke_opa(d, opa);
+  });
 }
 
 void VectorDraw::set_stroke_width(float width) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_width(dsc_, width);
+  update(kStrokeWidth, &width, sizeof(width), [width](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_stroke_width(d, width);
+  });
+  stroke_width_ = width;
 }
 
 void VectorDraw::set_stroke_dash(const std::vector<float>& dash_pattern) {
-  // lvgl expects non-const float*, so we might need a copy or const_cast if
-  // impl does not modify. Viewing source: it usually copies or references. The
-  // prototype is `float *`, implying potential modification or just legacy C.
-  // Assuming it copies or reads, but we need to pass a mutable pointer.
-  // If we pass a vector, we can pass data().
-  if (dsc_ && !dash_pattern.empty()) {
-    // Cast away constness, assuming API doesn't actually mutate pattern for
-    // read-only dash setting. Ideally check implementation.
-    lv_draw_vector_dsc_set_stroke_dash(
-        dsc_, const_cast<float*>(dash_pattern.data()), dash_pattern.size());
-  }
+  if (dash_pattern.empty()) return;
+  // lvgl takes a mutable float*, so each call passes its own copy.
+  update(kStrokeDash, dash_pattern.data(), dash_pattern.size() * sizeof(float),
+         [dash = dash_pattern](lv_draw_vector_dsc_t* d) mutable {
+           lv_draw_vector_dsc_set_stroke_dash(d, dash.data(), dash.size());
+         });
 }
 
 void VectorDraw::set_stroke_cap(lv_vector_stroke_cap_t cap) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_cap(dsc_, cap);
+  update(kStrokeCap, &cap, sizeof(cap), [cap](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_stroke_cap(d, cap);
+  });
 }
 
 void VectorDraw::set_stroke_join(lv_vector_stroke_join_t join) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_join(dsc_, join);
+  update(kStrokeJoin, &join, sizeof(join), [join](lv_draw_vector_dsc_t* d) {
+    lv_draw_vector_dsc_set_stroke_join(d, join);
+  });
 }
 
 void VectorDraw::set_stroke_miter_limit(uint16_t limit) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_miter_limit(dsc_, limit);
+  update(kStrokeMiterLimit, &limit, sizeof(limit),
+         [limit](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_stroke_miter_limit(d, limit);
+         });
 }
 
 void VectorDraw::set_stroke_linear_gradient(float x1, float y1, float x2,
                                             float y2) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_linear_gradient(dsc_, x1, y1, x2, y2);
+  float args[] = {x1, y1, x2, y2};
+  update(kStrokeLinearGradient, args, sizeof(args),
+         [=](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_stroke_linear_gradient(d, x1, y1, x2, y2);
+         });
 }
 
 void VectorDraw::set_stroke_radial_gradient(float cx, float cy, float radius) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_radial_gradient(dsc_, cx, cy, radius);
+  float args[] = {cx, cy, radius};
+  update(kStrokeRadialGradient, args, sizeof(args),
+         [=](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_stroke_radial_gradient(d, cx, cy, radius);
+         });
 }
 
 void VectorDraw::set_stroke_gradient_stops(
     const std::vector<lv_grad_stop_t>& stops) {
-  if (dsc_ && !stops.empty()) {
-    lv_draw_vector_dsc_set_stroke_gradient_color_stops(dsc_, stops.data(),
-                                                       stops.size());
-  }
+  if (stops.empty()) return;
+  update(kStrokeGradientStops, stops.data(),
+         stops.size() * sizeof(lv_grad_stop_t),
+         [stops](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_stroke_gradient_color_stops(d, stops.data(),
+                                                              stops.size());
+         });
 }
 
 void VectorDraw::set_stroke_gradient_spread(
     lv_vector_gradient_spread_t spread) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_gradient_spread(dsc_, spread);
+  update(kStrokeGradientSpread, &spread, sizeof(spread),
+         [spread](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_stroke_gradient_spread(d, spread);
+         });
 }
 
 void VectorDraw::set_stroke_transform(const lv_matrix_t& matrix) {
-  if (dsc_) lv_draw_vector_dsc_set_stroke_transform(dsc_, &matrix);
+  update(kStrokeTransform, &matrix, sizeof(matrix),
+         [matrix](lv_draw_vector_dsc_t* d) {
+           lv_draw_vector_dsc_set_stroke_transform(d, &matrix);
+         });
 }
 
+// The transform is mirrored in `matrix_`, which a cached path captures.
+
 void VectorDraw::identity() {
-  if (dsc_) lv_draw_vector_dsc_identity(dsc_);
+  if (!dsc_) return;
+  lv_draw_vector_dsc_identity(dsc_);
+  lv_matrix_identity(&matrix_);
 }
 
 void VectorDraw::scale(float x, float y) {
-  if (dsc_) lv_draw_vector_dsc_scale(dsc_, x, y);
+  if (!dsc_) return;
+  lv_draw_vector_dsc_scale(dsc_, x, y);
+  lv_matrix_scale(&matrix_, x, y);
 }
 
 void VectorDraw::rotate(float degree) {
-  if (dsc_) lv_draw_vector_dsc_rotate(dsc_, degree);
+  if (!dsc_) return;
+  lv_draw_vector_dsc_rotate(dsc_, degree);
+  lv_matrix_rotate(&matrix_, degree);
 }
 
 void VectorDraw::translate(float x, float y) {
-  if (dsc_) lv_draw_vector_dsc_translate(dsc_, x, y);
+  if (!dsc_) return;
+  lv_draw_vector_dsc_translate(dsc_, x, y);
+  lv_matrix_translate(&matrix_, x, y);
 }
 
 void VectorDraw::skew(float x, float y) {
-  if (dsc_) lv_draw_vector_dsc_skew(dsc_, x, y);
+  if (!dsc_) return;
+  lv_draw_vector_dsc_skew(dsc_, x, y);
+  lv_matrix_skew(&matrix_, x, y);
 }
 
 void VectorDraw::add_path(const VectorPath& path) {
-  if (dsc_ && path.raw()) {
+  if (!dsc_ || !path.raw()) return;
+  if (!cache_) {
     lv_draw_vector_dsc_add_path(dsc_, path.raw());
+    return;
   }
+  bool first = std::none_of(ops_.begin(), ops_.end(),
+                            [](const Op& op) { return op.setting == kPath; });
+  if (first) {
+    // The whole-pixel offset is drawn by the blit, so the same batch at
+    // another integer position shares the image.
+    origin_ = {static_cast<int32_t>(std::floor(matrix_.m[0][2])),
+               static_cast<int32_t>(std::floor(matrix_.m[1][2]))};
+  }
+  Op op = {kPath, 0, nullptr, path.raw(), matrix_, 0.0f};
+  op.matrix.m[0][2] -= static_cast<float>(origin_.x);
+  op.matrix.m[1][2] -= static_cast<float>(origin_.y);
+  float det = matrix_.m[0][0] * matrix_.m[1][1] -
+              matrix_.m[0][1] * matrix_.m[1][0];
+  op.margin = stroke_width_ * std::sqrt(std::fabs(det)) / 2 + 2;
+  op.hash = hash_value(hash_value(kHashSeed, path.get_hash()), op.matrix);
+  ops_.push_back(std::move(op));
 }
 
 void VectorDraw::clear_area(const lv_area_t& rect) {
-  if (dsc_) lv_draw_vector_dsc_clear_area(dsc_, &rect);
+  if (!dsc_) return;
+  if (cache_) draw();  // Keep the order of the pending batch.
+  lv_draw_vector_dsc_clear_area(dsc_, &rect);
+  if (cache_) lv_draw_vector(dsc_);
 }
 
 void VectorDraw::draw() {
-  if (dsc_) lv_draw_vector(dsc_);
+  if (!dsc_) return;
+  if (!cache_) {
+    lv_draw_vector(dsc_);
+    return;
+  }
+  bool has_path = std::any_of(ops_.begin(), ops_.end(), [](const Op& op) {
+    return op.setting == kPath;
+  });
+  if (has_path) {
+#if LV_USE_CANVAS
+    if (blend_ == LV_VECTOR_BLEND_SRC_OVER && !fill_image_) {
+      cache_->draw(*this);
+    } else {
+      draw_direct();
+    }
+#else
+    draw_direct();
+#endif
+  }
+  // Fold the batch's setters into the state, keeping the order of their
+  // last calls so a replay ends in the same state.
+  for (Op& op : ops_) {
+    if (op.setting == kPath) continue;
+    state_.erase(std::remove_if(state_.begin(), state_.end(),
+                                [&](const Op& s) {
+                                  return s.setting == op.setting;
+                                }),
+                 state_.end());
+    state_.push_back(std::move(op));
+  }
+  ops_.clear();
+}
+
+uint64_t VectorDraw::batch_key() const {
+  // Setters before the first path are folded into the state, so a batch
+  // keys the same whether its settings were made in it or before it.
+  std::vector<std::pair<uint32_t, uint64_t>> state;
+  state.reserve(state_.size());
+  for (const Op& op : state_) state.emplace_back(op.setting, op.hash);
+  size_t i = 0;
+  for (; i < ops_.size() && ops_[i].setting != kPath; ++i) {
+    uint32_t setting = ops_[i].setting;
+    auto same = [&](const auto& s) { return s.first == setting; };
+    state.erase(std::remove_if(state.begin(), state.end(), same), state.end());
+    state.emplace_back(setting, ops_[i].hash);
+  }
+  uint64_t h = hash_value(kHashSeed, state.size());
+  for (const auto& s : state) h = hash_value(h, s.second);
+  h = hash_value(h, ops_.size() - i);
+  for (; i < ops_.size(); ++i) h = hash_value(h, ops_[i].hash);
+  return h;
+}
+
+bool VectorDraw::batch_bounds(lv_area_t* area) const {
+  bool found = false;
+  float x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+  for (const Op& op : ops_) {
+    if (op.setting != kPath) continue;
+    lv_area_t box;
+    lv_vector_path_get_bounding(op.path, &box);
+    lv_fpoint_t corners[] = {{(float)box.x1, (float)box.y1},
+                             {(float)box.x2, (float)box.y1},
+                             {(float)box.x1, (float)box.y2},
+                             {(float)box.x2, (float)box.y2}};
+    for (lv_fpoint_t& p : corners) {
+      lv_matrix_transform_point(&op.matrix, &p);
+      if (!found) {
+        x1 = x2 = p.x;
+        y1 = y2 = p.y;
+        found = true;
+      }
+      x1 = std::min(x1, p.x - op.margin);
+      y1 = std::min(y1, p.y - op.margin);
+      x2 = std::max(x2, p.x + op.margin);
+      y2 = std::max(y2, p.y + op.margin);
+    }
+  }
+  if (!found) return false;
+  area->x1 = static_cast<int32_t>(std::floor(x1));
+  area->y1 = static_cast<int32_t>(std::floor(y1));
+  area->x2 = static_cast<int32_t>(std::ceil(x2));
+  area->y2 = static_cast<int32_t>(std::ceil(y2));
+  return true;
+}
+
+void VectorDraw::replay(lv_draw_vector_dsc_t* dsc, float dx, float dy) const {
+  for (const Op& op : state_) op.apply(dsc);
+  for (const Op& op : ops_) {
+    if (op.setting != kPath) {
+      op.apply(dsc);
+      continue;
+    }
+    lv_matrix_t matrix = op.matrix;
+    matrix.m[0][2] += dx;
+    matrix.m[1][2] += dy;
+    lv_draw_vector_dsc_set_transform(dsc, &matrix);
+    lv_draw_vector_dsc_add_path(dsc, op.path);
+  }
+}
+
+void VectorDraw::draw_direct() {
+  replay(dsc_, static_cast<float>(origin_.x), static_cast<float>(origin_.y));
+  lv_draw_vector(dsc_);
+  lv_draw_vector_dsc_set_transform(dsc_, &matrix_);
 }
 
 }  // namespace lvgl
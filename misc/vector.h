@@ -1,6 +1,11 @@
 #ifndef LVGL_CPP_MISC_VECTOR_H_
 #define LVGL_CPP_MISC_VECTOR_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
 #include "lvgl.h"
 
 #if LV_USE_VECTOR_GRAPHIC
@@ -9,6 +14,8 @@
 
 namespace lvgl {
 
+class VectorCache;
+
 class VectorPath {
  public:
   explicit VectorPath(
@@ -46,10 +53,22 @@ class VectorPath {
   void transform(const lv_matrix_t& matrix);
   void get_bounding_box(lv_area_t& area) const;
 
+  /**
+   * @brief Hash of the calls that built the path.
+   *
+   * Paths built by the same calls hash alike; `VectorCache` keys on it.
+   * Edits made through `raw()` are not seen.
+   */
+  uint64_t get_hash() const { return hash_; }
+
   lv_vector_path_t* raw() const { return path_; }
 
  private:
+  void mix(uint8_t op, const void* args, size_t size);
+
   lv_vector_path_t* path_ = nullptr;
+  lv_vector_path_quality_t quality_;
+  uint64_t hash_;
 };
 
 struct GradientStop {
@@ -74,6 +93,22 @@ struct DrawImageDescriptor {
 class VectorDraw {
  public:
   explicit VectorDraw(lv_layer_t* layer);
+
+  /**
+   * @brief Draw through a raster cache.
+   *
+   * Each `draw()` renders the paths added since the previous one into an
+   * offscreen image, keyed by the path hashes, the settings and the
+   * transform minus its whole-pixel translation, and blits it to `layer`.
+   * Later batches with the same key reuse the image, so a static icon
+   * costs one image draw per frame wherever it is placed.
+   *
+   * Paths are read at `draw()`, so they must live until then. `cache` must
+   * outlive this object. Batches drawn with a blend mode other than
+   * `LV_VECTOR_BLEND_SRC_OVER`, or with an image fill (whose pixels may
+   * change behind the same source), bypass the cache.
+   */
+  VectorDraw(lv_layer_t* layer, VectorCache& cache);
   virtual ~VectorDraw();
 
   // Non-copyable, move-only
@@ -129,7 +164,35 @@ class VectorDraw {
   lv_draw_vector_dsc_t* raw() const { return dsc_; }
 
  private:
+  friend class VectorCache;
+
+  // A recorded setter call, or a path when `setting` is 0.
+  struct Op {
+    uint32_t setting;
+    uint64_t hash;
+    std::function<void(lv_draw_vector_dsc_t*)> apply;
+    const lv_vector_path_t* path;
+    lv_matrix_t matrix;  // Relative to `origin_`.
+    float margin;        // Stroke and antialiasing overhang in pixels.
+  };
+
+  template <typename Fn>
+  void update(uint32_t setting, const void* value, size_t size, Fn fn);
+  uint64_t batch_key() const;
+  bool batch_bounds(lv_area_t* area) const;
+  void replay(lv_draw_vector_dsc_t* dsc, float dx, float dy) const;
+  void draw_direct();
+
   lv_draw_vector_dsc_t* dsc_ = nullptr;
+  lv_layer_t* layer_ = nullptr;
+  VectorCache* cache_ = nullptr;
+  lv_matrix_t matrix_;
+  float stroke_width_ = 1.0f;
+  lv_vector_blend_t blend_ = LV_VECTOR_BLEND_SRC_OVER;
+  bool fill_image_ = false;  // The fill style is an image pattern.
+  lv_point_t origin_ = {0, 0};
+  std::vector<Op> state_;  // Last call of each setter before the batch.
+  std::vector<Op> ops_;    // The batch since the last draw().
 };
 
 }  // namespace lvgl
@@ -0,0 +1,143 @@
+#include "vector_cache.h"
+
+#if LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
+
+#include <utility>
+
+#include "../widgets/canvas.h"
+
+namespace lvgl {
+
+float VectorCache::Stats::hit_rate() const {
+  uint64_t total = hits + misses;
+  return total ? static_cast<float>(hits) / static_cast<float>(total) : 0.0f;
+}
+
+VectorCache::VectorCache(size_t byte_budget, lv_display_t* display)
+    : budget_(byte_budget), display_(display) {
+  if (display_) {
+    lv_display_add_event_cb(display_, display_event_cb, LV_EVENT_ALL, this);
+  }
+}
+
+VectorCache::~VectorCache() {
+  if (display_) {
+    lv_display_remove_event_cb_with_user_data(display_, display_event_cb,
+                                              this);
+  }
+  canvas_.reset();  // Before the buffers it may point to.
+  while (!lru_.empty()) evict_last();
+}
+
+void VectorCache::set_byte_budget(size_t bytes) {
+  budget_ = bytes;
+  shrink(budget_);
+}
+
+void VectorCache::reset_stats() { stats_ = Stats(); }
+
+void VectorCache::next_frame() {
+  ++frame_;
+  shrink(budget_);
+}
+
+void VectorCache::clear() {
+  while (!lru_.empty()) evict_last();
+}
+
+void VectorCache::draw(VectorDraw& batch) {
+  uint64_t key = batch.batch_key();
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    ++stats_.hits;
+    lru_.splice(lru_.begin(), lru_, found->second);
+    found->second->frame = frame_;
+    blit(batch, *found->second);
+    return;
+  }
+  ++stats_.misses;
+  lv_area_t area;
+  if (!batch.batch_bounds(&area)) return;
+  uint32_t w = lv_area_get_width(&area);
+  uint32_t h = lv_area_get_height(&area);
+  size_t bytes =
+      static_cast<size_t>(
+          lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888)) *
+      h;
+  if (bytes <= budget_) shrink(budget_ - bytes);
+  if (bytes > budget_ || bytes_ + bytes > budget_) {
+    // Everything left was drawn this frame.
+    ++stats_.uncached;
+    batch.draw_direct();
+    return;
+  }
+  draw::DrawBuf buf(w, h, ColorFormat::ARGB8888);
+  if (!buf.raw()) {
+    ++stats_.uncached;
+    batch.draw_direct();
+    return;
+  }
+  render(batch, buf, area);
+  bytes_ += buf.data_size();
+  lru_.push_front(Entry{key, std::move(buf), area, frame_});
+  index_[key] = lru_.begin();
+  blit(batch, lru_.front());
+}
+
+void VectorCache::render(const VectorDraw& batch, draw::DrawBuf& buf,
+                         const lv_area_t& area) {
+  if (!canvas_) canvas_ = std::make_unique<Canvas>();
+  buf.clear();
+  canvas_->set_draw_buf(buf.raw());
+  lv_layer_t layer;
+  canvas_->init_layer(&layer);
+  lv_draw_vector_dsc_t* dsc = lv_draw_vector_dsc_create(&layer);
+  batch.replay(dsc, static_cast<float>(-area.x1),
+               static_cast<float>(-area.y1));
+  lv_draw_vector(dsc);
+  lv_draw_vector_dsc_delete(dsc);
+  canvas_->finish_layer(&layer);
+}
+
+void VectorCache::blit(const VectorDraw& batch, const Entry& entry) {
+  lv_draw_image_dsc_t dsc;
+  lv_draw_image_dsc_init(&dsc);
+  dsc.src = entry.buf.raw();
+  lv_area_t coords = entry.area;
+  lv_area_move(&coords, batch.origin_.x, batch.origin_.y);
+  lv_draw_image(batch.layer_, &dsc, &coords);
+}
+
+void VectorCache::shrink(size_t bytes) {
+  // Images drawn this frame may still have pending draw tasks.
+  while (bytes_ > bytes && !lru_.empty() && lru_.back().frame != frame_) {
+    evict_last();
+  }
+}
+
+void VectorCache::evict_last() {
+  Entry& entry = lru_.back();
+  lv_image_cache_drop(entry.buf.raw());
+  bytes_ -= entry.buf.data_size();
+  index_.erase(entry.key);
+  lru_.pop_back();
+  ++stats_.evictions;
+}
+
+void VectorCache::display_event_cb(lv_event_t* e) {
+  auto* self = static_cast<VectorCache*>(lv_event_get_user_data(e));
+  switch (lv_event_get_code(e)) {
+    case LV_EVENT_REFR_START:
+      self->next_frame();
+      return;
+    case LV_EVENT_DELETE:
+      self->display_ = nullptr;
+      return;
+    default:
+      return;
+  }
+}
+
+}  // namespace lvgl
+
+#endif  // LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
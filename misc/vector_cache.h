@@ -0,0 +1,148 @@
+#ifndef LVGL_CPP_MISC_VECTOR_CACHE_H_
+#define LVGL_CPP_MISC_VECTOR_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "lvgl.h"  // IWYU pragma: export
+
+#if LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
+
+#include "../draw/draw_buf.h"
+#include "vector.h"
+
+/**
+ * @file vector_cache.h
+ * @brief User Guide:
+ * `VectorCache` keeps rasterized `VectorDraw` batches across frames. A
+ * `VectorDraw` created with a cache renders each batch (the paths added
+ * between two `draw()` calls) once into an ARGB8888 image and then draws
+ * that image, so static icons skip path flattening and rasterization
+ * until their geometry, style or transform changes.
+ *
+ * Key Features:
+ * - **Content keys**: Batches are keyed by `VectorPath::get_hash()`, the
+ *   fill and stroke settings and the transform. The whole-pixel part of the
+ *   translation is left out, so moving an icon by whole pixels, or drawing
+ *   it at many places, reuses one image.
+ * - **Byte budget**: Images are evicted least recently used first once the
+ *   budget is exceeded. A batch larger than the whole budget is drawn
+ *   directly.
+ * - **Frame safety**: Images drawn in the current frame are never evicted,
+ *   since their draw tasks may still be pending. Frames advance on the
+ *   display's `LV_EVENT_REFR_START`, or by calling `next_frame()` after
+ *   drawing to a canvas.
+ *
+ * Example:
+ * @code
+ * lvgl::VectorCache cache(512 * 1024);
+ * // In an LV_EVENT_DRAW_MAIN handler:
+ * lvgl::VectorDraw draw(lv_event_get_layer(e), cache);
+ * draw.set_fill_color(lv_color32_make(0x20, 0x80, 0xff, 0xff));
+ * for (auto& pos : icon_positions) {
+ *   draw.identity();
+ *   draw.translate(pos.x, pos.y);
+ *   draw.add_path(icon);
+ *   draw.draw();  // Rasterized once, then an image blit.
+ * }
+ * @endcode
+ *
+ * Not thread-safe; use it from the LVGL thread like the widgets it serves.
+ */
+namespace lvgl {
+
+class Canvas;
+
+class VectorCache {
+ public:
+  static constexpr size_t kDefaultByteBudget = 256 * 1024;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t uncached = 0;  ///< Misses drawn directly for lack of room.
+
+    /**
+     * @brief Fraction of batches served from the cache.
+     * @return Value in [0, 1]; 0 when nothing has been drawn yet.
+     */
+    float hit_rate() const;
+  };
+
+  /**
+   * @brief Create a cache.
+   * @param byte_budget Maximum bytes of cached images.
+   * @param display Display whose refreshes mark frames, or nullptr to mark
+   * them only with `next_frame()`.
+   */
+  explicit VectorCache(size_t byte_budget = kDefaultByteBudget,
+                       lv_display_t* display = lv_display_get_default());
+  ~VectorCache();
+
+  VectorCache(const VectorCache&) = delete;
+  VectorCache& operator=(const VectorCache&) = delete;
+
+  /**
+   * @brief Change the budget, evicting images not drawn this frame.
+   */
+  void set_byte_budget(size_t bytes);
+  size_t get_byte_budget() const { return budget_; }
+
+  /** @brief Bytes of cached images. */
+  size_t get_byte_size() const { return bytes_; }
+
+  /** @brief Number of cached images. */
+  size_t get_entry_count() const { return index_.size(); }
+
+  const Stats& get_stats() const { return stats_; }
+  void reset_stats();
+
+  /**
+   * @brief Mark the end of a frame: the images drawn so far may be evicted,
+   * and the cache is trimmed back to its budget.
+   */
+  void next_frame();
+
+  /**
+   * @brief Drop every image. Do not call while a layer that drew from the
+   * cache is still being rendered.
+   */
+  void clear();
+
+ private:
+  friend class VectorDraw;
+
+  struct Entry {
+    uint64_t key;
+    draw::DrawBuf buf;
+    lv_area_t area;  // Relative to the batch origin.
+    uint32_t frame;  // Last frame that drew it.
+  };
+
+  void draw(VectorDraw& batch);
+  void render(const VectorDraw& batch, draw::DrawBuf& buf,
+              const lv_area_t& area);
+  void blit(const VectorDraw& batch, const Entry& entry);
+  void shrink(size_t bytes);
+  void evict_last();
+
+  static void display_event_cb(lv_event_t* e);
+
+  size_t budget_;
+  size_t bytes_ = 0;
+  uint32_t frame_ = 0;
+  Stats stats_;
+  lv_display_t* display_;
+  std::list<Entry> lru_;  ///< Front is most recently used.
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+  std::unique_ptr<Canvas> canvas_;  ///< Offscreen target, made on demand.
+};
+
+}  // namespace lvgl
+
+#endif  // LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
+#endif  // LVGL_CPP_MISC_VECTOR_CACHE_H_
@@ -0,0 +1,190 @@
+#ifndef LVGL_CPP_TESTS_BINFONT_WRITER_H_
+#define LVGL_CPP_TESTS_BINFONT_WRITER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "lvgl.h"
+
+// Serializes a built-in (fmt_txt) font into the LVGL binary font format, so
+// tests and benchmarks have a .bin file without shipping one. Only what the
+// built-in Montserrat fonts use is supported: uncompressed bitmaps and
+// class-based kerning.
+
+namespace lvgl_test {
+
+class BinFontWriter {
+ public:
+  static std::vector<uint8_t> write(const lv_font_t* font) {
+    BinFontWriter w;
+    w.run(font);
+    return std::move(w.out_);
+  }
+
+ private:
+  template <typename T>
+  void put(T value) {
+    const auto* p = reinterpret_cast<const uint8_t*>(&value);
+    out_.insert(out_.end(), p, p + sizeof(T));
+  }
+
+  void put(const void* data, size_t size) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    out_.insert(out_.end(), p, p + size);
+  }
+
+  template <typename T>
+  void patch(size_t pos, T value) {
+    std::memcpy(out_.data() + pos, &value, sizeof(T));
+  }
+
+  size_t begin(const char* tag) {
+    size_t start = out_.size();
+    put<uint32_t>(0);
+    put(tag, 4);
+    return start;
+  }
+
+  void end(size_t start, bool align) {
+    if (align) out_.resize((out_.size() + 3) & ~size_t{3}, 0);
+    patch<uint32_t>(start, static_cast<uint32_t>(out_.size() - start));
+  }
+
+  void run(const lv_font_t* font) {
+    const auto* dsc = static_cast<const lv_font_fmt_txt_dsc_t*>(font->dsc);
+    const auto* kern =
+        dsc->kern_classes
+            ? static_cast<const lv_font_fmt_txt_kern_classes_t*>(dsc->kern_dsc)
+            : nullptr;
+
+    // Glyph count: one past the highest id any cmap produces.
+    uint32_t glyphs = 1;
+    for (uint32_t i = 0; i < dsc->cmap_num; ++i) {
+      const lv_font_fmt_txt_cmap_t& c = dsc->cmaps[i];
+      uint32_t last = 0;
+      switch (c.type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+          last = c.range_length - 1;
+          break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+          last = c.list_length - 1;
+          break;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+          for (uint32_t j = 0; j < c.list_length; ++j) {
+            auto ofs = static_cast<const uint8_t*>(c.glyph_id_ofs_list)[j];
+            if (ofs > last) last = ofs;
+          }
+          break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+          for (uint32_t j = 0; j < c.list_length; ++j) {
+            auto ofs = static_cast<const uint16_t*>(c.glyph_id_ofs_list)[j];
+            if (ofs > last) last = ofs;
+          }
+          break;
+      }
+      if (c.glyph_id_start + last + 1 > glyphs) {
+        glyphs = c.glyph_id_start + last + 1;
+      }
+    }
+
+    size_t head = begin("head");
+    int32_t ascent = font->line_height - font->base_line;
+    int32_t descent = -font->base_line;
+    put<uint32_t>(1);             // version
+    put<uint16_t>(kern ? 4 : 3);  // tables_count
+    put<uint16_t>(font->line_height);
+    put<uint16_t>(ascent);
+    put<int16_t>(descent);
+    put<uint16_t>(ascent);   // typo_ascent
+    put<int16_t>(descent);   // typo_descent
+    put<uint16_t>(0);        // typo_line_gap
+    put<int16_t>(descent);   // min_y
+    put<int16_t>(ascent);    // max_y
+    put<uint16_t>(0);        // default_advance_width
+    put<uint16_t>(dsc->kern_scale);
+    put<uint8_t>(1);         // index_to_loc_format: 32-bit offsets
+    put<uint8_t>(1);         // glyph_id_format: 16-bit ids
+    put<uint8_t>(1);         // advance_width_format: already in 1/16 px
+    put<uint8_t>(dsc->bpp);
+    put<uint8_t>(8);         // xy_bits
+    put<uint8_t>(8);         // wh_bits
+    put<uint8_t>(16);        // advance_width_bits
+    put<uint8_t>(0);         // compression_id
+    put<uint8_t>(0);         // subpixels_mode
+    put<uint8_t>(0);         // padding
+    put<int16_t>(font->underline_position);
+    put<uint16_t>(font->underline_thickness);
+    end(head, false);
+
+    size_t cmap = begin("cmap");
+    put<uint32_t>(dsc->cmap_num);
+    size_t tables = out_.size();
+    out_.resize(out_.size() + dsc->cmap_num * 16);
+    for (uint32_t i = 0; i < dsc->cmap_num; ++i) {
+      const lv_font_fmt_txt_cmap_t& c = dsc->cmaps[i];
+      size_t t = tables + i * 16;
+      patch<uint32_t>(t, static_cast<uint32_t>(out_.size() - cmap));
+      patch<uint32_t>(t + 4, c.range_start);
+      patch<uint16_t>(t + 8, c.range_length);
+      patch<uint16_t>(t + 10, c.glyph_id_start);
+      patch<uint16_t>(t + 12, c.list_length);
+      patch<uint8_t>(t + 14, static_cast<uint8_t>(c.type));
+      if (c.unicode_list) put(c.unicode_list, c.list_length * 2u);
+      if (c.type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+        put(c.glyph_id_ofs_list, c.list_length);
+      } else if (c.type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+        put(c.glyph_id_ofs_list, c.list_length * 2u);
+      }
+    }
+    end(cmap, true);
+
+    size_t loca = begin("loca");
+    put<uint32_t>(glyphs);
+    size_t offsets = out_.size();
+    out_.resize(out_.size() + glyphs * 4);
+    end(loca, true);
+
+    size_t glyf = begin("glyf");
+    for (uint32_t i = 0; i < glyphs; ++i) {
+      patch<uint32_t>(offsets + i * 4,
+                      static_cast<uint32_t>(out_.size() - glyf));
+      if (i == 0) {
+        out_.resize(out_.size() + 6, 0);
+        continue;
+      }
+      const lv_font_fmt_txt_glyph_dsc_t& g = dsc->glyph_dsc[i];
+      // Fields are big-endian bit streams: 16-bit advance, then 8 bits each.
+      put<uint8_t>(static_cast<uint8_t>(g.adv_w >> 8));
+      put<uint8_t>(static_cast<uint8_t>(g.adv_w));
+      put<int8_t>(static_cast<int8_t>(g.ofs_x));
+      put<int8_t>(static_cast<int8_t>(g.ofs_y));
+      put<uint8_t>(static_cast<uint8_t>(g.box_w));
+      put<uint8_t>(static_cast<uint8_t>(g.box_h));
+      size_t bytes = (g.box_w * g.box_h * dsc->bpp + 7u) / 8u;
+      put(dsc->glyph_bitmap + g.bitmap_index, bytes);
+    }
+    end(glyf, false);
+
+    if (kern) {
+      size_t k = begin("kern");
+      put<uint8_t>(3);  // Class-based format.
+      out_.resize(out_.size() + 3, 0);
+      put<uint16_t>(static_cast<uint16_t>(glyphs));
+      put<uint8_t>(kern->left_class_cnt);
+      put<uint8_t>(kern->right_class_cnt);
+      put(kern->left_class_mapping, glyphs);
+      put(kern->right_class_mapping, glyphs);
+      put(kern->class_pair_values,
+          static_cast<size_t>(kern->left_class_cnt) * kern->right_class_cnt);
+      end(k, true);
+    }
+  }
+
+  std::vector<uint8_t> out_;
+};
+
+}  // namespace lvgl_test
+
+#endif  // LVGL_CPP_TESTS_BINFONT_WRITER_H_
@@ -65,6 +65,9 @@
 #define LV_USE_THORVG_EXTERNAL 0
 #define LV_USE_MATRIX 1
 
+// Fonts
+#define LV_USE_TINY_TTF 1
+
 // Filesystem
 #define LV_USE_FS_STDIO 1
 #if LV_USE_FS_STDIO
@@ -78,4 +81,10 @@
   0 /**< >0 to cache this number of bytes in lv_fs_read() */
 #endif
 
+#define LV_USE_FS_MEMFS 1
+#if LV_USE_FS_MEMFS
+#define LV_FS_MEMFS_LETTER \
+  'B' /**< Set an upper-case driver-identifier letter for this driver. */
+#endif
+
 #endif /*LV_CONF_H*/
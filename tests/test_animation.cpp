@@ -331,6 +331,55 @@ void test_abstract_callbacks() {
   }
 }
 
+void test_native_fast_path() {
+  std::cout << "Testing Native Fast Path..." << std::endl;
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+  lvgl::Button obj(screen);
+
+  // Exec helpers are plain function pointers and run without a proxy.
+  lvgl::Animation(obj)
+      .set_values(0, 100)
+      .set_duration(50)
+      .set_exec_cb(lvgl::Animation::Exec::X())
+      .set_path_cb(lvgl::Animation::Path::EaseOut())
+      .start();
+  lv_anim_t* running =
+      lv_anim_get(obj.raw(), (lv_anim_exec_xcb_t)lv_obj_set_x);
+  if (!running || running->user_data || running->custom_exec_cb) {
+    std::cerr << "FAIL: Exec::X() was not installed natively." << std::endl;
+    exit(1);
+  }
+  lv_anim_delete(obj.raw(), nullptr);
+
+  // Object callbacks get one borrowed wrapper for the whole run.
+  std::vector<lvgl::Object*> seen;
+  bool wrong_target = false;
+  lvgl::Animation(obj)
+      .set_values(0, 100)
+      .set_duration(50)
+      .set_exec_cb(lvgl::Animation::ObjectExecCallback(
+          [&](lvgl::Object& target, int32_t v) {
+            if (target.raw() != obj.raw()) wrong_target = true;
+            seen.push_back(&target);
+          }))
+      .start();
+  for (int i = 0; i < 10; ++i) {
+    lv_tick_inc(10);
+    lv_timer_handler();
+  }
+
+  bool stable = seen.size() > 1;
+  for (lvgl::Object* target : seen) stable = stable && target == seen[0];
+  if (stable && !wrong_target) {
+    std::cout << "PASS: Native fast path and borrowed wrapper work."
+              << std::endl;
+  } else {
+    std::cerr << "FAIL: Object callback wrapper changed between frames."
+              << std::endl;
+    exit(1);
+  }
+}
+
 int main() {
   lv_init();
   lvgl::Display display = lvgl::Display::create(800, 480);
@@ -340,5 +389,6 @@ int main() {
   test_convenience_methods();
   test_path_callback_lambda();
   test_abstract_callbacks();
+  test_native_fast_path();
   return 0;
 }
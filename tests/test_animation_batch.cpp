@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../lvgl_cpp.h"
+#include "../misc/animation_batch.h"
+#include "../misc/easing.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static void set_int(void* var, int32_t value) {
+  *static_cast<int32_t*>(var) = value;
+}
+
+void test_easing_tables() {
+  std::cout << "Testing easing tables..." << std::endl;
+  const lvgl::Easing easings[] = {
+      lvgl::Easing::Linear,    lvgl::Easing::EaseIn, lvgl::Easing::EaseOut,
+      lvgl::Easing::EaseInOut, lvgl::Easing::Overshoot,
+      lvgl::Easing::Bounce,    lvgl::Easing::Step,
+  };
+  lv_anim_t anim;
+  lv_anim_init(&anim);
+  lv_anim_set_values(&anim, 0, lvgl::EasingTable::kResolution);
+  anim.duration = lvgl::EasingTable::kResolution;
+  for (lvgl::Easing easing : easings) {
+    lv_anim_path_cb_t path = lvgl::EasingTable::path_cb(easing);
+    for (int32_t p = 0; p <= lvgl::EasingTable::kResolution; ++p) {
+      anim.act_time = p;
+      int32_t diff = lvgl::EasingTable::eval(easing, p) - path(&anim);
+      if (std::abs(diff) > 16) fail("table drifts from the LVGL path");
+    }
+    if (lvgl::EasingTable::eval(easing, lvgl::EasingTable::kResolution) !=
+        lvgl::EasingTable::kResolution) {
+      fail("curve does not end at the end value");
+    }
+  }
+  if (lvgl::EasingTable::eval(lvgl::Easing::Step, 1023) != 0) {
+    fail("step moved early");
+  }
+  std::cout << "PASS: Tables follow the LVGL paths." << std::endl;
+}
+
+void test_tick() {
+  std::cout << "Testing manual ticks..." << std::endl;
+  lvgl::AnimationBatch batch;
+  int32_t linear = -1, delayed = -1, looping = -1, shared = -1;
+  batch.add({&linear, set_int, 0, 100, 100, 0, lvgl::Easing::Linear, false});
+  lvgl::AnimationBatch::Handle delayed_handle = batch.add(
+      {&delayed, set_int, 10, 20, 100, 50, lvgl::Easing::Linear, false});
+  batch.add({&looping, set_int, 0, 100, 100, 0, lvgl::Easing::Linear, true});
+
+  batch.tick(0);
+  if (linear != 0 || looping != 0) fail("start value not applied");
+  if (delayed != -1) fail("delayed tween applied early");
+  batch.tick(50);
+  if (linear != 50) fail("midpoint");
+  if (delayed != 10) fail("delayed start");
+  batch.tick(50);
+  if (linear != 100 || looping != 100) fail("end value");
+  if (batch.size() != 2) fail("finished tween not removed");
+  batch.tick(30);
+  if (looping != 30) fail("repeat did not restart");
+  batch.remove(delayed_handle);
+  if (batch.is_running(delayed_handle)) fail("remove by handle");
+  if (delayed != 18) fail("removed tween should stay where it was");
+
+  // Tweens without an exec callback go to the batch callback together.
+  std::vector<int32_t> received;
+  batch.set_batch_exec_cb(
+      [](void* const*, const int32_t* values, uint32_t count, void* data) {
+        auto* out = static_cast<std::vector<int32_t>*>(data);
+        out->assign(values, values + count);
+      },
+      &received);
+  batch.add({&shared, nullptr, 0, 10, 10, 0, lvgl::Easing::Linear, false});
+  batch.add({&shared, nullptr, 100, 110, 10, 0, lvgl::Easing::Linear, false});
+  batch.tick(5);
+  if (received.size() != 2 || received[1] != 105) fail("batch callback");
+  batch.remove(static_cast<void*>(&shared));
+  if (batch.size() != 1) fail("remove by var");
+  std::cout << "PASS: Tweens advance, repeat and stop." << std::endl;
+}
+
+void test_timer(lvgl::Object& screen) {
+  std::cout << "Testing timer drive..." << std::endl;
+  lvgl::Object obj(&screen);
+  lvgl::AnimationBatch batch;
+  batch.add(obj, lvgl::AnimationBatch::Exec::X(), 0, 200, 200,
+            lvgl::Easing::EaseOut);
+  for (int i = 0; i < 20; ++i) {
+    lv_tick_inc(20);
+    lv_timer_handler();
+  }
+  if (batch.size() != 0) fail("tween still running after its duration");
+  if (lv_obj_get_style_x(obj.raw(), LV_PART_MAIN) != 200) {
+    fail("object not at the end value");
+  }
+  std::cout << "PASS: Timer runs the batch." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_easing_tables();
+  test_tick();
+  test_timer(screen);
+
+  std::cout << "All animation batch tests passed." << std::endl;
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include <cassert>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "../display/display.h"
 #include "../misc/animation_timeline.h"
@@ -146,12 +148,73 @@ void test_timeline_user_data() {
   std::cout << "PASS: Timeline user data." << std::endl;
 }
 
+static int keyframe_writes = 0;
+
+static void set_int(void* var, int32_t value) {
+  *static_cast<int32_t*>(var) = value;
+  keyframe_writes++;
+}
+
+void test_timeline_keyframes() {
+  std::cout << "Testing Timeline Keyframes..." << std::endl;
+  int32_t x = -1, y = -1;
+  std::vector<lvgl::KeyframeTrack> tracks;
+  // Keys out of order on purpose; they are sorted when compiled.
+  tracks.emplace_back(&x, set_int)
+      .key(1000, 0, lvgl::Easing::EaseOut)
+      .key(0, 100)
+      .key(500, 200);
+  tracks.emplace_back(&y, set_int)
+      .key(200, 10)
+      .key(600, 50, lvgl::Easing::Step);
+
+  lvgl::KeyframeClip clip(tracks);
+  if (clip.get_duration() != 1000 || clip.get_track_count() != 2) {
+    std::cerr << "FAIL: Clip duration or track count." << std::endl;
+    exit(1);
+  }
+  if (clip.get_value(0, 250) != 150 || clip.get_value(0, 500) != 200 ||
+      clip.get_value(1, 0) != 10 || clip.get_value(1, 599) != 10 ||
+      clip.get_value(1, 600) != 50) {
+    std::cerr << "FAIL: Keyframe values." << std::endl;
+    exit(1);
+  }
+
+  lvgl::AnimationTimeline timeline;
+  timeline.add(std::move(clip), 0);
+  if (timeline.get_playtime() != 1000) {
+    std::cerr << "FAIL: Keyframe playtime." << std::endl;
+    exit(1);
+  }
+  timeline.set_progress(0);
+  if (x != 100 || y != 10) {
+    std::cerr << "FAIL: Seek to start (" << x << ", " << y << ")."
+              << std::endl;
+    exit(1);
+  }
+  timeline.set_progress(65535);
+  if (x != 0 || y != 50) {
+    std::cerr << "FAIL: Seek to end (" << x << ", " << y << ")."
+              << std::endl;
+    exit(1);
+  }
+  // Seeking to the same place writes nothing.
+  int writes = keyframe_writes;
+  timeline.set_progress(65535);
+  if (keyframe_writes != writes) {
+    std::cerr << "FAIL: Unchanged values were written again." << std::endl;
+    exit(1);
+  }
+  std::cout << "PASS: Keyframes seek through the timeline." << std::endl;
+}
+
 int main() {
   lv_init();
   lvgl::Display display = lvgl::Display::create(800, 480);
   test_timeline_basic();
   test_timeline_advanced();
   test_timeline_user_data();
+  test_timeline_keyframes();
   std::cout << "All AnimationTimeline tests passed!" << std::endl;
   return 0;
 }
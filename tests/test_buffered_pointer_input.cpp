@@ -0,0 +1,144 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../indev/buffered_pointer_input.h"
+#include "../lvgl_cpp.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+namespace {
+
+constexpr int kTaps = 100;
+constexpr int kSamplesPerTap = 10;
+
+struct EdgeCounter {
+  int pressed = 0;
+  int released = 0;
+};
+
+// A 1 kHz controller: every tap is 5 ms down (press, three moves, release)
+// followed by 5 ms up, so each indev period holds several whole taps.
+std::vector<lvgl::PointerSample> make_stream(uint32_t start) {
+  std::vector<lvgl::PointerSample> stream;
+  for (int tap = 0; tap < kTaps; ++tap) {
+    int32_t x = 100 + (tap % 10) * 40;
+    int32_t y = 100 + (tap / 10) * 20;
+    for (int ms = 0; ms < kSamplesPerTap; ++ms) {
+      uint32_t t = start + tap * kSamplesPerTap + ms;
+      bool pressed = ms < 4;
+      stream.push_back({x + (pressed ? ms : 3), y, t, pressed});
+    }
+  }
+  return stream;
+}
+
+void pump() {
+  lv_tick_inc(LV_DEF_REFR_PERIOD);
+  lv_timer_handler();
+}
+
+// Feeds the stream in real-time order: one indev period of samples, then
+// one LVGL pass.
+void feed(lvgl::BufferedPointerInput& input,
+          const std::vector<lvgl::PointerSample>& stream) {
+  size_t next = 0;
+  while (next < stream.size()) {
+    for (uint32_t ms = 0; ms < LV_DEF_REFR_PERIOD && next < stream.size();
+         ++ms) {
+      if (!input.push(stream[next++])) fail("queue overflowed");
+    }
+    pump();
+  }
+  pump();
+}
+
+}  // namespace
+
+void test_every_edge(EdgeCounter& edges) {
+  std::cout << "Testing 1 kHz stream delivery..." << std::endl;
+  edges = {};
+  lvgl::BufferedPointerInput input(256);
+  feed(input, make_stream(lv_tick_get()));
+  if (edges.pressed != kTaps) fail("lost press edges");
+  if (edges.released != kTaps) fail("lost release edges");
+  if (input.get_delivered() != kTaps * kSamplesPerTap) {
+    fail("every sample should be delivered");
+  }
+  std::cout << "PASS: Every press and release reached LVGL." << std::endl;
+}
+
+void test_coalescing(EdgeCounter& edges) {
+  std::cout << "Testing move coalescing..." << std::endl;
+  edges = {};
+  lvgl::BufferedPointerInput input(256);
+  input.set_coalesce_moves(true);
+  feed(input, make_stream(lv_tick_get()));
+  if (edges.pressed != kTaps || edges.released != kTaps) {
+    fail("coalescing dropped an edge");
+  }
+  if (input.get_coalesced() == 0) fail("no moves were coalesced");
+  if (input.get_delivered() + input.get_coalesced() !=
+      kTaps * kSamplesPerTap) {
+    fail("samples unaccounted for");
+  }
+  std::cout << "PASS: Moves coalesce without losing edges." << std::endl;
+}
+
+void test_driver_thread(EdgeCounter& edges) {
+  std::cout << "Testing driver thread producer..." << std::endl;
+  edges = {};
+  lvgl::BufferedPointerInput input(kTaps * kSamplesPerTap);
+  std::vector<lvgl::PointerSample> stream = make_stream(lv_tick_get());
+  std::thread driver([&input, &stream]() {
+    for (const lvgl::PointerSample& sample : stream) input.push(sample);
+  });
+  while (input.get_delivered() < stream.size() / 2) pump();
+  driver.join();
+  pump();
+  pump();
+  if (input.get_dropped() != 0) fail("samples dropped");
+  if (edges.pressed != kTaps || edges.released != kTaps) {
+    fail("lost edges from the driver thread");
+  }
+  std::cout << "PASS: Samples pushed from another thread arrive in order."
+            << std::endl;
+}
+
+void test_overflow() {
+  std::cout << "Testing full queue..." << std::endl;
+  lvgl::BufferedPointerInput input(8);
+  int accepted = 0;
+  for (int i = 0; i < 20; ++i) accepted += input.push(i, 0, true);
+  if (accepted != 8 || input.get_dropped() != 12) fail("overflow count");
+  pump();
+  if (input.get_delivered() != 8) fail("queued samples not delivered");
+  std::cout << "PASS: A full queue refuses and counts samples." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  EdgeCounter edges;
+  lvgl::Button target(screen);
+  target.set_pos(0, 0).set_size(800, 480);
+  target.add_event_cb(lvgl::EventCode::Pressed,
+                      [&edges](lvgl::Event&) { ++edges.pressed; });
+  target.add_event_cb(lvgl::EventCode::Released,
+                      [&edges](lvgl::Event&) { ++edges.released; });
+
+  test_every_edge(edges);
+  test_coalescing(edges);
+  test_driver_thread(edges);
+  test_overflow();
+
+  std::cout << "All buffered pointer input tests passed." << std::endl;
+  return 0;
+}
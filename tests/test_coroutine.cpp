@@ -0,0 +1,175 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../lvgl_cpp.h"
+#include "../misc/coroutine.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static void pump(int passes, uint32_t ms = 10) {
+  for (int i = 0; i < passes; ++i) {
+    lv_tick_inc(ms);
+    lv_timer_handler();
+  }
+}
+
+static std::vector<std::string> steps;
+
+lvgl::Task<int> doubled_later(int value) {
+  co_await lvgl::delay(20);
+  steps.push_back("child");
+  co_return value * 2;
+}
+
+lvgl::Task<> flow(int* result) {
+  steps.push_back("start");
+  int value = co_await doubled_later(21);
+  steps.push_back("resumed");
+  co_await lvgl::next_frame();
+  steps.push_back("frame");
+  *result = value;
+}
+
+struct Sentinel {
+  bool* destroyed;
+  ~Sentinel() { *destroyed = true; }
+};
+
+lvgl::Task<> ticker(int* count, bool* destroyed) {
+  Sentinel sentinel{destroyed};
+  for (;;) {
+    ++*count;
+    co_await lvgl::delay(10);
+  }
+}
+
+void test_delay_and_children() {
+  std::cout << "Testing delay and child tasks..." << std::endl;
+  steps.clear();
+  int result = 0;
+  flow(&result).detach();
+  if (steps.size() != 1) fail("detach should run up to the first await");
+  pump(1);
+  if (steps.size() != 1) fail("child resumed before its delay");
+  pump(1);
+  if (steps.size() < 2 || steps[1] != "child") fail("child did not resume");
+  for (int i = 0; i < 10 && result == 0; ++i) pump(1, 20);
+  if (result != 42 || steps.back() != "frame") fail("flow did not finish");
+  std::cout << "PASS: Tasks await delays, children and frames." << std::endl;
+}
+
+void test_cancellation(lvgl::Object& screen) {
+  std::cout << "Testing cancellation..." << std::endl;
+  int count = 0;
+  bool destroyed = false;
+  {
+    lvgl::Task<> task = ticker(&count, &destroyed);
+    if (count != 0) fail("tasks should start lazily");
+    task.start();
+    pump(3);
+    if (count != 4) fail("owned task did not tick");
+  }
+  if (!destroyed) fail("destroying the task should destroy the frame");
+  pump(3);
+  if (count != 4) fail("cancelled task kept running");
+
+  count = 0;
+  destroyed = false;
+  auto* owner = new lvgl::Object(&screen);
+  ticker(&count, &destroyed).detach(*owner);
+  pump(2);
+  delete owner;
+  pump(1);
+  if (!destroyed) fail("deleting the owner should cancel the task");
+  int stopped_at = count;
+  pump(3);
+  if (count != stopped_at) fail("task ran after its owner was deleted");
+  std::cout << "PASS: Tasks are cancelled with their owner." << std::endl;
+}
+
+lvgl::Task<> wait_click(lvgl::Object& target, int* result) {
+  bool clicked = co_await lvgl::event(target, lvgl::EventCode::Clicked);
+  *result = clicked ? 1 : 2;
+}
+
+void test_event(lvgl::Object& screen) {
+  std::cout << "Testing event awaitable..." << std::endl;
+  auto* button = new lvgl::Button(screen);
+  int result = 0;
+  wait_click(*button, &result).detach();
+  lv_obj_send_event(button->raw(), LV_EVENT_CLICKED, nullptr);
+  if (result != 0) fail("resumed inside the event callback");
+  pump(1);
+  if (result != 1) fail("click not delivered");
+
+  int deleted = 0;
+  wait_click(*button, &deleted).detach();
+  delete button;
+  pump(1);
+  if (deleted != 2) fail("deleting the object should end the wait");
+  std::cout << "PASS: Event awaitable resumes once." << std::endl;
+}
+
+lvgl::Task<> slide(lvgl::Object& target, bool* done) {
+  lvgl::Animation anim(target);
+  anim.set_exec_cb(lvgl::Animation::Exec::X())
+      .set_values(0, 100)
+      .set_duration(100);
+  co_await anim.start();
+  *done = true;
+}
+
+void test_animation(lvgl::Object& screen) {
+  std::cout << "Testing animation awaitable..." << std::endl;
+  lvgl::Object box(&screen);
+  bool done = false;
+  slide(box, &done).detach();
+  pump(5);
+  if (done) fail("resumed before the animation ended");
+  pump(10);
+  if (!done) fail("animation end not delivered");
+  if (lv_obj_get_x(box.raw()) != 100) fail("animation did not finish");
+  std::cout << "PASS: Animation awaitable resumes at the end." << std::endl;
+}
+
+#if LV_USE_OBSERVER
+lvgl::Task<> wait_subject(lvgl::IntSubject& subject, int32_t* seen) {
+  co_await lvgl::subject_changed(subject);
+  *seen = subject.get();
+}
+
+void test_subject() {
+  std::cout << "Testing subject awaitable..." << std::endl;
+  lvgl::IntSubject subject(1);
+  int32_t seen = 0;
+  wait_subject(subject, &seen).detach();
+  pump(1);
+  if (seen != 0) fail("subscribing should not resume the task");
+  subject.set(7);
+  pump(1);
+  if (seen != 7) fail("subject change not delivered");
+  std::cout << "PASS: Subject awaitable resumes on change." << std::endl;
+}
+#endif
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_delay_and_children();
+  test_cancellation(screen);
+  test_event(screen);
+  test_animation(screen);
+#if LV_USE_OBSERVER
+  test_subject();
+#endif
+
+  std::cout << "All coroutine tests passed." << std::endl;
+  return 0;
+}
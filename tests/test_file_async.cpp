@@ -0,0 +1,247 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../lvgl_cpp.h"
+#include "../misc/file_system.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static std::vector<uint8_t> make_pattern(size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(i * 13 + 5);
+  return data;
+}
+
+// Run the timer handler until `done` is set, returning the number of
+// handler calls it took.
+static int pump_until(const bool& done, int max_iterations = 100000) {
+  int calls = 0;
+  while (calls < max_iterations && !done) {
+    lv_tick_inc(1);
+    lv_timer_handler();
+    ++calls;
+  }
+  if (!done) fail("request never completed");
+  return calls;
+}
+
+static void pump(int iterations) {
+  for (int i = 0; i < iterations; ++i) {
+    lv_tick_inc(1);
+    lv_timer_handler();
+  }
+}
+
+void test_large_native_load() {
+  std::cout << "Testing large load off the LVGL thread..." << std::endl;
+  const char* path = "A:test_async_large.bin";
+  std::vector<uint8_t> expected = make_pattern(8 * 1024 * 1024);
+  {
+    lvgl::File f(path, lvgl::FsMode::Write);
+    if (!f.is_open()) fail("could not create test file");
+    f.write(expected.data(), static_cast<uint32_t>(expected.size()));
+  }
+
+  bool done = false;
+  lvgl::FsRes result = lvgl::FsRes::Unknown;
+  std::vector<uint8_t> loaded;
+  lvgl::FileRequest request = lvgl::FileSystem::load_async(
+      path, [&](lvgl::FsRes res, std::vector<uint8_t> data) {
+        result = res;
+        loaded = std::move(data);
+        done = true;
+      });
+  if (!request.valid()) fail("request should be in flight");
+  if (done) fail("callback ran inside load_async()");
+
+  int calls = pump_until(done);
+  std::remove("test_async_large.bin");
+
+  if (result != lvgl::FsRes::Ok) fail("load reported an error");
+  if (loaded != expected) fail("loaded data differs");
+  if (request.valid()) fail("completed request still valid");
+  std::cout << "PASS: 8 MiB loaded over " << calls << " handler calls"
+            << std::endl;
+}
+
+void test_read_async_on_open_file() {
+  std::cout << "Testing File::read_async..." << std::endl;
+  const char* path = "A:test_async_part.bin";
+  std::vector<uint8_t> expected = make_pattern(4096);
+  {
+    lvgl::File out(path, lvgl::FsMode::Write);
+    out.write(expected.data(), static_cast<uint32_t>(expected.size()));
+  }
+  lvgl::File f(path, lvgl::FsMode::Read);
+  f.seek(10, lvgl::FsWhence::Set);
+
+  bool done = false;
+  std::vector<uint8_t> part;
+  lvgl::FileRequest request =
+      f.read_async(100, 1000, [&](lvgl::FsRes res, std::vector<uint8_t> data) {
+        if (res != lvgl::FsRes::Ok) fail("read_async reported an error");
+        part = std::move(data);
+        done = true;
+      });
+  pump_until(done);
+
+  if (part != std::vector<uint8_t>(expected.begin() + 100,
+                                   expected.begin() + 1100)) {
+    fail("read_async returned wrong bytes");
+  }
+  uint32_t pos = 0;
+  f.tell(&pos);
+  if (pos != 10) fail("read_async moved the file position");
+  f.close();
+  std::remove("test_async_part.bin");
+  std::cout << "PASS: partial read delivered, position untouched."
+            << std::endl;
+}
+
+void test_sliced_fallback(lvgl::RamFileSystem& ram) {
+  std::cout << "Testing sliced reads for non-native drivers..." << std::endl;
+  std::vector<uint8_t> expected = make_pattern(1024 * 1024);
+  ram.add_file("big.bin", expected);
+
+  bool done = false;
+  std::vector<uint8_t> loaded;
+  lvgl::FileRequest request = lvgl::FileSystem::load_async(
+      "R:big.bin", [&](lvgl::FsRes res, std::vector<uint8_t> data) {
+        if (res != lvgl::FsRes::Ok) fail("sliced load reported an error");
+        loaded = std::move(data);
+        done = true;
+      });
+  // The RAM drive is read 16 KiB per request per handler call.
+  int calls = pump_until(done);
+  if (loaded != expected) fail("sliced load returned wrong data");
+  if (calls < static_cast<int>(expected.size() / (16 * 1024))) {
+    fail("a handler call read more than one slice");
+  }
+
+  done = false;
+  lvgl::FsRes result = lvgl::FsRes::Ok;
+  request = lvgl::FileSystem::load_async(
+      "R:missing.bin", [&](lvgl::FsRes res, std::vector<uint8_t> data) {
+        result = res;
+        if (!data.empty()) fail("failed load delivered data");
+        done = true;
+      });
+  pump_until(done);
+  if (result == lvgl::FsRes::Ok) fail("missing file reported success");
+  std::cout << "PASS: RAM drive loaded in slices, errors reported."
+            << std::endl;
+}
+
+void test_cancellation(lvgl::RamFileSystem& ram) {
+  std::cout << "Testing cancellation..." << std::endl;
+  ram.add_file("cancel.bin", make_pattern(512 * 1024));
+
+  int calls = 0;
+  auto callback = [&](lvgl::FsRes, std::vector<uint8_t>) { calls++; };
+
+  lvgl::FileRequest request =
+      lvgl::FileSystem::load_async("R:cancel.bin", callback);
+  pump(2);  // Let it start.
+  if (!request.cancel()) fail("cancel() on a live request returned false");
+  if (request.cancel()) fail("second cancel() returned true");
+
+  {
+    // Dropping the handle cancels too.
+    lvgl::FileRequest dropped =
+        lvgl::FileSystem::load_async("R:cancel.bin", callback);
+  }
+
+  // Released requests run to completion without a handle.
+  lvgl::FileSystem::load_async("R:cancel.bin", callback).release();
+
+  pump(200);
+  if (calls != 1) fail("expected only the released request to complete");
+  if (lvgl::FileSystem::get_in_flight() != 0) fail("requests left in flight");
+  std::cout << "PASS: cancelled requests never call back." << std::endl;
+}
+
+void test_file_lifetime(lvgl::RamFileSystem& ram) {
+  std::cout << "Testing File moves and closes with reads pending..."
+            << std::endl;
+  std::vector<uint8_t> expected = make_pattern(256 * 1024);
+  ram.add_file("move.bin", expected);
+
+  bool done = false;
+  std::vector<uint8_t> loaded;
+  lvgl::File moved;
+  {
+    lvgl::File f("R:move.bin");
+    lvgl::FileRequest request = f.read_async(
+        0, 256 * 1024, [&](lvgl::FsRes res, std::vector<uint8_t> data) {
+          if (res != lvgl::FsRes::Ok) fail("moved read reported an error");
+          loaded = std::move(data);
+          done = true;
+        });
+    request.release();
+    pump(2);  // Mid-read.
+    moved = std::move(f);
+  }
+  pump_until(done);
+  if (loaded != expected) fail("read did not follow the moved File");
+
+  int calls = 0;
+  {
+    lvgl::File f("R:move.bin");
+    lvgl::FileRequest request = f.read_async(
+        0, 256 * 1024, [&](lvgl::FsRes, std::vector<uint8_t>) { calls++; });
+    request.release();
+    pump(2);
+  }  // Destroyed mid-read.
+  pump(100);
+  if (calls != 0) fail("read on a destroyed File called back");
+  if (lvgl::FileSystem::get_in_flight() != 0) fail("requests left in flight");
+  std::cout << "PASS: pending reads follow moves and stop on close."
+            << std::endl;
+}
+
+void test_bounded_in_flight(lvgl::RamFileSystem& ram) {
+  std::cout << "Testing bounded in-flight requests..." << std::endl;
+  ram.add_file("a.bin", make_pattern(64 * 1024));
+  lvgl::FileSystem::set_max_in_flight(1);
+
+  int completed = 0;
+  std::vector<lvgl::FileRequest> requests;
+  for (int i = 0; i < 3; ++i) {
+    requests.push_back(lvgl::FileSystem::load_async(
+        "R:a.bin",
+        [&](lvgl::FsRes, std::vector<uint8_t>) { completed++; }));
+  }
+  if (lvgl::FileSystem::get_in_flight() != 1) fail("expected one in flight");
+  if (lvgl::FileSystem::get_pending() != 2) fail("expected two pending");
+
+  for (int i = 0; i < 1000 && completed < 3; ++i) {
+    pump(1);
+    if (lvgl::FileSystem::get_in_flight() > 1) fail("limit exceeded");
+  }
+  if (completed != 3) fail("queued requests did not complete");
+
+  lvgl::FileSystem::set_max_in_flight(4);
+  std::cout << "PASS: queue drained one request at a time." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+
+  test_large_native_load();
+  test_read_async_on_open_file();
+
+  lvgl::RamFileSystem ram('R');
+  test_sliced_fallback(ram);
+  test_cancellation(ram);
+  test_file_lifetime(ram);
+  test_bounded_in_flight(ram);
+
+  std::cout << "All async file tests passed." << std::endl;
+  return 0;
+}
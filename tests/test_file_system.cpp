@@ -132,6 +132,75 @@ void test_directory() {
   // Actually, let's just create a dummy file and assume we are in it.
 }
 
+void test_ram_file_system() {
+  std::cout << "Testing RamFileSystem..." << std::endl;
+  lvgl::RamFileSystem ram('R');
+
+  // Write through lv_fs and read it back.
+  {
+    lvgl::File f("R:/data/log.txt", lvgl::FsMode::Write);
+    if (!f.is_open()) {
+      std::cerr << "FAIL: Could not create RAM file." << std::endl;
+      exit(1);
+    }
+    const char* text = "Hello RAM disk";
+    f.write(text, static_cast<uint32_t>(strlen(text)));
+  }
+  {
+    lvgl::File f("R:data/log.txt", lvgl::FsMode::Read);
+    char buf[32] = {};
+    uint32_t br = 0;
+    f.seek(6, lvgl::FsWhence::Set);
+    f.read(buf, sizeof(buf) - 1, &br);
+    uint32_t pos = 0;
+    f.tell(&pos);
+    if (std::string(buf) != "RAM disk" || pos != 14 || f.size() != 14) {
+      std::cerr << "FAIL: RAM read/seek mismatch. Got: '" << buf << "'"
+                << std::endl;
+      exit(1);
+    }
+    std::cout << "PASS: RAM write/read/seek/tell works." << std::endl;
+  }
+
+  // Zero-copy views of static data.
+  static const uint8_t kAsset[] = {1, 2, 3, 4, 5};
+  ram.add_file_static("img/icon.bin", kAsset, sizeof(kAsset));
+  ram.add_file("img/sub/extra.bin", std::vector<uint8_t>{9, 9});
+  if (ram.view("R:img/icon.bin").data() != kAsset ||
+      lvgl::FileSystem::get_size("R:img/icon.bin") != sizeof(kAsset)) {
+    std::cerr << "FAIL: Static file was copied or has the wrong size."
+              << std::endl;
+    exit(1);
+  }
+  std::vector<uint8_t> loaded = lvgl::File::load_to_buffer("R:img/icon.bin");
+  if (loaded != std::vector<uint8_t>(kAsset, kAsset + sizeof(kAsset))) {
+    std::cerr << "FAIL: Static file contents differ." << std::endl;
+    exit(1);
+  }
+  std::cout << "PASS: Zero-copy view and load_to_buffer work." << std::endl;
+
+  // Directory listing reports files and sub-directories.
+  {
+    lvgl::Directory dir("R:img");
+    std::vector<std::string> names;
+    std::string fn;
+    while (dir.read(fn) == lvgl::FsRes::Ok && !fn.empty()) names.push_back(fn);
+    if (names != std::vector<std::string>{"icon.bin", "/sub"}) {
+      std::cerr << "FAIL: Unexpected directory listing." << std::endl;
+      exit(1);
+    }
+    std::cout << "PASS: Directory listing works." << std::endl;
+  }
+
+  if (!ram.remove_file("img/icon.bin") ||
+      lvgl::FileSystem::exists("R:img/icon.bin") ||
+      ram.get_file_count() != 2) {
+    std::cerr << "FAIL: remove_file() did not remove the file." << std::endl;
+    exit(1);
+  }
+  std::cout << "PASS: remove_file() works." << std::endl;
+}
+
 int main() {
   lv_init();
 
@@ -141,6 +210,7 @@ int main() {
   lvgl::Display display = lvgl::Display::create(800, 480);
 
   test_filesystem_write_read();
+  test_ram_file_system();
 
   return 0;
 }
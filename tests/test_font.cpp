@@ -1,8 +1,161 @@
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #include "../font/owned_font.h"
 #include "../lvgl_cpp.h"
+#include "../misc/file_system.h"
+#include "binfont_writer.h"
+
+#if LV_USE_TINY_TTF
+// Glyph cache checks need a real TTF; set LVGL_TEST_TTF to override.
+static std::vector<char> read_test_ttf() {
+  const char* env = std::getenv("LVGL_TEST_TTF");
+  const char* path =
+      env ? env : "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in), {});
+}
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static void fetch_glyph(const lvgl::OwnedFont& font, uint32_t letter) {
+  lv_font_glyph_dsc_t g{};
+  lv_font_get_glyph_dsc(font.raw(), &g, letter, 0);
+  const void* bitmap = lv_font_get_glyph_bitmap(&g, nullptr);
+  if (!bitmap) fail("glyph bitmap missing");
+  lv_font_glyph_release_draw_data(&g);
+}
+
+static void test_glyph_cache() {
+  std::vector<char> ttf = read_test_ttf();
+  if (ttf.empty()) {
+    std::cout << "No TTF available, skipping glyph cache test." << std::endl;
+    return;
+  }
+
+  lvgl::OwnedFont plain =
+      lvgl::OwnedFont::load_tiny_ttf(ttf.data(), ttf.size(), 24);
+  if (plain.get_glyph_cache_budget() != 0) fail("cache is not opt-in");
+
+  lvgl::OwnedFont font =
+      lvgl::OwnedFont::load_tiny_ttf(ttf.data(), ttf.size(), 24, 32 * 1024);
+  if (!font.is_valid()) fail("font not loaded");
+  if (font.get_glyph_cache_budget() != 32 * 1024) fail("budget not set");
+
+  // Prewarming rasterizes each new glyph once.
+  uint32_t warmed = font.prewarm(U"Hello");
+  if (warmed != 4) fail("first prewarm did not rasterize 4 glyphs");
+  warmed = font.prewarm(U"Hello");
+  if (warmed != 0) fail("second prewarm rasterized again");
+  auto stats = font.get_glyph_cache_stats();
+  if (stats.entries != 4 || stats.misses != 4) fail("wrong prewarm counters");
+
+  // Drawing a warmed glyph is a hit.
+  fetch_glyph(font, 'H');
+  fetch_glyph(font, 'o');
+  stats = font.get_glyph_cache_stats();
+  if (stats.hits != 2 || stats.misses != 4) fail("warmed glyphs missed");
+
+  // Resizing drops bitmaps of the old size.
+  lv_tiny_ttf_set_size(const_cast<lv_font_t*>(font.raw()), 32);
+  warmed = font.prewarm(U"Hello");
+  if (warmed != 4) fail("resized font served stale glyphs");
+  lv_tiny_ttf_set_size(const_cast<lv_font_t*>(font.raw()), 24);
+  font.reset_glyph_cache_stats();
+  font.clear_glyph_cache();
+  font.prewarm(U"Hello");
+
+  // Shrinking the budget evicts.
+  font.set_glyph_cache_budget(0);
+  stats = font.get_glyph_cache_stats();
+  if (stats.entries != 0 || stats.bytes != 0 || stats.evictions != 4) {
+    fail("shrinking the budget did not evict");
+  }
+
+  // Moving the font keeps the cache working.
+  font.set_glyph_cache_budget(32 * 1024);
+  lvgl::OwnedFont moved = std::move(font);
+  fetch_glyph(moved, 'W');
+  fetch_glyph(moved, 'W');
+  if (moved.get_glyph_cache_stats().hits != 1) fail("moved cache missed");
+
+  std::cout << "Glyph cache prewarm, hits and eviction verified." << std::endl;
+}
+#endif
+
+#if LV_USE_FS_STDIO && LV_FONT_MONTSERRAT_14
+static bool same_dsc(const lv_font_glyph_dsc_t& a,
+                     const lv_font_glyph_dsc_t& b) {
+  return a.adv_w == b.adv_w && a.box_w == b.box_w && a.box_h == b.box_h &&
+         a.ofs_x == b.ofs_x && a.ofs_y == b.ofs_y && a.format == b.format &&
+         a.gid.index == b.gid.index;
+}
+
+static void test_glyph_index() {
+  const char* path = "A:test_font_index.bin";
+  {
+    std::vector<uint8_t> bin =
+        lvgl_test::BinFontWriter::write(&lv_font_montserrat_14);
+    lvgl::File file(path, lvgl::FsMode::Write);
+    file.write(bin.data(), static_cast<uint32_t>(bin.size()));
+  }
+
+  lvgl::OwnedFont plain = lvgl::OwnedFont::load_bin(path);
+  lvgl::OwnedFont indexed = lvgl::OwnedFont::load_bin(path, true);
+  assert(plain.is_valid() && indexed.is_valid());
+  assert(!plain.has_glyph_index());
+  assert(indexed.has_glyph_index());
+  assert(indexed.get_glyph_index_bytes() > 0);
+
+  // Every code point, with and without a kerning partner, resolves exactly
+  // as through the cmap subtables.
+  const uint32_t nexts[] = {0, 'A', 'V', 'o', '.'};
+  for (uint32_t letter = 0; letter < 0x10000; ++letter) {
+    for (uint32_t next : nexts) {
+      lv_font_glyph_dsc_t a{};
+      lv_font_glyph_dsc_t b{};
+      bool found_a = lv_font_get_glyph_dsc(plain.raw(), &a, letter, next);
+      bool found_b = lv_font_get_glyph_dsc(indexed.raw(), &b, letter, next);
+      assert(found_a == found_b);
+      assert(!found_a || same_dsc(a, b));
+    }
+  }
+
+#if LV_USE_FS_MEMFS
+  // Misses fall through to the fallback font.
+  lvgl::OwnedFont digits =
+      lvgl::OwnedFont::load_bin_subset(path, U"0123456789");
+  bool built = digits.build_glyph_index();
+  assert(built);
+  digits.set_fallback(&lvgl::Font::montserrat_14());
+  lv_font_glyph_dsc_t g{};
+  bool found = lv_font_get_glyph_dsc(digits.raw(), &g, 'A', 0);
+  assert(found && g.resolved_font == lvgl::Font::montserrat_14().raw());
+  found = lv_font_get_glyph_dsc(digits.raw(), &g, '7', 0);
+  assert(found && g.resolved_font == digits.raw());
+  (void)built;
+  (void)found;
+#endif
+
+  // Moving the font keeps the index working.
+  lvgl::OwnedFont moved = std::move(indexed);
+  assert(moved.has_glyph_index());
+  assert(lvgl::Font(moved.raw()).get_glyph_width('W') ==
+         lvgl::Font(plain.raw()).get_glyph_width('W'));
+
+  std::remove("test_font_index.bin");
+  std::cout << "Glyph index lookups match the cmap search." << std::endl;
+}
+#endif
 
 int main() {
   lv_init();
@@ -30,6 +183,14 @@ int main() {
     }
   }
 
+#if LV_USE_TINY_TTF
+  test_glyph_cache();
+#endif
+
+#if LV_USE_FS_STDIO && LV_FONT_MONTSERRAT_14
+  test_glyph_index();
+#endif
+
   std::cout << "[SUCCESS] OwnedFont basic lifecycle verified." << std::endl;
   return 0;
 }
@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "../font/owned_font.h"
+#include "../lvgl_cpp.h"
+#include "../misc/file_system.h"
+#include "binfont_writer.h"
+
+namespace {
+
+const char* kFontPath = "A:test_font_subset.bin";
+
+void check(bool cond, const char* msg) {
+  if (!cond) {
+    std::cerr << "FAIL: " << msg << std::endl;
+    exit(1);
+  }
+  std::cout << "PASS: " << msg << std::endl;
+}
+
+void write_font_file() {
+  std::vector<uint8_t> bin =
+      lvgl_test::BinFontWriter::write(&lv_font_montserrat_14);
+  lvgl::File file(kFontPath, lvgl::FsMode::Write);
+  uint32_t bw = 0;
+  file.write(bin.data(), static_cast<uint32_t>(bin.size()), &bw);
+}
+
+// The rendered result of a glyph: metrics plus bitmap bytes.
+bool same_glyph(const lv_font_t* a, const lv_font_t* b, uint32_t letter,
+                uint32_t next) {
+  lv_font_glyph_dsc_t ga{};
+  lv_font_glyph_dsc_t gb{};
+  bool found_a = lv_font_get_glyph_dsc(a, &ga, letter, next);
+  bool found_b = lv_font_get_glyph_dsc(b, &gb, letter, next);
+  if (!found_a || !found_b) return false;
+  if (ga.adv_w != gb.adv_w || ga.box_w != gb.box_w || ga.box_h != gb.box_h ||
+      ga.ofs_x != gb.ofs_x || ga.ofs_y != gb.ofs_y) {
+    return false;
+  }
+
+  const auto* da = static_cast<const lv_font_fmt_txt_dsc_t*>(a->dsc);
+  const auto* db = static_cast<const lv_font_fmt_txt_dsc_t*>(b->dsc);
+  const uint8_t* bmp_a =
+      da->glyph_bitmap + da->glyph_dsc[ga.gid.index].bitmap_index;
+  const uint8_t* bmp_b =
+      db->glyph_bitmap + db->glyph_dsc[gb.gid.index].bitmap_index;
+  size_t bytes = (ga.box_w * ga.box_h * da->bpp + 7u) / 8u;
+  return std::memcmp(bmp_a, bmp_b, bytes) == 0;
+}
+
+void test_subset_matches_full() {
+  lvgl::OwnedFont full = lvgl::OwnedFont::load_bin(kFontPath);
+  check(full.is_valid(), "Full binary font loads");
+
+  const std::u32string_view charset = U"0123456789.-AVTo";
+  lvgl::OwnedFont::SubsetInfo info;
+  lvgl::OwnedFont subset =
+      lvgl::OwnedFont::load_bin_subset(kFontPath, charset, &info);
+  check(subset.is_valid(), "Subset font loads");
+  check(info.glyphs_kept == charset.size() + 1, "Only requested glyphs kept");
+  check(info.glyphs_total > info.glyphs_kept, "Source has more glyphs");
+  check(info.missing == 0, "No requested glyph is missing");
+  check(info.bytes_saved() > 0 && info.subset_bytes < info.source_bytes,
+        "Subset is smaller than the source");
+
+  bool all_same = true;
+  for (char32_t cp : charset) {
+    all_same = all_same && same_glyph(full.raw(), subset.raw(), cp, 0);
+  }
+  check(all_same, "Kept glyphs render identically");
+
+  // "AV", "To" and "V." are kerned in Montserrat.
+  check(same_glyph(full.raw(), subset.raw(), 'A', 'V') &&
+            same_glyph(full.raw(), subset.raw(), 'T', 'o') &&
+            same_glyph(full.raw(), subset.raw(), 'V', '.'),
+        "Kerning survives renumbering");
+
+  lv_font_glyph_dsc_t g{};
+  check(!lv_font_get_glyph_dsc(subset.raw(), &g, 'x', 0) &&
+            lv_font_get_glyph_dsc(full.raw(), &g, 'x', 0),
+        "Dropped glyphs are absent from the subset");
+
+  check(lv_font_get_line_height(subset.raw()) ==
+            lv_font_get_line_height(full.raw()),
+        "Line metrics are preserved");
+}
+
+void test_sparse_and_missing() {
+  // Scattered code points, including a symbol from the private use area and
+  // one the font does not have.
+  const std::u32string_view charset = U"z!\U0000F00C\U00004E2D";
+  lvgl::OwnedFont::SubsetInfo info;
+  lvgl::OwnedFont subset =
+      lvgl::OwnedFont::load_bin_subset(kFontPath, charset, &info);
+  check(subset.is_valid(), "Sparse subset loads");
+  check(info.missing == 1 && info.glyphs_kept == 4,
+        "Missing code points are reported");
+
+  lvgl::OwnedFont full = lvgl::OwnedFont::load_bin(kFontPath);
+  check(same_glyph(full.raw(), subset.raw(), 'z', 0) &&
+            same_glyph(full.raw(), subset.raw(), '!', 0) &&
+            same_glyph(full.raw(), subset.raw(), 0xF00C, 0),
+        "Sparse glyphs render identically");
+}
+
+void test_errors() {
+  std::vector<uint8_t> none =
+      lvgl::OwnedFont::subset_bin("A:no_such_font.bin", U"abc");
+  check(none.empty(), "Missing file yields no subset");
+  check(!lvgl::OwnedFont::load_bin_subset("A:no_such_font.bin", U"abc")
+             .is_valid(),
+        "Missing file yields an invalid font");
+}
+
+}  // namespace
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+
+  write_font_file();
+  test_subset_matches_full();
+  test_sparse_and_missing();
+  test_errors();
+
+  std::remove("test_font_subset.bin");
+  std::cout << "All font subset tests passed." << std::endl;
+  return 0;
+}
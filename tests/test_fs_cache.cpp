@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../lvgl_cpp.h"
+#include "../misc/cached_file_system.h"
+
+// In-memory backing driver that simulates slow media and counts every call
+// that reaches it.
+class SlowMemoryDriver : public lvgl::FileSystemDriver {
+ public:
+  explicit SlowMemoryDriver(char letter) : FileSystemDriver(letter) {}
+
+  std::map<std::string, std::vector<uint8_t>> files;
+  uint32_t read_calls = 0;
+  uint64_t bytes_read = 0;
+
+ protected:
+  struct Handle {
+    std::vector<uint8_t>* data;
+    uint32_t pos;
+  };
+
+  void* open(const char* path, lvgl::FsMode mode) override {
+    if (mode == lvgl::FsMode::Write) {
+      files[path].clear();
+    } else if (files.find(path) == files.end()) {
+      return nullptr;
+    }
+    return new Handle{&files[path], 0};
+  }
+
+  lvgl::FsRes close(void* file) override {
+    delete static_cast<Handle*>(file);
+    return lvgl::FsRes::Ok;
+  }
+
+  lvgl::FsRes read(void* file, void* buf, uint32_t btr,
+                   uint32_t* br) override {
+    auto* h = static_cast<Handle*>(file);
+    read_calls++;
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    uint32_t size = static_cast<uint32_t>(h->data->size());
+    uint32_t n = h->pos < size ? std::min(btr, size - h->pos) : 0;
+    if (n > 0) std::memcpy(buf, h->data->data() + h->pos, n);
+    h->pos += n;
+    bytes_read += n;
+    if (br) *br = n;
+    return lvgl::FsRes::Ok;
+  }
+
+  lvgl::FsRes write(void* file, const void* buf, uint32_t btw,
+                    uint32_t* bw) override {
+    auto* h = static_cast<Handle*>(file);
+    if (h->data->size() < h->pos + btw) h->data->resize(h->pos + btw);
+    std::memcpy(h->data->data() + h->pos, buf, btw);
+    h->pos += btw;
+    if (bw) *bw = btw;
+    return lvgl::FsRes::Ok;
+  }
+
+  lvgl::FsRes seek(void* file, uint32_t pos, lvgl::FsWhence whence) override {
+    auto* h = static_cast<Handle*>(file);
+    if (whence == lvgl::FsWhence::Set) h->pos = pos;
+    if (whence == lvgl::FsWhence::Cur) h->pos += pos;
+    if (whence == lvgl::FsWhence::End) {
+      h->pos = static_cast<uint32_t>(h->data->size()) + pos;
+    }
+    return lvgl::FsRes::Ok;
+  }
+
+  lvgl::FsRes tell(void* file, uint32_t* pos) override {
+    *pos = static_cast<Handle*>(file)->pos;
+    return lvgl::FsRes::Ok;
+  }
+};
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static std::vector<uint8_t> make_pattern(size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(i * 31 + 7);
+  return data;
+}
+
+void test_sequential_small_reads(SlowMemoryDriver& backing) {
+  std::cout << "Testing sequential small reads..." << std::endl;
+  backing.files["font.bin"] = make_pattern(64 * 1024);
+  backing.read_calls = 0;
+
+  lvgl::CachedFileSystem cache('C', 'M');
+  lvgl::File f("C:font.bin", lvgl::FsMode::Read);
+  if (!f.is_open()) fail("could not open through cache");
+
+  // Font loaders read a handful of bytes at a time.
+  std::vector<uint8_t> out;
+  uint8_t buf[7];
+  uint32_t br = 0;
+  do {
+    if (f.read(buf, sizeof(buf), &br) != lvgl::FsRes::Ok) fail("read failed");
+    out.insert(out.end(), buf, buf + br);
+  } while (br == sizeof(buf));
+
+  if (out != backing.files["font.bin"]) fail("cached data differs");
+
+  // 16 blocks of 4 KiB; read-ahead fetches five blocks per backing read.
+  if (backing.read_calls > 5) {
+    fail("too many backing reads: " + std::to_string(backing.read_calls));
+  }
+  const auto& stats = cache.get_stats();
+  if (stats.read_ahead_blocks == 0) fail("read-ahead never triggered");
+  if (stats.hit_rate() < 0.99f) fail("hit rate too low");
+  std::cout << "PASS: " << out.size() << " bytes in " << backing.read_calls
+            << " backing reads, hit rate " << stats.hit_rate() << std::endl;
+}
+
+void test_reopen_hits_cache(SlowMemoryDriver& backing) {
+  std::cout << "Testing reopen served from cache..." << std::endl;
+  backing.files["icon.bin"] = make_pattern(10000);
+
+  lvgl::CachedFileSystem cache('C', 'M');
+  std::vector<uint8_t> first = lvgl::File::load_to_buffer("C:icon.bin");
+  uint32_t calls_after_first = backing.read_calls;
+  std::vector<uint8_t> second = lvgl::File::load_to_buffer("C:icon.bin");
+
+  if (first != backing.files["icon.bin"] || second != first) {
+    fail("reloaded data differs");
+  }
+  if (backing.read_calls != calls_after_first) {
+    fail("second load reached the backing driver");
+  }
+  std::cout << "PASS: second load fully cached." << std::endl;
+}
+
+void test_lru_eviction(SlowMemoryDriver& backing) {
+  std::cout << "Testing LRU eviction..." << std::endl;
+  backing.files["big.bin"] = make_pattern(8 * 1024);
+
+  lvgl::CachedFileSystem::Config config;
+  config.block_size = 1024;
+  config.max_blocks = 4;
+  config.read_ahead_blocks = 0;
+  lvgl::CachedFileSystem cache('C', 'M', config);
+
+  lvgl::File f("C:big.bin", lvgl::FsMode::Read);
+  uint8_t byte;
+  // Touch blocks 0..5 in random-access order; only the last four survive.
+  for (uint32_t block : {0u, 2u, 1u, 3u, 4u, 5u}) {
+    f.seek(block * 1024, lvgl::FsWhence::Set);
+    f.read(&byte, 1);
+  }
+  if (cache.get_stats().evictions != 2) fail("expected two evictions");
+
+  uint32_t calls = backing.read_calls;
+  f.seek(3 * 1024, lvgl::FsWhence::Set);
+  f.read(&byte, 1);
+  if (backing.read_calls != calls) fail("block 3 should still be cached");
+
+  f.seek(0, lvgl::FsWhence::Set);
+  f.read(&byte, 1);
+  if (backing.read_calls != calls + 1) fail("block 0 should have been evicted");
+  if (byte != backing.files["big.bin"][0]) fail("wrong data after reload");
+  std::cout << "PASS: least recently used blocks evicted." << std::endl;
+}
+
+void test_write_invalidates(SlowMemoryDriver& backing) {
+  std::cout << "Testing write-through invalidation..." << std::endl;
+  backing.files["cfg.bin"] = make_pattern(2048);
+
+  lvgl::CachedFileSystem cache('C', 'M');
+  lvgl::File::load_to_buffer("C:cfg.bin");  // Populate the cache.
+
+  {
+    lvgl::File f("C:cfg.bin", lvgl::FsMode::Write);
+    const char* text = "updated";
+    f.write(text, static_cast<uint32_t>(std::strlen(text)));
+  }
+
+  std::vector<uint8_t> after = lvgl::File::load_to_buffer("C:cfg.bin");
+  if (std::string(after.begin(), after.end()) != "updated") {
+    fail("stale data served after write");
+  }
+  std::cout << "PASS: writes invalidate cached blocks." << std::endl;
+}
+
+void test_paths_forgotten(SlowMemoryDriver& backing) {
+  std::cout << "Testing bounded path tracking..." << std::endl;
+  lvgl::CachedFileSystem::Config config;
+  config.block_size = 1024;
+  config.max_blocks = 4;
+  config.read_ahead_blocks = 0;
+  lvgl::CachedFileSystem cache('C', 'M', config);
+
+  // Like a device writing one log per boot: only cached paths are kept.
+  for (int i = 0; i < 20; ++i) {
+    std::string name = "log_" + std::to_string(i) + ".txt";
+    backing.files[name] = make_pattern(100);
+    lvgl::File::load_to_buffer("C:" + name);
+  }
+  if (cache.get_path_count() != 4) fail("evicted paths were kept");
+
+  cache.invalidate("log_19.txt");
+  if (cache.get_path_count() != 3) fail("invalidated path was kept");
+
+  {
+    lvgl::File f("C:log_0.txt", lvgl::FsMode::Read);
+    cache.invalidate();
+    if (cache.get_path_count() != 1) fail("open file lost its path");
+  }
+  if (cache.get_path_count() != 0) fail("closed file kept its path");
+  std::cout << "PASS: paths are forgotten with their blocks." << std::endl;
+}
+
+void test_detach() {
+  std::cout << "Testing detach on destruction..." << std::endl;
+  {
+    lvgl::CachedFileSystem cache('D', 'M');
+    if (!lvgl::FileSystem::is_ready('D')) fail("cache should be ready");
+  }
+  if (lvgl::FileSystem::is_ready('D')) fail("destroyed cache still ready");
+  lvgl::File f("D:font.bin", lvgl::FsMode::Read);
+  if (f.is_open()) fail("destroyed cache still opens files");
+  std::cout << "PASS: destroyed driver is detached." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+
+  SlowMemoryDriver backing('M');
+  test_sequential_small_reads(backing);
+  test_reopen_hits_cache(backing);
+  test_lru_eviction(backing);
+  test_write_invalidates(backing);
+  test_paths_forgotten(backing);
+  test_detach();
+
+  std::cout << "All filesystem cache tests passed." << std::endl;
+  return 0;
+}
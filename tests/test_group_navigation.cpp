@@ -0,0 +1,164 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../core/focus_graph.h"
+#include "../core/group.h"
+#include "../lvgl_cpp.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+namespace {
+
+constexpr int kSide = 10;
+
+// A 10 x 10 grid of 60 x 40 buttons on a 70 x 50 pitch. The panel is
+// shorter than the grid, so it scrolls.
+struct Grid {
+  lvgl::Object panel;
+  lvgl::Group group;
+  std::vector<lv_obj_t*> cells;
+
+  explicit Grid(lvgl::Object& screen) : panel(&screen) {
+    panel.set_pos(0, 0).set_size(800, 480);
+    lv_obj_set_style_pad_all(panel.raw(), 0, 0);
+    group.set_wrap(false);
+    for (int i = 0; i < kSide * kSide; ++i) {
+      lv_obj_t* button = lv_button_create(panel.raw());
+      lv_obj_set_pos(button, (i % kSide) * 70, (i / kSide) * 50);
+      lv_obj_set_size(button, 60, 40);
+      group.add_obj(button);
+      cells.push_back(button);
+    }
+    lv_obj_update_layout(panel.raw());
+  }
+
+  lv_obj_t* at(int row, int col) const { return cells[row * kSide + col]; }
+};
+
+void expect(lvgl::Group& group, lv_obj_t* obj, const std::string& what) {
+  if (group.get_focused() != obj) fail(what);
+}
+
+}  // namespace
+
+void test_grid_navigation(lvgl::Object& screen) {
+  std::cout << "Testing grid navigation..." << std::endl;
+  Grid grid(screen);
+  lvgl::Group& group = grid.group;
+  group.focus_obj(grid.at(0, 0));
+
+  for (int i = 0; i < 3; ++i) group.focus_direction(lvgl::Dir::Right);
+  expect(group, grid.at(0, 3), "right moved along the row");
+  group.focus_direction(lvgl::Dir::Bottom);
+  group.focus_direction(lvgl::Dir::Bottom);
+  expect(group, grid.at(2, 3), "down moved along the column");
+  group.focus_direction(lvgl::Dir::Left);
+  expect(group, grid.at(2, 2), "left moved back");
+  group.focus_obj(grid.at(0, 5));
+  if (group.focus_direction(lvgl::Dir::Top)) fail("moved past the top edge");
+  if (group.focus_direction(lvgl::Dir::Hor)) fail("combined dir accepted");
+
+  // Misaligned rows still pick the cell that overlaps the current row.
+  lv_obj_set_y(grid.at(4, 6), 4 * 50 + 20);
+  lv_obj_update_layout(grid.panel.raw());
+  group.focus_obj(grid.at(4, 5));
+  group.focus_direction(lvgl::Dir::Right);
+  expect(group, grid.at(4, 6), "shifted neighbor not chosen");
+  std::cout << "PASS: Directional moves follow the grid." << std::endl;
+}
+
+void test_incremental_updates(lvgl::Object& screen) {
+  std::cout << "Testing incremental updates..." << std::endl;
+  Grid grid(screen);
+  lvgl::Group& group = grid.group;
+  lvgl::FocusGraph& graph = group.get_focus_graph();
+  group.focus_obj(grid.at(2, 0));
+  for (int i = 0; i < kSide - 1; ++i) group.focus_direction(lvgl::Dir::Right);
+  expect(group, grid.at(2, 9), "row walk failed");
+  if (group.focus_direction(lvgl::Dir::Right)) fail("moved past the row end");
+  size_t edges = graph.get_edge_count();
+  if (edges < kSide) fail("edges not cached");
+
+  // Moving a member away only drops the edges that pointed to it.
+  lv_obj_set_pos(grid.at(2, 4), 0, 520);
+  lv_obj_update_layout(grid.panel.raw());
+  group.focus_obj(grid.at(2, 3));
+  group.focus_direction(lvgl::Dir::Right);
+  expect(group, grid.at(2, 5), "moved member still chosen");
+  if (graph.get_edge_count() + 3 < edges) fail("a move dropped every edge");
+
+  // A new member takes over the edges it now wins.
+  lv_obj_t* extra = lv_button_create(grid.panel.raw());
+  lv_obj_set_pos(extra, 700, 100);
+  lv_obj_set_size(extra, 60, 40);
+  lv_obj_update_layout(grid.panel.raw());
+  group.add_obj(extra);
+  group.focus_obj(grid.at(2, 9));
+  if (!group.focus_direction(lvgl::Dir::Right)) fail("added member missed");
+  expect(group, extra, "added member not focused");
+  group.focus_direction(lvgl::Dir::Left);
+  group.remove_obj(extra);
+  if (group.focus_direction(lvgl::Dir::Right)) fail("removed member kept");
+
+  // Deleted and hidden members are skipped.
+  lv_obj_delete(grid.at(2, 8));
+  group.focus_direction(lvgl::Dir::Left);
+  expect(group, grid.at(2, 7), "deleted member chosen");
+  lv_obj_add_flag(grid.at(2, 6), LV_OBJ_FLAG_HIDDEN);
+  group.focus_direction(lvgl::Dir::Left);
+  expect(group, grid.at(2, 5), "hidden member chosen");
+  lv_obj_delete(extra);
+  std::cout << "PASS: Moves, additions and removals update the graph."
+            << std::endl;
+}
+
+void test_scroll_and_wrap(lvgl::Object& screen) {
+  std::cout << "Testing scrolling and wrap..." << std::endl;
+  Grid grid(screen);
+  lvgl::Group& group = grid.group;
+  lvgl::FocusGraph& graph = group.get_focus_graph();
+  group.focus_obj(grid.at(5, 5));
+  group.focus_direction(lvgl::Dir::Bottom);
+  group.focus_direction(lvgl::Dir::Top);
+  size_t edges = graph.get_edge_count();
+
+  // Scrolling shifts every member alike, which keeps the edges.
+  lv_obj_scroll_to_y(grid.panel.raw(), 10, LV_ANIM_OFF);
+  lv_obj_update_layout(grid.panel.raw());
+  group.focus_direction(lvgl::Dir::Bottom);
+  expect(group, grid.at(6, 5), "navigation wrong after scrolling");
+  if (graph.get_edge_count() < edges) fail("scrolling dropped edges");
+
+  group.set_wrap(true);
+  group.focus_obj(grid.at(3, 0));
+  group.focus_direction(lvgl::Dir::Left);
+  expect(group, grid.at(3, 9), "left did not wrap to the row end");
+  group.focus_obj(grid.at(9, 2));
+  group.focus_direction(lvgl::Dir::Bottom);
+  expect(group, grid.at(0, 2), "down did not wrap to the column top");
+
+  // The graph follows the group through a move.
+  lvgl::Group moved(std::move(grid.group));
+  moved.focus_direction(lvgl::Dir::Right);
+  expect(moved, grid.at(0, 3), "moved group lost navigation");
+  std::cout << "PASS: Scrolling keeps edges; wrap reaches the far end."
+            << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_grid_navigation(screen);
+  test_incremental_updates(screen);
+  test_scroll_and_wrap(screen);
+
+  std::cout << "All group navigation tests passed." << std::endl;
+  return 0;
+}
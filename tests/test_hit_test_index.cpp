@@ -0,0 +1,183 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../core/hit_test_index.h"
+#include "../indev/pointer_input.h"
+#include "../lvgl_cpp.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+namespace {
+
+struct Touch {
+  int32_t x = 0;
+  int32_t y = 0;
+  bool pressed = false;
+};
+
+Touch touch;
+
+void frames(int count) {
+  for (int i = 0; i < count; ++i) {
+    lv_tick_inc(LV_DEF_REFR_PERIOD);
+    lv_timer_handler();
+  }
+}
+
+void tap(int32_t x, int32_t y) {
+  touch = {x, y, true};
+  frames(2);
+  touch.pressed = false;
+  frames(2);
+}
+
+}  // namespace
+
+void test_lookup(lvgl::Object& screen) {
+  std::cout << "Testing grid lookup..." << std::endl;
+  lvgl::Object map(&screen);
+  map.set_pos(0, 0).set_size(800, 480);
+  lv_obj_set_style_pad_all(map.raw(), 0, 0);
+  lvgl::HitTestIndex index(map, 32);
+  // 40 x 40 children on a 20 px pitch: the content scrolls vertically.
+  std::vector<lv_obj_t*> children;
+  for (int i = 0; i < 1600; ++i) {
+    lv_obj_t* child = lv_obj_create(map.raw());
+    lv_obj_remove_style_all(child);
+    lv_obj_set_pos(child, (i % 40) * 20, (i / 40) * 20);
+    lv_obj_set_size(child, 16, 16);
+    children.push_back(child);
+  }
+  lv_obj_update_layout(map.raw());
+  if (index.get_item_count() != children.size()) fail("children not indexed");
+
+  for (int i = 0; i < 24 * 40; i += 7) {
+    lv_point_t inside = {(i % 40) * 20 + 8, (i / 40) * 20 + 8};
+    if (index.hit_test(inside) != children[i]) fail("child not found");
+  }
+  if (index.hit_test({18, 18}) != nullptr) fail("gap should hit nothing");
+
+  // Moving a child re-indexes it.
+  lv_obj_set_pos(children[0], 790, 5);
+  lv_obj_update_layout(map.raw());
+  if (index.hit_test({8, 8}) != nullptr) fail("old position still hit");
+  if (index.hit_test({795, 10}) != children[0]) fail("new position missed");
+
+  // Entries are in content coordinates, so scrolling needs no update.
+  lv_obj_scroll_to_y(map.raw(), 100, LV_ANIM_OFF);
+  lv_obj_update_layout(map.raw());
+  if (index.hit_test({48, 8}) != children[40 * 5 + 2]) {
+    fail("lookup wrong after scrolling");
+  }
+  lv_obj_scroll_to_y(map.raw(), 0, LV_ANIM_OFF);
+
+  // Later siblings are on top; hidden ones are skipped.
+  lv_obj_t* overlay = lv_obj_create(map.raw());
+  lv_obj_remove_style_all(overlay);
+  lv_obj_set_pos(overlay, 40, 40);
+  lv_obj_set_size(overlay, 40, 40);
+  lv_obj_update_layout(map.raw());
+  if (index.hit_test({48, 48}) != overlay) fail("overlap z-order wrong");
+  lv_obj_add_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+  if (index.hit_test({48, 48}) != children[40 * 2 + 2]) {
+    fail("hidden child was hit");
+  }
+
+  // Descendants of an indexed child are found like LVGL would.
+  lv_obj_t* inner = lv_obj_create(children[100]);
+  lv_obj_remove_style_all(inner);
+  lv_obj_set_size(inner, 4, 4);
+  lv_obj_update_layout(map.raw());
+  lv_area_t coords;
+  lv_obj_get_coords(inner, &coords);
+  if (index.hit_test({coords.x1 + 1, coords.y1 + 1}) != inner) {
+    fail("descendant not found");
+  }
+
+  size_t before = index.get_item_count();
+  lv_obj_delete(children[41]);
+  if (index.hit_test({28, 28}) != nullptr) fail("deleted child still hit");
+  if (index.get_item_count() != before - 1) fail("deleted child indexed");
+  std::cout << "PASS: Lookup tracks moves, scrolling and deletes."
+            << std::endl;
+}
+
+void test_routing(lvgl::Object& screen) {
+  std::cout << "Testing pointer routing..." << std::endl;
+  lvgl::Object map(&screen);
+  map.set_pos(0, 0).set_size(800, 480);
+  lv_obj_set_style_pad_all(map.raw(), 0, 0);
+  lvgl::HitTestIndex index(map);
+
+  int map_clicks = 0;
+  map.add_event_cb(lvgl::EventCode::Clicked,
+                   [&map_clicks](lvgl::Event&) { ++map_clicks; });
+  lvgl::Button target(map);
+  target.set_pos(100, 100).set_size(60, 40);
+  lvgl::Button other(map);
+  other.set_pos(300, 100).set_size(60, 40);
+  int target_clicks = 0;
+  bool pressed_seen = false;
+  target.add_event_cb(lvgl::EventCode::Pressed, [&](lvgl::Event&) {
+    pressed_seen = lv_obj_has_state(target.raw(), LV_STATE_PRESSED);
+  });
+  target.add_event_cb(lvgl::EventCode::Clicked,
+                      [&target_clicks](lvgl::Event&) { ++target_clicks; });
+  frames(2);
+  if (lv_obj_get_index(index.get_router()) !=
+      static_cast<int32_t>(lv_obj_get_child_count(map.raw())) - 1) {
+    fail("router not moved on top of new children");
+  }
+
+  tap(120, 120);
+  if (target_clicks != 1) fail("click not routed to the child");
+  if (!pressed_seen) fail("pressed state not mirrored");
+  if (lv_obj_has_state(target.raw(), LV_STATE_PRESSED)) {
+    fail("pressed state left behind");
+  }
+  if (map_clicks != 0) fail("routed click also reached the container");
+
+  tap(600, 400);
+  if (map_clicks != 1 || target_clicks != 1) {
+    fail("click on empty space should reach the container");
+  }
+
+  // Clearing the container deletes the router too; it comes back.
+  lv_obj_clean(map.raw());
+  frames(1);
+  if (!index.get_router()) fail("router not recreated");
+  lvgl::Button late(map);
+  late.set_pos(10, 10).set_size(40, 40);
+  int late_clicks = 0;
+  late.add_event_cb(lvgl::EventCode::Clicked,
+                    [&late_clicks](lvgl::Event&) { ++late_clicks; });
+  frames(2);
+  tap(20, 20);
+  if (late_clicks != 1) fail("click after clean not routed");
+  if (index.get_item_count() != 1) fail("index not rebuilt after clean");
+  std::cout << "PASS: Presses are routed through the index." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  lvgl::PointerInput pointer = lvgl::PointerInput::create();
+  pointer.set_read_cb([](lvgl::IndevData& data) {
+    data.set_point(touch.x, touch.y)
+        .set_state(touch.pressed ? lvgl::IndevState::Pressed
+                                 : lvgl::IndevState::Released);
+  });
+
+  test_lookup(screen);
+  test_routing(screen);
+
+  std::cout << "All hit test index tests passed." << std::endl;
+  return 0;
+}
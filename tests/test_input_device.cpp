@@ -1,4 +1,5 @@
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -8,6 +9,7 @@
 #include "../indev/keypad_input.h"
 #include "../indev/pointer_input.h"
 #include "../lvgl_cpp.h"
+#include "src/indev/lv_indev_private.h"
 
 // Mock data to verify callback execution
 static bool callback_called = false;
@@ -116,6 +118,21 @@ void test_enhancements() {
   std::cout << "v9 Enhancements passed." << std::endl;
 }
 
+void test_gesture_config() {
+  std::cout << "Testing gesture config..." << std::endl;
+  auto ptr = lvgl::PointerInput::create();
+  ptr.gestures().config().min_velocity(7).limit(42);
+  lv_indev_t* indev = ptr.raw();
+  assert(indev->gesture_min_velocity == 7);
+  assert(indev->gesture_limit == 42);
+
+  // Values beyond LVGL's uint8_t fields saturate instead of wrapping.
+  ptr.gestures().config().min_velocity(300).limit(1000);
+  assert(indev->gesture_min_velocity == UINT8_MAX);
+  assert(indev->gesture_limit == UINT8_MAX);
+  std::cout << "Gesture config passed." << std::endl;
+}
+
 int main() {
   setup();
 
@@ -123,6 +140,7 @@ int main() {
   test_callback_dispatch();
   test_subclasses();
   test_enhancements();
+  test_gesture_config();
 
   std::cout << "All Input Device tests passed!" << std::endl;
   return 0;
@@ -0,0 +1,177 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../indev/input_recorder.h"
+#include "../indev/pointer_input.h"
+#include "../lvgl_cpp.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+namespace {
+
+struct Touch {
+  int32_t x = 0;
+  int32_t y = 0;
+  bool pressed = false;
+};
+
+Touch touch;
+
+void frames(int count) {
+  for (int i = 0; i < count; ++i) {
+    lv_tick_inc(LV_DEF_REFR_PERIOD);
+    lv_timer_handler();
+  }
+}
+
+void read_touch(lvgl::IndevData& data) {
+  data.set_point(touch.x, touch.y)
+      .set_state(touch.pressed ? lvgl::IndevState::Pressed
+                               : lvgl::IndevState::Released);
+}
+
+}  // namespace
+
+void test_encoding() {
+  std::cout << "Testing recording file format..." << std::endl;
+  std::vector<lvgl::InputRecord> records = {
+      {0, 10, 20, 0, 0, lvgl::IndevState::Released},
+      {33, 10, 20, 0, 0, lvgl::IndevState::Pressed},
+      {40, -5, 300, 0, 0, lvgl::IndevState::Pressed},
+      {70000, -5, 300, 0x1F600, 0, lvgl::IndevState::Released},
+      {70001, -5, 300, 0x1F600, -3, lvgl::IndevState::Released},
+  };
+  std::vector<uint8_t> bytes = lvgl::InputRecorder::encode(records);
+  std::vector<lvgl::InputRecord> decoded;
+  if (!lvgl::InputReplayer::decode(bytes, decoded) || decoded != records) {
+    fail("records did not round-trip");
+  }
+  bytes[0] = 'X';
+  if (lvgl::InputReplayer::decode(bytes, decoded)) fail("bad magic accepted");
+
+  lvgl::InputRecorder empty;
+  if (!lvgl::InputReplayer::decode(empty.encode(), decoded) ||
+      !decoded.empty()) {
+    fail("empty recording did not round-trip");
+  }
+  // A header claiming 2^32 - 1 records with no data behind it.
+  bytes = empty.encode();
+  bytes.pop_back();
+  bytes.insert(bytes.end(), {0xff, 0xff, 0xff, 0xff, 0x0f});
+  if (lvgl::InputReplayer::decode(bytes, decoded)) {
+    fail("impossible record count accepted");
+  }
+  std::cout << "PASS: Records round-trip through the file format."
+            << std::endl;
+}
+
+void test_record_and_replay(lvgl::Display& display, lvgl::Object& screen) {
+  std::cout << "Testing record and replay of a slider drag..." << std::endl;
+  lvgl::RamFileSystem ram('R');
+  lvgl::Slider slider(screen);
+  slider.set_pos(100, 200).set_size(400, 20);
+  slider.set_range(0, 100);
+
+  lvgl::PointerInput pointer = lvgl::PointerInput::create();
+  lvgl::InputRecorder recorder;
+  pointer.set_read_cb(recorder.wrap(read_touch));
+
+  recorder.start();
+  touch = {110, 210, false};
+  frames(3);
+  touch.pressed = true;
+  frames(2);
+  for (int x = 110; x <= 400; x += 10) {
+    touch.x = x;
+    frames(1);
+  }
+  touch.pressed = false;
+  frames(3);
+  recorder.stop();
+
+  int32_t recorded_value = slider.get_value();
+  if (recorded_value <= 0) fail("scripted drag did not move the slider");
+  const std::vector<lvgl::InputRecord>& records = recorder.get_records();
+  if (records.size() < 30) fail("drag was not recorded");
+  // Idle reads between changes are not stored.
+  if (records.size() > 40) fail("unchanged reads were recorded");
+
+  if (recorder.save("R:session.lvir") != lvgl::FsRes::Ok) {
+    fail("save failed");
+  }
+  std::vector<uint8_t> bytes = recorder.encode();
+  if (bytes.size() > records.size() * 4 + 8) fail("file is not compact");
+  std::vector<lvgl::InputRecord> decoded;
+  if (!lvgl::InputReplayer::decode(bytes, decoded) || decoded != records) {
+    fail("decode does not match the recording");
+  }
+  bytes.pop_back();
+  if (lvgl::InputReplayer::decode(bytes, decoded)) {
+    fail("truncated file was accepted");
+  }
+
+  lvgl::InputReplayer replayer;
+  if (replayer.load("R:missing.lvir")) fail("missing file loaded");
+  if (!replayer.load("R:session.lvir")) fail("load failed");
+  if (replayer.get_records() != records) fail("loaded records differ");
+  replayer.attach(pointer);
+
+  for (int run = 0; run < 2; ++run) {
+    slider.set_value(0);
+    frames(2);
+    lvgl::ReplayReport report = replayer.run(&display);
+    if (slider.get_value() != recorded_value) {
+      fail("replay " + std::to_string(run) + " ended at " +
+           std::to_string(slider.get_value()) + ", recorded " +
+           std::to_string(recorded_value));
+    }
+    if (!replayer.is_done()) fail("replay stopped early");
+    if (report.samples != records.size()) fail("samples were skipped");
+    if (report.frames == 0 || report.frame_time.count != report.frames) {
+      fail("no frames in the report");
+    }
+    if (report.virtual_ms < records.back().tick) fail("virtual time short");
+    std::cout << "  " << report.to_string() << std::endl;
+  }
+  std::cout << "PASS: Replay is deterministic and reports frames."
+            << std::endl;
+}
+
+void test_burst_delivery() {
+  std::cout << "Testing samples between reads..." << std::endl;
+  // Three samples within one frame period must all be delivered in order.
+  std::vector<lvgl::InputRecord> records = {
+      {1, 50, 50, 0, 0, lvgl::IndevState::Pressed},
+      {2, 60, 50, 0, 0, lvgl::IndevState::Pressed},
+      {3, 60, 50, 0, 0, lvgl::IndevState::Released},
+  };
+  lvgl::InputReplayer replayer(records);
+  lvgl::PointerInput pointer = lvgl::PointerInput::create();
+  replayer.attach(pointer);
+  lvgl::ReplayReport report = replayer.run(nullptr, LV_DEF_REFR_PERIOD, 0);
+  if (report.samples != 3) fail("burst samples were lost");
+  std::cout << "PASS: Bursts are delivered with continue_reading."
+            << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  display.auto_configure_buffers();
+  display.set_flush_cb([](lvgl::Display* disp, const lv_area_t*, uint8_t*) {
+    disp->flush_ready();
+  });
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_encoding();
+  test_record_and_replay(display, screen);
+  test_burst_delivery();
+
+  std::cout << "All input replay tests passed." << std::endl;
+  return 0;
+}
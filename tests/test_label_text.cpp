@@ -0,0 +1,123 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "../lvgl_cpp.h"
+#include "../widgets/label.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static void expect_text(const lvgl::Label& label, const char* expected) {
+  if (label.get_text() != expected) {
+    fail("expected \"" + std::string(expected) + "\", got \"" +
+         label.get_text() + "\"");
+  }
+}
+
+void test_change_detection(lvgl::Object& screen) {
+  std::cout << "Testing unchanged text is skipped..." << std::endl;
+  lvgl::Label label(screen);
+
+  // Static text makes a skipped update observable: a real one would
+  // replace the pointer with an LVGL copy.
+  static const char kStatic[] = "Ready";
+  label.set_text_static(kStatic);
+  label.set_text(std::string("Ready"));
+  if (lv_label_get_text(label.raw()) != kStatic) fail("string not skipped");
+  label.set_text("Ready");
+  if (lv_label_get_text(label.raw()) != kStatic) fail("char* not skipped");
+  label.set_text_fmt("%s", "Ready");
+  if (lv_label_get_text(label.raw()) != kStatic) fail("fmt not skipped");
+
+  label.set_text("Busy");
+  expect_text(label, "Busy");
+  if (lv_label_get_text(label.raw()) == kStatic) fail("change was skipped");
+
+  // Views need not be terminated.
+  std::string_view view("abcdef", 3);
+  label.set_text(view);
+  expect_text(label, "abc");
+
+  // nullptr still refreshes the current text.
+  label.set_text(static_cast<const char*>(nullptr));
+  expect_text(label, "abc");
+
+  // Long formatted text goes past the stack buffer.
+  std::string longer(300, 'x');
+  label.set_text_fmt("%s%d", longer.c_str(), 7);
+  if (label.get_text() != longer + "7") fail("long fmt text");
+  std::cout << "PASS: Unchanged text skipped." << std::endl;
+}
+
+void test_reserved_buffer(lvgl::Object& screen) {
+  std::cout << "Testing reserved text buffer..." << std::endl;
+  lvgl::Label label(screen, "keep");
+  if (label.get_text_capacity() != 0) fail("no buffer expected");
+
+  label.reserve_text(16);
+  if (label.get_text_capacity() != 16) fail("capacity not reserved");
+  expect_text(label, "keep");
+  const char* buf = lv_label_get_text(label.raw());
+
+  for (int i = 0; i < 100; ++i) label.set_text_fmt("value %d", i);
+  expect_text(label, "value 99");
+  if (lv_label_get_text(label.raw()) != buf) fail("buffer was replaced");
+
+  // Text beyond the capacity is handed to LVGL, shorter text comes back.
+  label.set_text("this text is longer than sixteen bytes");
+  expect_text(label, "this text is longer than sixteen bytes");
+  if (lv_label_get_text(label.raw()) == buf) fail("overflowed the buffer");
+  label.set_text("short");
+  if (lv_label_get_text(label.raw()) != buf) fail("buffer not reused");
+
+  // Another wrapper of the same object shares the buffer.
+  lvgl::Label view(label.raw(), lvgl::Object::Ownership::Unmanaged);
+  if (view.get_text_capacity() != 16) fail("buffer not found");
+  view.set_number(42);
+  if (lv_label_get_text(label.raw()) != buf) fail("view reallocated");
+
+  // Growing keeps the text and moves to a new buffer.
+  label.reserve_text(64);
+  if (label.get_text_capacity() != 64) fail("capacity not grown");
+  expect_text(label, "42");
+  label.reserve_text(8);
+  if (label.get_text_capacity() != 64) fail("capacity must not shrink");
+
+  // The buffer is released with the label.
+  lv_obj_delete(label.release());
+  std::cout << "PASS: Reserved buffer reused." << std::endl;
+}
+
+void test_set_number(lvgl::Object& screen) {
+  std::cout << "Testing set_number..." << std::endl;
+  lvgl::Label label(screen);
+  label.set_number(0);
+  expect_text(label, "0");
+  label.set_number(-1234, 2);
+  expect_text(label, "-12.34");
+  label.set_number(5, 3);
+  expect_text(label, "0.005");
+  label.set_number(100, 2);
+  expect_text(label, "1.00");
+  label.set_number(INT64_MIN);
+  expect_text(label, "-9223372036854775808");
+  std::cout << "PASS: set_number formats fixed-point values." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_change_detection(screen);
+  test_reserved_buffer(screen);
+  test_set_number(screen);
+
+  std::cout << "All label text tests passed." << std::endl;
+  return 0;
+}
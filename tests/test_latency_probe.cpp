@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../indev/pointer_input.h"
+#include "../lvgl_cpp.h"
+#include "../misc/latency_probe.h"
+#include "../misc/timer.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+namespace {
+
+constexpr auto kFlushTime = std::chrono::milliseconds(2);
+
+struct Touch {
+  int32_t x = 700;
+  int32_t y = 400;
+  bool pressed = false;
+};
+
+Touch touch;
+
+void frames(int count) {
+  for (int i = 0; i < count; ++i) {
+    lv_tick_inc(LV_DEF_REFR_PERIOD);
+    lv_timer_handler();
+  }
+}
+
+}  // namespace
+
+void test_histogram() {
+  std::cout << "Testing latency histogram..." << std::endl;
+  lvgl::LatencyStats stats;
+  for (int i = 0; i < 90; ++i) stats.add(700);  // Below 1 ms.
+  for (int i = 0; i < 10; ++i) stats.add(20000);
+  if (stats.count != 100 || stats.min_us != 700 || stats.max_us != 20000) {
+    fail("count or range wrong");
+  }
+  if (stats.get_mean_us() != 2630) fail("mean wrong");
+  if (stats.get_percentile_us(50) != 1000) fail("median bucket wrong");
+  if (stats.get_percentile_us(99) != 20000) fail("p99 should cap at max");
+  if (stats.buckets[1] != 90 || stats.buckets[6] != 10) fail("buckets wrong");
+  std::cout << "PASS: Histogram buckets and percentiles." << std::endl;
+}
+
+void test_input_to_flush(lvgl::Object& screen, lvgl::PointerInput& pointer) {
+  std::cout << "Testing input-to-flush latency..." << std::endl;
+  lvgl::LatencyProbe probe;
+  probe.attach(pointer);
+
+  lvgl::Button button(screen);
+  button.set_pos(100, 100).set_size(200, 100);
+  button.add_event_cb(lvgl::EventCode::Pressed, [](lvgl::Event& e) {
+    lv_obj_invalidate(static_cast<lv_obj_t*>(lv_event_get_target(e.raw())));
+  });
+  lvgl::Object spinner(&screen);
+  spinner.set_pos(600, 50).set_size(20, 20);
+  // Redraws unrelated to input must not be measured.
+  lvgl::Timer animation(LV_DEF_REFR_PERIOD, [&spinner](lvgl::Timer*) {
+    lv_obj_invalidate(spinner.raw());
+  });
+  frames(5);
+  if (probe.get_stats().count != 0) fail("idle reads were measured");
+  if (probe.get_pending() != 0) fail("idle reads left tags behind");
+
+  touch = {150, 150, true};
+  frames(3);
+  touch.pressed = false;
+  frames(3);
+  const lvgl::LatencyStats& stats = probe.get_stats();
+  if (stats.count == 0) fail("press was not measured");
+  if (stats.min_us < 2000) fail("latency should include the flush");
+  const lvgl::LatencyStats* per_button = probe.get_stats(button);
+  if (!per_button || per_button->count != stats.count) {
+    fail("latency not attributed to the button");
+  }
+  if (probe.get_pending() != 0) fail("flushed tags still pending");
+
+  uint64_t measured = stats.count;
+  probe.detach(pointer);
+  touch.pressed = true;
+  frames(3);
+  touch.pressed = false;
+  frames(3);
+  if (probe.get_stats().count != measured) fail("detached device measured");
+
+  lv_obj_delete(button.release());
+  if (!probe.get_widget_stats().empty()) fail("deleted widget kept stats");
+  std::cout << "PASS: Latency runs from read to the first flush."
+            << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  display.auto_configure_buffers();
+  display.set_flush_cb([](lvgl::Display* disp, const lv_area_t*, uint8_t*) {
+    std::this_thread::sleep_for(kFlushTime);
+    disp->flush_ready();
+  });
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  lvgl::PointerInput pointer = lvgl::PointerInput::create();
+  pointer.set_read_cb([](lvgl::IndevData& data) {
+    data.set_point(touch.x, touch.y)
+        .set_state(touch.pressed ? lvgl::IndevState::Pressed
+                                 : lvgl::IndevState::Released);
+  });
+
+  test_histogram();
+  test_input_to_flush(screen, pointer);
+
+  std::cout << "All latency probe tests passed." << std::endl;
+  return 0;
+}
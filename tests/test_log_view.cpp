@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../lvgl_cpp.h"
+#include "../misc/lockfree_queue.h"
+#include "../widgets/log_view.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+void test_queue() {
+  std::cout << "Testing LockFreeQueue..." << std::endl;
+  lvgl::LockFreeQueue<uint32_t> queue(5);
+  if (queue.capacity() != 8) fail("capacity not rounded up");
+  for (uint32_t i = 0; i < 8; ++i) {
+    if (!queue.try_push(i)) fail("push into free slot");
+  }
+  if (queue.try_push(99)) fail("push into full queue");
+  uint32_t value = 0;
+  for (uint32_t i = 0; i < 8; ++i) {
+    if (!queue.try_pop(value) || value != i) fail("FIFO order");
+  }
+  if (queue.try_pop(value)) fail("pop from empty queue");
+
+  // Four producers, one consumer: every value arrives exactly once.
+  constexpr uint32_t kPerThread = 20000;
+  lvgl::LockFreeQueue<uint32_t> shared(64);
+  std::vector<std::thread> producers;
+  for (uint32_t t = 0; t < 4; ++t) {
+    producers.emplace_back([&shared, t]() {
+      for (uint32_t i = 0; i < kPerThread; ++i) {
+        while (!shared.try_push(t * kPerThread + i)) std::this_thread::yield();
+      }
+    });
+  }
+  std::vector<uint8_t> seen(4 * kPerThread, 0);
+  std::vector<uint32_t> last(4, 0);
+  for (uint32_t received = 0; received < 4 * kPerThread;) {
+    if (!shared.try_pop(value)) continue;
+    if (seen[value]++) fail("duplicate value");
+    uint32_t t = value / kPerThread;
+    if (value % kPerThread < last[t]) fail("per-producer order");
+    last[t] = value % kPerThread;
+    ++received;
+  }
+  for (std::thread& thread : producers) thread.join();
+  std::cout << "PASS: Queue delivers each value once, in order."
+            << std::endl;
+}
+
+void test_ring(lvgl::Object& screen) {
+  std::cout << "Testing LogView ring buffer..." << std::endl;
+  lvgl::LogView log(screen);
+  log.set_size(300, 100);
+  log.set_capacity(50);
+  for (int i = 0; i < 120; ++i) log.append("line " + std::to_string(i));
+  if (log.get_line_count() != 50) fail("line count not capped");
+  if (log.get_evicted_count() != 70) fail("evicted count");
+  if (log.get_line(0) != "line 70") fail("oldest line");
+  if (log.get_line(49) != "line 119") fail("newest line");
+  if (!log.get_line(50).empty()) fail("line past the end");
+
+  // Long lines are cut, but never inside a UTF-8 sequence.
+  std::string long_line(lvgl::LogView::kMaxLineLength - 1, 'x');
+  log.append(long_line + "\xC3\xA9" + "tail");
+  if (log.get_line(49) != long_line) fail("truncation split a character");
+
+  log.clear();
+  if (log.get_line_count() != 0) fail("clear");
+  std::cout << "PASS: Ring keeps the last lines." << std::endl;
+}
+
+void test_follow(lvgl::Object& screen) {
+  std::cout << "Testing tail follow..." << std::endl;
+  lvgl::LogView log(screen);
+  log.set_size(300, 100);
+  for (int i = 0; i < 40; ++i) {
+    log.append("line", lvgl::LogView::Level::Warning);
+  }
+  lv_refr_now(nullptr);
+  if (!log.is_following()) fail("should follow by default");
+  if (lv_obj_get_scroll_bottom(log.raw()) > 0) fail("not at the tail");
+
+  // A user scroll away from the bottom stops following.
+  lv_obj_scroll_to_y(log.raw(), 0, LV_ANIM_OFF);
+  if (log.is_following()) fail("still following after scrolling up");
+  log.append("more");
+  if (lv_obj_get_scroll_y(log.raw()) != 0) fail("view jumped to the tail");
+
+  // Scrolling back to the bottom resumes it.
+  lv_obj_scroll_to_y(log.raw(), LV_COORD_MAX, LV_ANIM_OFF);
+  if (!log.is_following()) fail("not following at the bottom");
+  lv_refr_now(nullptr);
+  std::cout << "PASS: Follow tracks the tail." << std::endl;
+}
+
+void test_producer(lvgl::Object& screen) {
+  std::cout << "Testing cross-thread producer..." << std::endl;
+  auto log = std::make_unique<lvgl::LogView>(screen);
+  log->set_size(300, 100);
+  log->set_capacity(1000);
+  lvgl::LogView::Producer producer = log->get_producer(1024);
+
+  std::thread worker([producer]() mutable {
+    for (int i = 0; i < 500; ++i) {
+      producer.log("worker " + std::to_string(i),
+                   lvgl::LogView::Level::Error);
+    }
+  });
+  worker.join();
+  if (log->drain() != 500) fail("drain count");
+  if (log->get_line(499) != "worker 499") fail("drained order");
+  if (producer.get_dropped() != 0) fail("nothing should be dropped");
+
+  // A full queue drops instead of blocking.
+  lvgl::LogView small(screen);
+  lvgl::LogView::Producer tiny = small.get_producer(4);
+  for (int i = 0; i < 6; ++i) tiny.log("x");
+  if (tiny.get_dropped() != 2) fail("full queue did not drop");
+
+  // Producers outlive the view.
+  log.reset();
+  if (producer.log("late")) fail("log after delete should be dropped");
+  std::cout << "PASS: Producer feeds the view." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_queue();
+  test_ring(screen);
+  test_follow(screen);
+  test_producer(screen);
+
+  std::cout << "All log view tests passed." << std::endl;
+  return 0;
+}
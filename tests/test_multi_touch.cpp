@@ -0,0 +1,220 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../indev/multi_touch.h"
+#include "../lvgl_cpp.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+namespace {
+
+constexpr uint32_t kFrameMs = 10;
+constexpr float kPi = 3.14159265f;
+
+bool near(float value, float expected, float tolerance) {
+  return std::fabs(value - expected) <= tolerance;
+}
+
+// Two fingers on opposite sides of (cx, cy), `radius` apart from it at
+// `angle` degrees.
+void two_fingers(lvgl::TouchContact (&out)[2], float cx, float cy,
+                 float radius, float angle) {
+  float dx = radius * std::cos(angle * kPi / 180.0f);
+  float dy = radius * std::sin(angle * kPi / 180.0f);
+  out[0] = {1, static_cast<int32_t>(std::lround(cx + dx)),
+            static_cast<int32_t>(std::lround(cy + dy))};
+  out[1] = {2, static_cast<int32_t>(std::lround(cx - dx)),
+            static_cast<int32_t>(std::lround(cy - dy))};
+}
+
+struct Trace {
+  std::vector<lvgl::MultiTouchGesture> events;
+
+  void attach(lvgl::MultiTouchRecognizer& recognizer) {
+    events.clear();
+    recognizer.on_gesture(
+        [this](const lvgl::MultiTouchGesture& g) { events.push_back(g); });
+  }
+
+  void check_phases(const std::string& name) const {
+    if (events.size() < 3) fail(name + ": too few events");
+    if (events.front().phase != lvgl::MultiTouchPhase::Began) {
+      fail(name + ": first event is not Began");
+    }
+    if (events.back().phase != lvgl::MultiTouchPhase::Ended) {
+      fail(name + ": last event is not Ended");
+    }
+    for (size_t i = 1; i + 1 < events.size(); ++i) {
+      if (events[i].phase != lvgl::MultiTouchPhase::Changed) {
+        fail(name + ": middle event is not Changed");
+      }
+    }
+  }
+};
+
+// Moves two fingers from one pose to another over `frames` frames, then
+// lifts both.
+void play(lvgl::MultiTouchRecognizer& recognizer, uint32_t time, float cx0,
+          float cy0, float r0, float a0, float cx1, float cy1, float r1,
+          float a1, int frames) {
+  lvgl::TouchContact contacts[2];
+  for (int i = 0; i <= frames; ++i) {
+    float t = static_cast<float>(i) / frames;
+    two_fingers(contacts, cx0 + (cx1 - cx0) * t, cy0 + (cy1 - cy0) * t,
+                r0 + (r1 - r0) * t, a0 + (a1 - a0) * t);
+    recognizer.update(contacts, time);
+    time += kFrameMs;
+  }
+  recognizer.update({}, time);
+}
+
+}  // namespace
+
+void test_pinch(lvgl::Object& screen) {
+  std::cout << "Testing pinch..." << std::endl;
+  lvgl::Object photo(&screen);
+  photo.set_pos(200, 100).set_size(400, 280);
+  int received = 0;
+  float last_scale = 0;
+  photo.add_event_cb(lvgl::MultiTouchRecognizer::get_event_code(),
+                     [&](lvgl::Event& e) {
+                       const lvgl::MultiTouchGesture& g =
+                           lvgl::MultiTouchEvent(e).get_gesture();
+                       ++received;
+                       last_scale = g.scale;
+                     });
+
+  lvgl::MultiTouchRecognizer recognizer;
+  Trace trace;
+  trace.attach(recognizer);
+  play(recognizer, 0, 400, 240, 50, 0, 400, 240, 100, 0, 10);
+
+  trace.check_phases("pinch");
+  const lvgl::MultiTouchGesture& last = trace.events.back();
+  if (!last.pinch || last.rotate || last.pan) fail("pinch misclassified");
+  if (!near(last.scale, 2.0f, 0.05f)) fail("pinch scale wrong");
+  if (!near(last.rotation, 0, 1) || !near(last.pan_x, 0, 1)) {
+    fail("pinch drifted");
+  }
+  // 1.0 -> 2.0 over 100 ms.
+  if (!near(last.scale_velocity, 10.0f, 2.0f)) fail("scale velocity wrong");
+  if (last.contacts != 0) fail("Ended should report no contacts");
+  if (last.target != photo.raw()) fail("target is not under the centroid");
+  if (received != static_cast<int>(trace.events.size()) ||
+      last_scale != last.scale) {
+    fail("events not delivered to the object");
+  }
+  if (recognizer.is_active()) fail("still active after lift");
+  std::cout << "PASS: Pinch scale, velocity and target." << std::endl;
+}
+
+void test_rotate_and_pan() {
+  std::cout << "Testing rotate and two-finger pan..." << std::endl;
+  lvgl::MultiTouchRecognizer recognizer;
+  Trace trace;
+  trace.attach(recognizer);
+  // Crosses the atan2 seam at 180 degrees.
+  play(recognizer, 0, 400, 240, 80, 150, 400, 240, 80, 240, 18);
+  trace.check_phases("rotate");
+  const lvgl::MultiTouchGesture& turned = trace.events.back();
+  if (!turned.rotate || turned.pinch || turned.pan) {
+    fail("rotation misclassified");
+  }
+  if (!near(turned.rotation, 90, 2)) fail("rotation angle wrong");
+  if (turned.rotation_velocity < 400) fail("rotation velocity too low");
+
+  trace.events.clear();
+  play(recognizer, 1000, 300, 200, 60, 45, 360, 170, 60, 45, 6);
+  trace.check_phases("pan");
+  const lvgl::MultiTouchGesture& panned = trace.events.back();
+  if (!panned.pan || panned.pinch || panned.rotate) fail("pan misclassified");
+  if (!near(panned.pan_x, 60, 1) || !near(panned.pan_y, -30, 1)) {
+    fail("pan translation wrong");
+  }
+  if (!near(panned.pan_velocity_x, 1000, 100)) fail("pan velocity wrong");
+  std::cout << "PASS: Rotation and pan recognized separately." << std::endl;
+}
+
+void test_thresholds_and_contact_changes() {
+  std::cout << "Testing thresholds and joining fingers..." << std::endl;
+  lvgl::MultiTouchRecognizer recognizer;
+  Trace trace;
+  trace.attach(recognizer);
+  // Small jitter stays below every threshold.
+  play(recognizer, 0, 400, 240, 100, 0, 403, 242, 104, 2, 5);
+  if (!trace.events.empty()) fail("jitter was recognized");
+
+  // A third finger joining far away must not make the gesture jump.
+  lvgl::TouchContact contacts[3] = {{1, 300, 240}, {2, 500, 240}};
+  recognizer.update({contacts, 2}, 0);
+  contacts[0].x = 280;
+  contacts[1].x = 520;
+  recognizer.update({contacts, 2}, 10);
+  float scale = recognizer.get_gesture().scale;
+  contacts[2] = {3, 400, 50};
+  recognizer.update({contacts, 3}, 20);
+  if (recognizer.get_gesture().scale != scale ||
+      recognizer.get_gesture().pan_x != 0) {
+    fail("joining finger moved the gesture");
+  }
+  if (recognizer.get_gesture().contacts != 3) fail("contact count wrong");
+  recognizer.update({contacts + 1, 2}, 30);
+  if (recognizer.get_gesture().scale != scale) {
+    fail("lifting finger moved the gesture");
+  }
+  recognizer.cancel();
+  if (recognizer.is_active()) fail("cancel left the gesture active");
+  size_t before = trace.events.size();
+  recognizer.update({}, 40);
+  if (trace.events.size() != before) fail("cancelled gesture sent Ended");
+  std::cout << "PASS: Thresholds and contact changes." << std::endl;
+}
+
+void test_fixed_target(lvgl::Object& screen) {
+  std::cout << "Testing fixed and deleted targets..." << std::endl;
+  lvgl::Object* map = new lvgl::Object(&screen);
+  int received = 0;
+  map->add_event_cb(lvgl::MultiTouchRecognizer::get_event_code(),
+                    [&received](lvgl::Event&) { ++received; });
+  lvgl::MultiTouchRecognizer recognizer;
+  recognizer.set_target(map);
+  lvgl::MultiTouchConfig config;
+  config.pan_threshold = 4;
+  recognizer.set_config(config);
+  play(recognizer, 0, 100, 100, 30, 0, 110, 100, 30, 0, 4);
+  if (received == 0) fail("fixed target got no events");
+
+  Trace trace;
+  trace.attach(recognizer);
+  lvgl::TouchContact contacts[2];
+  two_fingers(contacts, 100, 100, 30, 0);
+  recognizer.update(contacts, 100);
+  two_fingers(contacts, 120, 100, 30, 0);
+  recognizer.update(contacts, 110);
+  delete map;
+  two_fingers(contacts, 140, 100, 30, 0);
+  recognizer.update(contacts, 120);
+  recognizer.update({}, 130);
+  if (trace.events.back().target != nullptr) fail("deleted target kept");
+  std::cout << "PASS: Deleted targets are not sent events." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_pinch(screen);
+  test_rotate_and_pan();
+  test_thresholds_and_contact_changes();
+  test_fixed_target(screen);
+
+  std::cout << "All multi-touch tests passed." << std::endl;
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "../lvgl_cpp.h"
+#include "../misc/spring_animator.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static void set_int(void* var, int32_t value) {
+  *static_cast<int32_t*>(var) = value;
+}
+
+void test_determinism() {
+  std::cout << "Testing determinism under variable ticks..." << std::endl;
+  int32_t steady = 0, jittery = 0;
+  lvgl::SpringAnimator a, b;
+  a.set_var(&steady).set_exec_cb(set_int).set_value(0).set_target(300);
+  b.set_var(&jittery).set_exec_cb(set_int).set_value(0).set_target(300);
+
+  // Same total time, cut into 16 ms frames for one and 1..7 ms for the
+  // other. Retarget both mid-flight at the same instant.
+  std::srand(7);
+  uint32_t time_a = 0, time_b = 0;
+  for (int frame = 0; frame < 60; ++frame) {
+    a.step(16);
+    time_a += 16;
+    while (time_b < time_a) {
+      uint32_t dt = std::min<uint32_t>(1 + std::rand() % 7, time_a - time_b);
+      b.step(dt);
+      time_b += dt;
+    }
+    if (steady != jittery || a.get_velocity() != b.get_velocity()) {
+      fail("tick interval changed the result");
+    }
+    if (frame == 10) {
+      float velocity = a.get_velocity();
+      a.set_target(-100);
+      b.set_target(-100);
+      if (a.get_velocity() != velocity) fail("retarget lost the velocity");
+    }
+  }
+  std::cout << "PASS: Same time, same motion." << std::endl;
+}
+
+void test_settle() {
+  std::cout << "Testing settle and fling..." << std::endl;
+  int32_t value = 0;
+  int completed = 0;
+  lvgl::SpringAnimator spring;
+  spring.set_var(&value).set_exec_cb(set_int).set_completed_cb(
+      [&completed]() { ++completed; });
+  spring.set_target(50);
+  for (int i = 0; i < 200 && spring.is_running(); ++i) spring.step(16);
+  if (spring.is_running()) fail("spring never came to rest");
+  if (value != 50 || completed != 1) fail("did not settle on the target");
+
+  // 1000 units/s with friction 4 coasts about 250 units.
+  spring.fling(1000.0f);
+  for (int i = 0; i < 500 && spring.is_running(); ++i) spring.step(16);
+  if (spring.is_running()) fail("fling never stopped");
+  if (value < 270 || value > 310) fail("fling distance");
+  if (spring.get_target() != value) fail("target not updated after fling");
+  std::cout << "PASS: Springs and flings come to rest." << std::endl;
+}
+
+void test_timer(lvgl::Object& screen) {
+  std::cout << "Testing timer drive..." << std::endl;
+  lvgl::Object obj(&screen);
+  lvgl::SpringAnimator spring;
+  spring.set_var(obj).set_exec_cb(lvgl::Animation::Exec::X());
+  spring.set_value(0).set_target(120);
+  for (int i = 0; i < 100 && spring.is_running(); ++i) {
+    lv_tick_inc(16);
+    lv_timer_handler();
+  }
+  if (spring.is_running()) fail("timer did not run the spring");
+  if (lv_obj_get_style_x(obj.raw(), LV_PART_MAIN) != 120) {
+    fail("object not at the target");
+  }
+  std::cout << "PASS: Timer runs the spring." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_determinism();
+  test_settle();
+  test_timer(screen);
+
+  std::cout << "All spring animator tests passed." << std::endl;
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../lvgl_cpp.h"
+#include "../misc/text_document.h"
+#include "../widgets/text_view.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static uint32_t count_lines(const std::string& text) {
+  uint32_t lines = 1;
+  for (char c : text) lines += c == '\n';
+  return lines;
+}
+
+void test_edits() {
+  std::cout << "Testing edits against std::string..." << std::endl;
+  std::string ref = "first\nsecond\n";
+  lvgl::TextDocument doc(ref);
+  std::mt19937 rng(1234);
+  for (int i = 0; i < 5000; ++i) {
+    size_t pos = rng() % (ref.size() + 1);
+    if (rng() % 3 == 0 && !ref.empty()) {
+      size_t len = rng() % 12;
+      doc.erase(pos, len);
+      if (pos < ref.size()) ref.erase(pos, len);
+    } else {
+      std::string text(rng() % 6, 'a' + static_cast<char>(i % 26));
+      if (rng() % 2) text += '\n';
+      // Favour typing runs at the end of the last insertion.
+      if (rng() % 4 == 0) pos = ref.size();
+      doc.insert(pos, text);
+      ref.insert(pos, text);
+    }
+    if (doc.size() != ref.size()) fail("size mismatch");
+    if (doc.line_count() != count_lines(ref)) fail("line count mismatch");
+  }
+  if (doc.get_text() != ref) fail("text mismatch");
+  if (doc.get_text(3, 10) != ref.substr(3, 10)) fail("range mismatch");
+  std::cout << "PASS: " << doc.get_piece_count() << " pieces match."
+            << std::endl;
+}
+
+void test_lines() {
+  std::cout << "Testing line mapping..." << std::endl;
+  lvgl::TextDocument doc("alpha\nbeta\n\ngamma");
+  doc.insert(doc.line_start(1), "pre-");
+  doc.append("\ndelta");
+  const char* expected[] = {"alpha", "pre-beta", "", "gamma", "delta"};
+  if (doc.line_count() != 5) fail("expected 5 lines");
+  for (uint32_t i = 0; i < 5; ++i) {
+    if (doc.get_line(i) != expected[i]) fail("line " + std::to_string(i));
+    if (doc.line_length(i) != std::string(expected[i]).size()) {
+      fail("line length " + std::to_string(i));
+    }
+    if (doc.line_of(doc.line_start(i)) != i) fail("line_of round trip");
+  }
+  if (doc.line_start(99) != doc.size()) fail("line_start past the end");
+  if (doc.line_of(doc.size()) != 4) fail("line_of at the end");
+
+  lvgl::TextDocument empty;
+  if (empty.line_count() != 1 || !empty.get_line(0).empty()) {
+    fail("empty document has one empty line");
+  }
+  std::cout << "PASS: Lines mapped." << std::endl;
+}
+
+void test_change_callback() {
+  std::cout << "Testing change callback..." << std::endl;
+  lvgl::TextDocument doc("a\nb\nc");
+  lvgl::TextDocument::Change last{};
+  doc.set_change_callback(
+      [&](const lvgl::TextDocument::Change& c) { last = c; });
+
+  doc.insert(doc.line_start(1), "x\ny\n");
+  if (last.first_line != 1 || last.removed_lines != 1 ||
+      last.added_lines != 3) {
+    fail("insert change");
+  }
+  doc.erase(0, doc.line_start(2));  // "a\nx\n"
+  if (last.first_line != 0 || last.removed_lines != 3 ||
+      last.added_lines != 1) {
+    fail("erase change");
+  }
+  doc.set_text("one");
+  if (last.first_line != 0 || last.added_lines != 1) fail("set_text change");
+  std::cout << "PASS: Changes reported in lines." << std::endl;
+}
+
+void test_view(lvgl::Object& screen) {
+  std::cout << "Testing TextView..." << std::endl;
+  std::string text;
+  for (int i = 0; i < 5000; ++i) text += "line " + std::to_string(i) + "\n";
+  lvgl::TextDocument doc(text);
+
+  lvgl::TextView view(screen);
+  view.set_size(200, 160);
+  view.set_document(&doc);
+  lv_refr_now(nullptr);
+
+  // Only the lines in view are measured and drawn.
+  lvgl::TextView::Stats stats = view.get_stats();
+  if (stats.lines_measured == 0 || stats.lines_measured > 20) {
+    fail("measured " + std::to_string(stats.lines_measured) + " lines");
+  }
+  if (stats.lines_drawn == 0 || stats.lines_drawn > 20) {
+    fail("drew " + std::to_string(stats.lines_drawn) + " lines");
+  }
+  if (view.get_row_count() != doc.line_count()) fail("row count");
+
+  // A long line wraps into several rows.
+  doc.insert(0, std::string(200, 'w') + " " + std::string(200, 'w') + "\n");
+  if (view.get_row_count() <= doc.line_count()) fail("long line not wrapped");
+
+  // Scrolling far measures only what comes into view.
+  view.reset_stats();
+  view.scroll_to_line(2500);
+  lv_refr_now(nullptr);
+  if (view.get_first_visible_line() != 2500) fail("scroll_to_line");
+  if (view.get_stats().lines_measured > 20) fail("scroll measured too much");
+
+  // Appends grow the view.
+  uint32_t rows = view.get_row_count();
+  doc.append("tail\n");
+  if (view.get_row_count() != rows + 1) fail("append not tracked");
+
+  // Deleting the view detaches it from the document.
+  lv_obj_delete(view.release());
+  doc.append("after\n");
+  std::cout << "PASS: TextView measures visible lines only." << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_edits();
+  test_lines();
+  test_change_callback();
+  test_view(screen);
+
+  std::cout << "All text document tests passed." << std::endl;
+  return 0;
+}
@@ -0,0 +1,129 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "../lvgl_cpp.h"
+#include "../misc/text_metrics_cache.h"
+#include "../widgets/label.h"
+#include "../widgets/span.h"
+#include "../widgets/table.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+static lv_point_t direct_size(const char* text, int32_t max_width) {
+  lv_point_t size;
+  lv_text_get_size(&size, text, LV_FONT_DEFAULT, 0, 0, max_width,
+                   LV_TEXT_FLAG_NONE);
+  return size;
+}
+
+void test_cache_hits_and_keys() {
+  std::cout << "Testing cache hits and key separation..." << std::endl;
+  lvgl::TextMetricsCache cache(8);
+
+  lvgl::Point a = cache.measure("12345", LV_FONT_DEFAULT, 0, 0);
+  lvgl::Point b = cache.measure("12345", LV_FONT_DEFAULT, 0, 0);
+  lv_point_t expected = direct_size("12345", LV_COORD_MAX);
+  if (a.x() != expected.x || a.y() != expected.y) fail("wrong size");
+  if (b.x() != a.x() || b.y() != a.y()) fail("cached size differs");
+  if (cache.get_stats().hits != 1 || cache.get_stats().misses != 1) {
+    fail("expected one hit and one miss");
+  }
+
+  // Any part of the key changing is a separate entry.
+  cache.measure("12345", LV_FONT_DEFAULT, 2, 0);
+  cache.measure("12345", LV_FONT_DEFAULT, 0, 0, 20);
+  cache.measure("12346", LV_FONT_DEFAULT, 0, 0);
+  if (cache.get_stats().misses != 4) fail("distinct keys should miss");
+
+  lvgl::Point wrapped = cache.measure("12345", LV_FONT_DEFAULT, 0, 0, 20);
+  if (wrapped.y() <= a.y()) fail("wrapped text should be taller");
+  std::cout << "PASS: hit rate " << cache.get_stats().hit_rate() << std::endl;
+}
+
+void test_lru_bound() {
+  std::cout << "Testing LRU bound..." << std::endl;
+  lvgl::TextMetricsCache cache(3);
+  cache.measure("a", LV_FONT_DEFAULT, 0, 0);
+  cache.measure("b", LV_FONT_DEFAULT, 0, 0);
+  cache.measure("c", LV_FONT_DEFAULT, 0, 0);
+  cache.measure("a", LV_FONT_DEFAULT, 0, 0);  // "b" is now oldest.
+  cache.measure("d", LV_FONT_DEFAULT, 0, 0);
+  if (cache.get_stats().entries != 3) fail("capacity not enforced");
+  if (cache.get_stats().evictions != 1) fail("expected one eviction");
+
+  cache.reset_stats();
+  cache.measure("a", LV_FONT_DEFAULT, 0, 0);
+  cache.measure("b", LV_FONT_DEFAULT, 0, 0);
+  if (cache.get_stats().hits != 1) fail("wrong entry evicted");
+
+  cache.set_capacity(1);
+  if (cache.get_stats().entries != 1) fail("shrinking did not evict");
+  std::cout << "PASS: least recently used text evicted." << std::endl;
+}
+
+void test_widget_integration(lvgl::Object& screen) {
+  std::cout << "Testing widget integration..." << std::endl;
+  lvgl::TextMetricsCache::set_enabled(true);
+  auto& cache = lvgl::TextMetricsCache::global();
+  cache.reset_stats();
+
+  lvgl::Label label(screen, "42.0 %");
+  lvgl::Point size = label.get_text_size();
+  lv_point_t expected = direct_size("42.0 %", LV_COORD_MAX);
+  if (size.x() != expected.x || size.y() != expected.y) {
+    fail("label size differs from lv_text_get_size");
+  }
+  label.get_text_size();
+  if (cache.get_stats().hits != 1) fail("label size not cached");
+
+  lvgl::Table table(screen);
+  table.set_row_count(3).set_column_count(1);
+  table.cell(0, 0).set_value("1");
+  table.cell(1, 0).set_value("1000");
+  table.cell(2, 0).set_value("1");
+
+  table.cell(0, 0).set_value("1");  // Identical: skipped.
+  if (std::strcmp(table.get_cell_value(0, 0), "1") != 0) {
+    fail("identical value lost");
+  }
+  table.set_cell_value_fmt(1, 0, "%d", 1001);
+  if (std::strcmp(table.get_cell_value(1, 0), "1001") != 0) {
+    fail("changed value not applied");
+  }
+
+  table.fit_column_width(0);
+  int32_t pad = lv_obj_get_style_pad_left(table.raw(), LV_PART_ITEMS) +
+                lv_obj_get_style_pad_right(table.raw(), LV_PART_ITEMS);
+  if (table.get_column_width(0) != direct_size("1001", LV_COORD_MAX).x + pad) {
+    fail("column not fitted to widest cell");
+  }
+
+  lvgl::SpanGroup group(screen);
+  lvgl::Span span = group.add_span();
+  span.set_text("span");
+  if (span.get_text_size().x() != direct_size("span", LV_COORD_MAX).x) {
+    fail("span size differs");
+  }
+
+  lvgl::TextMetricsCache::set_enabled(false);
+  if (cache.get_stats().entries != 0) fail("disabling should clear");
+  std::cout << "PASS: Label, Table and Span measure through the cache."
+            << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_cache_hits_and_keys();
+  test_lru_bound();
+  test_widget_integration(screen);
+
+  std::cout << "All text metrics tests passed." << std::endl;
+  return 0;
+}
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "../misc/timer.h"
+#include "../misc/timer_wheel.h"
 #include "../lvgl_cpp.h"
 
 // Variable to capture execution
@@ -109,12 +110,89 @@ void test_timer_raii() {
   }
 }
 
+void test_timer_wheel() {
+  std::cout << "Testing TimerWheel..." << std::endl;
+  lvgl::TimerWheel wheel;
+  if (wheel.get_next_deadline() != LV_NO_TIMER_READY) {
+    std::cerr << "FAIL: Empty wheel reports a deadline." << std::endl;
+    exit(1);
+  }
+
+  int fast = 0;
+  int limited = 0;
+  lvgl::Timer* seen = nullptr;
+  std::vector<lvgl::Timer> timers;
+  timers.reserve(2);
+  timers.emplace_back(wheel, 100, [&](lvgl::Timer* t) {
+    fast++;
+    seen = t;
+  });
+  timers.emplace_back(wheel, 30, [&limited](lvgl::Timer*) { limited++; });
+  timers[1].set_repeat_count(3);
+  if (timers[0].raw() != nullptr || wheel.size() != 2) {
+    std::cerr << "FAIL: Wheel timers should not own an lv_timer."
+              << std::endl;
+    exit(1);
+  }
+  if (wheel.get_next_deadline() != 30) {
+    std::cerr << "FAIL: Next deadline should be 30, got "
+              << wheel.get_next_deadline() << std::endl;
+    exit(1);
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    lv_tick_inc(10);
+    uint32_t idle = lv_timer_handler();
+    if (idle > wheel.get_next_deadline()) {
+      std::cerr << "FAIL: Handler would sleep past the wheel." << std::endl;
+      exit(1);
+    }
+  }
+  if (fast != 10 || seen != &timers[0]) {
+    std::cerr << "FAIL: Periodic wheel timer ran " << fast << " times."
+              << std::endl;
+    exit(1);
+  }
+  if (limited != 3) {
+    std::cerr << "FAIL: Repeat count not honoured (" << limited << ")."
+              << std::endl;
+    exit(1);
+  }
+
+  timers[0].pause();
+  for (int i = 0; i < 50; ++i) {
+    lv_tick_inc(10);
+    lv_timer_handler();
+  }
+  if (fast != 10) {
+    std::cerr << "FAIL: Paused wheel timer ran." << std::endl;
+    exit(1);
+  }
+  timers[0].resume();
+  timers[0].set_period(20);
+  lv_tick_inc(20);
+  lv_timer_handler();
+  if (fast != 11) {
+    std::cerr << "FAIL: Resumed wheel timer did not run." << std::endl;
+    exit(1);
+  }
+
+  timers.clear();
+  if (wheel.size() != 0 ||
+      wheel.get_next_deadline() != LV_NO_TIMER_READY) {
+    std::cerr << "FAIL: Destroyed timers left on the wheel." << std::endl;
+    exit(1);
+  }
+  std::cout << "PASS: TimerWheel drives Timers." << std::endl;
+}
+
 int main() {
   lv_init();
 
   test_timer_resume();
   test_timer_clear_resume();
   test_timer_raii();
+  test_timer_wheel();
 
   std::cout << "\nAll Timer tests passed!" << std::endl;
   return 0;
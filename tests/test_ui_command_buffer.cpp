@@ -0,0 +1,131 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../lvgl_cpp.h"
+#include "../misc/ui_command_buffer.h"
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+void test_coalescing(lvgl::Object& screen) {
+  std::cout << "Testing last-writer-wins coalescing..." << std::endl;
+  lvgl::UiCommandBuffer commands;
+  lvgl::Label label(screen);
+  lvgl::Bar bar(screen);
+  bar.set_range(0, 1000);
+  for (int i = 0; i < 1000; ++i) {
+    commands.post(label).set_text(std::to_string(i));
+    commands.post(bar).set_value(i);
+  }
+  commands.post(label).set_hidden(true).set_hidden(false);
+  if (std::strcmp(lv_label_get_text(label.raw()), "999") == 0) {
+    fail("recording should not touch the widget");
+  }
+  if (commands.flush() != 3) fail("expected one command per property");
+  if (std::strcmp(lv_label_get_text(label.raw()), "999") != 0) {
+    fail("label text is not the last value");
+  }
+  if (lv_bar_get_value(bar.raw()) != 999) fail("bar value is not the last");
+  if (lv_obj_has_flag(label.raw(), LV_OBJ_FLAG_HIDDEN)) {
+    fail("hidden flag is not the last value");
+  }
+  if (commands.get_recorded() != 2002) fail("recorded count");
+  if (commands.get_coalesced() != 1999) fail("coalesced count");
+  if (commands.flush() != 0) fail("flush should empty the buffer");
+  std::cout << "PASS: Only the last value of each property is applied."
+            << std::endl;
+}
+
+void test_replay_on_refresh(lvgl::Object& screen) {
+  std::cout << "Testing replay at display refresh..." << std::endl;
+  lvgl::UiCommandBuffer commands;
+  lvgl::Slider slider(screen);
+  commands.post(slider).set_value(42);
+  commands.post(slider).set_pos(5, 7);
+  lv_refr_now(nullptr);
+  if (lv_slider_get_value(slider.raw()) != 42) fail("value not replayed");
+  if (lv_obj_get_x(slider.raw()) != 5 || lv_obj_get_y(slider.raw()) != 7) {
+    fail("position not replayed");
+  }
+  std::cout << "PASS: Commands are replayed when a frame starts." << std::endl;
+}
+
+void test_producers(lvgl::Object& screen) {
+  std::cout << "Testing 16 producer threads..." << std::endl;
+  constexpr int kThreads = 16;
+  constexpr int kUpdates = 10000;
+  lvgl::UiCommandBuffer commands;
+  std::vector<lvgl::Label*> labels;
+  for (int i = 0; i < kThreads; ++i) labels.push_back(new lvgl::Label(screen));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&commands, &labels, t]() {
+      for (int i = 0; i < kUpdates; ++i) {
+        commands.post(*labels[t]).set_text(std::to_string(t * kUpdates + i));
+      }
+    });
+  }
+  // Replay while the producers are still recording.
+  for (int i = 0; i < 50; ++i) commands.flush();
+  for (std::thread& thread : threads) thread.join();
+  commands.flush();
+  for (int t = 0; t < kThreads; ++t) {
+    std::string expected = std::to_string(t * kUpdates + kUpdates - 1);
+    if (expected != lv_label_get_text(labels[t]->raw())) {
+      fail("a producer's last value was lost");
+    }
+    delete labels[t];
+  }
+  if (commands.get_recorded() != kThreads * kUpdates) fail("recorded count");
+  std::cout << "PASS: Each producer's last value wins." << std::endl;
+}
+
+void test_deleted_object(lvgl::Object& screen) {
+  std::cout << "Testing deleted objects..." << std::endl;
+  lvgl::UiCommandBuffer commands;
+  auto* tracked = new lvgl::Label(screen);
+  commands.track(*tracked);
+  commands.post(*tracked).set_text("gone");
+  delete tracked;
+
+  auto* untracked = new lvgl::Bar(screen);
+  commands.post(*untracked).set_value(10);
+  delete untracked;
+
+  if (commands.flush() != 0) fail("commands for deleted objects applied");
+  std::cout << "PASS: Commands for deleted objects are dropped." << std::endl;
+}
+
+void test_wrong_type(lvgl::Object& screen) {
+  std::cout << "Testing widget type checks..." << std::endl;
+  lvgl::UiCommandBuffer commands;
+  // As if the label had been freed and a bar allocated at its address.
+  lvgl::Bar bar(screen);
+  lvgl::Label alias(bar.raw(), lvgl::Object::Ownership::Unmanaged);
+  commands.post(alias).set_text("not a bar").set_pos(3, 4);
+  if (commands.flush() != 1) fail("text applied to a bar");
+  if (lv_obj_get_x(bar.raw()) != 3) fail("generic command not applied");
+  std::cout << "PASS: Widget commands skip objects of another class."
+            << std::endl;
+}
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+  test_coalescing(screen);
+  test_replay_on_refresh(screen);
+  test_producers(screen);
+  test_deleted_object(screen);
+  test_wrong_type(screen);
+
+  std::cout << "All UI command buffer tests passed." << std::endl;
+  return 0;
+}
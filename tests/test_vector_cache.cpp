@@ -0,0 +1,201 @@
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+#include "../draw/draw_buf.h"
+#include "../lvgl_cpp.h"
+#include "../misc/vector_cache.h"
+
+#if LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
+
+static void fail(const std::string& msg) {
+  std::cerr << "FAIL: " << msg << std::endl;
+  exit(1);
+}
+
+namespace {
+
+constexpr lv_color32_t kBlue = {0xff, 0x40, 0x20, 0xff};  // B, G, R, A
+
+void make_icon(lvgl::VectorPath& path) {
+  path.clear();
+  path.append_rect(0, 0, 16, 16, 3, 3);
+}
+
+// Draws `icon` once per position through `cache` onto `canvas`.
+void draw_icons(lvgl::Canvas& canvas, lvgl::VectorCache& cache,
+                const lvgl::VectorPath& icon,
+                std::initializer_list<lv_fpoint_t> positions) {
+  lv_layer_t layer;
+  canvas.init_layer(&layer);
+  {
+    lvgl::VectorDraw draw(&layer, cache);
+    draw.set_fill_color(kBlue);
+    for (lv_fpoint_t p : positions) {
+      draw.identity();
+      draw.translate(p.x, p.y);
+      draw.add_path(icon);
+      draw.draw();
+    }
+  }
+  canvas.finish_layer(&layer);
+  cache.next_frame();
+}
+
+}  // namespace
+
+void test_path_hash() {
+  std::cout << "Testing path hashes..." << std::endl;
+  lvgl::VectorPath a;
+  lvgl::VectorPath b;
+  if (a.get_hash() != b.get_hash()) fail("empty paths differ");
+  make_icon(a);
+  make_icon(b);
+  if (a.get_hash() != b.get_hash()) fail("equal paths differ");
+  uint64_t icon = a.get_hash();
+
+  b.line_to(4, 4);
+  if (b.get_hash() == icon) fail("line_to not hashed");
+  make_icon(b);
+  if (b.get_hash() != icon) fail("clear did not reset the hash");
+  lv_matrix_t m;
+  lv_matrix_identity(&m);
+  lv_matrix_scale(&m, 2, 2);
+  b.transform(m);
+  if (b.get_hash() == icon) fail("transform not hashed");
+
+  lvgl::VectorPath c;
+  c.copy_from(a);
+  if (c.get_hash() != icon) fail("copy_from lost the hash");
+  lvgl::VectorPath d(std::move(c));
+  if (d.get_hash() != icon) fail("move lost the hash");
+  std::cout << "PASS: Paths hash by their building calls." << std::endl;
+}
+
+void test_cache_reuse(lvgl::Canvas& canvas) {
+  std::cout << "Testing cache reuse..." << std::endl;
+  lvgl::VectorCache cache(64 * 1024, nullptr);
+  lvgl::VectorPath icon;
+  make_icon(icon);
+
+  draw_icons(canvas, cache, icon, {{10, 10}, {50, 10}, {90, 40}});
+  const auto& stats = cache.get_stats();
+  if (stats.misses != 1 || stats.hits != 2) fail("integer moves not shared");
+  if (cache.get_entry_count() != 1) fail("expected a single image");
+  lv_color32_t px = canvas.get_px(98, 48);
+  if (px.blue < 0xc0 || px.alpha < 0xc0) fail("blitted icon not drawn");
+  px = canvas.get_px(70, 70);
+  if (px.alpha != 0) fail("drew outside the icons");
+
+  // Next frame: still cached.
+  draw_icons(canvas, cache, icon, {{20, 100}});
+  if (stats.hits != 3) fail("image not reused across frames");
+
+  // A sub-pixel offset or a different path is another image.
+  draw_icons(canvas, cache, icon, {{20.5f, 100}});
+  icon.append_circle(8, 8, 4, 4);
+  draw_icons(canvas, cache, icon, {{20, 100}});
+  if (stats.misses != 3 || cache.get_entry_count() != 3) {
+    fail("changed batches were not rasterized again");
+  }
+  std::cout << "PASS: Batches are reused wherever they are drawn."
+            << std::endl;
+}
+
+void test_cache_budget(lvgl::Canvas& canvas) {
+  std::cout << "Testing the byte budget..." << std::endl;
+  lvgl::VectorCache cache(64 * 1024, nullptr);
+  // Same size, different corners: one image's worth of bytes each.
+  lvgl::VectorPath icons[3];
+  for (int i = 0; i < 3; ++i) icons[i].append_rect(0, 0, 16, 16, i, i);
+  draw_icons(canvas, cache, icons[0], {{10, 10}});
+  size_t one = cache.get_byte_size();
+  if (one == 0) fail("no bytes accounted");
+
+  // Room for two: the third is drawn directly while both are in use.
+  cache.set_byte_budget(one * 2 + one / 2);
+  lv_layer_t layer;
+  canvas.init_layer(&layer);
+  {
+    lvgl::VectorDraw draw(&layer, cache);
+    draw.set_fill_color(kBlue);
+    for (auto& icon : icons) {
+      draw.identity();
+      draw.translate(10, 10);
+      draw.add_path(icon);
+      draw.draw();
+    }
+  }
+  canvas.finish_layer(&layer);
+  if (cache.get_stats().uncached != 1) fail("over-budget miss was cached");
+  if (cache.get_byte_size() > cache.get_byte_budget()) fail("over budget");
+
+  // In a later frame the least recently used image makes room.
+  cache.next_frame();
+  draw_icons(canvas, cache, icons[2], {{10, 10}});
+  if (cache.get_stats().evictions != 1) fail("LRU image not evicted");
+  if (cache.get_entry_count() != 2) fail("wrong entry count");
+
+  cache.set_byte_budget(0);
+  cache.next_frame();
+  if (cache.get_entry_count() != 0 || cache.get_byte_size() != 0) {
+    fail("zero budget kept images");
+  }
+  std::cout << "PASS: Images are evicted to stay within the budget."
+            << std::endl;
+}
+
+void test_image_fill_bypass(lvgl::Canvas& canvas) {
+  std::cout << "Testing image fills..." << std::endl;
+  lvgl::VectorCache cache(64 * 1024, nullptr);
+  lvgl::VectorPath icon;
+  make_icon(icon);
+  lvgl::draw::DrawBuf pattern(8, 8, lvgl::ColorFormat::ARGB8888);
+  pattern.clear();
+  lv_draw_image_dsc_t img;
+  lv_draw_image_dsc_init(&img);
+  img.src = pattern.raw();
+
+  lv_layer_t layer;
+  canvas.init_layer(&layer);
+  {
+    lvgl::VectorDraw draw(&layer, cache);
+    draw.set_fill_image(img);
+    draw.add_path(icon);
+    draw.draw();
+    const auto& stats = cache.get_stats();
+    if (stats.hits + stats.misses != 0) fail("image fill went through cache");
+
+    // Back to a solid fill: cached again.
+    draw.set_fill_color(kBlue);
+    draw.add_path(icon);
+    draw.draw();
+    if (stats.misses != 1) fail("solid fill after an image not cached");
+  }
+  canvas.finish_layer(&layer);
+  std::cout << "PASS: Image fills are drawn directly." << std::endl;
+}
+
+#endif  // LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
+
+int main() {
+  lv_init();
+  lvgl::Display display = lvgl::Display::create(800, 480);
+  lvgl::Object screen(lv_screen_active(), lvgl::Object::Ownership::Unmanaged);
+
+#if LV_USE_VECTOR_GRAPHIC && LV_USE_CANVAS
+  lvgl::draw::DrawBuf buf(160, 160);
+  buf.clear();
+  lvgl::Canvas canvas(screen);
+  canvas.set_draw_buf(buf.raw());
+
+  test_path_hash();
+  test_cache_reuse(canvas);
+  test_cache_budget(canvas);
+  test_image_fill_bypass(canvas);
+#endif
+
+  std::cout << "All vector cache tests passed." << std::endl;
+  return 0;
+}
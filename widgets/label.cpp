@@ -1,13 +1,59 @@
 #include "label.h"
 
+#include <algorithm>
+#include <charconv>
 #include <cstdarg>
+#include <cstring>
+#include <new>
 
 #include "../core/observer.h"
+#include "../misc/text_metrics_cache.h"
 
 #if LV_USE_LABEL
 
 namespace lvgl {
 
+namespace {
+
+// Text formatted or copied on the stack before reaching LVGL.
+constexpr size_t kStackTextSize = 128;
+
+/**
+ * A label's reserved text buffer. It is installed as the label's static
+ * text and found again through the LV_EVENT_DELETE handler that frees it,
+ * so any Label wrapper of the object can use it.
+ */
+struct TextBuffer {
+  size_t capacity;
+
+  char* text() { return reinterpret_cast<char*>(this + 1); }
+
+  static TextBuffer* create(size_t capacity) {
+    void* mem = lv_malloc(sizeof(TextBuffer) + capacity + 1);
+    if (!mem) return nullptr;
+    auto* buf = new (mem) TextBuffer{capacity};
+    buf->text()[0] = '\0';
+    return buf;
+  }
+
+  static void delete_cb(lv_event_t* e) {
+    lv_free(lv_event_get_user_data(e));
+  }
+
+  static TextBuffer* find(lv_obj_t* obj) {
+    uint32_t count = lv_obj_get_event_count(obj);
+    for (uint32_t i = 0; i < count; ++i) {
+      lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+      if (lv_event_dsc_get_cb(dsc) == delete_cb) {
+        return static_cast<TextBuffer*>(lv_event_dsc_get_user_data(dsc));
+      }
+    }
+    return nullptr;
+  }
+};
+
+}  // namespace
+
 Label::Label() : Label(static_cast<Object*>(nullptr), Ownership::Managed) {}
 
 Label::Label(Object* parent, Ownership ownership)
@@ -25,16 +71,103 @@ Label::Label(Object& parent, const char* text) : Label(&parent) {
   set_text(text);
 }
 
-Label& Label::set_text(const std::string& text) {
-  if (raw()) lv_label_set_text(raw(), text.c_str());
+Label& Label::set_text(std::string_view text) {
+  lv_obj_t* obj = raw();
+  if (!obj) return *this;
+
+  // Passing the label's own text back is a refresh, not a no-op.
+  const char* current = lv_label_get_text(obj);
+  if (current && current != text.data() && text == current) return *this;
+
+  TextBuffer* buf = TextBuffer::find(obj);
+  if (buf && text.size() <= buf->capacity) {
+    std::memmove(buf->text(), text.data(), text.size());
+    buf->text()[text.size()] = '\0';
+    lv_label_set_text_static(obj, buf->text());
+    return *this;
+  }
+
+  // LVGL needs a terminated string.
+  if (text.size() < kStackTextSize) {
+    char tmp[kStackTextSize];
+    std::memcpy(tmp, text.data(), text.size());
+    tmp[text.size()] = '\0';
+    lv_label_set_text(obj, tmp);
+  } else {
+    lv_label_set_text(obj, std::string(text).c_str());
+  }
   return *this;
 }
 
 Label& Label::set_text(const char* text) {
-  if (raw()) lv_label_set_text(raw(), text);
+  if (!raw()) return *this;
+  if (!text) {
+    lv_label_set_text(raw(), nullptr);
+    return *this;
+  }
+  return set_text(std::string_view(text));
+}
+
+Label& Label::set_number(int64_t value, uint8_t precision) {
+  precision = std::min<uint8_t>(precision, 18);
+  uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                 : static_cast<uint64_t>(value);
+  char digits[20];
+  char* end = std::to_chars(digits, digits + sizeof(digits), magnitude).ptr;
+  size_t count = static_cast<size_t>(end - digits);
+
+  // Sign, "0.", up to 18 zeros of padding and 20 digits fit in 48 bytes.
+  char buf[48];
+  char* out = buf;
+  if (value < 0) *out++ = '-';
+  if (precision == 0) {
+    out = std::copy(digits, end, out);
+  } else if (count <= precision) {
+    *out++ = '0';
+    *out++ = '.';
+    out = std::fill_n(out, precision - count, '0');
+    out = std::copy(digits, end, out);
+  } else {
+    out = std::copy(digits, end - precision, out);
+    *out++ = '.';
+    out = std::copy(end - precision, end, out);
+  }
+  return set_text(std::string_view(buf, static_cast<size_t>(out - buf)));
+}
+
+Label& Label::reserve_text(size_t capacity) {
+  lv_obj_t* obj = raw();
+  if (!obj) return *this;
+  TextBuffer* old = TextBuffer::find(obj);
+  if (old && old->capacity >= capacity) return *this;
+
+  TextBuffer* buf = TextBuffer::create(capacity);
+  if (!buf) return *this;
+  lv_obj_add_event_cb(obj, TextBuffer::delete_cb, LV_EVENT_DELETE, buf);
+
+  const char* current = lv_label_get_text(obj);
+  size_t len = current ? std::strlen(current) : 0;
+  if (len <= capacity) {
+    std::memcpy(buf->text(), current ? current : "", len + 1);
+    lv_label_set_text_static(obj, buf->text());
+  } else if (old && current == old->text()) {
+    // Too long for either buffer: let LVGL own a copy.
+    lv_label_set_text(obj, current);
+  }
+
+  if (old) {
+    lv_obj_remove_event_cb_with_user_data(obj, TextBuffer::delete_cb, old);
+    lv_free(old);
+  }
   return *this;
 }
 
+size_t Label::get_text_capacity() const {
+  if (!raw()) return 0;
+  TextBuffer* buf = TextBuffer::find(raw());
+  return buf ? buf->capacity : 0;
+}
+
 Label& Label::set_text_fmt(const char* fmt, ...) {
   if (!raw()) return *this;
   va_list args;
@@ -45,8 +178,19 @@ Label& Label::set_text_fmt(const char* fmt, ...) {
 }
 
 Label& Label::set_text_vfmt(const char* fmt, va_list args) {
-  if (raw()) lv_label_set_text_vfmt(raw(), fmt, args);
-  return *this;
+  if (!raw()) return *this;
+  char buf[kStackTextSize];
+  va_list copy;
+  va_copy(copy, args);
+  int len = lv_vsnprintf(buf, sizeof(buf), fmt, copy);
+  va_end(copy);
+  if (len < 0) return *this;
+  if (static_cast<size_t>(len) < sizeof(buf)) {
+    return set_text(std::string_view(buf, static_cast<size_t>(len)));
+  }
+  std::string text(static_cast<size_t>(len), '\0');
+  lv_vsnprintf(text.data(), text.size() + 1, fmt, args);
+  return set_text(std::string_view(text));
 }
 
 std::string Label::get_text() const {
@@ -86,6 +230,24 @@ uint32_t Label::get_selection_end() const {
               : LV_LABEL_TEXT_SELECTION_OFF;
 }
 
+Point Label::get_text_size() const {
+  if (!raw()) return Point();
+  lv_obj_t* obj = raw();
+  // Labels sized to their content never wrap.
+  int32_t max_width = lv_obj_get_style_width(obj, LV_PART_MAIN) ==
+                              LV_SIZE_CONTENT
+                          ? LV_COORD_MAX
+                          : lv_obj_get_content_width(obj);
+  lv_text_flag_t flags = LV_TEXT_FLAG_NONE;
+  if (lv_label_get_recolor(obj)) {
+    flags = static_cast<lv_text_flag_t>(flags | LV_TEXT_FLAG_RECOLOR);
+  }
+  return TextMetricsCache::text_size(
+      lv_label_get_text(obj), lv_obj_get_style_text_font(obj, LV_PART_MAIN),
+      lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN),
+      lv_obj_get_style_text_line_space(obj, LV_PART_MAIN), max_width, flags);
+}
+
 Label& Label::set_recolor(bool en) {
   if (raw()) lv_label_set_recolor(raw(), en);
   return *this;
@@ -1,8 +1,10 @@
 #ifndef LVGL_CPP_WIDGETS_LABEL_H_
 #define LVGL_CPP_WIDGETS_LABEL_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "../core/traits.h"
 #include "../core/widget.h"  // IWYU pragma: export
@@ -21,6 +23,9 @@
  * - **Long Mode**: Control wrapping, scrolling, or ellipsis via `LongMode`.
  * - **Data Binding**: Directly bind label text to a `Subject` via `bind_text`.
  * - **Formatting**: Printf-style formatting directly into the label.
+ * - **Cheap Updates**: Setters skip text that did not change, and
+ *   `reserve_text()` lets frequently updated labels rewrite a fixed buffer
+ *   instead of reallocating.
  *
  * Example:
  * `Label(parent, "Hello").center().set_text_fmt("Count: %d", i);`
@@ -72,18 +77,47 @@ class Label : public Widget<Label> {
 
   /**
    * @brief Set the text of the label.
+   * Does nothing if the label already shows this text, so neither the
+   * buffer nor the layout is touched. With a reserved buffer (see
+   * reserve_text()) text that fits is copied in place.
    * @param text The text to set.
    */
-  Label& set_text(const std::string& text);
+  Label& set_text(std::string_view text);
 
   /**
    * @brief Set the text with C-style string.
-   * @param text The text to set.
+   * Unchanged text is skipped as with set_text(std::string_view).
+   * @param text The text to set, or nullptr to refresh the current text.
    */
   Label& set_text(const char* text);
 
+  /**
+   * @brief Show a fixed-point number, e.g. `set_number(-1234, 2)` shows
+   * "-12.34". Formats with `std::to_chars` instead of printf.
+   * @param value The number, scaled by 10^precision.
+   * @param precision Number of decimal places (at most 18).
+   */
+  Label& set_number(int64_t value, uint8_t precision = 0);
+
+  /**
+   * @brief Give the label a text buffer of fixed capacity.
+   * Later updates that fit are written into it without allocating; longer
+   * text falls back to LVGL's own allocation. The buffer is freed with the
+   * label. The current text is kept if it fits.
+   * @param capacity Maximum text length in bytes, excluding the terminator.
+   */
+  Label& reserve_text(size_t capacity);
+
+  /**
+   * @brief Get the capacity of the reserved text buffer.
+   * @return Capacity in bytes, or 0 if reserve_text() was not called.
+   */
+  size_t get_text_capacity() const;
+
   /**
    * @brief Set the text using printf-style formatting.
+   * Short results are formatted on the stack and go through
+   * set_text(std::string_view).
    * @param fmt Format string.
    */
   Label& set_text_fmt(const char* fmt, ...) LV_FORMAT_ATTRIBUTE(2, 3);
@@ -196,6 +230,13 @@ class Label : public Widget<Label> {
    */
   Point get_letter_pos(uint32_t char_id) const;
 
+  /**
+   * @brief Measure the label's text with its current font, spacing and wrap
+   * width. Served from the TextMetricsCache when it is enabled.
+   * @return Width and height of the text block.
+   */
+  Point get_text_size() const;
+
   /**
    * @brief Bind the label's text to a subject (Int, String, Pointer).
    * @param subject The subject to bind.
@@ -0,0 +1,404 @@
+#include "log_view.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "../misc/lockfree_queue.h"
+
+namespace lvgl {
+
+namespace {
+
+constexpr size_t kSlotSize = LogView::kMaxLineLength + 1;
+constexpr uint32_t kDrainPeriodMs = 10;
+
+// Bytes of `line` that fit a slot without splitting a UTF-8 sequence.
+size_t fit_length(std::string_view line) {
+  if (line.size() <= LogView::kMaxLineLength) return line.size();
+  size_t n = LogView::kMaxLineLength;
+  while (n > 0 && (static_cast<uint8_t>(line[n]) & 0xC0) == 0x80) --n;
+  return n;
+}
+
+// One queued line; fixed-size so producers never allocate.
+struct Entry {
+  lv_color_t color;
+  LogView::Level level;
+  bool has_color;
+  uint8_t length;
+  char text[LogView::kMaxLineLength];
+
+  static Entry make(std::string_view line, LogView::Level level,
+                    bool has_color, lv_color_t color) {
+    Entry e;
+    e.color = color;
+    e.level = level;
+    e.has_color = has_color;
+    e.length = static_cast<uint8_t>(fit_length(line));
+    std::memcpy(e.text, line.data(), e.length);
+    return e;
+  }
+};
+
+}  // namespace
+
+struct LogView::Channel {
+  explicit Channel(size_t capacity) : queue(capacity) {}
+
+  bool push(const Entry& entry) {
+    if (closed.load(std::memory_order_relaxed) || !queue.try_push(entry)) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  LockFreeQueue<Entry> queue;
+  std::atomic<uint32_t> dropped{0};
+  std::atomic<bool> closed{false};  ///< Set when the view is deleted.
+};
+
+/**
+ * Per-object log state. It lives as long as the LVGL object and is found
+ * again through the event handler it is registered with, so any LogView
+ * wrapper of the object can use it.
+ */
+struct LogView::State {
+  struct LineInfo {
+    lv_color_t color;
+    Level level;
+    bool has_color;
+    uint8_t length;
+  };
+
+  lv_obj_t* obj;
+  std::vector<char> text;  ///< kSlotSize bytes per line, NUL-terminated.
+  std::vector<LineInfo> lines;
+  uint32_t head = 0;  ///< Slot of the oldest line.
+  uint32_t count = 0;
+  uint64_t evicted = 0;
+  bool follow = true;
+  bool scrolling = false;  ///< Set while the view scrolls itself.
+  lv_color_t level_colors[4];
+  bool info_color_set = false;  ///< Else Info uses the style text color.
+  std::shared_ptr<Channel> channel;
+  lv_timer_t* timer = nullptr;
+
+  explicit State(lv_obj_t* o) : obj(o) {
+    level_colors[static_cast<int>(Level::Debug)] =
+        lv_palette_main(LV_PALETTE_GREY);
+    level_colors[static_cast<int>(Level::Info)] = lv_color_black();
+    level_colors[static_cast<int>(Level::Warning)] =
+        lv_palette_main(LV_PALETTE_AMBER);
+    level_colors[static_cast<int>(Level::Error)] =
+        lv_palette_main(LV_PALETTE_RED);
+    resize(kDefaultCapacity);
+  }
+
+  uint32_t capacity() const { return static_cast<uint32_t>(lines.size()); }
+
+  void resize(uint32_t capacity) {
+    text.assign(static_cast<size_t>(capacity) * kSlotSize, '\0');
+    lines.assign(capacity, LineInfo{});
+    head = count = 0;
+    evicted = 0;
+  }
+
+  uint32_t slot(uint32_t index) const {
+    return (head + index) % capacity();
+  }
+
+  const char* line_text(uint32_t index) const {
+    return text.data() + static_cast<size_t>(slot(index)) * kSlotSize;
+  }
+
+  /** Store a line, dropping the oldest when full. Returns lines dropped. */
+  uint32_t push(const Entry& e) {
+    uint32_t cap = capacity();
+    if (cap == 0) return 0;
+    uint32_t dropped = 0;
+    uint32_t s;
+    if (count < cap) {
+      s = slot(count);
+      ++count;
+    } else {
+      s = head;
+      head = (head + 1) % cap;
+      ++evicted;
+      dropped = 1;
+    }
+    char* dst = text.data() + static_cast<size_t>(s) * kSlotSize;
+    std::memcpy(dst, e.text, e.length);
+    dst[e.length] = '\0';
+    lines[s] = LineInfo{e.color, e.level, e.has_color, e.length};
+    return dropped;
+  }
+
+  int32_t row_height() const {
+    const lv_font_t* font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    int32_t space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+    return std::max<int32_t>(1, lv_font_get_line_height(font) + space);
+  }
+
+  void scroll_by(int32_t dy) {
+    if (dy == 0) return;
+    scrolling = true;
+    lv_obj_scroll_by(obj, 0, dy, LV_ANIM_OFF);
+    scrolling = false;
+  }
+
+  void scroll_to_tail() {
+    int32_t bottom = lv_obj_get_scroll_bottom(obj);
+    scroll_by(-std::max(bottom, -lv_obj_get_scroll_y(obj)));
+  }
+
+  /** Update scrolling and redraw after lines were added. */
+  void appended(uint32_t dropped) {
+    lv_obj_refresh_self_size(obj);
+    if (follow) {
+      scroll_to_tail();
+    } else if (dropped > 0) {
+      // Keep the lines being read in place while the front is dropped.
+      int32_t top = lv_obj_get_scroll_y(obj);
+      scroll_by(std::min<int32_t>(top, static_cast<int32_t>(dropped) *
+                                           row_height()));
+    }
+    lv_obj_invalidate(obj);
+  }
+
+  uint32_t drain() {
+    if (!channel) return 0;
+    uint32_t moved = 0;
+    uint32_t dropped = 0;
+    Entry e;
+    // Bounded so a flooding producer cannot starve the LVGL thread.
+    size_t limit = channel->queue.capacity();
+    while (moved < limit && channel->queue.try_pop(e)) {
+      dropped += push(e);
+      ++moved;
+    }
+    if (moved > 0) appended(dropped);
+    return moved;
+  }
+
+  void draw(lv_event_t* e) {
+    if (count == 0) return;
+    lv_layer_t* layer = lv_event_get_layer(e);
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    lv_area_t clip = content;
+    if (!lv_obj_area_is_visible(obj, &clip)) return;
+
+    int32_t row_h = row_height();
+    int32_t origin = content.y1 - lv_obj_get_scroll_y(obj);
+    int32_t first = std::max<int32_t>(0, clip.y1 - origin) / row_h;
+    int32_t last = std::min<int32_t>(static_cast<int32_t>(count) - 1,
+                                     (clip.y2 - origin) / row_h);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+    dsc.flag = static_cast<lv_text_flag_t>(dsc.flag | LV_TEXT_FLAG_EXPAND);
+    lv_color_t text_color = dsc.color;
+    int32_t font_h = lv_font_get_line_height(dsc.font);
+    for (int32_t i = first; i <= last; ++i) {
+      uint32_t index = static_cast<uint32_t>(i);
+      const LineInfo& info = lines[slot(index)];
+      if (info.length == 0) continue;
+      if (info.has_color) {
+        dsc.color = info.color;
+      } else if (info.level == Level::Info && !info_color_set) {
+        dsc.color = text_color;
+      } else {
+        dsc.color = level_colors[static_cast<int>(info.level)];
+      }
+      // Slots are only rewritten on the LVGL thread, so the text can be
+      // drawn in place.
+      dsc.text = line_text(index);
+      int32_t y = origin + i * row_h;
+      lv_area_t area{content.x1, y, content.x2, y + font_h - 1};
+      lv_draw_label(layer, &dsc, &area);
+    }
+  }
+
+  static void timer_cb(lv_timer_t* timer) {
+    static_cast<State*>(lv_timer_get_user_data(timer))->drain();
+  }
+
+  static void event_cb(lv_event_t* e) {
+    auto* s = static_cast<State*>(lv_event_get_user_data(e));
+    switch (lv_event_get_code(e)) {
+      case LV_EVENT_DELETE:
+        if (s->timer) lv_timer_delete(s->timer);
+        if (s->channel) s->channel->closed.store(true);
+        delete s;
+        break;
+      case LV_EVENT_GET_SELF_SIZE: {
+        auto* p = static_cast<lv_point_t*>(lv_event_get_param(e));
+        int32_t space = lv_obj_get_style_text_line_space(s->obj, LV_PART_MAIN);
+        int32_t h = static_cast<int32_t>(s->count) * s->row_height() - space;
+        p->y = std::max(p->y, h);
+        break;
+      }
+      case LV_EVENT_SCROLL:
+        if (!s->scrolling) s->follow = lv_obj_get_scroll_bottom(s->obj) <= 0;
+        break;
+      case LV_EVENT_SIZE_CHANGED:
+        if (s->follow) s->scroll_to_tail();
+        break;
+      case LV_EVENT_DRAW_MAIN:
+        s->draw(e);
+        break;
+      default:
+        break;
+    }
+  }
+
+  static void attach(lv_obj_t* obj) {
+    if (!obj) return;
+    lv_obj_add_event_cb(obj, event_cb, LV_EVENT_ALL, new State(obj));
+  }
+};
+
+LogView::Producer::Producer(std::shared_ptr<Channel> channel)
+    : channel_(std::move(channel)) {}
+
+bool LogView::Producer::log(std::string_view line, Level level) {
+  if (!channel_) return false;
+  return channel_->push(Entry::make(line, level, false, lv_color_black()));
+}
+
+bool LogView::Producer::log(std::string_view line, Color color) {
+  if (!channel_) return false;
+  return channel_->push(Entry::make(line, Level::Info, true, color));
+}
+
+uint32_t LogView::Producer::get_dropped() const {
+  return channel_ ? channel_->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+LogView::LogView()
+    : LogView(static_cast<Object*>(nullptr), Ownership::Managed) {}
+
+LogView::LogView(Object* parent, Ownership ownership)
+    : Widget(parent, ownership) {
+  State::attach(raw());
+}
+
+LogView::LogView(Object& parent) : LogView(&parent) {}
+
+LogView::LogView(lv_obj_t* obj, Ownership ownership)
+    : Widget(obj, ownership) {}
+
+LogView::State* LogView::state() const {
+  lv_obj_t* obj = raw();
+  if (!obj) return nullptr;
+  uint32_t count = lv_obj_get_event_count(obj);
+  for (uint32_t i = 0; i < count; ++i) {
+    lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+    if (lv_event_dsc_get_cb(dsc) == State::event_cb) {
+      return static_cast<State*>(lv_event_dsc_get_user_data(dsc));
+    }
+  }
+  return nullptr;
+}
+
+LogView& LogView::set_capacity(uint32_t lines) {
+  if (State* s = state()) {
+    s->resize(lines);
+    lv_obj_refresh_self_size(raw());
+    lv_obj_scroll_to_y(raw(), 0, LV_ANIM_OFF);
+    lv_obj_invalidate(raw());
+  }
+  return *this;
+}
+
+uint32_t LogView::get_capacity() const {
+  State* s = state();
+  return s ? s->capacity() : 0;
+}
+
+LogView& LogView::append(std::string_view line, Level level) {
+  if (State* s = state()) {
+    s->appended(s->push(Entry::make(line, level, false, lv_color_black())));
+  }
+  return *this;
+}
+
+LogView& LogView::append(std::string_view line, Color color) {
+  if (State* s = state()) {
+    s->appended(s->push(Entry::make(line, Level::Info, true, color)));
+  }
+  return *this;
+}
+
+LogView& LogView::clear() {
+  if (State* s = state()) {
+    s->head = s->count = 0;
+    s->evicted = 0;
+    s->follow = true;
+    lv_obj_refresh_self_size(raw());
+    lv_obj_scroll_to_y(raw(), 0, LV_ANIM_OFF);
+    lv_obj_invalidate(raw());
+  }
+  return *this;
+}
+
+uint32_t LogView::get_line_count() const {
+  State* s = state();
+  return s ? s->count : 0;
+}
+
+std::string_view LogView::get_line(uint32_t index) const {
+  State* s = state();
+  if (!s || index >= s->count) return {};
+  return std::string_view(s->line_text(index),
+                          s->lines[s->slot(index)].length);
+}
+
+uint64_t LogView::get_evicted_count() const {
+  State* s = state();
+  return s ? s->evicted : 0;
+}
+
+LogView& LogView::set_level_color(Level level, Color color) {
+  if (State* s = state()) {
+    s->level_colors[static_cast<int>(level)] = color;
+    if (level == Level::Info) s->info_color_set = true;
+    lv_obj_invalidate(raw());
+  }
+  return *this;
+}
+
+LogView& LogView::set_follow(bool follow) {
+  if (State* s = state()) {
+    s->follow = follow;
+    if (follow) s->scroll_to_tail();
+  }
+  return *this;
+}
+
+bool LogView::is_following() const {
+  State* s = state();
+  return s && s->follow;
+}
+
+LogView::Producer LogView::get_producer(size_t queue_capacity) {
+  State* s = state();
+  if (!s) return Producer();
+  if (!s->channel) {
+    s->channel = std::make_shared<Channel>(queue_capacity);
+    s->timer = lv_timer_create(State::timer_cb, kDrainPeriodMs, s);
+  }
+  return Producer(s->channel);
+}
+
+uint32_t LogView::drain() {
+  State* s = state();
+  return s ? s->drain() : 0;
+}
+
+}  // namespace lvgl
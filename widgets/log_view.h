@@ -0,0 +1,169 @@
+#ifndef LVGL_CPP_WIDGETS_LOG_VIEW_H_
+#define LVGL_CPP_WIDGETS_LOG_VIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "../core/widget.h"  // IWYU pragma: export
+#include "../misc/color.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file log_view.h
+ * @brief User Guide:
+ * `LogView` shows the last N lines of a live log. Unlike a `Textarea` fed
+ * with `add_text`, its memory is fixed: lines go into a ring buffer
+ * allocated up front, and the oldest line is dropped when it is full.
+ *
+ * Key Features:
+ * - **Bounded**: `set_capacity()` preallocates every line slot; appending
+ *   never allocates.
+ * - **Visible-only drawing**: Lines are one row each and drawn straight
+ *   from the ring buffer, so a frame costs the same with 10 or 10,000
+ *   lines stored.
+ * - **Levels and colors**: Each line has a level with its own color, or
+ *   an explicit color.
+ * - **Tail follow**: The view sticks to the newest line until the user
+ *   scrolls up, and resumes once they scroll back to the bottom.
+ * - **Any-thread ingest**: A `Producer` pushes lines through a lock-free
+ *   queue that the view drains on the LVGL thread.
+ *
+ * Example:
+ * @code
+ * lvgl::LogView log(screen);
+ * log.set_size(lv_pct(100), lv_pct(100));
+ * log.set_capacity(500);
+ * auto producer = log.get_producer();
+ * std::thread worker([producer]() mutable {
+ *   producer.log("sensor ready", lvgl::LogView::Level::Info);
+ * });
+ * @endcode
+ */
+namespace lvgl {
+
+/**
+ * @brief Scrolling, fixed-capacity log display.
+ */
+class LogView : public Widget<LogView> {
+ public:
+  enum class Level : uint8_t {
+    Debug,
+    Info,  ///< Drawn in the text color of the style.
+    Warning,
+    Error,
+  };
+
+  /** Longer lines are truncated to this many bytes. */
+  static constexpr size_t kMaxLineLength = 119;
+
+  /** Lines kept until set_capacity() says otherwise. */
+  static constexpr uint32_t kDefaultCapacity = 200;
+
+  /**
+   * Queue slots allocated by default for producers. The queue should hold
+   * the lines arriving between two drains; the view drains every 10 ms.
+   */
+  static constexpr size_t kDefaultQueueCapacity = 512;
+
+  struct Channel;
+
+  /**
+   * @brief Thread-safe handle for logging into a view.
+   *
+   * Copies share one queue. Logging never blocks or allocates: when the
+   * queue is full the line is dropped and counted. A producer stays valid
+   * after its view is deleted; its lines are then discarded.
+   */
+  class Producer {
+   public:
+    Producer() = default;
+
+    /**
+     * @brief Queue a line.
+     * @return false if the line was dropped.
+     */
+    bool log(std::string_view line, Level level = Level::Info);
+    bool log(std::string_view line, Color color);
+
+    /**
+     * @brief Lines dropped because the queue was full.
+     */
+    uint32_t get_dropped() const;
+
+   private:
+    friend class LogView;
+    explicit Producer(std::shared_ptr<Channel> channel);
+    std::shared_ptr<Channel> channel_;
+  };
+
+  LogView();
+  explicit LogView(Object* parent, Ownership ownership = Ownership::Default);
+  explicit LogView(Object& parent);
+  explicit LogView(lv_obj_t* obj, Ownership ownership = Ownership::Default);
+
+  /**
+   * @brief Keep at most `lines` lines. Allocates all slots and clears the
+   * log.
+   */
+  LogView& set_capacity(uint32_t lines);
+  uint32_t get_capacity() const;
+
+  /**
+   * @brief Append a line on the LVGL thread. Newlines are not split.
+   */
+  LogView& append(std::string_view line, Level level = Level::Info);
+  LogView& append(std::string_view line, Color color);
+
+  LogView& clear();
+
+  /**
+   * @brief Number of lines currently stored.
+   */
+  uint32_t get_line_count() const;
+
+  /**
+   * @brief A stored line, 0 being the oldest. Valid until the next append.
+   */
+  std::string_view get_line(uint32_t index) const;
+
+  /**
+   * @brief Total lines dropped from the front since the last clear.
+   */
+  uint64_t get_evicted_count() const;
+
+  /**
+   * @brief Color used for lines of a level. Info lines use the style's
+   * text color until this is called for them.
+   */
+  LogView& set_level_color(Level level, Color color);
+
+  /**
+   * @brief Keep the newest line in view. Turned off when the user scrolls
+   * away from the bottom and back on when they return.
+   */
+  LogView& set_follow(bool follow);
+  bool is_following() const;
+
+  /**
+   * @brief Handle for feeding lines from other threads. The first call
+   * creates the queue with `queue_capacity` slots; later calls share it.
+   */
+  Producer get_producer(size_t queue_capacity = kDefaultQueueCapacity);
+
+  /**
+   * @brief Move queued lines into the log now. Runs automatically from an
+   * LVGL timer once a producer exists.
+   * @return Number of lines moved.
+   */
+  uint32_t drain();
+
+ private:
+  struct State;
+  State* state() const;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_WIDGETS_LOG_VIEW_H_
@@ -1,10 +1,23 @@
 #include "span.h"
 
 #if LV_USE_SPAN
+#include <cstring>
+
 #include "../misc/style.h"
+#include "../misc/text_metrics_cache.h"
 
 namespace lvgl {
 
+namespace {
+
+bool span_unchanged(lv_span_t* span, const char* text) {
+  if (!text) return false;
+  const char* current = lv_span_get_text(span);
+  return current && std::strcmp(current, text) == 0;
+}
+
+}  // namespace
+
 // ============================================================================
 // Span Proxy Implementation
 // ============================================================================
@@ -12,7 +25,7 @@ namespace lvgl {
 Span::Span(lv_span_t* span, SpanGroup* group) : span_(span), group_(group) {}
 
 Span& Span::set_text(const char* text) {
-  if (span_) lv_span_set_text(span_, text);
+  if (span_ && !span_unchanged(span_, text)) lv_span_set_text(span_, text);
   return *this;
 }
 
@@ -27,7 +40,7 @@ Span& Span::set_text_fmt(const char* fmt, ...) {
     va_start(args, fmt);
     char buf[256];  // Temporary buffer for formatting
     vsnprintf(buf, sizeof(buf), fmt, args);
-    lv_span_set_text(span_, buf);
+    if (!span_unchanged(span_, buf)) lv_span_set_text(span_, buf);
     va_end(args);
   }
   return *this;
@@ -45,6 +58,28 @@ const char* Span::get_text() const {
   return span_ ? lv_span_get_text(span_) : nullptr;
 }
 
+Point Span::get_text_size(int32_t max_width) const {
+  if (!span_) return Point();
+  lv_obj_t* group = group_ ? group_->raw() : nullptr;
+  const lv_font_t* font =
+      group ? lv_obj_get_style_text_font(group, LV_PART_MAIN) : LV_FONT_DEFAULT;
+  int32_t letter_space =
+      group ? lv_obj_get_style_text_letter_space(group, LV_PART_MAIN) : 0;
+
+  lv_style_t* style = lv_span_get_style(span_);
+  lv_style_value_t value;
+  if (lv_style_get_prop(style, LV_STYLE_TEXT_FONT, &value) ==
+      LV_STYLE_RES_FOUND) {
+    font = static_cast<const lv_font_t*>(value.ptr);
+  }
+  if (lv_style_get_prop(style, LV_STYLE_TEXT_LETTER_SPACE, &value) ==
+      LV_STYLE_RES_FOUND) {
+    letter_space = value.num;
+  }
+  return TextMetricsCache::text_size(lv_span_get_text(span_), font,
+                                     letter_space, 0, max_width);
+}
+
 lv_span_t* Span::raw() const { return span_; }
 
 void Span::refresh() {
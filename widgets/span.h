@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include "../core/widget.h"  // IWYU pragma: export
+#include "../misc/geometry.h"
 #include "lvgl.h"            // IWYU pragma: export
 
 #if LV_USE_SPAN
@@ -26,6 +27,11 @@ class Span {
  public:
   Span(lv_span_t* span, SpanGroup* group);
 
+  /**
+   * @brief Set the span text.
+   * Setting the text the span already holds is skipped, so the group is not
+   * laid out again.
+   */
   Span& set_text(const char* text);
   Span& set_text_static(const char* text);
   Span& set_text_fmt(const char* fmt, ...);
@@ -33,6 +39,14 @@ class Span {
   Span& style(const Style& style);  // Alias
 
   const char* get_text() const;
+
+  /**
+   * @brief Measure the span text on its own with the span's font and letter
+   * spacing (falling back to the group's style). Served from the
+   * TextMetricsCache when it is enabled.
+   * @param max_width Wrap width, or `LV_COORD_MAX` for a single line.
+   */
+  Point get_text_size(int32_t max_width = LV_COORD_MAX) const;
   lv_span_t* raw() const;
   void refresh();
 
@@ -1,13 +1,49 @@
 #include "table.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "../misc/text_metrics_cache.h"
+
 #if LV_USE_TABLE
 
 namespace lvgl {
 
+namespace {
+
+// Skip the update when the cell already holds this text.
+bool cell_unchanged(lv_obj_t* table, uint32_t row, uint32_t col,
+                    const char* txt) {
+  if (!txt) return false;
+  if (row >= lv_table_get_row_count(table) ||
+      col >= lv_table_get_column_count(table)) {
+    return false;
+  }
+  const char* current = lv_table_get_cell_value(table, row, col);
+  return current && std::strcmp(current, txt) == 0;
+}
+
+Point measure_cell(lv_obj_t* table, uint32_t row, uint32_t col,
+                   int32_t max_width) {
+  return TextMetricsCache::text_size(
+      lv_table_get_cell_value(table, row, col),
+      lv_obj_get_style_text_font(table, LV_PART_ITEMS),
+      lv_obj_get_style_text_letter_space(table, LV_PART_ITEMS),
+      lv_obj_get_style_text_line_space(table, LV_PART_ITEMS), max_width);
+}
+
+int32_t cell_padding(lv_obj_t* table) {
+  return lv_obj_get_style_pad_left(table, LV_PART_ITEMS) +
+         lv_obj_get_style_pad_right(table, LV_PART_ITEMS);
+}
+
+}  // namespace
+
 // --- TableCell ---
 
 TableCell& TableCell::set_value(const char* txt) {
-  if (table_ && table_->raw()) {
+  if (table_ && table_->raw() &&
+      !cell_unchanged(table_->raw(), row_, col_, txt)) {
     lv_table_set_cell_value(table_->raw(), row_, col_, txt);
   }
   return *this;
@@ -44,6 +80,14 @@ bool TableCell::has_ctrl(Table::Control ctrl) const {
              : false;
 }
 
+Point TableCell::get_text_size() const {
+  if (!table_ || !table_->raw()) return Point();
+  lv_obj_t* table = table_->raw();
+  int32_t max_width =
+      lv_table_get_column_width(table, col_) - cell_padding(table);
+  return measure_cell(table, row_, col_, std::max<int32_t>(max_width, 0));
+}
+
 TableCell& TableCell::set_user_data(void* user_data) {
   if (table_ && table_->raw()) {
     lv_table_set_cell_user_data(table_->raw(), static_cast<uint16_t>(row_),
@@ -122,7 +166,9 @@ Table& Table::set_cell_value_fmt(uint32_t row, uint32_t col, const char* fmt,
     va_start(args, fmt);
     vsnprintf(buf, sizeof(buf), fmt, args);
     va_end(args);
-    lv_table_set_cell_value(raw(), row, col, buf);
+    if (!cell_unchanged(raw(), row, col, buf)) {
+      lv_table_set_cell_value(raw(), row, col, buf);
+    }
   }
   return *this;
 }
@@ -132,6 +178,18 @@ Table& Table::set_selected_cell(uint32_t row, uint32_t col) {
   return *this;
 }
 
+Table& Table::fit_column_width(uint32_t col, int32_t min_width) {
+  if (!raw() || col >= lv_table_get_column_count(raw())) return *this;
+  int32_t width = 0;
+  uint32_t rows = lv_table_get_row_count(raw());
+  for (uint32_t row = 0; row < rows; ++row) {
+    width = std::max(width, measure_cell(raw(), row, col, LV_COORD_MAX).x());
+  }
+  lv_table_set_column_width(raw(), col,
+                            std::max(width + cell_padding(raw()), min_width));
+  return *this;
+}
+
 Table& Table::on_value_changed(std::function<void(lvgl::Event&)> cb) {
   add_event_cb(EventCode::ValueChanged, std::move(cb));
   return *this;
@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include "../core/widget.h"  // IWYU pragma: export
+#include "../misc/geometry.h"
 #include "lvgl.h"            // IWYU pragma: export
 
 #if LV_USE_TABLE
@@ -87,6 +88,15 @@ class Table : public Widget<Table> {
    * @param col Column index.
    */
   Table& set_selected_cell(uint32_t row, uint32_t col);
+
+  /**
+   * @brief Resize a column to fit its widest cell.
+   * Cells are measured on one line through the TextMetricsCache, so
+   * refitting a table of repeated values is cheap.
+   * @param col Column index.
+   * @param min_width Lower bound for the column width.
+   */
+  Table& fit_column_width(uint32_t col, int32_t min_width = 0);
 };
 
 /**
@@ -97,6 +107,11 @@ class TableCell {
   TableCell(Table* table, uint32_t row, uint32_t col)
       : table_(table), row_(row), col_(col) {}
 
+  /**
+   * @brief Set the cell text.
+   * Setting the text a cell already holds is skipped, so LVGL does not
+   * re-measure the whole row.
+   */
   TableCell& set_value(const char* txt);
   TableCell& set_ctrl(Table::Control ctrl);
 
@@ -105,6 +120,12 @@ class TableCell {
   TableCell& add_ctrl(Table::Control ctrl);
 
   bool has_ctrl(Table::Control ctrl) const;
+
+  /**
+   * @brief Measure the cell text as it wraps in the current column width.
+   * Served from the TextMetricsCache when it is enabled.
+   */
+  Point get_text_size() const;
   TableCell& set_user_data(void* user_data);
   void* get_user_data();
 
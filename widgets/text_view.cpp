@@ -0,0 +1,308 @@
+#include "text_view.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace lvgl {
+
+/**
+ * Per-object view state. It lives as long as the LVGL object and is found
+ * again through the event handler it is registered with, so any TextView
+ * wrapper of the object can use it.
+ */
+struct TextView::State {
+  lv_obj_t* obj;
+  TextDocument* doc = nullptr;
+  // Wrapped rows per line, 0 while unmeasured. `tree` is a Fenwick tree
+  // over the same values with unmeasured lines weighted as one row, so
+  // line <-> row mapping is O(log n).
+  std::vector<uint16_t> rows;
+  std::vector<uint32_t> tree{0};
+  uint32_t total = 0;
+  int32_t width = -1;  ///< Content width the cached rows are valid for.
+  std::string scratch;
+  Stats stats{};
+
+  struct Metrics {
+    const lv_font_t* font;
+    int32_t letter_space;
+    int32_t line_space;
+    int32_t row_h;
+  };
+
+  explicit State(lv_obj_t* o) : obj(o) {}
+
+  static uint32_t weight(uint16_t r) { return r ? r : 1; }
+  static size_t lowbit(size_t i) { return i & (~i + 1); }
+
+  Metrics metrics() const {
+    Metrics m;
+    m.font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    m.letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    m.line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+    m.row_h = std::max<int32_t>(1, lv_font_get_line_height(m.font) +
+                                       m.line_space);
+    return m;
+  }
+
+  /** Rows before `line`. */
+  uint32_t prefix(size_t line) const {
+    uint32_t sum = 0;
+    for (size_t i = line; i > 0; i -= lowbit(i)) sum += tree[i];
+    return sum;
+  }
+
+  /** The line containing `row`, clamped to the last line. */
+  size_t find(uint32_t row) const {
+    size_t pos = 0;
+    size_t step = 1;
+    while (step * 2 < tree.size()) step *= 2;
+    for (; step > 0; step /= 2) {
+      if (pos + step < tree.size() && tree[pos + step] <= row) {
+        pos += step;
+        row -= tree[pos];
+      }
+    }
+    return rows.empty() ? 0 : std::min(pos, rows.size() - 1);
+  }
+
+  void rebuild() {
+    size_t n = rows.size();
+    tree.assign(n + 1, 0);
+    total = 0;
+    for (size_t i = 1; i <= n; ++i) {
+      tree[i] += weight(rows[i - 1]);
+      total += weight(rows[i - 1]);
+      if (i + lowbit(i) <= n) tree[i + lowbit(i)] += tree[i];
+    }
+  }
+
+  void push_back(uint16_t r) {
+    rows.push_back(r);
+    size_t i = rows.size();
+    tree.push_back(weight(r) + prefix(i - 1) - prefix(i - lowbit(i)));
+    total += weight(r);
+  }
+
+  void set(size_t line, uint16_t r) {
+    // Unsigned wraparound makes a shrinking delta work too.
+    uint32_t delta = weight(r) - weight(rows[line]);
+    rows[line] = r;
+    for (size_t i = line + 1; i < tree.size(); i += lowbit(i)) {
+      tree[i] += delta;
+    }
+    total += delta;
+  }
+
+  int32_t height(const Metrics& m) const {
+    return total > 0 ? static_cast<int32_t>(total) * m.row_h - m.line_space
+                     : 0;
+  }
+
+  void measure(size_t line, const Metrics& m) {
+    doc->get_line(static_cast<uint32_t>(line), &scratch);
+    lv_point_t size;
+    lv_text_get_size(&size, scratch.c_str(), m.font, m.letter_space,
+                     m.line_space, width, LV_TEXT_FLAG_NONE);
+    int32_t r = (size.y + m.line_space) / m.row_h;
+    set(line, static_cast<uint16_t>(std::clamp<int32_t>(r, 1, 0xFFFF)));
+    ++stats.lines_measured;
+  }
+
+  /** Measure the unmeasured lines in the viewport. */
+  void measure_visible() {
+    if (!doc) return;
+    int32_t w = lv_obj_get_content_width(obj);
+    if (w <= 0) return;
+    Metrics m = metrics();
+    if (w != width) {
+      width = w;
+      std::fill(rows.begin(), rows.end(), 0);
+      rebuild();
+    }
+
+    int32_t before = height(m);
+    int32_t top = std::max<int32_t>(0, lv_obj_get_scroll_y(obj));
+    int32_t bottom = top + lv_obj_get_content_height(obj);
+    size_t line = find(static_cast<uint32_t>(top / m.row_h));
+    int32_t y = static_cast<int32_t>(prefix(line)) * m.row_h;
+    for (; line < rows.size() && y < bottom; ++line) {
+      if (rows[line] == 0) measure(line, m);
+      y += rows[line] * m.row_h;
+    }
+    if (height(m) != before) {
+      lv_obj_refresh_self_size(obj);
+      lv_obj_invalidate(obj);
+    }
+  }
+
+  void on_change(const TextDocument::Change& c) {
+    size_t n = rows.size();
+    size_t first = std::min<size_t>(c.first_line, n);
+    size_t removed = std::min<size_t>(c.removed_lines, n - first);
+    if (removed == c.added_lines) {
+      for (size_t i = first; i < first + removed; ++i) set(i, 0);
+    } else if (first + removed == n) {
+      // Edits at the end, e.g. appends, only touch the tail of the tree.
+      rows.resize(first);
+      tree.resize(first + 1);
+      total = prefix(first);
+      for (uint32_t i = 0; i < c.added_lines; ++i) push_back(0);
+    } else {
+      rows.erase(rows.begin() + first, rows.begin() + first + removed);
+      rows.insert(rows.begin() + first, c.added_lines, 0);
+      rebuild();
+    }
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+    measure_visible();
+  }
+
+  void draw(lv_event_t* e) {
+    if (!doc || rows.empty()) return;
+    lv_layer_t* layer = lv_event_get_layer(e);
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    lv_area_t clip = content;
+    if (!lv_obj_area_is_visible(obj, &clip)) return;
+    if (width < 0) width = lv_area_get_width(&content);
+
+    Metrics m = metrics();
+    int32_t origin = content.y1 - lv_obj_get_scroll_y(obj);
+    int32_t first_row = std::max<int32_t>(0, clip.y1 - origin) / m.row_h;
+    size_t line = find(static_cast<uint32_t>(first_row));
+    int32_t y = origin + static_cast<int32_t>(prefix(line)) * m.row_h;
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+    for (; line < rows.size() && y <= clip.y2; ++line) {
+      if (rows[line] == 0) measure(line, m);
+      int32_t h = rows[line] * m.row_h;
+      doc->get_line(static_cast<uint32_t>(line), &scratch);
+      if (!scratch.empty()) {
+        lv_area_t area{content.x1, y, content.x2, y + h - 1};
+        dsc.text = scratch.c_str();
+        dsc.text_local = 1;  // `scratch` is reused for the next line.
+        lv_draw_label(layer, &dsc, &area);
+        ++stats.lines_drawn;
+      }
+      y += h;
+    }
+  }
+
+  static void event_cb(lv_event_t* e) {
+    auto* s = static_cast<State*>(lv_event_get_user_data(e));
+    switch (lv_event_get_code(e)) {
+      case LV_EVENT_DELETE:
+        if (s->doc) s->doc->set_change_callback(nullptr);
+        delete s;
+        break;
+      case LV_EVENT_GET_SELF_SIZE: {
+        auto* p = static_cast<lv_point_t*>(lv_event_get_param(e));
+        p->y = std::max(p->y, s->height(s->metrics()));
+        break;
+      }
+      case LV_EVENT_STYLE_CHANGED:
+        s->width = -1;
+        s->measure_visible();
+        break;
+      case LV_EVENT_SIZE_CHANGED:
+      case LV_EVENT_SCROLL:
+        s->measure_visible();
+        break;
+      case LV_EVENT_DRAW_MAIN:
+        s->draw(e);
+        break;
+      default:
+        break;
+    }
+  }
+
+  static void attach(lv_obj_t* obj) {
+    if (!obj) return;
+    lv_obj_add_event_cb(obj, event_cb, LV_EVENT_ALL, new State(obj));
+  }
+};
+
+TextView::TextView()
+    : TextView(static_cast<Object*>(nullptr), Ownership::Managed) {}
+
+TextView::TextView(Object* parent, Ownership ownership)
+    : Widget(parent, ownership) {
+  State::attach(raw());
+}
+
+TextView::TextView(Object& parent) : TextView(&parent) {}
+
+TextView::TextView(lv_obj_t* obj, Ownership ownership)
+    : Widget(obj, ownership) {}
+
+TextView::State* TextView::state() const {
+  lv_obj_t* obj = raw();
+  if (!obj) return nullptr;
+  uint32_t count = lv_obj_get_event_count(obj);
+  for (uint32_t i = 0; i < count; ++i) {
+    lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+    if (lv_event_dsc_get_cb(dsc) == State::event_cb) {
+      return static_cast<State*>(lv_event_dsc_get_user_data(dsc));
+    }
+  }
+  return nullptr;
+}
+
+TextView& TextView::set_document(TextDocument* doc) {
+  State* s = state();
+  if (!s) return *this;
+  if (s->doc && s->doc != doc) s->doc->set_change_callback(nullptr);
+  s->doc = doc;
+  s->rows.assign(doc ? doc->line_count() : 0, 0);
+  s->rebuild();
+  if (doc) {
+    doc->set_change_callback(
+        [s](const TextDocument::Change& c) { s->on_change(c); });
+  }
+  lv_obj_refresh_self_size(raw());
+  lv_obj_invalidate(raw());
+  s->measure_visible();
+  return *this;
+}
+
+TextDocument* TextView::get_document() const {
+  State* s = state();
+  return s ? s->doc : nullptr;
+}
+
+TextView& TextView::scroll_to_line(uint32_t line, bool anim) {
+  State* s = state();
+  if (!s || s->rows.empty()) return *this;
+  line = std::min<uint32_t>(line, static_cast<uint32_t>(s->rows.size() - 1));
+  int32_t y = static_cast<int32_t>(s->prefix(line)) * s->metrics().row_h;
+  lv_obj_scroll_to_y(raw(), y, anim ? LV_ANIM_ON : LV_ANIM_OFF);
+  return *this;
+}
+
+uint32_t TextView::get_first_visible_line() const {
+  State* s = state();
+  if (!s) return 0;
+  int32_t top = std::max<int32_t>(0, lv_obj_get_scroll_y(raw()));
+  return static_cast<uint32_t>(
+      s->find(static_cast<uint32_t>(top / s->metrics().row_h)));
+}
+
+uint32_t TextView::get_row_count() const {
+  State* s = state();
+  return s ? s->total : 0;
+}
+
+TextView::Stats TextView::get_stats() const {
+  State* s = state();
+  return s ? s->stats : Stats{};
+}
+
+void TextView::reset_stats() {
+  if (State* s = state()) s->stats = Stats{};
+}
+
+}  // namespace lvgl
@@ -0,0 +1,99 @@
+#ifndef LVGL_CPP_WIDGETS_TEXT_VIEW_H_
+#define LVGL_CPP_WIDGETS_TEXT_VIEW_H_
+
+#include <cstdint>
+
+#include "../core/widget.h"  // IWYU pragma: export
+#include "../misc/text_document.h"
+#include "lvgl.h"  // IWYU pragma: export
+
+/**
+ * @file text_view.h
+ * @brief User Guide:
+ * `TextView` shows a `TextDocument` that may be far larger than a `Label`
+ * or `Textarea` can handle. Instead of laying out the whole text, it keeps
+ * a per-line count of wrapped rows and only measures and draws the lines
+ * that are on screen.
+ *
+ * The view has no cursor or key handling: edit the `TextDocument`
+ * (`insert()`, `erase()`, `append()`) and the view follows.
+ *
+ * Key Features:
+ * - **Visible-only work**: Scrolling measures the lines that come into
+ *   view; drawing touches only the lines inside the visible area.
+ * - **Incremental wrap cache**: Edits reported by the document invalidate
+ *   just the changed lines. Lines not measured yet count as one row, so
+ *   the scrollable height converges as the user scrolls.
+ * - **Styling**: Font, color, letter and line spacing come from the
+ *   object's `LV_PART_MAIN` style.
+ *
+ * Example:
+ * @code
+ * lvgl::TextDocument doc(load_log());
+ * lvgl::TextView view(screen);
+ * view.set_size(lv_pct(100), lv_pct(100));
+ * view.set_document(&doc);
+ * doc.append("another line\n");  // The view updates itself.
+ * @endcode
+ */
+namespace lvgl {
+
+/**
+ * @brief Scrollable, read-only view of a TextDocument.
+ *
+ * The view installs itself as the document's change callback and does not
+ * own the document: it must outlive the view or be detached with
+ * `set_document(nullptr)` first.
+ */
+class TextView : public Widget<TextView> {
+ public:
+  /**
+   * @brief Work done by the view, for tests and benchmarks.
+   */
+  struct Stats {
+    uint32_t lines_measured;  ///< Lines whose wrapped height was computed.
+    uint32_t lines_drawn;     ///< Line draw calls issued.
+  };
+
+  TextView();
+  explicit TextView(Object* parent, Ownership ownership = Ownership::Default);
+  explicit TextView(Object& parent);
+  explicit TextView(lv_obj_t* obj, Ownership ownership = Ownership::Default);
+
+  /**
+   * @brief Show a document, or nothing if `doc` is nullptr.
+   * Replaces the change callback of the document.
+   */
+  TextView& set_document(TextDocument* doc);
+
+  /**
+   * @brief The document being shown, or nullptr.
+   */
+  TextDocument* get_document() const;
+
+  /**
+   * @brief Scroll so a line is at the top of the view.
+   */
+  TextView& scroll_to_line(uint32_t line, bool anim = false);
+
+  /**
+   * @brief Index of the topmost line in view.
+   */
+  uint32_t get_first_visible_line() const;
+
+  /**
+   * @brief Total wrapped rows, counting unmeasured lines as one row.
+   */
+  uint32_t get_row_count() const;
+
+  Stats get_stats() const;
+  void reset_stats();
+
+ private:
+  struct State;
+  State* state() const;
+};
+
+}  // namespace lvgl
+
+#endif  // LVGL_CPP_WIDGETS_TEXT_VIEW_H_